@@ -25,6 +25,7 @@
 #include <aws/core/utils/stream/PreallocatedStreamBuf.h>
 #include <glog/logging.h>
 
+#include <cerrno>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -513,6 +514,24 @@ bool S3Adapter::ObjectExist(const Aws::String& key) {
   }
 }
 
+int S3Adapter::GetObjectSize(const Aws::String& key, uint64_t* size) {
+  Aws::S3::Model::HeadObjectRequest request;
+  request.SetBucket(bucketName_);
+  request.SetKey(key);
+  auto response = s3Client_->HeadObject(request);
+  if (response.IsSuccess()) {
+    *size = response.GetResult().GetContentLength();
+    return 0;
+  } else if (response.GetError().GetResponseCode() ==
+             Aws::Http::HttpResponseCode::NOT_FOUND) {
+    return -ENOENT;
+  }
+  LOG(ERROR) << "HeadObject error:" << bucketName_ << "--" << key << "--"
+             << response.GetError().GetExceptionName()
+             << response.GetError().GetMessage();
+  return -1;
+}
+
 int S3Adapter::DeleteObject(const Aws::String& key) {
   Aws::S3::Model::DeleteObjectRequest request;
   request.SetBucket(bucketName_);
@@ -528,6 +547,25 @@ int S3Adapter::DeleteObject(const Aws::String& key) {
   }
 }
 
+int S3Adapter::CopyObject(const Aws::String& src_key,
+                          const Aws::String& dst_key) {
+  Aws::S3::Model::CopyObjectRequest request;
+  request.SetBucket(bucketName_);
+  request.SetKey(dst_key);
+  // the object key only consists of digits, '_' and '/', no need to encode
+  request.SetCopySource(bucketName_ + "/" + src_key);
+  auto response = s3Client_->CopyObject(request);
+  if (response.IsSuccess()) {
+    return 0;
+  } else {
+    LOG(ERROR) << "CopyObject error:" << bucketName_ << "--" << src_key
+               << "->" << dst_key << "--"
+               << response.GetError().GetExceptionName()
+               << response.GetError().GetMessage();
+    return -1;
+  }
+}
+
 int S3Adapter::DeleteObjects(const std::list<Aws::String>& key_list) {
   Aws::S3::Model::DeleteObjectsRequest delete_objects_request;
   Aws::S3::Model::Delete delete_objects;
@@ -37,6 +37,7 @@
 #include <aws/s3/model/BucketLocationConstraint.h>
 #include <aws/s3/model/CompleteMultipartUploadRequest.h>
 #include <aws/s3/model/CompletedPart.h>
+#include <aws/s3/model/CopyObjectRequest.h>
 #include <aws/s3/model/CreateBucketConfiguration.h>
 #include <aws/s3/model/CreateBucketRequest.h>
 #include <aws/s3/model/CreateMultipartUploadRequest.h>
@@ -277,6 +278,16 @@ class S3Adapter {
   virtual int DeleteObject(const Aws::String& key);
 
   virtual int DeleteObjects(const std::list<Aws::String>& key_list);
+
+  /**
+   * 服务端拷贝对象, 数据不经过客户端
+   * @param 源对象名
+   * @param 目标对象名
+   * @return: 0 拷贝成功/ -1 拷贝失败
+   */
+  virtual int CopyObject(const Aws::String& src_key,
+                         const Aws::String& dst_key);
+
   /**
    * 判断对象是否存在
    * @param 对象名
@@ -284,6 +295,14 @@ class S3Adapter {
    */
   virtual bool ObjectExist(const Aws::String& key);
 
+  /**
+   * 获取对象大小
+   * @param 对象名
+   * @param[out] 对象大小
+   * @return: 0 成功/ -ENOENT 对象不存在/ -1 失败
+   */
+  virtual int GetObjectSize(const Aws::String& key, uint64_t* size);
+
   /**
    * 初始化对象的分片上传任务
    * @param 对象名
@@ -431,6 +450,19 @@ class FakeS3Adapter final : public S3Adapter {
     (void)key;
     return true;
   }
+
+  int GetObjectSize(const Aws::String& key, uint64_t* size) override {
+    (void)key;
+    *size = 4 * 1024 * 1024;
+    return 0;
+  }
+
+  int CopyObject(const Aws::String& src_key,
+                 const Aws::String& dst_key) override {
+    (void)src_key;
+    (void)dst_key;
+    return 0;
+  }
 };
 
 }  // namespace aws
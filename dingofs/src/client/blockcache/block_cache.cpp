@@ -37,6 +37,7 @@
 #include "dingofs/src/client/blockcache/log.h"
 #include "dingofs/src/client/blockcache/mem_cache.h"
 #include "dingofs/src/client/blockcache/phase_timer.h"
+#include "dingofs/src/client/blockcache/tiered_cache.h"
 
 namespace dingofs {
 namespace client {
@@ -49,7 +50,12 @@ BlockCacheImpl::BlockCacheImpl(BlockCacheOption option)
       stage_count_(std::make_shared<Countdown>()),
       throttle_(std::make_unique<BlockCacheThrottle>()) {
   if (option.cache_store == "none") {
-    store_ = std::make_shared<MemCache>();
+    store_ = std::make_shared<MemCache>();  // disabled
+  } else if (option.cache_store == "memory") {
+    store_ = std::make_shared<MemCache>(option.mem_cache_option);
+  } else if (option.cache_store == "tiered") {
+    store_ = std::make_shared<TieredCache>(option.mem_cache_option,
+                                           option.disk_cache_options);
   } else {
     store_ = std::make_shared<DiskCacheGroup>(option.disk_cache_options);
   }
@@ -62,7 +68,8 @@ BCACHE_ERROR BlockCacheImpl::Init() {
   if (!running_.exchange(true)) {
     throttle_->Start();
     uploader_->Init(option_.upload_stage_workers,
-                    option_.upload_stage_queue_size);
+                    option_.upload_stage_queue_size,
+                    option_.upload_stage_pack_size);
     return store_->Init([this](const BlockKey& key,
                                const std::string& stage_path,
                                BlockContext ctx) {
@@ -136,10 +143,24 @@ BCACHE_ERROR BlockCacheImpl::Range(const BlockKey& key, off_t offset,
   timer.NextPhase(Phase::S3_RANGE);
   if (retrive) {
     rc = s3_->Range(key.StoreKey(), offset, length, buffer);
+    if (rc == BCACHE_ERROR::NOT_FOUND) {  // maybe packed with other blocks
+      rc = RangePackedBlock(s3_.get(), key, offset, length, buffer);
+    }
   }
   return rc;
 }
 
+BCACHE_ERROR BlockCacheImpl::Load(const BlockKey& key,
+                                  std::shared_ptr<BlockReader>& reader) {
+  BCACHE_ERROR rc;
+  LogGuard log([&]() {
+    return StrFormat("load(%s): %s", key.Filename(), StrErr(rc));
+  });
+
+  rc = store_->Load(key, reader);
+  return rc;
+}
+
 BCACHE_ERROR BlockCacheImpl::Cache(const BlockKey& key, const Block& block) {
   BCACHE_ERROR rc;
   LogGuard log([&]() {
@@ -155,7 +176,9 @@ BCACHE_ERROR BlockCacheImpl::Flush(uint64_t ino) {
   BCACHE_ERROR rc;
   LogGuard log([&]() { return StrFormat("flush(%d): %s", ino, StrErr(rc)); });
 
+  uploader_->Urge(ino);
   rc = stage_count_->Wait(ino);
+  uploader_->Unurge(ino);
   return rc;
 }
 
@@ -166,8 +189,10 @@ bool BlockCacheImpl::IsCached(const BlockKey& key) {
 StoreType BlockCacheImpl::GetStoreType() {
   if (option_.cache_store == "none") {
     return StoreType::NONE;
+  } else if (option_.cache_store == "memory") {
+    return StoreType::MEMORY;
   }
-  return StoreType::DISK;
+  return StoreType::DISK;  // disk or tiered, both support stage
 }
 
 }  // namespace blockcache
@@ -49,6 +49,7 @@ using ::dingofs::client::common::BlockCacheOption;
 enum class StoreType {
   NONE,
   DISK,
+  MEMORY,
 };
 
 class BlockCache {
@@ -65,6 +66,11 @@ class BlockCache {
   virtual BCACHE_ERROR Range(const BlockKey& key, off_t offset, size_t length,
                              char* buffer, bool retrive = true) = 0;
 
+  // Load the cached block for zero-copy read, the |reader| should be closed
+  // after the data consumed.
+  virtual BCACHE_ERROR Load(const BlockKey& key,
+                            std::shared_ptr<BlockReader>& reader) = 0;
+
   virtual BCACHE_ERROR Cache(const BlockKey& key, const Block& block) = 0;
 
   virtual BCACHE_ERROR Flush(uint64_t ino) = 0;
@@ -90,6 +96,9 @@ class BlockCacheImpl : public BlockCache {
   BCACHE_ERROR Range(const BlockKey& key, off_t offset, size_t length,
                      char* buffer, bool retrive = true) override;
 
+  BCACHE_ERROR Load(const BlockKey& key,
+                    std::shared_ptr<BlockReader>& reader) override;
+
   BCACHE_ERROR Cache(const BlockKey& key, const Block& block) override;
 
   BCACHE_ERROR Flush(uint64_t ino) override;
@@ -140,6 +140,55 @@ class BlockCacheMetric {
   Metric metric_;
 };
 
+// Metric for each tier of tiered cache, e.g. memory tier, disk tier
+class BlockCacheTierMetric {
+ public:
+  explicit BlockCacheTierMetric(const std::string& tier)
+      : metric_("dingofs_block_cache." + tier + "_tier") {}
+
+  virtual ~BlockCacheTierMetric() = default;
+
+  void AddLoad(bool hit, int64_t latency_us) {
+    if (hit) {
+      metric_.hits << 1;
+      metric_.load_latency << latency_us;
+    } else {
+      metric_.misses << 1;
+    }
+  }
+
+  void AddPromotion() { metric_.promotions << 1; }
+
+  void AddDemotion() { metric_.demotions << 1; }
+
+ private:
+  struct Metric {
+    Metric(const std::string& prefix)
+        : hits(prefix, "hits"),
+          misses(prefix, "misses"),
+          hit_ratio(prefix, "hit_ratio", &Metric::GetHitRatio, this),
+          load_latency(prefix, "load_latency", 1),
+          promotions(prefix, "promotions"),
+          demotions(prefix, "demotions") {}
+
+    static double GetHitRatio(void* arg) {
+      auto* metric = static_cast<Metric*>(arg);
+      int64_t hits = metric->hits.get_value();
+      int64_t total = hits + metric->misses.get_value();
+      return total == 0 ? 0 : static_cast<double>(hits) / total;
+    }
+
+    bvar::Adder<int64_t> hits;
+    bvar::Adder<int64_t> misses;
+    bvar::PassiveStatus<double> hit_ratio;
+    bvar::LatencyRecorder load_latency;  // only for hit
+    bvar::Adder<int64_t> promotions;     // blocks promoted into this tier
+    bvar::Adder<int64_t> demotions;      // blocks demoted into this tier
+  };
+
+  Metric metric_;
+};
+
 }  // namespace blockcache
 }  // namespace client
 }  // namespace dingofs
@@ -22,6 +22,8 @@
 
 #include "dingofs/src/client/blockcache/block_cache_uploader.h"
 
+#include <sys/stat.h>
+
 #include <chrono>
 #include <memory>
 #include <mutex>
@@ -30,12 +32,12 @@
 
 #include "absl/cleanup/cleanup.h"
 #include "dingofs/src/client/blockcache/block_cache_uploader_cmmon.h"
+#include "dingofs/src/client/blockcache/block_pack.h"
 #include "dingofs/src/client/blockcache/cache_store.h"
 #include "dingofs/src/client/blockcache/error.h"
 #include "dingofs/src/client/blockcache/local_filesystem.h"
 #include "dingofs/src/client/blockcache/log.h"
 #include "dingofs/src/client/blockcache/phase_timer.h"
-#include "dingofs/src/client/blockcache/segments.h"
 #include "dingofs/src/client/common/dynamic_config.h"
 
 namespace dingofs {
@@ -47,7 +49,11 @@ USING_FLAG(drop_page_cache);
 BlockCacheUploader::BlockCacheUploader(std::shared_ptr<S3Client> s3,
                                        std::shared_ptr<CacheStore> store,
                                        std::shared_ptr<Countdown> stage_count)
-    : running_(false), s3_(s3), store_(store), stage_count_(stage_count) {
+    : running_(false),
+      pack_block_size_(0),
+      s3_(s3),
+      store_(store),
+      stage_count_(stage_count) {
   scan_stage_thread_pool_ =
       std::make_unique<TaskThreadPool<>>("scan_stage_worker");
   upload_stage_thread_pool_ =
@@ -55,11 +61,15 @@ BlockCacheUploader::BlockCacheUploader(std::shared_ptr<S3Client> s3,
 }
 
 void BlockCacheUploader::Init(uint64_t upload_workers,
-                              uint64_t upload_queue_size) {
+                              uint64_t upload_queue_size,
+                              uint64_t pack_block_size) {
   if (!running_.exchange(true)) {
+    pack_block_size_ = pack_block_size;
+
     // pending and uploading queue
     pending_queue_ = std::make_shared<PendingQueue>();
     uploading_queue_ = std::make_shared<UploadingQueue>(upload_queue_size);
+    delay_metric_ = std::make_unique<UploadDelayMetric>();
 
     // scan stage block worker
     CHECK(scan_stage_thread_pool_->Start(1) == 0);
@@ -91,35 +101,83 @@ void BlockCacheUploader::AddStageBlock(const BlockKey& key,
   pending_queue_->Push(stage_block);
 }
 
+void BlockCacheUploader::Urge(uint64_t ino) { pending_queue_->Urge(ino); }
+
+void BlockCacheUploader::Unurge(uint64_t ino) { pending_queue_->Unurge(ino); }
+
 // Reserve space for stage blocks which from |CTO_FLUSH|
-bool BlockCacheUploader::CanUpload(const std::vector<StageBlock>& blocks) {
-  if (blocks.empty()) {
-    return false;
-  }
-  auto from = blocks[0].ctx.from;
-  return from == BlockFrom::CTO_FLUSH ||
-         uploading_queue_->Size() < uploading_queue_->Capacity() * 0.5;
+bool BlockCacheUploader::HasFreeSlot() {
+  return uploading_queue_->Size() < uploading_queue_->Capacity() * 0.5;
 }
 
 void BlockCacheUploader::ScaningWorker() {
   while (running_.load(std::memory_order_relaxed)) {
-    auto stage_blocks = pending_queue_->Pop(true);  // peek it
-    if (!CanUpload(stage_blocks)) {
+    auto stage_blocks = pending_queue_->Pop(!HasFreeSlot());
+    if (stage_blocks.empty()) {
       std::this_thread::sleep_for(std::chrono::milliseconds(10));
       continue;
     }
 
-    stage_blocks = pending_queue_->Pop();
+    if (pack_block_size_ > 0) {
+      stage_blocks = PackStageBlocks(stage_blocks);
+    }
     for (const auto& stage_block : stage_blocks) {
       uploading_queue_->Push(stage_block);
     }
   }
 }
 
+// The blocks of one chunk are staged together, and the pending queue pops
+// blocks of one inode in staged order, so they are adjacent.
+std::vector<StageBlock> BlockCacheUploader::PackStageBlocks(
+    const std::vector<StageBlock>& stage_blocks) {
+  std::vector<StageBlock> packed;
+  bool packable = false;  // whether the last one can be packed with next
+  for (const auto& stage_block : stage_blocks) {
+    bool small = IsSmallBlock(stage_block);
+    if (small && packable) {
+      auto& last = packed.back();
+      const auto& prev =
+          last.packed.empty() ? last.key : last.packed.back().key;
+      if (BlockPack::IsAdjacent(prev, stage_block.key) &&
+          last.packed.size() + 1 < BlockPack::kMaxBlocks) {
+        last.packed.emplace_back(stage_block);
+        continue;
+      }
+    }
+    packed.emplace_back(stage_block);
+    packable = small;
+  }
+  return packed;
+}
+
+bool BlockCacheUploader::IsSmallBlock(const StageBlock& stage_block) {
+  struct stat file;
+  auto fs = NewTempLocalFileSystem();
+  auto rc = fs->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
+    return posix->Stat(stage_block.stage_path, &file);
+  });
+  return rc == BCACHE_ERROR::OK &&
+         static_cast<uint64_t>(file.st_size) < pack_block_size_;
+}
+
 void BlockCacheUploader::UploadingWorker() {
   while (running_.load(std::memory_order_relaxed)) {
-    auto stage_block = uploading_queue_->Pop();
-    UploadStageBlock(stage_block);
+    StageBlock stage_block;
+    if (!uploading_queue_->Pop(&stage_block)) {
+      continue;
+    }
+
+    delay_metric_->Add(stage_block);
+    for (const auto& block : stage_block.packed) {
+      delay_metric_->Add(block);
+    }
+
+    if (stage_block.packed.empty()) {
+      UploadStageBlock(stage_block);
+    } else {
+      UploadPackedBlocks(stage_block);
+    }
   }
 }
 
@@ -193,6 +251,74 @@ void BlockCacheUploader::UploadBlock(const StageBlock& stage_block,
   s3_->AsyncPut(stage_block.key.StoreKey(), buffer.get(), length, retry_cb);
 }
 
+// Any block failed to read will break the consecutive blocks, so we upload
+// them one by one instead, so do we if the pack marker can't be put.
+void BlockCacheUploader::UploadPackedBlocks(const StageBlock& stage_block) {
+  PhaseTimer timer;
+  auto stage_blocks = stage_block.packed;
+  stage_blocks.insert(stage_blocks.begin(), stage_block);
+  stage_blocks.front().packed.clear();
+  if (!PutPackMarker(stage_block.key.fs_id)) {
+    for (const auto& item : stage_blocks) {
+      UploadStageBlock(item);
+    }
+    return;
+  }
+
+  timer.NextPhase(Phase::READ_BLOCK);
+  BlockPack pack;
+  std::vector<size_t> lengths;
+  for (const auto& block : stage_blocks) {
+    std::shared_ptr<char> buffer;
+    size_t length;
+    if (ReadBlock(block, buffer, &length) != BCACHE_ERROR::OK) {
+      for (const auto& item : stage_blocks) {
+        UploadStageBlock(item);
+      }
+      return;
+    }
+    pack.Add(block.key, buffer.get(), length);
+    lengths.emplace_back(length);
+  }
+
+  timer.NextPhase(Phase::S3_PUT);
+  auto key = pack.FirstKey();
+  auto data = std::make_shared<std::string>(pack.Finish());
+  auto retry_cb = [stage_blocks, lengths, data, key, timer, this](int code) {
+    if (code != 0) {
+      LOG(ERROR) << "Upload packed object " << key.Filename()
+                 << " failed, code=" << code;
+      return true;  // retry
+    }
+
+    for (size_t i = 0; i < stage_blocks.size(); i++) {
+      RemoveBlock(stage_blocks[i]);
+      Uploaded(stage_blocks[i], true);
+      Log(stage_blocks[i], lengths[i], BCACHE_ERROR::OK, timer);
+    }
+    return false;
+  };
+  s3_->AsyncPut(key.StoreKey(), data->data(), data->size(), retry_cb);
+}
+
+// Readers only probe the pack if the marker exists, so it must be put
+// before any pack of the filesystem.
+bool BlockCacheUploader::PutPackMarker(uint64_t fs_id) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (marked_fs_ids_.count(fs_id) != 0) {
+    return true;
+  }
+
+  auto rc = s3_->Put(BlockPack::MarkerKey(fs_id), "", 0);
+  if (rc != BCACHE_ERROR::OK) {
+    LOG(ERROR) << "Put pack marker of filesystem " << fs_id
+               << " failed: " << StrErr(rc);
+    return false;
+  }
+  marked_fs_ids_.insert(fs_id);
+  return true;
+}
+
 void BlockCacheUploader::RemoveBlock(const StageBlock& stage_block) {
   auto rc = store_->RemoveStage(stage_block.key, stage_block.ctx);
   if (rc != BCACHE_ERROR::OK) {
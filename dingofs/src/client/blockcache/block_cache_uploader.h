@@ -26,6 +26,8 @@
 #include <atomic>
 #include <memory>
 #include <mutex>
+#include <unordered_set>
+#include <vector>
 
 #include "dingofs/src/client/blockcache/block_cache_uploader_cmmon.h"
 #include "dingofs/src/client/blockcache/cache_store.h"
@@ -44,6 +46,11 @@ using ::dingofs::utils::TaskThreadPool;
 // How it works:
 //               add                   scan                     put
 // [stage block]----> [pending queue] -----> [uploading queue] ----> [s3]
+//
+// The pending queue decides which blocks are scanned first, see PendingQueue.
+//
+// If pack enabled, the consecutive small blocks of one chunk which scanned
+// together are uploaded as one object, see BlockPack.
 class BlockCacheUploader {
  public:
   BlockCacheUploader(std::shared_ptr<S3Client> s3,
@@ -52,23 +59,35 @@ class BlockCacheUploader {
 
   virtual ~BlockCacheUploader() = default;
 
-  void Init(uint64_t upload_workers, uint64_t upload_queue_size);
+  // The block smaller than |pack_block_size| will be packed, 0 means disable.
+  void Init(uint64_t upload_workers, uint64_t upload_queue_size,
+            uint64_t pack_block_size = 0);
 
   void Shutdown();
 
   void AddStageBlock(const BlockKey& key, const std::string& stage_path,
                      BlockContext ctx);
 
+  // The stage blocks of flushing inode are uploaded before others.
+  void Urge(uint64_t ino);
+
+  void Unurge(uint64_t ino);
+
   void WaitAllUploaded();
 
  private:
   friend class BlockCacheMetricHelper;
 
  private:
-  bool CanUpload(const std::vector<StageBlock>& blocks);
+  bool HasFreeSlot();
 
   void ScaningWorker();
 
+  std::vector<StageBlock> PackStageBlocks(
+      const std::vector<StageBlock>& stage_blocks);
+
+  bool IsSmallBlock(const StageBlock& stage_block);
+
   void UploadingWorker();
 
   void UploadStageBlock(const StageBlock& stage_block);
@@ -79,6 +98,10 @@ class BlockCacheUploader {
   void UploadBlock(const StageBlock& stage_block, std::shared_ptr<char> buffer,
                    size_t length, PhaseTimer timer);
 
+  void UploadPackedBlocks(const StageBlock& stage_block);
+
+  bool PutPackMarker(uint64_t fs_id);
+
   void RemoveBlock(const StageBlock& stage_block);
 
   void Staging(const StageBlock& stage_block);
@@ -90,11 +113,14 @@ class BlockCacheUploader {
  private:
   std::mutex mutex_;
   std::atomic<bool> running_;
+  uint64_t pack_block_size_;
+  std::unordered_set<uint64_t> marked_fs_ids_;  // protected by mutex_
   std::shared_ptr<S3Client> s3_;
   std::shared_ptr<CacheStore> store_;
   std::shared_ptr<Countdown> stage_count_;
   std::shared_ptr<PendingQueue> pending_queue_;
   std::shared_ptr<UploadingQueue> uploading_queue_;
+  std::unique_ptr<UploadDelayMetric> delay_metric_;
   std::unique_ptr<TaskThreadPool<>> scan_stage_thread_pool_;
   std::unique_ptr<TaskThreadPool<>> upload_stage_thread_pool_;
 };
@@ -23,24 +23,39 @@
 #ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_BLOCK_CACHE_UPLOADER_COMMON_H_
 #define DINGOFS_SRC_CLIENT_BLOCKCACHE_BLOCK_CACHE_UPLOADER_COMMON_H_
 
+#include <butil/time.h>
+#include <bvar/bvar.h>
+
 #include <condition_variable>
+#include <deque>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <queue>
 #include <unordered_map>
+#include <vector>
 
 #include "dingofs/src/client/blockcache/cache_store.h"
 #include "dingofs/src/client/blockcache/countdown.h"
-#include "dingofs/src/client/blockcache/segments.h"
 
 namespace dingofs {
 namespace client {
 namespace blockcache {
 
 struct StageBlock {
+  StageBlock() : seq_num(0), ctx(BlockFrom::RELOAD) {}
+
   StageBlock(uint64_t seq_num, const BlockKey& key,
              const std::string& stage_path, BlockContext ctx)
-      : seq_num(seq_num), key(key), stage_path(stage_path), ctx(ctx) {}
-
+      : seq_num(seq_num),
+        key(key),
+        stage_path(stage_path),
+        ctx(ctx),
+        urgent(false),
+        stage_time_us(butil::monotonic_time_us()) {}
+
+  // The urgent block goes first, then by |BlockFrom|, and FIFO for the
+  // same class.
   bool operator<(const StageBlock& other) const {
     static std::unordered_map<BlockFrom, uint8_t> priority{
         {BlockFrom::CTO_FLUSH, 0},
@@ -48,7 +63,9 @@ struct StageBlock {
         {BlockFrom::RELOAD, 2},
     };
 
-    if (ctx.from == other.ctx.from) {
+    if (urgent != other.urgent) {
+      return other.urgent;
+    } else if (ctx.from == other.ctx.from) {
       return seq_num > other.seq_num;
     }
     return priority[ctx.from] > priority[other.ctx.from];
@@ -58,6 +75,9 @@ struct StageBlock {
   BlockKey key;
   std::string stage_path;
   BlockContext ctx;
+  bool urgent;                     // the inode is flushing
+  int64_t stage_time_us;           // for queueing delay
+  std::vector<StageBlock> packed;  // the following blocks packed with it
 };
 
 struct StatBlocks {
@@ -76,23 +96,63 @@ struct StatBlocks {
   uint64_t num_from_reload;
 };
 
+// The pending queue schedules stage blocks as follows:
+//
+//   1) the CTO_FLUSH blocks of flushing inode (urgent) go first;
+//   2) the block which waits longer than |block_cache_upload_max_delay_ms|
+//      goes next, so the lower class will not starve;
+//   3) otherwise by class: CTO_FLUSH > NOCTO_FLUSH > RELOAD.
+//
+// Inodes of the same class are served in round-robin, each turn pops at
+// most |kQuantum| blocks of one inode, so a large file can't block
+// the others.
 class PendingQueue {
+  struct InodeBlocks {
+    std::deque<StageBlock> blocks;  // in staged order
+    std::list<uint64_t>::iterator iter;
+  };
+
+  struct ClassQueue {
+    std::unordered_map<uint64_t, InodeBlocks> inodes;
+    std::list<uint64_t> round_robin;  // front is the next one to serve
+  };
+
  public:
   PendingQueue() = default;
 
   void Push(const StageBlock& stage_block);
 
-  std::vector<StageBlock> Pop(bool peek = false);
+  // Pop the next blocks of one inode, only CTO_FLUSH blocks are popped
+  // if |cto_only| is true.
+  std::vector<StageBlock> Pop(bool cto_only = false);
+
+  // Mark the inode flushing or not, it can be nested.
+  void Urge(uint64_t ino);
+
+  void Unurge(uint64_t ino);
 
   size_t Size();
 
   void Stat(struct StatBlocks* stat);
 
+ private:
+  ClassQueue* Queue(const StageBlock& stage_block);
+
+  static void PushBack(ClassQueue* queue, const StageBlock& stage_block);
+
+  static void MoveInode(ClassQueue* from, ClassQueue* to, uint64_t ino);
+
+  static std::vector<StageBlock> PopFront(ClassQueue* queue);
+
+  static const StageBlock* Front(ClassQueue* queue);
+
  private:
   std::mutex mutex_;
-  std::unordered_map<BlockFrom, Segments<StageBlock>> queues_;
+  ClassQueue urgent_queue_;
+  std::unordered_map<BlockFrom, ClassQueue> queues_;
   std::unordered_map<BlockFrom, uint64_t> count_;
-  static constexpr uint64_t kSegmentSize = 100;
+  std::unordered_map<uint64_t, uint32_t> flushing_;  // ino -> nested count
+  static constexpr uint64_t kQuantum = 16;
 };
 
 class UploadingQueue {
@@ -101,7 +161,8 @@ class UploadingQueue {
 
   void Push(const StageBlock& stage_block);
 
-  StageBlock Pop();
+  // Return false if no block within |timeout_ms|, so the worker can exit.
+  bool Pop(StageBlock* stage_block, uint64_t timeout_ms = 100);
 
   size_t Size();
 
@@ -114,10 +175,40 @@ class UploadingQueue {
   size_t capacity_;
   std::condition_variable not_empty_;
   std::condition_variable not_full_;
+  uint64_t next_seq_num_;
   std::priority_queue<StageBlock> queue_;
   std::unordered_map<BlockFrom, uint64_t> count_;
 };
 
+// Queueing delay (from staged to start uploading) for each class.
+class UploadDelayMetric {
+ public:
+  UploadDelayMetric()
+      : urgent_("dingofs_block_cache", "upload_delay_urgent", 1),
+        cto_("dingofs_block_cache", "upload_delay_cto", 1),
+        nocto_("dingofs_block_cache", "upload_delay_nocto", 1),
+        reload_("dingofs_block_cache", "upload_delay_reload", 1) {}
+
+  void Add(const StageBlock& stage_block) {
+    auto delay_us = butil::monotonic_time_us() - stage_block.stage_time_us;
+    if (stage_block.urgent) {
+      urgent_ << delay_us;
+    } else if (stage_block.ctx.from == BlockFrom::CTO_FLUSH) {
+      cto_ << delay_us;
+    } else if (stage_block.ctx.from == BlockFrom::NOCTO_FLUSH) {
+      nocto_ << delay_us;
+    } else {
+      reload_ << delay_us;
+    }
+  }
+
+ private:
+  bvar::LatencyRecorder urgent_;
+  bvar::LatencyRecorder cto_;
+  bvar::LatencyRecorder nocto_;
+  bvar::LatencyRecorder reload_;
+};
+
 }  // namespace blockcache
 }  // namespace client
 }  // namespace dingofs
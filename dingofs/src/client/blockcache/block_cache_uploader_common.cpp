@@ -22,6 +22,10 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
 #include "dingofs/src/client/blockcache/block_cache_uploader_cmmon.h"
 #include "dingofs/src/client/common/dynamic_config.h"
 
@@ -29,22 +33,15 @@ namespace dingofs {
 namespace client {
 namespace blockcache {
 
-USING_FLAG(drop_page_cache);
+USING_FLAG(block_cache_upload_max_delay_ms);
 
 void PendingQueue::Push(const StageBlock& stage_block) {
   std::unique_lock<std::mutex> lk(mutex_);
-  auto from = stage_block.ctx.from;
-  auto iter = queues_.find(from);
-  if (iter == queues_.end()) {
-    iter = queues_.emplace(from, Segments<StageBlock>(kSegmentSize)).first;
-  }
-
-  auto& queue = iter->second;
-  queue.Push(stage_block);
-  count_[from]++;
+  PushBack(Queue(stage_block), stage_block);
+  count_[stage_block.ctx.from]++;
 }
 
-std::vector<StageBlock> PendingQueue::Pop(bool peek) {
+std::vector<StageBlock> PendingQueue::Pop(bool cto_only) {
   static std::vector<BlockFrom> pop_prority{
       BlockFrom::CTO_FLUSH,
       BlockFrom::NOCTO_FLUSH,
@@ -52,25 +49,76 @@ std::vector<StageBlock> PendingQueue::Pop(bool peek) {
   };
 
   std::unique_lock<std::mutex> lk(mutex_);
+  std::vector<StageBlock> stage_blocks;
+  if (!urgent_queue_.round_robin.empty()) {
+    stage_blocks = PopFront(&urgent_queue_);
+    for (auto& stage_block : stage_blocks) {
+      stage_block.urgent = true;
+    }
+  }
+
+  // the oldest one which exceed the max delay
+  uint64_t max_delay_us = FLAGS_block_cache_upload_max_delay_ms * 1000;
+  if (stage_blocks.empty() && max_delay_us > 0) {
+    ClassQueue* oldest = nullptr;
+    int64_t oldest_time_us = butil::monotonic_time_us() - max_delay_us;
+    for (const auto& from : pop_prority) {
+      auto iter = queues_.find(from);
+      if (iter == queues_.end() || (cto_only && from != BlockFrom::CTO_FLUSH)) {
+        continue;
+      }
+
+      const auto* front = Front(&iter->second);
+      if (front != nullptr && front->stage_time_us < oldest_time_us) {
+        oldest = &iter->second;
+        oldest_time_us = front->stage_time_us;
+      }
+    }
+    if (oldest != nullptr) {
+      stage_blocks = PopFront(oldest);
+    }
+  }
+
   for (const auto& from : pop_prority) {
+    if (!stage_blocks.empty() || (cto_only && from != BlockFrom::CTO_FLUSH)) {
+      break;
+    }
     auto iter = queues_.find(from);
-    if (iter != queues_.end() && iter->second.Size() != 0) {
-      auto stage_blocks = iter->second.Pop(peek);
-      if (!peek) {
-        CHECK(count_[from] >= stage_blocks.size());
-        count_[from] -= stage_blocks.size();
-      }
-      return stage_blocks;
+    if (iter != queues_.end()) {
+      stage_blocks = PopFront(&iter->second);
     }
   }
-  return std::vector<StageBlock>();
+
+  for (const auto& stage_block : stage_blocks) {
+    auto from = stage_block.ctx.from;
+    CHECK(count_[from] > 0);
+    count_[from]--;
+  }
+  return stage_blocks;
+}
+
+void PendingQueue::Urge(uint64_t ino) {
+  std::unique_lock<std::mutex> lk(mutex_);
+  if (flushing_[ino]++ == 0) {
+    MoveInode(&queues_[BlockFrom::CTO_FLUSH], &urgent_queue_, ino);
+  }
+}
+
+void PendingQueue::Unurge(uint64_t ino) {
+  std::unique_lock<std::mutex> lk(mutex_);
+  auto iter = flushing_.find(ino);
+  CHECK(iter != flushing_.end());
+  if (--iter->second == 0) {
+    flushing_.erase(iter);
+    MoveInode(&urgent_queue_, &queues_[BlockFrom::CTO_FLUSH], ino);
+  }
 }
 
 size_t PendingQueue::Size() {
   std::unique_lock<std::mutex> lk(mutex_);
   size_t size = 0;
-  for (auto& item : queues_) {
-    size += item.second.Size();
+  for (auto& item : count_) {
+    size += item.second;
   }
   return size;
 }
@@ -84,31 +132,101 @@ void PendingQueue::Stat(struct StatBlocks* stat) {
   *stat = StatBlocks(num_total, num_from_cto, num_from_nocto, num_from_reload);
 }
 
-UploadingQueue::UploadingQueue(size_t capacity) : capacity_(capacity) {}
+// protect by mutex
+PendingQueue::ClassQueue* PendingQueue::Queue(const StageBlock& stage_block) {
+  auto from = stage_block.ctx.from;
+  if (from == BlockFrom::CTO_FLUSH &&
+      flushing_.find(stage_block.key.ino) != flushing_.end()) {
+    return &urgent_queue_;
+  }
+  return &queues_[from];
+}
+
+void PendingQueue::PushBack(ClassQueue* queue, const StageBlock& stage_block) {
+  auto ino = stage_block.key.ino;
+  auto iter = queue->inodes.find(ino);
+  if (iter == queue->inodes.end()) {
+    queue->round_robin.emplace_back(ino);
+    iter = queue->inodes.emplace(ino, InodeBlocks()).first;
+    iter->second.iter = std::prev(queue->round_robin.end());
+  }
+  iter->second.blocks.emplace_back(stage_block);
+}
+
+void PendingQueue::MoveInode(ClassQueue* from, ClassQueue* to, uint64_t ino) {
+  auto iter = from->inodes.find(ino);
+  if (iter == from->inodes.end()) {
+    return;
+  }
+
+  for (const auto& stage_block : iter->second.blocks) {
+    PushBack(to, stage_block);
+  }
+  from->round_robin.erase(iter->second.iter);
+  from->inodes.erase(iter);
+}
+
+std::vector<StageBlock> PendingQueue::PopFront(ClassQueue* queue) {
+  if (queue->round_robin.empty()) {
+    return std::vector<StageBlock>();
+  }
+
+  auto ino = queue->round_robin.front();
+  auto iter = queue->inodes.find(ino);
+  CHECK(iter != queue->inodes.end());
+  auto& blocks = iter->second.blocks;
+  size_t n = std::min(blocks.size(), static_cast<size_t>(kQuantum));
+  std::vector<StageBlock> stage_blocks(blocks.begin(), blocks.begin() + n);
+  blocks.erase(blocks.begin(), blocks.begin() + n);
+
+  if (blocks.empty()) {
+    queue->round_robin.pop_front();
+    queue->inodes.erase(iter);
+  } else {  // next turn
+    queue->round_robin.splice(queue->round_robin.end(), queue->round_robin,
+                              queue->round_robin.begin());
+  }
+  return stage_blocks;
+}
+
+const StageBlock* PendingQueue::Front(ClassQueue* queue) {
+  if (queue->round_robin.empty()) {
+    return nullptr;
+  }
+  return &queue->inodes.at(queue->round_robin.front()).blocks.front();
+}
+
+UploadingQueue::UploadingQueue(size_t capacity)
+    : capacity_(capacity), next_seq_num_(0) {}
 
+// The blocks are pushed in scheduled order, so the |seq_num| is reassigned
+// to keep it for the same class.
 void UploadingQueue::Push(const StageBlock& stage_block) {
   std::unique_lock<std::mutex> lk(mutex_);
   while (queue_.size() == capacity_) {  // full
     not_full_.wait(lk);
   }
-  queue_.push(stage_block);
+  StageBlock block = stage_block;
+  block.seq_num = next_seq_num_++;
+  queue_.push(block);
   count_[stage_block.ctx.from]++;
   not_empty_.notify_one();
 }
 
-StageBlock UploadingQueue::Pop() {
+bool UploadingQueue::Pop(StageBlock* stage_block, uint64_t timeout_ms) {
   std::unique_lock<std::mutex> lk(mutex_);
-  while (queue_.empty()) {
-    not_empty_.wait(lk);
+  if (!not_empty_.wait_for(lk, std::chrono::milliseconds(timeout_ms),
+                           [this] { return !queue_.empty(); })) {
+    return false;
   }
 
   CHECK(queue_.size() != 0);
-  auto stage_block = queue_.top();
+  *stage_block = queue_.top();
   queue_.pop();
-  CHECK(count_[stage_block.ctx.from] > 0);
-  count_[stage_block.ctx.from]--;
+  CHECK(count_[stage_block->ctx.from] > 0);
+  count_[stage_block->ctx.from]--;
   not_full_.notify_one();
-  return stage_block;
+  return true;
 }
 
 size_t UploadingQueue::Size() {
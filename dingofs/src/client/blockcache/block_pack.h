@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_BLOCK_PACK_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_BLOCK_PACK_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "dingofs/src/client/blockcache/cache_store.h"
+#include "dingofs/src/utils/crc32.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+// The pack coalesces the consecutive small blocks of one chunk into one
+// object, its layout:
+//
+//   [block 0][block 1]...[block n-1][entry 0]...[entry n-1][footer]
+//
+//   entry  : index (8 bytes), offset (8 bytes), length (8 bytes)
+//   footer : num_entries (4 bytes), crc of entries (4 bytes), magic (8 bytes)
+//
+// The pack is stored as the object of its first block, and the first block
+// starts at offset 0, so anyone who doesn't know the pack still reads the
+// first block correctly. Other blocks in the pack have no object, reader
+// should locate the pack by probing the previous blocks, see |Candidates|.
+//
+// Probing is only worth it when the filesystem ever packed blocks, so the
+// uploader puts a marker object (|MarkerKey|) before its first pack, and
+// readers only probe if the marker exists. The reader needn't fetch the
+// whole pack either: the entries and footer are within the last
+// |kMaxTailSize| bytes, see |LookupTail|.
+//
+// NOTE: the pack never crosses chunks, so deleting all block objects of
+// chunk deletes the pack too.
+class BlockPack {
+  struct Entry {
+    uint64_t index;
+    uint64_t offset;
+    uint64_t length;
+  };
+
+  struct Footer {
+    uint32_t num_entries;
+    uint32_t crc;
+    uint64_t magic;
+  };
+
+  static constexpr uint64_t kMagic = 0x4b434150534f4644;  // "DFOSPACK"
+
+ public:
+  static constexpr uint32_t kMaxBlocks = 64;
+
+  // The entries and footer of any pack are within its last bytes.
+  static constexpr size_t kMaxTailSize =
+      kMaxBlocks * sizeof(Entry) + sizeof(Footer);
+
+ public:
+  BlockPack() = default;
+
+  // Whether |key| is the next block of |prev| in the same chunk.
+  static bool IsAdjacent(const BlockKey& prev, const BlockKey& key) {
+    return key.fs_id == prev.fs_id && key.ino == prev.ino &&
+           key.id == prev.id && key.version == prev.version &&
+           key.index == prev.index + 1;
+  }
+
+  // The |key| must be adjacent to the last added one.
+  void Add(const BlockKey& key, const char* data, size_t length) {
+    if (entries_.empty()) {
+      first_ = key;
+    }
+    entries_.push_back(Entry{key.index, data_.size(), length});
+    data_.append(data, length);
+  }
+
+  // Seal the pack, it should be stored as the object of |FirstKey()|.
+  std::string Finish() {
+    Footer footer;
+    footer.num_entries = entries_.size();
+    footer.crc = Checksum(entries_.data(), entries_.size());
+    footer.magic = kMagic;
+    data_.append(reinterpret_cast<const char*>(entries_.data()),
+                 entries_.size() * sizeof(Entry));
+    data_.append(reinterpret_cast<const char*>(&footer), sizeof(footer));
+    entries_.clear();
+    std::string pack = std::move(data_);
+    data_.clear();
+    return pack;
+  }
+
+  size_t NumBlocks() const { return entries_.size(); }
+
+  const BlockKey& FirstKey() const { return first_; }
+
+  // Locate the block |index| in |pack|, return false if |pack| isn't a pack
+  // or the block not in it.
+  static bool Lookup(const char* pack, size_t length, uint64_t index,
+                     size_t* offset, size_t* block_length) {
+    return LookupTail(pack, length, length, index, offset, block_length);
+  }
+
+  // Same as |Lookup|, but only the last |tail_length| bytes of the pack whose
+  // size is |pack_length| are given, the returned offset is in the pack.
+  static bool LookupTail(const char* tail, size_t tail_length,
+                         size_t pack_length, uint64_t index, size_t* offset,
+                         size_t* block_length) {
+    Footer footer;
+    if (tail_length < sizeof(footer) || tail_length > pack_length) {
+      return false;
+    }
+    std::memcpy(&footer, tail + tail_length - sizeof(footer), sizeof(footer));
+    if (footer.magic != kMagic || footer.num_entries == 0 ||
+        footer.num_entries > kMaxBlocks ||
+        footer.num_entries * sizeof(Entry) > tail_length - sizeof(footer)) {
+      return false;
+    }
+
+    size_t table_length = footer.num_entries * sizeof(Entry);
+    size_t table_offset = pack_length - sizeof(footer) - table_length;
+    std::vector<Entry> entries(footer.num_entries);
+    std::memcpy(entries.data(),
+                tail + tail_length - sizeof(footer) - table_length,
+                table_length);
+    if (Checksum(entries.data(), entries.size()) != footer.crc) {
+      return false;
+    }
+
+    for (const auto& entry : entries) {
+      if (entry.index == index && entry.offset <= table_offset &&
+          entry.length <= table_offset - entry.offset) {
+        *offset = entry.offset;
+        *block_length = entry.length;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // The marker object of the filesystem which ever packed blocks.
+  static std::string MarkerKey(uint64_t fs_id) {
+    return StrFormat("blocks/pack/%d", fs_id);
+  }
+
+  // The blocks which may store the pack contains |key|, nearest first.
+  static std::vector<BlockKey> Candidates(const BlockKey& key) {
+    std::vector<BlockKey> keys;
+    for (uint64_t i = 1; i < kMaxBlocks && i <= key.index; i++) {
+      keys.emplace_back(key.fs_id, key.ino, key.id, key.index - i,
+                        key.version);
+    }
+    return keys;
+  }
+
+ private:
+  static uint32_t Checksum(const Entry* entries, size_t num_entries) {
+    return ::dingofs::utils::CRC32(reinterpret_cast<const char*>(entries),
+                                   num_entries * sizeof(Entry));
+  }
+
+ private:
+  BlockKey first_;
+  std::vector<Entry> entries_;
+  std::string data_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_BLOCK_PACK_H_
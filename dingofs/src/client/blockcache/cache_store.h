@@ -94,10 +94,28 @@ struct BlockContext {
   std::string store_id;
 };
 
+// Where the block data lives, either in memory or in file.
+struct BlockBuffer {
+  BlockBuffer() : mem(nullptr), fd(-1), pos(0) {}
+
+  const char* mem;
+  int fd;
+  off_t pos;  // offset in |fd|
+};
+
 class BlockReader {
  public:
   virtual BCACHE_ERROR ReadAt(off_t offset, size_t length, char* buffer) = 0;
 
+  // Get the data without copy (e.g. for splice), it's valid until the
+  // reader closed, return false if not supported.
+  virtual bool GetBuffer(off_t offset, size_t length, BlockBuffer* buffer) {
+    (void)offset;
+    (void)length;
+    (void)buffer;
+    return false;
+  }
+
   virtual void Close() = 0;
 };
 
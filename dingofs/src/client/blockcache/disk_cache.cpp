@@ -23,6 +23,7 @@
 #include "dingofs/src/client/blockcache/disk_cache.h"
 
 #include <glog/logging.h>
+#include <sys/stat.h>
 
 #include <memory>
 
@@ -50,8 +51,10 @@ using DiskCacheTotalMetric = ::dingofs::stub::metric::DiskCacheMetric;
 using DiskCacheMetricGuard =
     ::dingofs::client::blockcache::DiskCacheMetricGuard;
 
-BlockReaderImpl::BlockReaderImpl(int fd, std::shared_ptr<LocalFileSystem> fs)
-    : fd_(fd), fs_(fs) {}
+BlockReaderImpl::BlockReaderImpl(int fd, std::shared_ptr<LocalFileSystem> fs,
+                                 std::shared_ptr<FdCache> fd_cache,
+                                 FdCache::Handle* handle)
+    : fd_(fd), fs_(fs), fd_cache_(fd_cache), handle_(handle) {}
 
 BCACHE_ERROR BlockReaderImpl::ReadAt(off_t offset, size_t length,
                                      char* buffer) {
@@ -59,21 +62,29 @@ BCACHE_ERROR BlockReaderImpl::ReadAt(off_t offset, size_t length,
     BCACHE_ERROR rc;
     DiskCacheMetricGuard guard(
         &rc, &DiskCacheTotalMetric::GetInstance().read_disk, length);
-    rc = posix->LSeek(fd_, offset, SEEK_SET);
-    if (rc == BCACHE_ERROR::OK) {
-      rc = posix->Read(fd_, buffer, length);
-    }
+    rc = posix->PRead(fd_, buffer, length, offset);
     return rc;
   });
 }
 
-void BlockReaderImpl::Close() {
-  fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
-    posix->Close(fd_);
-    return BCACHE_ERROR::OK;
-  });
+// The cache file may be shorter than the block (e.g. the last block of
+// file), splicing beyond its end would reply short data to fuse, so let the
+// caller take the copy path instead.
+bool BlockReaderImpl::GetBuffer(off_t offset, size_t length,
+                                BlockBuffer* buffer) {
+  struct stat st;
+  if (offset < 0 || ::fstat(fd_, &st) != 0 ||
+      static_cast<uint64_t>(offset) + length >
+          static_cast<uint64_t>(st.st_size)) {
+    return false;
+  }
+  buffer->fd = fd_;
+  buffer->pos = offset;
+  return true;
 }
 
+void BlockReaderImpl::Close() { fd_cache_->Release(handle_); }
+
 DiskCache::DiskCache(DiskCacheOption option)
     : option_(option), running_(false), use_direct_write_(false) {
   metric_ = std::make_shared<DiskCacheMetric>(option);
@@ -81,10 +92,17 @@ DiskCache::DiskCache(DiskCacheOption option)
   disk_state_machine_ = std::make_shared<DiskStateMachineImpl>(metric_);
   disk_state_health_checker_ =
       std::make_unique<DiskStateHealthChecker>(layout_, disk_state_machine_);
-  fs_ = std::make_shared<LocalFileSystem>(disk_state_machine_);
-  manager_ = std::make_shared<DiskCacheManager>(option.cache_size, layout_, fs_,
-                                                metric_);
-  loader_ = std::make_unique<DiskCacheLoader>(layout_, fs_, manager_, metric_);
+  fs_ = std::make_shared<LocalFileSystem>(disk_state_machine_,
+                                          NewIOEngine(option.io_engine));
+  fd_cache_ = std::make_shared<FdCache>(option.fd_cache_capacity, fs_);
+  if (option.enable_index) {
+    index_ = std::make_shared<DiskCacheIndex>(layout_);
+  }
+  manager_ = std::make_shared<DiskCacheManager>(
+      option.cache_size, layout_, fs_, fd_cache_, metric_,
+      option.eviction_policy, option.index_shards, index_);
+  loader_ = std::make_unique<DiskCacheLoader>(layout_, fs_, manager_, metric_,
+                                              index_);
 }
 
 BCACHE_ERROR DiskCache::Init(UploadFunc uploader) {
@@ -205,6 +223,9 @@ BCACHE_ERROR DiskCache::Cache(const BlockKey& key, const Block& block) {
   rc = Check(WANT_EXEC | WANT_CACHE);
   if (rc != BCACHE_ERROR::OK) {
     return rc;
+  } else if (!manager_->Admit(key, block.size)) {
+    rc = BCACHE_ERROR::CACHE_FULL;
+    return rc;
   }
 
   timer.NextPhase(Phase::WRITE_FILE);
@@ -242,14 +263,7 @@ BCACHE_ERROR DiskCache::Load(const BlockKey& key,
   }
 
   timer.NextPhase(Phase::OPEN_FILE);
-  rc = fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
-    int fd;
-    auto rc = posix->Open(GetCachePath(key), O_RDONLY, &fd);
-    if (rc == BCACHE_ERROR::OK) {
-      reader = std::make_shared<BlockReaderImpl>(fd, fs_);
-    }
-    return rc;
-  });
+  rc = OpenFile(key, reader);
 
   // Delete corresponding key of block which maybe already deleted by accident.
   if (rc == BCACHE_ERROR::NOT_FOUND) {
@@ -272,12 +286,54 @@ bool DiskCache::IsCached(const BlockKey& key) {
 
 std::string DiskCache::Id() { return uuid_; }
 
+BCACHE_ERROR DiskCache::ReadBlock(const BlockKey& key,
+                                  std::shared_ptr<char>& buffer,
+                                  size_t* length) {
+  BCACHE_ERROR rc;
+  LogGuard log([&]() {
+    return StrFormat("readblock(%s): %s", key.Filename(), StrErr(rc));
+  });
+
+  rc = Check(WANT_EXEC);
+  if (rc != BCACHE_ERROR::OK) {
+    return rc;
+  } else if (!IsCached(key)) {
+    rc = BCACHE_ERROR::NOT_FOUND;
+    return rc;
+  }
+
+  rc = fs_->ReadFile(GetCachePath(key), buffer, length);
+  return rc;
+}
+
+BCACHE_ERROR DiskCache::OpenFile(const BlockKey& key,
+                                 std::shared_ptr<BlockReader>& reader) {
+  int fd;
+  auto* handle = fd_cache_->Lookup(key, &fd);
+  if (handle != nullptr) {
+    metric_->AddFdCacheHit();
+    reader = std::make_shared<BlockReaderImpl>(fd, fs_, fd_cache_, handle);
+    return BCACHE_ERROR::OK;
+  }
+
+  metric_->AddFdCacheMiss();
+  auto rc = fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
+    return posix->Open(GetCachePath(key), O_RDONLY, &fd);
+  });
+  if (rc == BCACHE_ERROR::OK) {
+    handle = fd_cache_->Insert(key, fd);
+    reader = std::make_shared<BlockReaderImpl>(fd, fs_, fd_cache_, handle);
+  }
+  return rc;
+}
+
 BCACHE_ERROR DiskCache::CreateDirs() {
   std::vector<std::string> dirs{
       layout_->GetRootDir(),
       layout_->GetStageDir(),
       layout_->GetCacheDir(),
       layout_->GetProbeDir(),
+      layout_->GetIndexDir(),
   };
 
   for (const auto& dir : dirs) {
@@ -28,6 +28,7 @@
 #include <string>
 
 #include "dingofs/src/client/blockcache/cache_store.h"
+#include "dingofs/src/client/blockcache/disk_cache_index.h"
 #include "dingofs/src/client/blockcache/disk_cache_layout.h"
 #include "dingofs/src/client/blockcache/disk_cache_loader.h"
 #include "dingofs/src/client/blockcache/disk_cache_manager.h"
@@ -35,6 +36,7 @@
 #include "dingofs/src/client/blockcache/disk_state_health_checker.h"
 #include "dingofs/src/client/blockcache/disk_state_machine.h"
 #include "dingofs/src/client/blockcache/error.h"
+#include "dingofs/src/client/blockcache/fd_cache.h"
 #include "dingofs/src/client/blockcache/local_filesystem.h"
 #include "dingofs/src/client/common/config.h"
 
@@ -46,17 +48,25 @@ using ::dingofs::client::common::DiskCacheOption;
 
 class BlockReaderImpl : public BlockReader {
  public:
-  BlockReaderImpl(int fd, std::shared_ptr<LocalFileSystem> fs);
+  BlockReaderImpl(int fd, std::shared_ptr<LocalFileSystem> fs,
+                  std::shared_ptr<FdCache> fd_cache, FdCache::Handle* handle);
 
   virtual ~BlockReaderImpl() = default;
 
   BCACHE_ERROR ReadAt(off_t offset, size_t length, char* buffer) override;
 
+  // The cache file holds the whole block, so the data can be spliced
+  // from the fd directly.
+  bool GetBuffer(off_t offset, size_t length, BlockBuffer* buffer) override;
+
+  // Release the fd to fd cache, it will be closed by fd cache.
   void Close() override;
 
  private:
   int fd_;
   std::shared_ptr<LocalFileSystem> fs_;
+  std::shared_ptr<FdCache> fd_cache_;
+  FdCache::Handle* handle_;
 };
 
 class DiskCache : public CacheStore {
@@ -89,6 +99,10 @@ class DiskCache : public CacheStore {
 
   std::string Id() override;
 
+  // Read the whole cached block into memory.
+  BCACHE_ERROR ReadBlock(const BlockKey& key, std::shared_ptr<char>& buffer,
+                         size_t* length);
+
  private:
   BCACHE_ERROR CreateDirs();
 
@@ -99,6 +113,9 @@ class DiskCache : public CacheStore {
   // check running status, disk healthy and disk free space
   BCACHE_ERROR Check(uint8_t want);
 
+  BCACHE_ERROR OpenFile(const BlockKey& key,
+                        std::shared_ptr<BlockReader>& reader);
+
   bool IsLoading() const;
 
   bool IsHealthy() const;
@@ -123,6 +140,8 @@ class DiskCache : public CacheStore {
   std::shared_ptr<DiskStateMachine> disk_state_machine_;
   std::unique_ptr<DiskStateHealthChecker> disk_state_health_checker_;
   std::shared_ptr<LocalFileSystem> fs_;
+  std::shared_ptr<FdCache> fd_cache_;
+  std::shared_ptr<DiskCacheIndex> index_;
   std::shared_ptr<DiskCacheManager> manager_;
   std::unique_ptr<DiskCacheLoader> loader_;
   bool use_direct_write_;
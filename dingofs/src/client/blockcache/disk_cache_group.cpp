@@ -123,6 +123,12 @@ bool DiskCacheGroup::IsCached(const BlockKey& key) {
 
 std::string DiskCacheGroup::Id() { return "disk_cache_group"; }
 
+BCACHE_ERROR DiskCacheGroup::ReadBlock(const BlockKey& key,
+                                       std::shared_ptr<char>& buffer,
+                                       size_t* length) {
+  return GetStore(key)->ReadBlock(key, buffer, length);
+}
+
 std::vector<uint64_t> DiskCacheGroup::CalcWeights(
     std::vector<DiskCacheOption> options) {
   uint64_t gcd = 0;
@@ -66,6 +66,9 @@ class DiskCacheGroup : public CacheStore {
 
   std::string Id() override;
 
+  BCACHE_ERROR ReadBlock(const BlockKey& key, std::shared_ptr<char>& buffer,
+                         size_t* length);
+
  private:
   std::vector<uint64_t> CalcWeights(std::vector<DiskCacheOption> options);
 
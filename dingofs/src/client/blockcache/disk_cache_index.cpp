@@ -0,0 +1,410 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include "dingofs/src/client/blockcache/disk_cache_index.h"
+
+#include <butil/time.h>
+#include <fcntl.h>
+#include <glog/logging.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "dingofs/src/base/filepath/filepath.h"
+#include "dingofs/src/utils/crc32.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::butil::Timer;
+using ::dingofs::base::filepath::PathJoin;
+using ::dingofs::utils::LockGuard;
+
+namespace {
+
+bool WriteAll(int fd, const char* buffer, size_t length) {
+  while (length > 0) {
+    ssize_t n = ::write(fd, buffer, length);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    buffer += n;
+    length -= n;
+  }
+  return true;
+}
+
+std::string KeyBytes(const char* key) {
+  return std::string(key, sizeof(uint64_t) * 5);  // fs_id ... version
+}
+
+}  // namespace
+
+DiskCacheIndex::DiskCacheIndex(std::shared_ptr<DiskCacheLayout> layout)
+    : journal_fd_(-1), journal_records_(0), ready_(false), layout_(layout) {
+  static_assert(sizeof(Record) == 64, "index record must be 64 bytes");
+}
+
+DiskCacheIndex::~DiskCacheIndex() { Close(); }
+
+BCACHE_ERROR DiskCacheIndex::Load(LoadFunc func) {
+  struct stat st;
+  if (::stat(GetSnapshotPath().c_str(), &st) != 0) {
+    return BCACHE_ERROR::NOT_FOUND;
+  }
+
+  // Replay all records before invoking |func|, so nothing will be loaded
+  // if the index is inconsistent.
+  Timer timer;
+  timer.start();
+  std::unordered_map<std::string, Record> records;
+  uint64_t num_journal_records = 0;
+  auto rc = Replay(GetSnapshotPath(), true, &records, nullptr);
+  if (rc == BCACHE_ERROR::OK) {
+    rc = Replay(GetOldJournalPath(), false, &records, &num_journal_records);
+  }
+  if (rc == BCACHE_ERROR::OK) {
+    rc = Replay(GetJournalPath(), false, &records, &num_journal_records);
+  }
+  if (rc != BCACHE_ERROR::OK) {
+    return rc;
+  }
+
+  for (const auto& item : records) {
+    const auto& record = item.second;
+    func(CacheKey(record.fs_id, record.ino, record.id, record.index,
+                  record.version),
+         CacheValue(record.size, TimeSpec(record.atime)));
+  }
+  timer.stop();
+
+  {
+    LockGuard lk(mutex_);
+    rc = OpenJournal();
+  }
+  journal_records_.store(num_journal_records);
+  ready_.store(rc == BCACHE_ERROR::OK, std::memory_order_release);
+  LOG(INFO) << "Load disk cache index (dir=" << layout_->GetIndexDir()
+            << ") " << StrErr(rc) << ": " << records.size()
+            << " blocks loaded, " << num_journal_records
+            << " journal records replayed, costs " << timer.u_elapsed() / 1e6
+            << " seconds.";
+  return rc;
+}
+
+void DiskCacheIndex::Reset() {
+  LockGuard lk(mutex_);
+  CloseJournal();
+  ::unlink(GetSnapshotPath().c_str());
+  ::unlink(GetOldJournalPath().c_str());
+  ::unlink(GetJournalPath().c_str());
+  journal_records_.store(0);
+  ready_.store(false, std::memory_order_release);
+  OpenJournal();
+}
+
+void DiskCacheIndex::Add(const CacheKey& key, const CacheValue& value) {
+  Append(Op::kAdd, key, value);
+}
+
+void DiskCacheIndex::Delete(const CacheKey& key) {
+  Append(Op::kDelete, key, CacheValue(0, TimeSpec()));
+}
+
+bool DiskCacheIndex::NeedCompact(uint64_t num_blocks) const {
+  uint64_t num_records = journal_records_.load(std::memory_order_relaxed);
+  return num_records >= kMinCompactRecords && num_records >= num_blocks * 2;
+}
+
+BCACHE_ERROR DiskCacheIndex::Compact(DumpFunc func) {
+  Timer timer;
+  timer.start();
+
+  // The records appended after rotation are in the new journal, which will
+  // be replayed after the snapshot, so it's fine that snapshot includes them.
+  //
+  // The old journal left by a failed compaction isn't covered by any
+  // snapshot, so the journal is not rotated to overwrite it, and it's
+  // dropped after this compaction success. Replaying the whole journal
+  // after the snapshot is also fine, for the same reason as above.
+  BCACHE_ERROR rc = BCACHE_ERROR::OK;
+  struct stat st;
+  if (::stat(GetOldJournalPath().c_str(), &st) == 0) {
+    LOG(WARNING) << "Old disk cache index journal exists, "
+                 << "skip rotating journal for this compaction.";
+  } else {
+    LockGuard lk(mutex_);
+    CloseJournal();
+    if (::rename(GetJournalPath().c_str(), GetOldJournalPath().c_str()) != 0 &&
+        errno != ENOENT) {
+      LOG(ERROR) << "Rotate disk cache index journal failed: "
+                 << ::strerror(errno);
+    }
+    journal_records_.store(0);
+    rc = OpenJournal();
+  }
+
+  std::string tmp_path = GetSnapshotPath() + ".tmp";
+  if (rc == BCACHE_ERROR::OK) {
+    rc = WriteSnapshot(tmp_path, func);
+  }
+  if (rc == BCACHE_ERROR::OK &&
+      ::rename(tmp_path.c_str(), GetSnapshotPath().c_str()) != 0) {
+    LOG(ERROR) << "Rename disk cache index snapshot failed: "
+               << ::strerror(errno);
+    rc = BCACHE_ERROR::IO_ERROR;
+  }
+  if (rc != BCACHE_ERROR::OK) {
+    ::unlink(tmp_path.c_str());
+    return rc;
+  }
+
+  ::unlink(GetOldJournalPath().c_str());
+  ready_.store(true, std::memory_order_release);
+  timer.stop();
+  LOG(INFO) << "Compact disk cache index (dir=" << layout_->GetIndexDir()
+            << ") success, costs " << timer.u_elapsed() / 1e6 << " seconds.";
+  return rc;
+}
+
+void DiskCacheIndex::Close() {
+  LockGuard lk(mutex_);
+  CloseJournal();
+}
+
+void DiskCacheIndex::Append(Op op, const CacheKey& key,
+                            const CacheValue& value) {
+  Record record{};
+  record.op = static_cast<uint8_t>(op);
+  record.fs_id = key.fs_id;
+  record.ino = key.ino;
+  record.id = key.id;
+  record.index = key.index;
+  record.version = key.version;
+  record.size = value.size;
+  record.atime = value.atime.seconds;
+  record.crc = Checksum(record);
+
+  LockGuard lk(mutex_);
+  if (journal_fd_ < 0) {
+    return;  // not opened yet, the block will be found by walking
+  }
+
+  if (!WriteAll(journal_fd_, reinterpret_cast<const char*>(&record),
+                sizeof(record))) {
+    LOG(ERROR) << "Append disk cache index journal failed: "
+               << ::strerror(errno);
+    ready_.store(false, std::memory_order_release);  // compact will fix it
+    return;
+  }
+  journal_records_.fetch_add(1, std::memory_order_relaxed);
+}
+
+BCACHE_ERROR DiskCacheIndex::Replay(
+    const std::string& path, bool is_snapshot,
+    std::unordered_map<std::string, Record>* records, uint64_t* num_replayed) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    if (errno == ENOENT && !is_snapshot) {
+      return BCACHE_ERROR::OK;  // journal is optional
+    }
+    LOG(ERROR) << "Open disk cache index (path=" << path
+               << ") failed: " << ::strerror(errno);
+    return BCACHE_ERROR::IO_ERROR;
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    return BCACHE_ERROR::IO_ERROR;
+  } else if (st.st_size == 0 && !is_snapshot) {
+    ::close(fd);
+    return BCACHE_ERROR::OK;  // empty journal
+  } else if (static_cast<size_t>(st.st_size) < sizeof(Header)) {
+    ::close(fd);
+    LOG(ERROR) << "Disk cache index (path=" << path << ") is truncated.";
+    return BCACHE_ERROR::IO_ERROR;
+  }
+
+  size_t length = st.st_size;
+  void* addr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    LOG(ERROR) << "Mmap disk cache index (path=" << path
+               << ") failed: " << ::strerror(errno);
+    return BCACHE_ERROR::IO_ERROR;
+  }
+  ::madvise(addr, length, MADV_SEQUENTIAL);
+
+  // The torn record at the tail of journal is expected (e.g. crashed while
+  // appending), but it must not happen for snapshot.
+  auto rc = BCACHE_ERROR::OK;
+  const char* data = static_cast<const char*>(addr);
+  const auto* header = reinterpret_cast<const Header*>(data);
+  uint64_t num_records = (length - sizeof(Header)) / sizeof(Record);
+  bool torn = (length - sizeof(Header)) % sizeof(Record) != 0;
+  if (header->magic != kMagic || header->version != kVersion) {
+    rc = BCACHE_ERROR::IO_ERROR;
+  } else if (is_snapshot && (torn || header->num_records != num_records)) {
+    rc = BCACHE_ERROR::IO_ERROR;
+  }
+
+  for (uint64_t i = 0; i < num_records && rc == BCACHE_ERROR::OK; i++) {
+    Record record;
+    std::memcpy(&record, data + sizeof(Header) + i * sizeof(Record),
+                sizeof(Record));
+    if (record.crc != Checksum(record)) {
+      rc = BCACHE_ERROR::IO_ERROR;
+      break;
+    }
+
+    auto key = KeyBytes(reinterpret_cast<const char*>(&record.fs_id));
+    if (record.op == static_cast<uint8_t>(Op::kAdd)) {
+      (*records)[key] = record;
+    } else if (record.op == static_cast<uint8_t>(Op::kDelete)) {
+      records->erase(key);
+    } else {
+      rc = BCACHE_ERROR::IO_ERROR;
+    }
+  }
+  ::munmap(addr, length);
+
+  if (rc != BCACHE_ERROR::OK) {
+    LOG(ERROR) << "Disk cache index (path=" << path << ") is corrupted.";
+  } else if (num_replayed != nullptr) {
+    *num_replayed += num_records;
+  }
+  return rc;
+}
+
+BCACHE_ERROR DiskCacheIndex::WriteSnapshot(const std::string& path,
+                                           DumpFunc func) {
+  int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    LOG(ERROR) << "Create disk cache index snapshot (path=" << path
+               << ") failed: " << ::strerror(errno);
+    return BCACHE_ERROR::IO_ERROR;
+  }
+
+  bool ok = true;
+  std::string buffer;
+  Header header{kMagic, kVersion, 0};
+  buffer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  func([&](const CacheKey& key, const CacheValue& value) {
+    Record record{};
+    record.op = static_cast<uint8_t>(Op::kAdd);
+    record.fs_id = key.fs_id;
+    record.ino = key.ino;
+    record.id = key.id;
+    record.index = key.index;
+    record.version = key.version;
+    record.size = value.size;
+    record.atime = value.atime.seconds;
+    record.crc = Checksum(record);
+    buffer.append(reinterpret_cast<const char*>(&record), sizeof(record));
+    header.num_records++;
+
+    if (ok && buffer.size() >= 1024 * 1024) {
+      ok = WriteAll(fd, buffer.data(), buffer.size());
+      buffer.clear();
+    }
+  });
+
+  ok = ok && WriteAll(fd, buffer.data(), buffer.size()) &&
+       ::pwrite(fd, &header, sizeof(header), 0) == sizeof(header) &&
+       ::fsync(fd) == 0;
+  if (!ok) {
+    LOG(ERROR) << "Write disk cache index snapshot (path=" << path
+               << ") failed: " << ::strerror(errno);
+  }
+  ::close(fd);
+  return ok ? BCACHE_ERROR::OK : BCACHE_ERROR::IO_ERROR;
+}
+
+// protect by mutex
+BCACHE_ERROR DiskCacheIndex::OpenJournal() {
+  std::string path = GetJournalPath();
+  journal_fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (journal_fd_ < 0) {
+    LOG(ERROR) << "Open disk cache index journal (path=" << path
+               << ") failed: " << ::strerror(errno);
+    return BCACHE_ERROR::IO_ERROR;
+  }
+
+  // Write header for new journal, or cut the torn record at the tail,
+  // otherwise the records appended later will be misaligned.
+  struct stat st;
+  bool ok = ::fstat(journal_fd_, &st) == 0;
+  if (ok && st.st_size == 0) {
+    Header header{kMagic, kVersion, 0};
+    ok = WriteAll(journal_fd_, reinterpret_cast<const char*>(&header),
+                  sizeof(header));
+  } else if (ok && static_cast<size_t>(st.st_size) > sizeof(Header)) {
+    size_t torn = (st.st_size - sizeof(Header)) % sizeof(Record);
+    ok = (torn == 0) || ::ftruncate(journal_fd_, st.st_size - torn) == 0;
+  }
+
+  if (!ok) {
+    LOG(ERROR) << "Init disk cache index journal (path=" << path
+               << ") failed: " << ::strerror(errno);
+    CloseJournal();
+    return BCACHE_ERROR::IO_ERROR;
+  }
+  return BCACHE_ERROR::OK;
+}
+
+// protect by mutex
+void DiskCacheIndex::CloseJournal() {
+  if (journal_fd_ >= 0) {
+    ::close(journal_fd_);
+    journal_fd_ = -1;
+  }
+}
+
+uint32_t DiskCacheIndex::Checksum(const Record& record) {
+  const char* data = reinterpret_cast<const char*>(&record);
+  return ::dingofs::utils::CRC32(data + sizeof(record.crc),
+                                 sizeof(Record) - sizeof(record.crc));
+}
+
+std::string DiskCacheIndex::GetSnapshotPath() const {
+  return PathJoin({layout_->GetIndexDir(), "snapshot"});
+}
+
+std::string DiskCacheIndex::GetJournalPath() const {
+  return PathJoin({layout_->GetIndexDir(), "journal"});
+}
+
+std::string DiskCacheIndex::GetOldJournalPath() const {
+  return PathJoin({layout_->GetIndexDir(), "journal.old"});
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_DISK_CACHE_INDEX_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_DISK_CACHE_INDEX_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "dingofs/src/client/blockcache/disk_cache_layout.h"
+#include "dingofs/src/client/blockcache/error.h"
+#include "dingofs/src/client/blockcache/lru_common.h"
+#include "dingofs/src/utils/concurrent/concurrent.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::utils::Mutex;
+
+// The persistent index of cache blocks, so the disk cache can be reloaded
+// without walking the whole cache directory:
+//
+//   journal     : append-only log of add/delete records
+//   journal.old : the journal which is being compacted
+//   snapshot    : compacted image of all cache blocks
+//
+// Loading replays snapshot, journal.old and journal in order, any corrupted
+// record makes the whole index inconsistent, and the caller should fallback
+// to walk the directory. Record for added block is appended after the block
+// file written, and record for deleted block after the file removed, so the
+// index never misses a block file which exists, except the tiny window
+// between the file written and its record appended.
+//
+// NOTE: the access time updated by lookup is not journaled, it's only
+// persisted by compaction.
+class DiskCacheIndex {
+  enum class Op : uint8_t {
+    kAdd = 1,
+    kDelete = 2,
+  };
+
+  struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t num_records;  // only for snapshot
+  };
+
+  struct Record {
+    uint32_t crc;  // checksum of the bytes after it
+    uint8_t op;
+    uint8_t reserved[3];
+    uint64_t fs_id;
+    uint64_t ino;
+    uint64_t id;
+    uint64_t index;
+    uint64_t version;
+    uint64_t size;
+    uint64_t atime;  // seconds
+  };
+
+  static constexpr uint32_t kMagic = 0x58494344;  // "DCIX"
+  static constexpr uint32_t kVersion = 1;
+  static constexpr uint64_t kMinCompactRecords = 1000000;
+
+ public:
+  using LoadFunc =
+      std::function<void(const CacheKey& key, const CacheValue& value)>;
+  using DumpFunc = std::function<void(LoadFunc handler)>;
+
+ public:
+  explicit DiskCacheIndex(std::shared_ptr<DiskCacheLayout> layout);
+
+  virtual ~DiskCacheIndex();
+
+  // Replay the whole index, the |func| is invoked for every cache block only
+  // if the index is consistent, it returns NOT_FOUND if index is missing.
+  BCACHE_ERROR Load(LoadFunc func);
+
+  // Discard the whole index and start with an empty journal.
+  void Reset();
+
+  void Add(const CacheKey& key, const CacheValue& value);
+
+  void Delete(const CacheKey& key);
+
+  // Whether the journal grows too large compared to the live blocks.
+  bool NeedCompact(uint64_t num_blocks) const;
+
+  // Write all blocks dumped by |func| as new snapshot, and drop journals.
+  BCACHE_ERROR Compact(DumpFunc func);
+
+  // Whether the index reflects all cache blocks, i.e. loaded or compacted.
+  bool Ready() const { return ready_.load(std::memory_order_acquire); }
+
+  void Close();
+
+ private:
+  void Append(Op op, const CacheKey& key, const CacheValue& value);
+
+  BCACHE_ERROR Replay(const std::string& path, bool is_snapshot,
+                      std::unordered_map<std::string, Record>* records,
+                      uint64_t* num_replayed);
+
+  BCACHE_ERROR WriteSnapshot(const std::string& path, DumpFunc func);
+
+  // protect by mutex
+  BCACHE_ERROR OpenJournal();
+
+  void CloseJournal();
+
+  static uint32_t Checksum(const Record& record);
+
+  std::string GetSnapshotPath() const;
+
+  std::string GetJournalPath() const;
+
+  std::string GetOldJournalPath() const;
+
+ private:
+  Mutex mutex_;  // protect journal
+  int journal_fd_;
+  std::atomic<uint64_t> journal_records_;
+  std::atomic<bool> ready_;
+  std::shared_ptr<DiskCacheLayout> layout_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_DISK_CACHE_INDEX_H_
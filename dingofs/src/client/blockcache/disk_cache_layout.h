@@ -59,6 +59,9 @@ using ::dingofs::base::filepath::PathJoin;
  *   |               ├── 2_21626898_4096_0_0
  *   |               └── 2_21626898_4097_0_0
  *   ├── probe
+ *   ├── index
+ *   │   ├── snapshot
+ *   │   └── journal
  *   ├── .detect
  *   └── .lock
  */
@@ -74,6 +77,8 @@ class DiskCacheLayout {
 
   std::string GetProbeDir() const { return PathJoin({root_dir_, "probe"}); }
 
+  std::string GetIndexDir() const { return PathJoin({root_dir_, "index"}); }
+
   std::string GetDetectPath() const { return PathJoin({root_dir_, ".detect"}); }
 
   std::string GetLockPath() const { return PathJoin({root_dir_, ".lock"}); }
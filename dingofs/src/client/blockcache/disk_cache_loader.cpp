@@ -42,12 +42,14 @@ using ::dingofs::base::filepath::PathJoin;
 DiskCacheLoader::DiskCacheLoader(std::shared_ptr<DiskCacheLayout> layout,
                                  std::shared_ptr<LocalFileSystem> fs,
                                  std::shared_ptr<DiskCacheManager> manager,
-                                 std::shared_ptr<DiskCacheMetric> metric)
+                                 std::shared_ptr<DiskCacheMetric> metric,
+                                 std::shared_ptr<DiskCacheIndex> index)
     : running_(false),
       layout_(layout),
       fs_(fs),
       manager_(manager),
       metric_(metric),
+      index_(index),
       task_pool_(absl::make_unique<TaskThreadPool<>>("disk_cache_loader")) {}
 
 void DiskCacheLoader::Start(const std::string& disk_id,
@@ -89,6 +91,16 @@ void DiskCacheLoader::LoadAllBlocks(const std::string& root, BlockType type) {
   BCACHE_ERROR rc;
   uint64_t num_blocks = 0, num_invalids = 0, size = 0;
 
+  // The stage blocks are always walked, there are only a few of them
+  // which are not uploaded yet.
+  if (type == BlockType::CACHE_BLOCK && index_ != nullptr) {
+    if (LoadFromIndex()) {
+      metric_->SetLoadStatus(kLoadFinised);
+      return;
+    }
+    index_->Reset();  // rebuild it after walking
+  }
+
   timer.start();
   rc = fs_->Walk(root, [&](const std::string& prefix, const FileInfo& file) {
     if (!running_.load(std::memory_order_relaxed)) {
@@ -117,10 +129,33 @@ void DiskCacheLoader::LoadAllBlocks(const std::string& root, BlockType type) {
   }
 
   if (type == BlockType::CACHE_BLOCK) {
+    if (index_ != nullptr && rc == BCACHE_ERROR::OK) {
+      manager_->CompactIndex();
+    }
     metric_->SetLoadStatus(kLoadFinised);
   }
 }
 
+bool DiskCacheLoader::LoadFromIndex() {
+  uint64_t num_blocks = 0;
+  auto rc = index_->Load([&](const CacheKey& key, const CacheValue& value) {
+    manager_->Restore(key, value);
+    num_blocks++;
+  });
+
+  if (rc == BCACHE_ERROR::OK) {
+    LOG(INFO) << "Load cache (dir=" << layout_->GetCacheDir()
+              << ") from index: " << num_blocks << " blocks restored.";
+    return true;
+  } else if (rc == BCACHE_ERROR::NOT_FOUND) {
+    LOG(INFO) << "Disk cache index not found, walk the cache dir.";
+  } else {
+    LOG(WARNING) << "Disk cache index is inconsistent (" << StrErr(rc)
+                 << "), walk the cache dir.";
+  }
+  return false;
+}
+
 bool DiskCacheLoader::LoadOneBlock(const std::string& prefix,
                                    const FileInfo& file, BlockType type) {
   BlockKey key;
@@ -27,6 +27,7 @@
 #include <memory>
 #include <string>
 
+#include "dingofs/src/client/blockcache/disk_cache_index.h"
 #include "dingofs/src/client/blockcache/disk_cache_layout.h"
 #include "dingofs/src/client/blockcache/disk_cache_manager.h"
 #include "dingofs/src/client/blockcache/disk_cache_metric.h"
@@ -51,7 +52,8 @@ class DiskCacheLoader {
   DiskCacheLoader(std::shared_ptr<DiskCacheLayout> layout,
                   std::shared_ptr<LocalFileSystem> fs,
                   std::shared_ptr<DiskCacheManager> manager,
-                  std::shared_ptr<DiskCacheMetric> metric);
+                  std::shared_ptr<DiskCacheMetric> metric,
+                  std::shared_ptr<DiskCacheIndex> index = nullptr);
 
   virtual ~DiskCacheLoader() = default;
 
@@ -64,6 +66,8 @@ class DiskCacheLoader {
  private:
   void LoadAllBlocks(const std::string& root, BlockType type);
 
+  bool LoadFromIndex();
+
   bool LoadOneBlock(const std::string& prefix, const FileInfo& file,
                     BlockType type);
 
@@ -77,6 +81,7 @@ class DiskCacheLoader {
   std::shared_ptr<LocalFileSystem> fs_;
   std::shared_ptr<DiskCacheManager> manager_;
   std::shared_ptr<DiskCacheMetric> metric_;
+  std::shared_ptr<DiskCacheIndex> index_;
   std::unique_ptr<TaskThreadPool<>> task_pool_;
 };
 
@@ -24,13 +24,14 @@
 
 #include <butil/time.h>
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 
 #include "dingofs/src/base/math/math.h"
 #include "dingofs/src/base/time/time.h"
 #include "dingofs/src/client/blockcache/disk_cache_metric.h"
-#include "dingofs/src/client/blockcache/lru_cache.h"
+#include "dingofs/src/client/blockcache/eviction_policy.h"
 #include "dingofs/src/client/blockcache/lru_common.h"
 #include "dingofs/src/client/common/config.h"
 #include "dingofs/src/client/common/dynamic_config.h"
@@ -52,17 +53,26 @@ using ::dingofs::utils::LockGuard;
 DiskCacheManager::DiskCacheManager(uint64_t capacity,
                                    std::shared_ptr<DiskCacheLayout> layout,
                                    std::shared_ptr<LocalFileSystem> fs,
-                                   std::shared_ptr<DiskCacheMetric> metric)
+                                   std::shared_ptr<FdCache> fd_cache,
+                                   std::shared_ptr<DiskCacheMetric> metric,
+                                   const std::string& eviction_policy,
+                                   uint32_t num_shards,
+                                   std::shared_ptr<DiskCacheIndex> index)
     : used_bytes_(0),
+      num_blocks_(0),
       capacity_(capacity),
       stage_full_(false),
       cache_full_(false),
       running_(false),
       layout_(layout),
       fs_(fs),
-      lru_(std::make_unique<LRUCache>()),
+      fd_cache_(fd_cache),
+      index_(index),
       metric_(metric),
       task_pool_(std::make_unique<TaskThreadPool<>>("disk_cache_manager")) {
+  for (uint32_t i = 0; i < std::max(num_shards, 1U); i++) {
+    shards_.emplace_back(std::make_unique<Shard>(eviction_policy));
+  }
   mq_ = std::make_unique<MessageQueueType>("delete_block_queue", 10);
   mq_->Subscribe([&](MessageType message) {
     DeleteBlocks(message.first, message.second);
@@ -75,13 +85,19 @@ void DiskCacheManager::Start() {
   }
 
   used_bytes_ = 0;  // For restart
+  num_blocks_ = 0;
   mq_->Start();
-  task_pool_->Start(2);
+  task_pool_->Start(index_ != nullptr ? 3 : 2);
   task_pool_->Enqueue(&DiskCacheManager::CheckFreeSpace, this);
   task_pool_->Enqueue(&DiskCacheManager::CleanupExpire, this);
+  if (index_ != nullptr) {
+    task_pool_->Enqueue(&DiskCacheManager::CheckIndex, this);
+  }
   LOG(INFO) << "Disk cache manager start, capacity=" << capacity_
             << ", free_space_ratio=" << FLAGS_disk_cache_free_space_ratio
-            << ", cache_expire_second=" << FLAGS_disk_cache_expire_second;
+            << ", cache_expire_second=" << FLAGS_disk_cache_expire_second
+            << ", eviction_policy=" << shards_[0]->policy->Name()
+            << ", shards=" << shards_.size();
 }
 
 void DiskCacheManager::Stop() {
@@ -91,36 +107,95 @@ void DiskCacheManager::Stop() {
 
   LOG(INFO) << "Stop disk cache manager thread...";
   task_pool_->Stop();
-  mq_->Stop();
-  lru_->Clear();
+  mq_->Stop();  // all evicted blocks are deleted
+  if (index_ != nullptr) {
+    if (index_->Ready()) {
+      CompactIndex();  // fast reload for next time
+    }
+    index_->Close();
+  }
+  for (auto& shard : shards_) {
+    LockGuard lk(shard->mutex);
+    shard->policy->Clear();
+  }
+  fd_cache_->Clear();
   LOG(INFO) << "Disk cache manager thread stopped.";
 }
 
 void DiskCacheManager::Add(const CacheKey& key, const CacheValue& value) {
-  LockGuard lk(mutex_);
-  lru_->Add(key, value);
-  UpdateUsage(1, value.size);
-  if (used_bytes_ >= capacity_) {
+  Insert(key, value, true);
+}
+
+void DiskCacheManager::Restore(const CacheKey& key, const CacheValue& value) {
+  Insert(key, value, false);
+}
+
+void DiskCacheManager::Insert(const CacheKey& key, const CacheValue& value,
+                              bool persist) {
+  {
+    // journal under the shard lock, so the records of one key are
+    // appended in the same order as they are applied to the policy
+    auto* shard = GetShard(key);
+    LockGuard lk(shard->mutex);
+    shard->policy->Add(key, value);
+    UpdateUsage(1, value.size);
+    if (persist && index_ != nullptr) {
+      index_->Add(key, value);
+    }
+  }
+
+  if (used_bytes_.load(std::memory_order_relaxed) >= capacity_) {
     uint64_t goal_bytes = capacity_ * 0.95;
-    uint64_t goal_files = lru_->Size() * 0.95;
+    uint64_t goal_files = num_blocks_.load(std::memory_order_relaxed) * 0.95;
     CleanupFull(goal_bytes, goal_files);
   }
 }
 
 BCACHE_ERROR DiskCacheManager::Get(const CacheKey& key, CacheValue* value) {
-  LockGuard lk(mutex_);
-  if (lru_->Get(key, value)) {
+  auto* shard = GetShard(key);
+  LockGuard lk(shard->mutex);
+  if (shard->policy->Get(key, value)) {
     return BCACHE_ERROR::OK;
   }
   return BCACHE_ERROR::NOT_FOUND;
 }
 
 void DiskCacheManager::Delete(const CacheKey& key) {
-  LockGuard lk(mutex_);
-  CacheValue value;
-  if (lru_->Delete(key, &value)) {  // exist
-    UpdateUsage(-1, -value.size);
+  {
+    auto* shard = GetShard(key);
+    LockGuard lk(shard->mutex);
+    CacheValue value;
+    if (shard->policy->Delete(key, &value)) {  // exist
+      UpdateUsage(-1, -value.size);
+      if (index_ != nullptr) {
+        index_->Delete(key);
+      }
+    }
+  }
+  fd_cache_->Erase(key);
+}
+
+bool DiskCacheManager::Admit(const CacheKey& key, size_t size) {
+  if (used_bytes_.load(std::memory_order_relaxed) + size < capacity_ * 0.95) {
+    return true;  // no block will be evicted
   }
+
+  auto* shard = GetShard(key);
+  LockGuard lk(shard->mutex);
+  if (shard->policy->Admit(key)) {
+    return true;
+  }
+  metric_->AddCacheReject();
+  return false;
+}
+
+BCACHE_ERROR DiskCacheManager::CompactIndex() {
+  return index_->Compact([this](DiskCacheIndex::LoadFunc handler) {
+    for (auto& shard : shards_) {
+      LockGuard lk(shard->mutex);
+      shard->policy->Walk(handler);
+    }
+  });
 }
 
 bool DiskCacheManager::StageFull() const {
@@ -164,7 +239,6 @@ void DiskCacheManager::CheckFreeSpace() {
           root_dir, watermark * 100, (1.0 - br) * 100, (1.0 - fr) * 100,
           cache_full ? 'Y' : 'N', stage_full ? 'Y' : 'N');
 
-      LockGuard lk(mutex_);
       goal_bytes = stat.total_bytes * watermark;
       goal_files = stat.total_files * watermark;
       CleanupFull(goal_bytes, goal_files);
@@ -173,15 +247,34 @@ void DiskCacheManager::CheckFreeSpace() {
   }
 }
 
-// protect by mutex
+// Evict blocks from all shards in turn, each shard only evicts its share
+// of the excess once, so the global eviction order is roughly kept.
 void DiskCacheManager::CleanupFull(uint64_t goal_bytes, uint64_t goal_files) {
-  auto to_del = lru_->Evict([&](const CacheValue& value) {
-    if (used_bytes_ <= goal_bytes && lru_->Size() <= goal_files) {
-      return FilterStatus::FINISH;
+  LockGuard cleanup_lk(cleanup_mutex_);
+  CacheItems to_del;
+  bool evicted = true;
+  while (evicted && !GoalReached(goal_bytes, goal_files)) {
+    evicted = false;
+    for (auto& shard : shards_) {
+      uint64_t used_bytes = used_bytes_.load(std::memory_order_relaxed);
+      uint64_t excess = used_bytes > goal_bytes ? used_bytes - goal_bytes : 0;
+      uint64_t share = excess / shards_.size() + 1;
+      uint64_t freed = 0;
+
+      LockGuard lk(shard->mutex);
+      auto items = shard->policy->Evict([&](const CacheValue& value) {
+        if (freed >= share || GoalReached(goal_bytes, goal_files)) {
+          return FilterStatus::FINISH;
+        }
+        freed += value.size;
+        UpdateUsage(-1, -value.size);
+        return FilterStatus::EVICT_IT;
+      });
+
+      evicted = evicted || !items.empty();
+      to_del.insert(to_del.end(), items.begin(), items.end());
     }
-    UpdateUsage(-1, -value.size);
-    return FilterStatus::EVICT_IT;
-  });
+  }
 
   if (to_del.size() > 0) {
     mq_->Publish({to_del, DeleteFrom::CACHE_FULL});
@@ -191,17 +284,19 @@ void DiskCacheManager::CleanupFull(uint64_t goal_bytes, uint64_t goal_files) {
 void DiskCacheManager::CleanupExpire() {
   CacheItems to_del;
   while (running_.load(std::memory_order_relaxed)) {
-    uint64_t num_checks = 0;
     auto now = TimeNow();
     if (FLAGS_disk_cache_expire_second == 0) {
       std::this_thread::sleep_for(std::chrono::seconds(3));
       continue;
     }
 
-    {
-      LockGuard lk(mutex_);
-      to_del = lru_->Evict([&](const CacheValue& value) {
-        if (++num_checks > 1e3) {
+    // check at most 1000 blocks each time, share by all shards
+    uint64_t max_checks = std::max(1000 / shards_.size(), size_t(1));
+    for (auto& shard : shards_) {
+      uint64_t num_checks = 0;
+      LockGuard lk(shard->mutex);
+      auto items = shard->policy->Evict([&](const CacheValue& value) {
+        if (++num_checks > max_checks) {
           return FilterStatus::FINISH;
         } else if (value.atime + FLAGS_disk_cache_expire_second > now) {
           return FilterStatus::SKIP;
@@ -209,16 +304,28 @@ void DiskCacheManager::CleanupExpire() {
         UpdateUsage(-1, -value.size);
         return FilterStatus::EVICT_IT;
       });
+      to_del.insert(to_del.end(), items.begin(), items.end());
     }
 
     if (to_del.size() > 0) {
       mq_->Publish({to_del, DeleteFrom::CACHE_EXPIRED});
+      to_del.clear();
     }
     std::this_thread::sleep_for(std::chrono::milliseconds(
         FLAGS_disk_cache_cleanup_expire_interval_millsecond));
   }
 }
 
+void DiskCacheManager::CheckIndex() {
+  while (running_.load(std::memory_order_relaxed)) {
+    if (index_->Ready() &&
+        index_->NeedCompact(num_blocks_.load(std::memory_order_relaxed))) {
+      CompactIndex();
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+}
+
 void DiskCacheManager::DeleteBlocks(const CacheItems& to_del, DeleteFrom from) {
   Timer timer;
   uint64_t num_deleted = 0, bytes_freed = 0;
@@ -228,7 +335,19 @@ void DiskCacheManager::DeleteBlocks(const CacheItems& to_del, DeleteFrom from) {
     CacheKey key = item.key;
     CacheValue value = item.value;
     std::string cache_path = GetCachePath(key);
-    auto rc = fs_->RemoveFile(cache_path);
+    fd_cache_->Erase(key);  // close the fd after all readers released it
+    BCACHE_ERROR rc;
+    {
+      // the same key may be added again meanwhile, remove the file and
+      // journal its record under the shard lock to keep them in order
+      auto* shard = GetShard(key);
+      LockGuard lk(shard->mutex);
+      rc = fs_->RemoveFile(cache_path);
+      if (index_ != nullptr &&
+          (rc == BCACHE_ERROR::OK || rc == BCACHE_ERROR::NOT_FOUND)) {
+        index_->Delete(key);
+      }
+    }
     if (rc == BCACHE_ERROR::NOT_FOUND) {
       LOG(WARNING) << "Cache block (path=" << cache_path
                    << ") already deleted.";
@@ -253,10 +372,23 @@ void DiskCacheManager::DeleteBlocks(const CacheItems& to_del, DeleteFrom from) {
       timer.u_elapsed() / 1e6);
 }
 
+DiskCacheManager::Shard* DiskCacheManager::GetShard(const CacheKey& key) {
+  uint64_t hash = (key.ino * 31 + key.id) * 31 + key.index;
+  return shards_[hash % shards_.size()].get();
+}
+
+bool DiskCacheManager::GoalReached(uint64_t goal_bytes,
+                                   uint64_t goal_files) const {
+  return used_bytes_.load(std::memory_order_relaxed) <= goal_bytes &&
+         num_blocks_.load(std::memory_order_relaxed) <= goal_files;
+}
+
+// protect by shard's mutex
 void DiskCacheManager::UpdateUsage(int64_t n, int64_t bytes) {
-  used_bytes_ += bytes;
+  uint64_t used_bytes = used_bytes_.fetch_add(bytes) + bytes;
+  num_blocks_.fetch_add(n);
   metric_->AddCacheBlock(n, bytes);
-  metric_->SetUsedBytes(used_bytes_);
+  metric_->SetUsedBytes(used_bytes);
 }
 
 std::string DiskCacheManager::GetCachePath(const CacheKey& key) {
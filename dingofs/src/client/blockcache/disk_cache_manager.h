@@ -26,15 +26,18 @@
 #include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "dingofs/src/base/cache/cache.h"
 #include "dingofs/src/base/queue/message_queue.h"
 #include "dingofs/src/base/time/time.h"
 #include "dingofs/src/client/blockcache/cache_store.h"
+#include "dingofs/src/client/blockcache/disk_cache_index.h"
 #include "dingofs/src/client/blockcache/disk_cache_layout.h"
 #include "dingofs/src/client/blockcache/disk_cache_metric.h"
+#include "dingofs/src/client/blockcache/eviction_policy.h"
+#include "dingofs/src/client/blockcache/fd_cache.h"
 #include "dingofs/src/client/blockcache/local_filesystem.h"
-#include "dingofs/src/client/blockcache/lru_cache.h"
 #include "dingofs/src/utils/concurrent/concurrent.h"
 #include "dingofs/src/utils/concurrent/task_thread_pool.h"
 
@@ -47,22 +50,38 @@ using ::dingofs::utils::TaskThreadPool;
 using ::dingofs::base::cache::Cache;
 using ::dingofs::base::queue::MessageQueue;
 using ::dingofs::base::time::TimeSpec;
-using ::dingofs::client::blockcache::LRUCache;
 
-// Manage cache items and its capacity
+// Manage cache items and its capacity.
+//
+// The cache items are sharded by block key, each shard has its own lock
+// and eviction policy, so the lookups on hot path are not serialized.
+// The capacity is still accounted globally, cleanup evicts blocks from
+// all shards in turn until the goal reached.
 class DiskCacheManager {
   enum class DeleteFrom {
     CACHE_FULL,
     CACHE_EXPIRED,
   };
 
+  struct Shard {
+    explicit Shard(const std::string& policy_name)
+        : policy(NewEvictionPolicy(policy_name)) {}
+
+    Mutex mutex;
+    std::unique_ptr<EvictionPolicy> policy;
+  };
+
   using MessageType = std::pair<CacheItems, DeleteFrom>;
   using MessageQueueType = MessageQueue<MessageType>;
 
  public:
   DiskCacheManager(uint64_t capacity, std::shared_ptr<DiskCacheLayout> layout,
                    std::shared_ptr<LocalFileSystem> fs,
-                   std::shared_ptr<DiskCacheMetric> metric);
+                   std::shared_ptr<FdCache> fd_cache,
+                   std::shared_ptr<DiskCacheMetric> metric,
+                   const std::string& eviction_policy = kLRUPolicy,
+                   uint32_t num_shards = 1,
+                   std::shared_ptr<DiskCacheIndex> index = nullptr);
 
   virtual ~DiskCacheManager() = default;
 
@@ -72,15 +91,28 @@ class DiskCacheManager {
 
   virtual void Add(const BlockKey& key, const CacheValue& value);
 
+  // Add the block which loaded from persistent index, not journal it again.
+  virtual void Restore(const BlockKey& key, const CacheValue& value);
+
   virtual BCACHE_ERROR Get(const BlockKey& key, CacheValue* value);
 
   virtual void Delete(const BlockKey& key);
 
+  // Whether the block should be cached, only make sense when cache is full.
+  virtual bool Admit(const BlockKey& key, size_t size);
+
   virtual bool StageFull() const;
 
   virtual bool CacheFull() const;
 
+  // Dump all cache blocks into a new snapshot of persistent index.
+  virtual BCACHE_ERROR CompactIndex();
+
  private:
+  void Insert(const BlockKey& key, const CacheValue& value, bool persist);
+
+  void CheckIndex();
+
   void CheckFreeSpace();
 
   void CleanupFull(uint64_t goal_bytes, uint64_t goal_files);
@@ -89,6 +121,10 @@ class DiskCacheManager {
 
   void DeleteBlocks(const CacheItems& to_del, DeleteFrom);
 
+  Shard* GetShard(const CacheKey& key);
+
+  bool GoalReached(uint64_t goal_bytes, uint64_t goal_files) const;
+
   void UpdateUsage(int64_t n, int64_t bytes);
 
   std::string GetCachePath(const CacheKey& key);
@@ -96,15 +132,18 @@ class DiskCacheManager {
   static std::string StrFrom(DeleteFrom from);
 
  private:
-  Mutex mutex_;
-  uint64_t used_bytes_;
+  Mutex cleanup_mutex_;  // only one cleanup at a time
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<uint64_t> used_bytes_;
+  std::atomic<uint64_t> num_blocks_;
   uint64_t capacity_;
   std::atomic<bool> stage_full_;
   std::atomic<bool> cache_full_;
   std::atomic<bool> running_;
   std::shared_ptr<DiskCacheLayout> layout_;
   std::shared_ptr<LocalFileSystem> fs_;
-  std::unique_ptr<LRUCache> lru_;
+  std::shared_ptr<FdCache> fd_cache_;
+  std::shared_ptr<DiskCacheIndex> index_;
   std::unique_ptr<MessageQueueType> mq_;
   std::shared_ptr<DiskCacheMetric> metric_;
   std::unique_ptr<TaskThreadPool<>> task_pool_;
@@ -76,6 +76,9 @@ class DiskCacheMetric {
     metric_.cache_blocks.reset();
     metric_.cache_bytes.reset();
     metric_.cache_full.set_value(false);
+    metric_.cache_rejects.reset();
+    metric_.fd_cache_hits.reset();
+    metric_.fd_cache_misses.reset();
     metric_.use_direct_write.set_value(false);
   }
 
@@ -122,6 +125,13 @@ class DiskCacheMetric {
 
   void SetCacheFull(bool is_full) { metric_.cache_full.set_value(is_full); }
 
+  void AddCacheReject() { metric_.cache_rejects << 1; }
+
+  // fd cache
+  void AddFdCacheHit() { metric_.fd_cache_hits << 1; }
+
+  void AddFdCacheMiss() { metric_.fd_cache_misses << 1; }
+
   void SetUseDirectWrite(bool use_direct_write) {
     metric_.use_direct_write.set_value(use_direct_write);
   }
@@ -145,6 +155,9 @@ class DiskCacheMetric {
       cache_blocks.expose_as(prefix, "cache_blocks");
       cache_bytes.expose_as(prefix, "cache_bytes");
       cache_full.expose_as(prefix, "cache_full");
+      cache_rejects.expose_as(prefix, "cache_rejects");
+      fd_cache_hits.expose_as(prefix, "fd_cache_hits");  // fd cache
+      fd_cache_misses.expose_as(prefix, "fd_cache_misses");
       use_direct_write.expose_as(prefix, "use_direct_write");
     }
 
@@ -164,6 +177,9 @@ class DiskCacheMetric {
     bvar::Adder<int64_t> cache_blocks;
     bvar::Adder<int64_t> cache_bytes;
     bvar::Status<bool> cache_full;
+    bvar::Adder<int64_t> cache_rejects;  // not admitted by eviction policy
+    bvar::Adder<int64_t> fd_cache_hits;  // fd cache
+    bvar::Adder<int64_t> fd_cache_misses;
     bvar::Status<bool> use_direct_write;
   };
 
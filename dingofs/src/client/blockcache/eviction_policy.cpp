@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include "dingofs/src/client/blockcache/eviction_policy.h"
+
+#include <glog/logging.h>
+
+#include "dingofs/src/client/blockcache/lru_cache.h"
+#include "dingofs/src/client/blockcache/tiny_lfu.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+std::unique_ptr<EvictionPolicy> NewEvictionPolicy(const std::string& name) {
+  if (name == kTinyLFUPolicy) {
+    return std::make_unique<TinyLFUCache>();
+  } else if (!name.empty() && name != kLRUPolicy) {
+    LOG(WARNING) << "Unknown eviction policy (" << name
+                 << "), fallback to lru policy.";
+  }
+  return std::make_unique<LRUCache>();
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
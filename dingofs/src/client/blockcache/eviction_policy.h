@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_EVICTION_POLICY_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_EVICTION_POLICY_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "dingofs/src/client/blockcache/lru_common.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+constexpr const char* kLRUPolicy = "lru";
+constexpr const char* kTinyLFUPolicy = "tinylfu";
+
+enum class FilterStatus {
+  EVICT_IT,
+  SKIP,
+  FINISH,
+};
+
+// The policy which manage cache items for disk cache, it decides which
+// block should be evicted and whether a new block should be admitted.
+// NOTE: it's not thread-safe, protected by the caller.
+class EvictionPolicy {
+ public:
+  using FilterFunc = std::function<FilterStatus(const CacheValue& value)>;
+  using WalkFunc =
+      std::function<void(const CacheKey& key, const CacheValue& value)>;
+
+ public:
+  virtual ~EvictionPolicy() = default;
+
+  virtual void Add(const CacheKey& key, const CacheValue& value) = 0;
+
+  virtual bool Get(const CacheKey& key, CacheValue* value) = 0;
+
+  virtual bool Delete(const CacheKey& key, CacheValue* deleted) = 0;
+
+  // Walk items in eviction order, the |filter| decide what to do for each.
+  virtual CacheItems Evict(FilterFunc filter) = 0;
+
+  // Visit all items, e.g. dump them to persistent index.
+  virtual void Walk(WalkFunc func) = 0;
+
+  virtual size_t Size() = 0;
+
+  virtual void Clear() = 0;
+
+  // Whether the new block should be admitted when cache is full,
+  // which means some block will be evicted for it.
+  virtual bool Admit(const CacheKey& /*key*/) { return true; }
+
+  virtual std::string Name() const = 0;
+};
+
+// Create policy by name, fallback to lru if the name is unknown.
+std::unique_ptr<EvictionPolicy> NewEvictionPolicy(const std::string& name);
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_EVICTION_POLICY_H_
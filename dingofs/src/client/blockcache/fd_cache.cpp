@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include "dingofs/src/client/blockcache/fd_cache.h"
+
+#include <memory>
+
+#include "dingofs/src/client/blockcache/error.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::base::cache::NewLRUCache;
+
+FdCache::FdCache(size_t capacity, std::shared_ptr<LocalFileSystem> fs)
+    : cache_(NewLRUCache(capacity)), fs_(fs) {}
+
+FdCache::~FdCache() { delete cache_; }
+
+FdCache::Handle* FdCache::Lookup(const BlockKey& key, int* fd) {
+  auto* handle = cache_->Lookup(key.Filename());
+  if (handle != nullptr) {
+    *fd = reinterpret_cast<CachedFd*>(cache_->Value(handle))->fd;
+  }
+  return handle;
+}
+
+FdCache::Handle* FdCache::Insert(const BlockKey& key, int fd) {
+  auto* value = new CachedFd(fd, fs_);
+  return cache_->Insert(key.Filename(), value, 1, &FdCache::CloseFd);
+}
+
+void FdCache::Release(Handle* handle) { cache_->Release(handle); }
+
+void FdCache::Erase(const BlockKey& key) { cache_->Erase(key.Filename()); }
+
+void FdCache::Clear() { cache_->Prune(); }
+
+size_t FdCache::Size() { return cache_->TotalCharge(); }
+
+void FdCache::CloseFd(const std::string_view&, void* value) {
+  auto* cached = reinterpret_cast<CachedFd*>(value);
+  cached->fs->Do([cached](const std::shared_ptr<PosixFileSystem> posix) {
+    return posix->Close(cached->fd);
+  });
+  delete cached;
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
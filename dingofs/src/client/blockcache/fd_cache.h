@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_FD_CACHE_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_FD_CACHE_H_
+
+#include <memory>
+
+#include "dingofs/src/base/cache/cache.h"
+#include "dingofs/src/client/blockcache/cache_store.h"
+#include "dingofs/src/client/blockcache/local_filesystem.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::base::cache::Cache;
+
+// Cache opened read-only fds of cache blocks, which avoid open/close
+// for every range read on hot blocks.
+//
+// The fd is shared by all readers (they only use pread), and it will be
+// closed once it's evicted (or erased) and all handles are released,
+// so the space of deleted block file can be reclaimed in time.
+class FdCache {
+ public:
+  using Handle = Cache::Handle;
+
+  // |capacity| is the max number of cached fds, 0 means disable cache,
+  // and the fd will be closed when its handle released.
+  FdCache(size_t capacity, std::shared_ptr<LocalFileSystem> fs);
+
+  virtual ~FdCache();
+
+  // Return nullptr if not found, otherwise the handle which
+  // must be released by Release().
+  virtual Handle* Lookup(const BlockKey& key, int* fd);
+
+  // Take ownership of |fd| and return its handle.
+  virtual Handle* Insert(const BlockKey& key, int fd);
+
+  virtual void Release(Handle* handle);
+
+  virtual void Erase(const BlockKey& key);
+
+  virtual void Clear();
+
+  virtual size_t Size();
+
+ private:
+  struct CachedFd {
+    CachedFd(int fd, std::shared_ptr<LocalFileSystem> fs) : fd(fd), fs(fs) {}
+
+    int fd;
+    std::shared_ptr<LocalFileSystem> fs;
+  };
+
+  static void CloseFd(const std::string_view& key, void* value);
+
+ private:
+  Cache* cache_;
+  std::shared_ptr<LocalFileSystem> fs_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_FD_CACHE_H_
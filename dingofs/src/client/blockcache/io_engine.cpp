@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include "dingofs/src/client/blockcache/io_engine.h"
+
+#include <errno.h>
+#include <glog/logging.h>
+#include <unistd.h>
+
+#include <memory>
+
+#ifdef WITH_LIBURING
+#include "dingofs/src/client/blockcache/uring_io_engine.h"
+#endif
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+int PosixIOEngine::PWrite(int fd, const char* buffer, size_t length,
+                          off_t offset, bool /*direct*/) {
+  while (length > 0) {
+    ssize_t nwritten = ::pwrite(fd, buffer, length, offset);
+    if (nwritten < 0) {
+      if (errno == EINTR) {
+        continue;  // retry
+      }
+      return errno;
+    }
+    buffer += nwritten;
+    length -= nwritten;
+    offset += nwritten;
+  }
+  return 0;
+}
+
+int PosixIOEngine::PRead(int fd, char* buffer, size_t length, off_t offset) {
+  while (length > 0) {
+    ssize_t n = ::pread(fd, buffer, length, offset);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;  // retry
+      }
+      return errno;
+    } else if (n == 0) {  // end of file
+      break;
+    }
+    buffer += n;
+    length -= n;
+    offset += n;
+  }
+  return 0;
+}
+
+std::shared_ptr<IOEngine> NewIOEngine(const std::string& name) {
+  std::shared_ptr<IOEngine> engine;
+  if (name.empty() || name == kPosixIOEngine) {
+    engine = std::make_shared<PosixIOEngine>();
+  } else if (name == kUringIOEngine) {
+#ifdef WITH_LIBURING
+    engine = std::make_shared<UringIOEngine>();
+#else
+    LOG(WARNING) << "The client is built without liburing, "
+                 << "fallback to posix io engine.";
+#endif
+  } else {
+    LOG(WARNING) << "Unknown io engine (" << name
+                 << "), fallback to posix io engine.";
+  }
+
+  if (engine != nullptr && !engine->Init()) {
+    LOG(WARNING) << "Init io engine (" << engine->Name()
+                 << ") failed, fallback to posix io engine.";
+    engine = nullptr;
+  }
+
+  if (engine == nullptr) {
+    engine = std::make_shared<PosixIOEngine>();
+    CHECK(engine->Init());
+  }
+  return engine;
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_IO_ENGINE_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_IO_ENGINE_H_
+
+#include <sys/types.h>
+
+#include <memory>
+#include <string>
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+constexpr const char* kPosixIOEngine = "posix";
+constexpr const char* kUringIOEngine = "io_uring";
+
+// The engine which issue data read/write for block cache files,
+// all methods return 0 on success, otherwise the errno.
+class IOEngine {
+ public:
+  virtual ~IOEngine() = default;
+
+  virtual bool Init() = 0;
+
+  virtual void Shutdown() = 0;
+
+  // Write all |length| bytes of |buffer| to |fd| at |offset|,
+  // |direct| means the |fd| is opened with O_DIRECT.
+  virtual int PWrite(int fd, const char* buffer, size_t length, off_t offset,
+                     bool direct) = 0;
+
+  // Read |length| bytes from |fd| at |offset|, stop at end of file.
+  virtual int PRead(int fd, char* buffer, size_t length, off_t offset) = 0;
+
+  // Whether the engine can write a misaligned buffer with direct IO,
+  // e.g. by copying it into an aligned (registered) buffer.
+  virtual bool SupportMisalignedDirect() const = 0;
+
+  virtual std::string Name() const = 0;
+};
+
+// The default engine, issue blocking syscalls from the calling thread.
+class PosixIOEngine : public IOEngine {
+ public:
+  PosixIOEngine() = default;
+
+  ~PosixIOEngine() override = default;
+
+  bool Init() override { return true; }
+
+  void Shutdown() override {}
+
+  int PWrite(int fd, const char* buffer, size_t length, off_t offset,
+             bool direct) override;
+
+  int PRead(int fd, char* buffer, size_t length, off_t offset) override;
+
+  bool SupportMisalignedDirect() const override { return false; }
+
+  std::string Name() const override { return kPosixIOEngine; }
+};
+
+// Create and initialize the engine specified by |name|, it will fallback
+// to posix engine if the engine is unknown or fail to initialize
+// (e.g. io_uring is not supported by the kernel).
+std::shared_ptr<IOEngine> NewIOEngine(const std::string& name);
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_IO_ENGINE_H_
@@ -54,8 +54,9 @@ using ::dingofs::base::string::StrFormat;
 
 // posix filesystem
 PosixFileSystem::PosixFileSystem(
-    std::shared_ptr<DiskStateMachine> disk_state_machine)
-    : disk_state_machine_(disk_state_machine) {}
+    std::shared_ptr<DiskStateMachine> disk_state_machine,
+    std::shared_ptr<IOEngine> io_engine)
+    : disk_state_machine_(disk_state_machine), io_engine_(io_engine) {}
 
 template <typename... Args>
 BCACHE_ERROR PosixFileSystem::PosixError(int code, const char* format,
@@ -204,6 +205,27 @@ BCACHE_ERROR PosixFileSystem::Read(int fd, char* buffer, size_t length) {
   return BCACHE_ERROR::OK;
 }
 
+BCACHE_ERROR PosixFileSystem::PWrite(int fd, const char* buffer,
+                                     size_t length, off_t offset,
+                                     bool direct) {
+  int code = io_engine_->PWrite(fd, buffer, length, offset, direct);
+  if (code != 0) {
+    return PosixError(code, "%s:pwrite(%d,%d,%d)", io_engine_->Name(), fd,
+                      length, offset);
+  }
+  return BCACHE_ERROR::OK;
+}
+
+BCACHE_ERROR PosixFileSystem::PRead(int fd, char* buffer, size_t length,
+                                    off_t offset) {
+  int code = io_engine_->PRead(fd, buffer, length, offset);
+  if (code != 0) {
+    return PosixError(code, "%s:pread(%d,%d,%d)", io_engine_->Name(), fd,
+                      length, offset);
+  }
+  return BCACHE_ERROR::OK;
+}
+
 BCACHE_ERROR PosixFileSystem::Close(int fd) {
   ::close(fd);
   return BCACHE_ERROR::OK;
@@ -248,8 +270,12 @@ BCACHE_ERROR PosixFileSystem::FAdvise(int fd, int advise) {
 }
 
 LocalFileSystem::LocalFileSystem(
-    std::shared_ptr<DiskStateMachine> disk_state_machine)
-    : posix_(std::make_shared<PosixFileSystem>(disk_state_machine)) {}
+    std::shared_ptr<DiskStateMachine> disk_state_machine,
+    std::shared_ptr<IOEngine> io_engine)
+    : io_engine_(io_engine != nullptr ? io_engine
+                                      : std::make_shared<PosixIOEngine>()),
+      posix_(std::make_shared<PosixFileSystem>(disk_state_machine,
+                                               io_engine_)) {}
 
 BCACHE_ERROR LocalFileSystem::MkDirs(const std::string& path) {
   // The parent diectory already exists in most time
@@ -328,11 +354,12 @@ BCACHE_ERROR LocalFileSystem::WriteFile(const std::string& path,
   std::string tmp = path + ".tmp";
   if (use_direct) {
     use_direct = IsAligned(length) &&
-                 IsAligned(reinterpret_cast<std::uintptr_t>(buffer));
+                 (IsAligned(reinterpret_cast<std::uintptr_t>(buffer)) ||
+                  io_engine_->SupportMisalignedDirect());
   }
   rc = posix_->Create(tmp, &fd, use_direct);
   if (rc == BCACHE_ERROR::OK) {
-    rc = posix_->Write(fd, buffer, length);
+    rc = posix_->PWrite(fd, buffer, length, 0, use_direct);
     posix_->Close(fd);
     if (rc == BCACHE_ERROR::OK) {
       rc = posix_->Rename(tmp, path);
@@ -366,7 +393,7 @@ BCACHE_ERROR LocalFileSystem::ReadFile(const std::string& path,
 
   *length = size;
   buffer = std::shared_ptr<char>(new char[size], std::default_delete<char[]>());
-  rc = posix_->Read(fd, buffer.get(), size);
+  rc = posix_->PRead(fd, buffer.get(), size, 0);
 
   if (rc == BCACHE_ERROR::OK && drop_page_cache) {
     posix_->FAdvise(fd, POSIX_FADV_DONTNEED);
@@ -34,6 +34,7 @@
 #include "dingofs/src/base/time/time.h"
 #include "dingofs/src/client/blockcache/disk_state_machine_impl.h"
 #include "dingofs/src/client/blockcache/error.h"
+#include "dingofs/src/client/blockcache/io_engine.h"
 
 #define IO_ALIGNED_BLOCK_SIZE 4096
 
@@ -45,7 +46,8 @@ using ::dingofs::base::time::TimeSpec;
 
 class PosixFileSystem {
  public:
-  PosixFileSystem(std::shared_ptr<DiskStateMachine> disk_state_machine);
+  PosixFileSystem(std::shared_ptr<DiskStateMachine> disk_state_machine,
+                  std::shared_ptr<IOEngine> io_engine);
 
   ~PosixFileSystem() = default;
 
@@ -69,6 +71,12 @@ class PosixFileSystem {
 
   BCACHE_ERROR Read(int fd, char* buffer, size_t length);
 
+  // Positional read/write which issued by the io engine
+  BCACHE_ERROR PWrite(int fd, const char* buffer, size_t length, off_t offset,
+                      bool direct);
+
+  BCACHE_ERROR PRead(int fd, char* buffer, size_t length, off_t offset);
+
   BCACHE_ERROR Close(int fd);
 
   BCACHE_ERROR Unlink(const std::string& path);
@@ -89,6 +97,7 @@ class PosixFileSystem {
 
  private:
   std::shared_ptr<DiskStateMachine> disk_state_machine_;
+  std::shared_ptr<IOEngine> io_engine_;
 };
 
 // The local filesystem with high-level utilities for block cache
@@ -122,7 +131,8 @@ class LocalFileSystem {
 
  public:
   explicit LocalFileSystem(
-      std::shared_ptr<DiskStateMachine> disk_state_machine = nullptr);
+      std::shared_ptr<DiskStateMachine> disk_state_machine = nullptr,
+      std::shared_ptr<IOEngine> io_engine = nullptr);
 
   ~LocalFileSystem() = default;
 
@@ -151,6 +161,7 @@ class LocalFileSystem {
   bool IsAligned(uint64_t n);
 
  private:
+  std::shared_ptr<IOEngine> io_engine_;
   std::shared_ptr<PosixFileSystem> posix_;
 };
 
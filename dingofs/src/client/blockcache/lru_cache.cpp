@@ -96,8 +96,26 @@ CacheItems LRUCache::Evict(FilterFunc filter) {
   return evicted;
 }
 
+void LRUCache::Walk(WalkFunc func) {
+  for (ListNode* list : {&inactive_, &active_}) {
+    for (ListNode* curr = list->next; curr != list; curr = curr->next) {
+      auto item = KV(curr);
+      func(item.key, item.value);
+    }
+  }
+}
+
 size_t LRUCache::Size() { return hash_->TotalCharge(); }
 
+bool LRUCache::Peek(CacheKey* key) {
+  ListNode* list = (inactive_.next != &inactive_) ? &inactive_ : &active_;
+  if (list->next == list) {
+    return false;
+  }
+  *key = KV(list->next).key;
+  return true;
+}
+
 void LRUCache::Clear() {
   EvictAllNodes(&inactive_);
   EvictAllNodes(&active_);
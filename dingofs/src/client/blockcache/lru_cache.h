@@ -25,42 +25,43 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 #include <string_view>
 
+#include "dingofs/src/client/blockcache/eviction_policy.h"
 #include "dingofs/src/client/blockcache/lru_common.h"
 
 namespace dingofs {
 namespace client {
 namespace blockcache {
 
-enum class FilterStatus {
-  EVICT_IT,
-  SKIP,
-  FINISH,
-};
-
 // How it implements:
 //  hash table: using base::Cache
 //  lru policy: manage inactive and active list
-class LRUCache {
-  using FilterFunc = std::function<FilterStatus(const CacheValue& value)>;
-
+class LRUCache : public EvictionPolicy {
  public:
   LRUCache();
 
-  virtual ~LRUCache();
+  ~LRUCache() override;
+
+  void Add(const CacheKey& key, const CacheValue& value) override;
+
+  bool Get(const CacheKey& key, CacheValue* value) override;
+
+  bool Delete(const CacheKey& key, CacheValue* deleted) override;
 
-  virtual void Add(const CacheKey& key, const CacheValue& value);
+  CacheItems Evict(FilterFunc filter) override;
 
-  virtual bool Get(const CacheKey& key, CacheValue* value);
+  void Walk(WalkFunc func) override;
 
-  virtual bool Delete(const CacheKey& key, CacheValue* deleted);
+  size_t Size() override;
 
-  virtual CacheItems Evict(FilterFunc filter);
+  void Clear() override;
 
-  virtual size_t Size();
+  std::string Name() const override { return kLRUPolicy; }
 
-  virtual void Clear();
+  // Get the key which will be evicted first, return false if empty.
+  bool Peek(CacheKey* key);
 
  private:
   void HashInsert(const std::string& key, ListNode* node);
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include "dingofs/src/client/blockcache/mem_cache.h"
+
+#include <glog/logging.h>
+
+#include <cstring>
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::utils::LockGuard;
+
+MemBlock::MemBlock(const char* data, size_t size)
+    : data(new char[size]), size(size) {
+  std::memcpy(this->data.get(), data, size);
+}
+
+MemBlockReader::MemBlockReader(std::shared_ptr<MemBlock> block)
+    : block_(block) {}
+
+BCACHE_ERROR MemBlockReader::ReadAt(off_t offset, size_t length,
+                                    char* buffer) {
+  if (offset < 0 || static_cast<size_t>(offset) + length > block_->size) {
+    return BCACHE_ERROR::END_OF_FILE;
+  }
+  std::memcpy(buffer, block_->data.get() + offset, length);
+  return BCACHE_ERROR::OK;
+}
+
+bool MemBlockReader::GetBuffer(off_t offset, size_t length,
+                               BlockBuffer* buffer) {
+  if (offset < 0 || static_cast<size_t>(offset) + length > block_->size) {
+    return false;
+  }
+  buffer->mem = block_->data.get() + offset;
+  return true;
+}
+
+void MemBlockReader::Close() { block_ = nullptr; }
+
+MemCache::MemCache(MemCacheOption option, EvictFunc on_evict)
+    : option_(option),
+      on_evict_(on_evict),
+      used_bytes_(0),
+      protected_bytes_(0),
+      metric_(std::make_unique<MemCacheMetric>(option)) {}
+
+BCACHE_ERROR MemCache::Init(UploadFunc) {
+  metric_->Init();
+  LOG(INFO) << "Memory cache init success: capacity=" << option_.cache_size;
+  return BCACHE_ERROR::OK;
+}
+
+BCACHE_ERROR MemCache::Shutdown() {
+  LockGuard lk(mutex_);
+  while (!entries_.empty()) {
+    Remove(entries_.begin());
+  }
+  metric_->SetUsedBytes(0);
+  return BCACHE_ERROR::OK;
+}
+
+BCACHE_ERROR MemCache::Stage(const BlockKey&, const Block&, BlockContext) {
+  return BCACHE_ERROR::NOT_SUPPORTED;
+}
+
+BCACHE_ERROR MemCache::RemoveStage(const BlockKey&, BlockContext) {
+  return BCACHE_ERROR::NOT_SUPPORTED;
+}
+
+BCACHE_ERROR MemCache::Cache(const BlockKey& key, const Block& block) {
+  if (!Enabled()) {
+    return BCACHE_ERROR::NOT_SUPPORTED;
+  } else if (block.size > option_.cache_size) {
+    return BCACHE_ERROR::CACHE_FULL;
+  }
+
+  // copy the data outside the lock
+  auto mem_block = std::make_shared<MemBlock>(block.data, block.size);
+  std::string name = key.Filename();
+
+  std::vector<Entry> evicted;
+  {
+    LockGuard lk(mutex_);
+    if (entries_.find(name) != entries_.end()) {
+      return BCACHE_ERROR::OK;  // already cached
+    }
+
+    probation_.emplace_front(name);
+    entries_.emplace(name, Entry{key, mem_block, Segment::kProbation,
+                                 probation_.begin()});
+    used_bytes_ += block.size;
+    metric_->AddCacheBlock(1, block.size);
+    CleanupFull(&evicted);
+    metric_->SetUsedBytes(used_bytes_);
+  }
+
+  if (on_evict_ != nullptr) {
+    for (const auto& entry : evicted) {
+      on_evict_(entry.key, Block(entry.block->data.get(), entry.block->size));
+    }
+  }
+  return BCACHE_ERROR::OK;
+}
+
+BCACHE_ERROR MemCache::Load(const BlockKey& key,
+                            std::shared_ptr<BlockReader>& reader) {
+  if (!Enabled()) {
+    return BCACHE_ERROR::NOT_SUPPORTED;
+  }
+
+  LockGuard lk(mutex_);
+  auto iter = entries_.find(key.Filename());
+  if (iter == entries_.end()) {
+    metric_->AddCacheMiss();
+    return BCACHE_ERROR::NOT_FOUND;
+  }
+
+  Promote(&iter->second);
+  reader = std::make_shared<MemBlockReader>(iter->second.block);
+  metric_->AddCacheHit();
+  return BCACHE_ERROR::OK;
+}
+
+bool MemCache::IsCached(const BlockKey& key) {
+  LockGuard lk(mutex_);
+  return entries_.find(key.Filename()) != entries_.end();
+}
+
+size_t MemCache::UsedBytes() {
+  LockGuard lk(mutex_);
+  return used_bytes_;
+}
+
+std::list<std::string>* MemCache::List(Segment segment) {
+  return segment == Segment::kProbation ? &probation_ : &protected_;
+}
+
+// protect by mutex
+void MemCache::Remove(std::unordered_map<std::string, Entry>::iterator iter) {
+  auto& entry = iter->second;
+  if (entry.segment == Segment::kProtected) {
+    protected_bytes_ -= entry.block->size;
+  }
+  used_bytes_ -= entry.block->size;
+  metric_->AddCacheBlock(-1, -static_cast<int64_t>(entry.block->size));
+
+  List(entry.segment)->erase(entry.iter);
+  entries_.erase(iter);
+}
+
+// protect by mutex
+void MemCache::Promote(Entry* entry) {
+  if (entry->segment == Segment::kProtected) {  // move to front
+    protected_.splice(protected_.begin(), protected_, entry->iter);
+    return;
+  }
+
+  protected_.splice(protected_.begin(), probation_, entry->iter);
+  entry->segment = Segment::kProtected;
+  protected_bytes_ += entry->block->size;
+
+  // demote the least recently used blocks in protected segment
+  size_t max_protected_bytes = option_.cache_size * kProtectedRatio;
+  while (protected_bytes_ > max_protected_bytes && !protected_.empty()) {
+    auto& demoted = entries_.at(protected_.back());
+    probation_.splice(probation_.begin(), protected_, demoted.iter);
+    demoted.segment = Segment::kProbation;
+    protected_bytes_ -= demoted.block->size;
+  }
+}
+
+// protect by mutex
+void MemCache::CleanupFull(std::vector<Entry>* evicted) {
+  while (used_bytes_ > option_.cache_size) {
+    auto* list = probation_.empty() ? &protected_ : &probation_;
+    CHECK(!list->empty());
+    auto iter = entries_.find(list->back());
+    VLOG(9) << "Evict block (" << iter->first
+            << ") from memory cache: size=" << iter->second.block->size;
+    evicted->emplace_back(iter->second);
+    Remove(iter);
+    metric_->AddEvictBlock();
+  }
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
@@ -20,51 +20,139 @@
  * Author: Jingli Chen (Wine93)
  */
 
-#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_NONE_CACHE_H_
-#define DINGOFS_SRC_CLIENT_BLOCKCACHE_NONE_CACHE_H_
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_MEM_CACHE_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_MEM_CACHE_H_
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "dingofs/src/client/blockcache/cache_store.h"
 #include "dingofs/src/client/blockcache/error.h"
+#include "dingofs/src/client/blockcache/mem_cache_metric.h"
+#include "dingofs/src/client/common/config.h"
+#include "dingofs/src/utils/concurrent/concurrent.h"
 
 namespace dingofs {
 namespace client {
 namespace blockcache {
 
+using ::dingofs::client::common::MemCacheOption;
+using ::dingofs::utils::Mutex;
 using UploadFunc = CacheStore::UploadFunc;
 
+// The cached block, shared by cache and readers, so the block is still
+// readable after it's evicted.
+struct MemBlock {
+  MemBlock(const char* data, size_t size);
+
+  std::unique_ptr<char[]> data;
+  size_t size;
+};
+
+// Serve read straight from the cached block, no IO at all.
+class MemBlockReader : public BlockReader {
+ public:
+  explicit MemBlockReader(std::shared_ptr<MemBlock> block);
+
+  virtual ~MemBlockReader() = default;
+
+  BCACHE_ERROR ReadAt(off_t offset, size_t length, char* buffer) override;
+
+  bool GetBuffer(off_t offset, size_t length, BlockBuffer* buffer) override;
+
+  void Close() override;
+
+ private:
+  std::shared_ptr<MemBlock> block_;
+};
+
+// The memory cache store which use segmented LRU for eviction:
+//
+//   probation: the block which accessed only once (e.g. scanned)
+//   protected: the block which hit in probation segment, it can use up to
+//              |kProtectedRatio| of capacity, the overflowed block
+//              will be demoted to probation segment.
+//
+// Blocks are always evicted from the tail of probation segment first,
+// so a large scan can't flush out the hot blocks.
+//
+// NOTE: the stage (write-back) is not supported, because the memory is
+// not durable.
 class MemCache : public CacheStore {
+  enum class Segment {
+    kProbation,
+    kProtected,
+  };
+
+  struct Entry {
+    BlockKey key;
+    std::shared_ptr<MemBlock> block;
+    Segment segment;
+    std::list<std::string>::iterator iter;  // position in segment list
+  };
+
+  static constexpr double kProtectedRatio = 0.8;
+
  public:
-  MemCache() = default;
+  // Invoked (without lock) for every block which evicted for capacity.
+  using EvictFunc =
+      std::function<void(const BlockKey& key, const Block& block)>;
+
+ public:
+  explicit MemCache(MemCacheOption option = MemCacheOption{0},
+                    EvictFunc on_evict = nullptr);
 
   virtual ~MemCache() = default;
 
-  BCACHE_ERROR Init(UploadFunc) override { return BCACHE_ERROR::OK; }
+  BCACHE_ERROR Init(UploadFunc uploader) override;
 
-  BCACHE_ERROR Shutdown() override { return BCACHE_ERROR::OK; }
+  BCACHE_ERROR Shutdown() override;
 
-  BCACHE_ERROR Stage(const BlockKey&, const Block&, BlockContext) override {
-    return BCACHE_ERROR::NOT_SUPPORTED;
-  }
+  BCACHE_ERROR Stage(const BlockKey& key, const Block& block,
+                     BlockContext ctx) override;
 
-  BCACHE_ERROR RemoveStage(const BlockKey&, BlockContext) override {
-    return BCACHE_ERROR::NOT_SUPPORTED;
-  }
+  BCACHE_ERROR RemoveStage(const BlockKey& key, BlockContext ctx) override;
 
-  BCACHE_ERROR Cache(const BlockKey&, const Block&) override {
-    return BCACHE_ERROR::NOT_SUPPORTED;
-  }
+  BCACHE_ERROR Cache(const BlockKey& key, const Block& block) override;
 
-  BCACHE_ERROR Load(const BlockKey&, std::shared_ptr<BlockReader>&) override {
-    return BCACHE_ERROR::NOT_SUPPORTED;
-  }
+  BCACHE_ERROR Load(const BlockKey& key,
+                    std::shared_ptr<BlockReader>& reader) override;
 
-  bool IsCached(const BlockKey&) override { return false; }
+  bool IsCached(const BlockKey& key) override;
 
   std::string Id() override { return "memory_cache"; }
+
+  size_t UsedBytes();
+
+ private:
+  bool Enabled() const { return option_.cache_size > 0; }
+
+  std::list<std::string>* List(Segment segment);
+
+  void Remove(std::unordered_map<std::string, Entry>::iterator iter);
+
+  void Promote(Entry* entry);
+
+  void CleanupFull(std::vector<Entry>* evicted);
+
+ private:
+  MemCacheOption option_;
+  EvictFunc on_evict_;
+  Mutex mutex_;
+  size_t used_bytes_;
+  size_t protected_bytes_;
+  std::list<std::string> probation_;  // front is the most recently used
+  std::list<std::string> protected_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::unique_ptr<MemCacheMetric> metric_;
 };
 
 }  // namespace blockcache
 }  // namespace client
 }  // namespace dingofs
 
-#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_NONE_CACHE_H_
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_MEM_CACHE_H_
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_MEM_CACHE_METRIC_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_MEM_CACHE_METRIC_H_
+
+#include <bvar/bvar.h>
+
+#include <string>
+
+#include "dingofs/src/client/common/config.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::client::common::MemCacheOption;
+
+class MemCacheMetric {
+ public:
+  explicit MemCacheMetric(MemCacheOption option)
+      : option_(option), metric_("dingofs_block_cache.mem_cache") {}
+
+  virtual ~MemCacheMetric() = default;
+
+  void Init() {
+    metric_.used_bytes.set_value(0);
+    metric_.capacity.set_value(option_.cache_size);
+    metric_.cache_hits.reset();
+    metric_.cache_misses.reset();
+    metric_.cache_blocks.reset();
+    metric_.cache_bytes.reset();
+    metric_.evict_blocks.reset();
+  }
+
+  void SetUsedBytes(int64_t used_bytes) {
+    metric_.used_bytes.set_value(used_bytes);
+  }
+
+  void AddCacheHit() { metric_.cache_hits << 1; }
+
+  void AddCacheMiss() { metric_.cache_misses << 1; }
+
+  void AddCacheBlock(int64_t n, int64_t bytes) {
+    metric_.cache_blocks << n;
+    metric_.cache_bytes << bytes;
+  }
+
+  void AddEvictBlock() { metric_.evict_blocks << 1; }
+
+ private:
+  struct Metric {
+    Metric(const std::string& prefix) {
+      used_bytes.expose_as(prefix, "used_bytes");
+      capacity.expose_as(prefix, "capacity");
+      cache_hits.expose_as(prefix, "cache_hits");
+      cache_misses.expose_as(prefix, "cache_misses");
+      cache_blocks.expose_as(prefix, "cache_blocks");
+      cache_bytes.expose_as(prefix, "cache_bytes");
+      evict_blocks.expose_as(prefix, "evict_blocks");
+    }
+
+    bvar::Status<int64_t> used_bytes;
+    bvar::Status<int64_t> capacity;
+    bvar::Adder<int64_t> cache_hits;
+    bvar::Adder<int64_t> cache_misses;
+    bvar::Adder<int64_t> cache_blocks;
+    bvar::Adder<int64_t> cache_bytes;
+    bvar::Adder<int64_t> evict_blocks;
+  };
+
+  MemCacheOption option_;
+  Metric metric_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_MEM_CACHE_METRIC_H_
@@ -22,8 +22,13 @@
 
 #include "dingofs/src/client/blockcache/s3_client.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <mutex>
 #include <ostream>
+#include <unordered_set>
 
+#include "dingofs/src/client/blockcache/block_pack.h"
 #include "dingofs/src/stub/metric/metric.h"
 
 namespace dingofs {
@@ -77,6 +82,58 @@ BCACHE_ERROR S3ClientImpl::Range(const std::string& key, off_t offset,
   return BCACHE_ERROR::OK;
 }
 
+BCACHE_ERROR S3ClientImpl::Get(const std::string& key, std::string* data) {
+  int rc;
+  auto start = butil::cpuwide_time_us();
+  MetricGuard guard(&rc, &S3Metric::GetInstance().read_s3, 0, start);
+
+  rc = client_->GetObject(S3Key(key), data);
+  if (rc < 0) {
+    if (!client_->ObjectExist(S3Key(key))) {
+      return BCACHE_ERROR::NOT_FOUND;
+    }
+    LOG(ERROR) << "Get object(" << key << ") failed, retCode=" << rc;
+    return BCACHE_ERROR::IO_ERROR;
+  }
+  return BCACHE_ERROR::OK;
+}
+
+BCACHE_ERROR S3ClientImpl::Size(const std::string& key, size_t* size) {
+  uint64_t object_size;
+  int rc = client_->GetObjectSize(S3Key(key), &object_size);
+  if (rc == -ENOENT) {
+    return BCACHE_ERROR::NOT_FOUND;
+  } else if (rc < 0) {
+    LOG(ERROR) << "Head object(" << key << ") failed, retCode=" << rc;
+    return BCACHE_ERROR::IO_ERROR;
+  }
+  *size = object_size;
+  return BCACHE_ERROR::OK;
+}
+
+BCACHE_ERROR S3ClientImpl::Copy(const std::string& src_key,
+                                const std::string& dst_key) {
+  int rc = client_->CopyObject(S3Key(src_key), S3Key(dst_key));
+  if (rc < 0) {
+    if (!client_->ObjectExist(S3Key(src_key))) {
+      return BCACHE_ERROR::NOT_FOUND;
+    }
+    LOG(ERROR) << "Copy object(" << src_key << ") to (" << dst_key
+               << ") failed, retCode=" << rc;
+    return BCACHE_ERROR::IO_ERROR;
+  }
+  return BCACHE_ERROR::OK;
+}
+
+BCACHE_ERROR S3ClientImpl::Delete(const std::string& key) {
+  int rc = client_->DeleteObject(S3Key(key));
+  if (rc < 0) {
+    LOG(ERROR) << "Delete object(" << key << ") failed, retCode=" << rc;
+    return BCACHE_ERROR::IO_ERROR;
+  }
+  return BCACHE_ERROR::OK;
+}
+
 void S3ClientImpl::AsyncPut(const std::string& key, const char* buffer,
                             size_t length, RetryCallback retry) {
   auto context = std::make_shared<PutObjectAsyncContext>();
@@ -107,6 +164,84 @@ Aws::String S3ClientImpl::S3Key(const std::string& key) {
   return Aws::String(key.c_str(), key.size());
 }
 
+namespace {
+
+// The marker is never removed once put, so only the positive result cached.
+BCACHE_ERROR CheckPackMarker(S3Client* s3, uint64_t fs_id) {
+  static std::mutex mutex;
+  static std::unordered_set<uint64_t> marked;
+  {
+    std::lock_guard<std::mutex> lk(mutex);
+    if (marked.count(fs_id) != 0) {
+      return BCACHE_ERROR::OK;
+    }
+  }
+
+  size_t size;
+  auto rc = s3->Size(BlockPack::MarkerKey(fs_id), &size);
+  if (rc == BCACHE_ERROR::OK) {
+    std::lock_guard<std::mutex> lk(mutex);
+    marked.insert(fs_id);
+  }
+  return rc;
+}
+
+}  // namespace
+
+BCACHE_ERROR LocatePackedBlock(S3Client* s3, const BlockKey& key,
+                               BlockKey* pack_key, size_t* block_offset,
+                               size_t* block_length) {
+  auto rc = CheckPackMarker(s3, key.fs_id);
+  if (rc != BCACHE_ERROR::OK) {
+    return rc;
+  }
+
+  // The nearest existing object is the only one which may contain the block,
+  // because the pack consists of consecutive blocks.
+  for (const auto& candidate : BlockPack::Candidates(key)) {
+    size_t pack_size;
+    std::string store_key = candidate.StoreKey();
+    rc = s3->Size(store_key, &pack_size);
+    if (rc == BCACHE_ERROR::NOT_FOUND) {
+      continue;
+    } else if (rc != BCACHE_ERROR::OK) {
+      return rc;
+    } else if (pack_size == 0) {
+      break;
+    }
+
+    // only fetch the entries and footer to locate the block
+    size_t tail_size = std::min(pack_size, BlockPack::kMaxTailSize);
+    std::string tail(tail_size, '\0');
+    rc = s3->Range(store_key, pack_size - tail_size, tail_size, tail.data());
+    if (rc != BCACHE_ERROR::OK) {
+      return rc;
+    } else if (!BlockPack::LookupTail(tail.data(), tail.size(), pack_size,
+                                      key.index, block_offset, block_length)) {
+      break;
+    }
+    *pack_key = candidate;
+    return BCACHE_ERROR::OK;
+  }
+  return BCACHE_ERROR::NOT_FOUND;
+}
+
+BCACHE_ERROR RangePackedBlock(S3Client* s3, const BlockKey& key, off_t offset,
+                              size_t length, char* buffer) {
+  BlockKey pack_key;
+  size_t block_offset, block_length;
+  auto rc =
+      LocatePackedBlock(s3, key, &pack_key, &block_offset, &block_length);
+  if (rc != BCACHE_ERROR::OK) {
+    return rc;
+  } else if (offset < 0 ||
+             static_cast<size_t>(offset) + length > block_length) {
+    return BCACHE_ERROR::END_OF_FILE;
+  }
+  return s3->Range(pack_key.StoreKey(), block_offset + offset, length,
+                   buffer);
+}
+
 }  // namespace blockcache
 }  // namespace client
 }  // namespace dingofs
@@ -27,6 +27,7 @@
 #include <string>
 
 #include "dingofs/src/aws/s3_adapter.h"
+#include "dingofs/src/client/blockcache/cache_store.h"
 #include "dingofs/src/client/blockcache/error.h"
 
 namespace dingofs {
@@ -50,6 +51,16 @@ class S3Client {
   virtual BCACHE_ERROR Range(const std::string& key, off_t offset,
                              size_t length, char* buffer) = 0;
 
+  virtual BCACHE_ERROR Get(const std::string& key, std::string* data) = 0;
+
+  virtual BCACHE_ERROR Size(const std::string& key, size_t* size) = 0;
+
+  // Copy the object in storage side, the data never passes the client.
+  virtual BCACHE_ERROR Copy(const std::string& src_key,
+                            const std::string& dst_key) = 0;
+
+  virtual BCACHE_ERROR Delete(const std::string& key) = 0;
+
   virtual void AsyncPut(const std::string& key, const char* buffer,
                         size_t length, RetryCallback callback) = 0;
 
@@ -80,6 +91,15 @@ class S3ClientImpl : public S3Client {
   BCACHE_ERROR Range(const std::string& key, off_t offset, size_t length,
                      char* buffer) override;
 
+  BCACHE_ERROR Get(const std::string& key, std::string* data) override;
+
+  BCACHE_ERROR Size(const std::string& key, size_t* size) override;
+
+  BCACHE_ERROR Copy(const std::string& src_key,
+                    const std::string& dst_key) override;
+
+  BCACHE_ERROR Delete(const std::string& key) override;
+
   void AsyncPut(const std::string& key, const char* buffer, size_t length,
                 RetryCallback retry) override;
 
@@ -93,6 +113,18 @@ class S3ClientImpl : public S3Client {
   std::unique_ptr<::dingofs::aws::S3Adapter> client_;
 };
 
+// Locate the block in the pack which contains it, |pack_key| is the block
+// whose object stores the pack, return NOT_FOUND if the block isn't packed.
+BCACHE_ERROR LocatePackedBlock(S3Client* s3, const BlockKey& key,
+                               BlockKey* pack_key, size_t* block_offset,
+                               size_t* block_length);
+
+// Read the block from the pack which contains it, it's the fallback for
+// the block whose object not found, see BlockPack. It costs nothing but
+// one HEAD request if the filesystem never packed blocks.
+BCACHE_ERROR RangePackedBlock(S3Client* s3, const BlockKey& key, off_t offset,
+                              size_t length, char* buffer);
+
 }  // namespace blockcache
 }  // namespace client
 }  // namespace dingofs
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+
+#include "dingofs/src/client/blockcache/tiered_cache.h"
+
+#include <butil/time.h>
+#include <glog/logging.h>
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::butil::Timer;
+using ::dingofs::utils::LockGuard;
+
+TieredCache::TieredCache(MemCacheOption mem_option,
+                         std::vector<DiskCacheOption> disk_options)
+    : disk_(std::make_shared<DiskCacheGroup>(disk_options)),
+      mem_metric_(std::make_unique<BlockCacheTierMetric>("mem")),
+      disk_metric_(std::make_unique<BlockCacheTierMetric>("disk")) {
+  mem_ = std::make_shared<MemCache>(
+      mem_option, [this](const BlockKey& key, const Block& block) {
+        Demote(key, block);
+      });
+}
+
+BCACHE_ERROR TieredCache::Init(UploadFunc uploader) {
+  auto rc = disk_->Init(uploader);
+  if (rc == BCACHE_ERROR::OK) {
+    rc = mem_->Init(uploader);
+  }
+  return rc;
+}
+
+BCACHE_ERROR TieredCache::Shutdown() {
+  mem_->Shutdown();
+  return disk_->Shutdown();
+}
+
+BCACHE_ERROR TieredCache::Stage(const BlockKey& key, const Block& block,
+                                BlockContext ctx) {
+  return disk_->Stage(key, block, ctx);
+}
+
+BCACHE_ERROR TieredCache::RemoveStage(const BlockKey& key, BlockContext ctx) {
+  return disk_->RemoveStage(key, ctx);
+}
+
+BCACHE_ERROR TieredCache::Cache(const BlockKey& key, const Block& block) {
+  auto rc = mem_->Cache(key, block);
+  if (rc == BCACHE_ERROR::OK) {
+    return rc;
+  }
+  return disk_->Cache(key, block);
+}
+
+BCACHE_ERROR TieredCache::Load(const BlockKey& key,
+                               std::shared_ptr<BlockReader>& reader) {
+  Timer timer;
+  timer.start();
+  auto rc = mem_->Load(key, reader);
+  timer.stop();
+  mem_metric_->AddLoad(rc == BCACHE_ERROR::OK, timer.u_elapsed());
+  if (rc == BCACHE_ERROR::OK) {
+    return rc;
+  }
+
+  timer.start();
+  rc = disk_->Load(key, reader);
+  timer.stop();
+  disk_metric_->AddLoad(rc == BCACHE_ERROR::OK, timer.u_elapsed());
+  if (rc != BCACHE_ERROR::OK || !NeedPromote(key)) {
+    return rc;
+  }
+
+  // The disk reader is still usable if promote failed.
+  std::shared_ptr<BlockReader> mem_reader;
+  if (Promote(key, mem_reader) == BCACHE_ERROR::OK) {
+    reader->Close();
+    reader = mem_reader;
+  }
+  return BCACHE_ERROR::OK;
+}
+
+bool TieredCache::IsCached(const BlockKey& key) {
+  return mem_->IsCached(key) || disk_->IsCached(key);
+}
+
+bool TieredCache::NeedPromote(const BlockKey& key) {
+  LockGuard lk(mutex_);
+  if (disk_hits_.size() >= kMaxTrackedBlocks) {
+    disk_hits_.clear();  // the counters are only a hint, reset them simply
+  }
+
+  auto name = key.Filename();
+  if (++disk_hits_[name] < kPromoteHits) {
+    return false;
+  }
+  disk_hits_.erase(name);
+  return true;
+}
+
+BCACHE_ERROR TieredCache::Promote(const BlockKey& key,
+                                  std::shared_ptr<BlockReader>& reader) {
+  size_t length;
+  std::shared_ptr<char> buffer;
+  auto rc = disk_->ReadBlock(key, buffer, &length);
+  if (rc == BCACHE_ERROR::OK) {
+    rc = mem_->Cache(key, Block(buffer.get(), length));
+  }
+  if (rc == BCACHE_ERROR::OK) {
+    rc = mem_->Load(key, reader);
+  }
+
+  if (rc == BCACHE_ERROR::OK) {
+    mem_metric_->AddPromotion();
+  } else if (rc != BCACHE_ERROR::NOT_SUPPORTED) {
+    LOG(WARNING) << "Promote block " << key.Filename()
+                 << " to memory tier failed: " << StrErr(rc);
+  }
+  return rc;
+}
+
+// Invoked by memory tier when block evicted.
+void TieredCache::Demote(const BlockKey& key, const Block& block) {
+  if (disk_->IsCached(key)) {
+    return;
+  }
+
+  auto rc = disk_->Cache(key, block);
+  if (rc == BCACHE_ERROR::OK) {
+    disk_metric_->AddDemotion();
+  } else {
+    VLOG(3) << "Demote block " << key.Filename()
+            << " to disk tier failed: " << StrErr(rc);
+  }
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
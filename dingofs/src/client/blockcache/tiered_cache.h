@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_TIERED_CACHE_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_TIERED_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dingofs/src/client/blockcache/block_cache_metric.h"
+#include "dingofs/src/client/blockcache/cache_store.h"
+#include "dingofs/src/client/blockcache/disk_cache_group.h"
+#include "dingofs/src/client/blockcache/error.h"
+#include "dingofs/src/client/blockcache/mem_cache.h"
+#include "dingofs/src/client/common/config.h"
+#include "dingofs/src/utils/concurrent/concurrent.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::client::common::DiskCacheOption;
+using ::dingofs::client::common::MemCacheOption;
+using ::dingofs::utils::Mutex;
+using UploadFunc = CacheStore::UploadFunc;
+
+// The two-tier cache store, memory (L1) in front of disk (L2):
+//
+//   cache: put block into memory tier, fallback to disk tier if rejected
+//   load : lookup memory tier first, then disk tier
+//   stage: always go to disk tier, because the memory is not durable
+//
+// The block which hit in disk tier for |kPromoteHits| times will be promoted
+// to memory tier, and the block evicted from memory tier will be demoted
+// to disk tier if it's not there yet.
+class TieredCache : public CacheStore {
+  static constexpr uint32_t kPromoteHits = 2;
+  static constexpr size_t kMaxTrackedBlocks = 65536;
+
+ public:
+  TieredCache(MemCacheOption mem_option,
+              std::vector<DiskCacheOption> disk_options);
+
+  virtual ~TieredCache() = default;
+
+  BCACHE_ERROR Init(UploadFunc uploader) override;
+
+  BCACHE_ERROR Shutdown() override;
+
+  BCACHE_ERROR Stage(const BlockKey& key, const Block& block,
+                     BlockContext ctx) override;
+
+  BCACHE_ERROR RemoveStage(const BlockKey& key, BlockContext ctx) override;
+
+  BCACHE_ERROR Cache(const BlockKey& key, const Block& block) override;
+
+  BCACHE_ERROR Load(const BlockKey& key,
+                    std::shared_ptr<BlockReader>& reader) override;
+
+  bool IsCached(const BlockKey& key) override;
+
+  std::string Id() override { return "tiered_cache"; }
+
+ private:
+  bool NeedPromote(const BlockKey& key);
+
+  BCACHE_ERROR Promote(const BlockKey& key,
+                       std::shared_ptr<BlockReader>& reader);
+
+  void Demote(const BlockKey& key, const Block& block);
+
+ private:
+  std::shared_ptr<MemCache> mem_;
+  std::shared_ptr<DiskCacheGroup> disk_;
+  Mutex mutex_;
+  std::unordered_map<std::string, uint32_t> disk_hits_;
+  std::unique_ptr<BlockCacheTierMetric> mem_metric_;
+  std::unique_ptr<BlockCacheTierMetric> disk_metric_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_TIERED_CACHE_H_
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include "dingofs/src/client/blockcache/tiny_lfu.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+CountMinSketch::CountMinSketch(size_t width) : width_(1), additions_(0) {
+  while (width_ < width) {
+    width_ <<= 1;
+  }
+  sample_size_ = width_ * 10;
+  table_.resize(width_ * kDepth, 0);
+}
+
+void CountMinSketch::Increment(uint64_t hash) {
+  for (int row = 0; row < kDepth; row++) {
+    auto& counter = table_[Index(hash, row)];
+    if (counter < kMaxCount) {
+      counter++;
+    }
+  }
+
+  if (++additions_ >= sample_size_) {
+    Reset();
+  }
+}
+
+uint8_t CountMinSketch::Estimate(uint64_t hash) const {
+  uint8_t count = kMaxCount;
+  for (int row = 0; row < kDepth; row++) {
+    count = std::min(count, table_[Index(hash, row)]);
+  }
+  return count;
+}
+
+// double hashing: h1 + row * h2
+size_t CountMinSketch::Index(uint64_t hash, int row) const {
+  uint64_t h1 = hash;
+  uint64_t h2 = (hash >> 32) | 1;
+  return row * width_ + ((h1 + row * h2) & (width_ - 1));
+}
+
+void CountMinSketch::Reset() {
+  for (auto& counter : table_) {
+    counter >>= 1;
+  }
+  additions_ /= 2;
+}
+
+TinyLFUCache::TinyLFUCache(size_t sketch_width)
+    : sketch_(sketch_width), lru_(std::make_unique<LRUCache>()) {}
+
+void TinyLFUCache::Add(const CacheKey& key, const CacheValue& value) {
+  lru_->Add(key, value);
+}
+
+bool TinyLFUCache::Get(const CacheKey& key, CacheValue* value) {
+  sketch_.Increment(Hash(key));
+  return lru_->Get(key, value);
+}
+
+bool TinyLFUCache::Delete(const CacheKey& key, CacheValue* deleted) {
+  return lru_->Delete(key, deleted);
+}
+
+CacheItems TinyLFUCache::Evict(FilterFunc filter) {
+  return lru_->Evict(filter);
+}
+
+void TinyLFUCache::Walk(WalkFunc func) { lru_->Walk(func); }
+
+size_t TinyLFUCache::Size() { return lru_->Size(); }
+
+void TinyLFUCache::Clear() { lru_->Clear(); }
+
+bool TinyLFUCache::Admit(const CacheKey& key) {
+  CacheKey victim;
+  if (!lru_->Peek(&victim)) {
+    return true;
+  }
+  return sketch_.Estimate(Hash(key)) > sketch_.Estimate(Hash(victim));
+}
+
+uint64_t TinyLFUCache::Hash(const CacheKey& key) {
+  return std::hash<std::string>{}(key.Filename());
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
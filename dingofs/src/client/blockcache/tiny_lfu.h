@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_TINY_LFU_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_TINY_LFU_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dingofs/src/client/blockcache/eviction_policy.h"
+#include "dingofs/src/client/blockcache/lru_cache.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+// The count-min sketch with 4-bit (saturated at 15) counters, it estimates
+// the access frequency of keys in a compact space. All counters are halved
+// after |sample_size| increments, so the history will fade out.
+class CountMinSketch {
+  static constexpr int kDepth = 4;
+  static constexpr uint8_t kMaxCount = 15;
+
+ public:
+  // |width| is the number of counters per row, rounded up to power of 2.
+  explicit CountMinSketch(size_t width);
+
+  void Increment(uint64_t hash);
+
+  uint8_t Estimate(uint64_t hash) const;
+
+ private:
+  size_t Index(uint64_t hash, int row) const;
+
+  void Reset();
+
+ private:
+  size_t width_;
+  size_t additions_;
+  size_t sample_size_;
+  std::vector<uint8_t> table_;  // kDepth rows
+};
+
+// TinyLFU admission in front of the LRU policy:
+//
+//   every lookup (hit or miss) is recorded in the sketch, and when the cache
+//   is full, the new block is admitted only if it's accessed more frequently
+//   than the victim which would be evicted for it.
+//
+// So the blocks which accessed only once (e.g. full-dataset scan, warmup)
+// can't flush the hot working set out of the cache.
+class TinyLFUCache : public EvictionPolicy {
+  static constexpr size_t kSketchWidth = 65536;
+
+ public:
+  explicit TinyLFUCache(size_t sketch_width = kSketchWidth);
+
+  ~TinyLFUCache() override = default;
+
+  void Add(const CacheKey& key, const CacheValue& value) override;
+
+  bool Get(const CacheKey& key, CacheValue* value) override;
+
+  bool Delete(const CacheKey& key, CacheValue* deleted) override;
+
+  CacheItems Evict(FilterFunc filter) override;
+
+  void Walk(WalkFunc func) override;
+
+  size_t Size() override;
+
+  void Clear() override;
+
+  bool Admit(const CacheKey& key) override;
+
+  std::string Name() const override { return kTinyLFUPolicy; }
+
+ private:
+  static uint64_t Hash(const CacheKey& key);
+
+ private:
+  CountMinSketch sketch_;
+  std::unique_ptr<LRUCache> lru_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_TINY_LFU_H_
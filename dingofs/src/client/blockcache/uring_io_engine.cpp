@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#ifdef WITH_LIBURING
+
+#include "dingofs/src/client/blockcache/uring_io_engine.h"
+
+#include <errno.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <utility>
+#include <thread>
+
+#include "dingofs/src/client/blockcache/local_filesystem.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+UringIOEngine::UringIOEngine(uint32_t num_rings, uint32_t queue_depth,
+                             size_t segment_size)
+    : num_rings_(num_rings),
+      queue_depth_(queue_depth),
+      segment_size_(segment_size),
+      running_(false) {
+  CHECK(num_rings_ > 0 && queue_depth_ > 0);
+  CHECK(IsAligned(segment_size_));
+}
+
+UringIOEngine::~UringIOEngine() { Shutdown(); }
+
+bool UringIOEngine::Init() {
+  if (running_.exchange(true)) {
+    return true;  // already running
+  }
+
+  for (uint32_t i = 0; i < num_rings_; i++) {
+    auto ring = std::make_unique<Ring>();
+    if (!InitRing(ring.get())) {
+      Shutdown();
+      return false;
+    }
+    rings_.emplace_back(std::move(ring));
+  }
+
+  LOG(INFO) << "Init io_uring engine success: num_rings=" << num_rings_
+            << ", queue_depth=" << queue_depth_
+            << ", segment_size=" << segment_size_;
+  return true;
+}
+
+void UringIOEngine::Shutdown() {
+  if (!running_.exchange(false)) {
+    return;
+  }
+
+  for (auto& ring : rings_) {
+    DestroyRing(ring.get());
+  }
+  rings_.clear();
+}
+
+int UringIOEngine::PWrite(int fd, const char* buffer, size_t length,
+                          off_t offset, bool direct) {
+  auto* ring = PickRing();
+  if (IsBroken(ring)) {
+    return FallbackPWrite(fd, buffer, length, offset, direct);
+  }
+
+  // Direct IO requires aligned memory, we copy the data into registered
+  // buffers if the caller's buffer is misaligned.
+  Request request;
+  request.fd = fd;
+  request.is_write = true;
+  request.use_fixed =
+      direct && !IsAligned(reinterpret_cast<std::uintptr_t>(buffer));
+  return DoIO(ring, &request, const_cast<char*>(buffer), length, offset);
+}
+
+int UringIOEngine::PRead(int fd, char* buffer, size_t length, off_t offset) {
+  auto* ring = PickRing();
+  if (IsBroken(ring)) {
+    return fallback_.PRead(fd, buffer, length, offset);
+  }
+
+  Request request;
+  request.fd = fd;
+  request.is_write = false;
+  request.use_fixed = false;
+  return DoIO(ring, &request, buffer, length, offset);
+}
+
+bool UringIOEngine::InitRing(Ring* ring) {
+  int rc = io_uring_queue_init(queue_depth_, &ring->ring, 0);
+  if (rc < 0) {
+    LOG(ERROR) << "io_uring_queue_init(" << queue_depth_
+               << ") failed: " << ::strerror(-rc);
+    return false;
+  }
+  ring->ready = true;
+
+  for (uint32_t i = 0; i < queue_depth_; i++) {
+    void* buffer;
+    if (::posix_memalign(&buffer, IO_ALIGNED_BLOCK_SIZE, segment_size_) != 0) {
+      LOG(ERROR) << "Allocate aligned buffer for io_uring failed.";
+      DestroyRing(ring);
+      return false;
+    }
+    ring->buffers.push_back(iovec{buffer, segment_size_});
+    ring->free_slots.push_back(i);
+  }
+
+  rc = io_uring_register_buffers(&ring->ring, ring->buffers.data(),
+                                 ring->buffers.size());
+  if (rc < 0) {
+    LOG(ERROR) << "io_uring_register_buffers() failed: " << ::strerror(-rc);
+    DestroyRing(ring);
+    return false;
+  }
+  return true;
+}
+
+void UringIOEngine::DestroyRing(Ring* ring) {
+  std::unique_lock<std::mutex> lk(ring->mutex);
+  // The kernel may still write to registered buffers or callers' buffers,
+  // the waiting callers reap their completions.
+  ring->cond.wait(lk, [&] {
+    return ring->free_slots.size() == ring->buffers.size() &&
+           ring->inflight == 0;
+  });
+
+  if (ring->ready) {
+    io_uring_queue_exit(&ring->ring);  // unregister buffers implicitly
+    ring->ready = false;
+  }
+  for (auto& iov : ring->buffers) {
+    ::free(iov.iov_base);
+  }
+  ring->buffers.clear();
+  ring->free_slots.clear();
+}
+
+UringIOEngine::Ring* UringIOEngine::PickRing() {
+  static thread_local size_t hash =
+      std::hash<std::thread::id>()(std::this_thread::get_id());
+  return rings_[hash % rings_.size()].get();
+}
+
+bool UringIOEngine::IsBroken(Ring* ring) {
+  std::lock_guard<std::mutex> lk(ring->mutex);
+  return ring->broken;
+}
+
+// Posix engine can't write misaligned buffer with direct IO,
+// so copy it into an aligned buffer first.
+int UringIOEngine::FallbackPWrite(int fd, const char* buffer, size_t length,
+                                  off_t offset, bool direct) {
+  if (!direct || IsAligned(reinterpret_cast<std::uintptr_t>(buffer))) {
+    return fallback_.PWrite(fd, buffer, length, offset, direct);
+  }
+
+  void* aligned;
+  if (::posix_memalign(&aligned, IO_ALIGNED_BLOCK_SIZE, length) != 0) {
+    return ENOMEM;
+  }
+  std::memcpy(aligned, buffer, length);
+  int rc = fallback_.PWrite(fd, static_cast<char*>(aligned), length, offset,
+                            direct);
+  ::free(aligned);
+  return rc;
+}
+
+std::vector<UringIOEngine::Segment> UringIOEngine::Split(Request* request,
+                                                          char* buffer,
+                                                          size_t length,
+                                                          off_t offset) const {
+  std::vector<Segment> segments;
+  while (length > 0) {
+    size_t n = std::min(length, segment_size_);
+    segments.push_back(Segment{request, buffer, n, offset, -1});
+    buffer += n;
+    length -= n;
+    offset += n;
+  }
+  return segments;
+}
+
+int UringIOEngine::DoIO(Ring* ring, Request* request, char* buffer,
+                        size_t length, off_t offset) {
+  auto segments = Split(request, buffer, length, offset);
+
+  size_t submitted = 0;
+  std::unique_lock<std::mutex> lk(ring->mutex);
+  for (auto& segment : segments) {
+    while (ring->free_slots.empty() && !ring->broken) {
+      WaitOrReap(ring, &lk);
+    }
+    if (ring->broken || request->error != 0) {
+      break;
+    }
+
+    segment.slot = ring->free_slots.back();
+    ring->free_slots.pop_back();
+    request->inflight++;
+    if (request->use_fixed) {  // the slot is owned by us
+      char* fixed = static_cast<char*>(ring->buffers[segment.slot].iov_base);
+      lk.unlock();
+      std::memcpy(fixed, segment.buffer, segment.length);
+      lk.lock();
+      segment.buffer = fixed;
+    }
+    Submit(ring, &segment);
+    submitted++;
+  }
+
+  while (request->inflight > 0) {
+    WaitOrReap(ring, &lk);
+  }
+  if (request->error == 0 && submitted < segments.size()) {
+    request->error = EIO;  // the ring is broken
+  }
+  return request->error;
+}
+
+// protect by ring mutex
+void UringIOEngine::Submit(Ring* ring, Segment* segment) {
+  if (ring->broken) {
+    Done(ring, segment, EIO);
+    return;
+  }
+
+  auto* sqe = io_uring_get_sqe(&ring->ring);
+  CHECK(sqe != nullptr);  // in-flight segments never exceed the queue depth
+  PrepareSqe(sqe, segment);
+
+  int rc;
+  do {
+    rc = io_uring_submit(&ring->ring);
+  } while (rc == -EINTR);
+
+  if (rc < 0) {  // the sqe is not consumed by kernel
+    LOG(ERROR) << "io_uring_submit() failed: " << ::strerror(-rc)
+               << ", fallback to posix io engine.";
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    ring->broken = true;
+    Done(ring, segment, -rc);
+    ring->cond.notify_all();
+    return;
+  }
+
+  if (ring->inflight++ == 0) {
+    ring->cond.notify_all();  // someone can reap now
+  }
+}
+
+// protect by ring mutex
+void UringIOEngine::Complete(Ring* ring, Segment* segment, int res) {
+  if (res == -EINTR || res == -EAGAIN) {
+    Submit(ring, segment);  // retry
+  } else if (res < 0) {
+    Done(ring, segment, -res);
+  } else if (res == 0) {
+    // read: end of file, write: should never happen
+    Done(ring, segment, segment->request->is_write ? EIO : 0);
+  } else if (static_cast<size_t>(res) < segment->length) {  // short IO
+    segment->buffer += res;
+    segment->length -= res;
+    segment->offset += res;
+    Submit(ring, segment);
+  } else {
+    Done(ring, segment, 0);
+  }
+}
+
+// protect by ring mutex
+void UringIOEngine::Done(Ring* ring, Segment* segment, int error) {
+  auto* request = segment->request;
+  if (error != 0 && request->error == 0) {
+    request->error = error;
+  }
+  request->inflight--;
+  ring->free_slots.push_back(segment->slot);
+}
+
+// protect by ring mutex
+void UringIOEngine::WaitOrReap(Ring* ring, std::unique_lock<std::mutex>* lk) {
+  if (ring->reaping || ring->inflight == 0) {
+    ring->cond.wait(*lk);
+    return;
+  }
+
+  ring->reaping = true;
+  lk->unlock();
+
+  std::vector<std::pair<Segment*, int>> completions;
+  struct io_uring_cqe* cqe;
+  int rc = io_uring_wait_cqe(&ring->ring, &cqe);
+  if (rc == 0) {
+    unsigned head;
+    unsigned count = 0;
+    io_uring_for_each_cqe(&ring->ring, head, cqe) {
+      completions.emplace_back(
+          static_cast<Segment*>(io_uring_cqe_get_data(cqe)), cqe->res);
+      count++;
+    }
+    io_uring_cq_advance(&ring->ring, count);
+  } else if (rc != -EINTR) {
+    LOG(ERROR) << "io_uring_wait_cqe() failed: " << ::strerror(-rc);
+  }
+
+  lk->lock();
+  ring->reaping = false;
+  for (const auto& completion : completions) {
+    if (completion.first != nullptr) {
+      ring->inflight--;
+      Complete(ring, completion.first, completion.second);
+    }
+  }
+  ring->cond.notify_all();
+}
+
+void UringIOEngine::PrepareSqe(struct io_uring_sqe* sqe, Segment* segment) {
+  int fd = segment->request->fd;
+  if (segment->request->is_write && segment->request->use_fixed) {
+    io_uring_prep_write_fixed(sqe, fd, segment->buffer, segment->length,
+                              segment->offset, segment->slot);
+  } else if (segment->request->is_write) {
+    io_uring_prep_write(sqe, fd, segment->buffer, segment->length,
+                        segment->offset);
+  } else {
+    io_uring_prep_read(sqe, fd, segment->buffer, segment->length,
+                       segment->offset);
+  }
+  io_uring_sqe_set_data(sqe, segment);
+}
+
+bool UringIOEngine::IsAligned(uint64_t n) {
+  return n % IO_ALIGNED_BLOCK_SIZE == 0;
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // WITH_LIBURING
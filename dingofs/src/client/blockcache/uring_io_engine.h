@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_URING_IO_ENGINE_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_URING_IO_ENGINE_H_
+
+#ifdef WITH_LIBURING
+
+#include <liburing.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dingofs/src/client/blockcache/io_engine.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+// How it works:
+//   1. one request is split into segments, each segment holds one of the
+//      |queue_depth| slots of a ring while it's in flight;
+//   2. each slot owns a registered aligned buffer, which is used as bounce
+//      buffer to write misaligned data with direct IO;
+//   3. the ring mutex only protects preparing and submitting SQEs, waiters
+//      take turns to reap completions for all requests on the ring;
+//   4. caller threads are spread among rings to reduce lock contention;
+//   5. a ring which fails to submit is never used again, requests on it
+//      are served by posix engine.
+class UringIOEngine : public IOEngine {
+  struct Request;
+
+  struct Segment {
+    Request* request;
+    char* buffer;
+    size_t length;
+    off_t offset;
+    int slot;  // index of registered buffer, -1 means no slot
+  };
+
+  // One PWrite/PRead call, protect by ring mutex.
+  struct Request {
+    int fd;
+    bool is_write;
+    bool use_fixed;
+    uint32_t inflight = 0;  // segments which are not done
+    int error = 0;
+  };
+
+  struct Ring {
+    std::mutex mutex;
+    std::condition_variable cond;  // slot freed or reaping finished
+    struct io_uring ring;
+    std::vector<struct iovec> buffers;  // registered buffers
+    std::vector<int> free_slots;
+    uint32_t inflight = 0;  // submitted but not reaped
+    bool reaping = false;   // some thread is waiting for completions
+    bool ready = false;     // false means the ring is destroyed
+    bool broken = false;    // true means serve requests by posix engine
+  };
+
+ public:
+  UringIOEngine(uint32_t num_rings = 4, uint32_t queue_depth = 32,
+                size_t segment_size = 256 * 1024);
+
+  ~UringIOEngine() override;
+
+  bool Init() override;
+
+  void Shutdown() override;
+
+  int PWrite(int fd, const char* buffer, size_t length, off_t offset,
+             bool direct) override;
+
+  int PRead(int fd, char* buffer, size_t length, off_t offset) override;
+
+  bool SupportMisalignedDirect() const override { return true; }
+
+  std::string Name() const override { return kUringIOEngine; }
+
+ private:
+  bool InitRing(Ring* ring);
+
+  // Wait all in-flight segments completed, then destroy the ring.
+  void DestroyRing(Ring* ring);
+
+  Ring* PickRing();
+
+  bool IsBroken(Ring* ring);
+
+  int FallbackPWrite(int fd, const char* buffer, size_t length, off_t offset,
+                     bool direct);
+
+  std::vector<Segment> Split(Request* request, char* buffer, size_t length,
+                             off_t offset) const;
+
+  // Submit all segments of the request and wait them completed.
+  int DoIO(Ring* ring, Request* request, char* buffer, size_t length,
+           off_t offset);
+
+  void Submit(Ring* ring, Segment* segment);
+
+  void Complete(Ring* ring, Segment* segment, int res);
+
+  void Done(Ring* ring, Segment* segment, int error);
+
+  // Reap completions if no other thread is reaping, otherwise wait for it.
+  void WaitOrReap(Ring* ring, std::unique_lock<std::mutex>* lk);
+
+  static void PrepareSqe(struct io_uring_sqe* sqe, Segment* segment);
+
+  static bool IsAligned(uint64_t n);
+
+ private:
+  const uint32_t num_rings_;
+  const uint32_t queue_depth_;
+  const size_t segment_size_;
+  std::atomic<bool> running_;
+  std::vector<std::unique_ptr<Ring>> rings_;
+  PosixIOEngine fallback_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // WITH_LIBURING
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_URING_IO_ENGINE_H_
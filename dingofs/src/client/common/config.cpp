@@ -53,6 +53,7 @@ namespace common {
 
 using dingofs::aws::S3InfoOption;
 using ::dingofs::base::filepath::PathJoin;
+using ::dingofs::base::math::kKiB;
 using ::dingofs::base::math::kMiB;
 using ::dingofs::base::string::Str2Int;
 using dingofs::utils::Configuration;
@@ -120,6 +121,10 @@ void InitMetaCacheOption(Configuration* conf, MetaCacheOpt* opts) {
                             &opts->metacacheRPCRetryIntervalUS);
   conf->GetValueFatalIfFail("metaCacheOpt.metacacheGetLeaderRPCTimeOutMS",
                             &opts->metacacheGetLeaderRPCTimeOutMS);
+  LOG_IF(WARNING,
+         !conf->GetBoolValue("metaCacheOpt.followerRead", &opts->followerRead))
+      << "Not found `metaCacheOpt.followerRead` in conf, use default value `"
+      << std::boolalpha << opts->followerRead << '`';
 }
 
 void InitExcutorOption(Configuration* conf, ExcutorOpt* opts, bool internal) {
@@ -161,6 +166,10 @@ void InitS3Option(Configuration* conf, S3Option* s3Opt) {
                             &s3Opt->s3ClientAdaptorOpt.prefetchBlocks);
   conf->GetValueFatalIfFail("s3.prefetchExecQueueNum",
                             &s3Opt->s3ClientAdaptorOpt.prefetchExecQueueNum);
+  conf->GetValueFatalIfFail("s3.readaheadMaxBlocks",
+                            &FLAGS_s3_readahead_max_blocks);
+  conf->GetValueFatalIfFail("s3.readaheadMaxMemoryMB",
+                            &FLAGS_s3_readahead_max_memory_mb);
   conf->GetValueFatalIfFail("data_stream.background_flush.interval_ms",
                             &s3Opt->s3ClientAdaptorOpt.intervalMs);
   conf->GetValueFatalIfFail("data_stream.slice.stay_in_memory_max_second",
@@ -255,6 +264,14 @@ void InitFileSystemOption(Configuration* c, FileSystemOption* option) {
     c->GetValueFatalIfFail("fs.lookupCache.negativeTimeoutSec",
                            &o->negativeTimeoutSec);
     c->GetValueFatalIfFail("fs.lookupCache.minUses", &o->minUses);
+    c->GetValueFatalIfFail("fs.lookupCache.positiveTimeoutSec",
+                           &o->positiveTimeoutSec);
+  }
+  {  // attr cache option, expired as same as kernel
+    auto o = &option->attrCacheOption;
+    c->GetValueFatalIfFail("fs.attrCache.lruSize", &o->lruSize);
+    o->attrTimeoutSec = option->kernelCacheOption.attrTimeoutSec;
+    o->dirAttrTimeoutSec = option->kernelCacheOption.dirAttrTimeoutSec;
   }
   {  // dir cache option
     auto o = &option->dirCacheOption;
@@ -287,6 +304,8 @@ void InitDataStreamOption(Configuration* c, DataStreamOption* option) {
     c->GetValueFatalIfFail("data_stream.file.flush_workers", &o->flush_workers);
     c->GetValueFatalIfFail("data_stream.file.flush_queue_size",
                            &o->flush_queue_size);
+    c->GetValueFatalIfFail("data_stream.file.flush_inflight_blocks",
+                           &o->flush_inflight_blocks);
   }
   {  // chunk option
     auto* o = &option->chunk_option;
@@ -307,6 +326,7 @@ void InitDataStreamOption(Configuration* c, DataStreamOption* option) {
     c->GetValueFatalIfFail("data_stream.page.size", &o->page_size);
     c->GetValueFatalIfFail("data_stream.page.total_size_mb", &o->total_size);
     c->GetValueFatalIfFail("data_stream.page.use_pool", &o->use_pool);
+    c->GetValueFatalIfFail("data_stream.page.numa_aware", &o->numa_aware);
 
     if (o->page_size == 0) {
       CHECK(false) << "Page size must greater than 0.";
@@ -358,17 +378,31 @@ void InitBlockCacheOption(Configuration* c, BlockCacheOption* option) {
                            &FLAGS_block_cache_stage_bandwidth_throttle_enable);
     c->GetValueFatalIfFail("block_cache.stage_bandwidth_throttle_mb",
                            &FLAGS_block_cache_stage_bandwidth_throttle_mb);
+    c->GetValueFatalIfFail("block_cache.upload_max_delay_ms",
+                           &FLAGS_block_cache_upload_max_delay_ms);
     c->GetValueFatalIfFail("block_cache.logging", &FLAGS_block_cache_logging);
     c->GetValueFatalIfFail("block_cache.upload_stage_workers",
                            &option->upload_stage_workers);
     c->GetValueFatalIfFail("block_cache.upload_stage_queue_size",
                            &option->upload_stage_queue_size);
+    uint64_t pack_kb;
+    c->GetValueFatalIfFail("block_cache.upload_stage_pack_kb", &pack_kb);
+    option->upload_stage_pack_size = pack_kb * kKiB;
     c->GetValueFatalIfFail("block_cache.cache_store", &option->cache_store);
-    if (option->cache_store != "none" && option->cache_store != "disk") {
-      CHECK(false) << "Only support disk or none cache store.";
+    if (option->cache_store != "none" && option->cache_store != "disk" &&
+        option->cache_store != "memory" && option->cache_store != "tiered") {
+      CHECK(false) << "Only support disk, memory, tiered or none cache store.";
     }
   }
 
+  {  // memory cache option
+    uint64_t cache_size_mb;
+    c->GetValueFatalIfFail("mem_cache.cache_size_mb", &cache_size_mb);
+    bool enable = option->cache_store == "memory" ||
+                  option->cache_store == "tiered";
+    option->mem_cache_option.cache_size = enable ? cache_size_mb * kMiB : 0;
+  }
+
   {  // disk cache option
     DiskCacheOption o;
     c->GetValueFatalIfFail("disk_cache.cache_dir", &o.cache_dir);
@@ -382,7 +416,17 @@ void InitBlockCacheOption(Configuration* c, BlockCacheOption* option) {
         &FLAGS_disk_cache_cleanup_expire_interval_millsecond);
     c->GetValueFatalIfFail("disk_cache.drop_page_cache",
                            &FLAGS_drop_page_cache);
-    if (option->cache_store == "disk") {
+    // unknown io engine fallback to posix, see NewIOEngine()
+    c->GetValueFatalIfFail("disk_cache.io_engine", &o.io_engine);
+    c->GetValueFatalIfFail("disk_cache.fd_cache_capacity",
+                           &o.fd_cache_capacity);
+    c->GetValueFatalIfFail("disk_cache.eviction_policy", &o.eviction_policy);
+    if (o.eviction_policy != "lru" && o.eviction_policy != "tinylfu") {
+      CHECK(false) << "Only support lru or tinylfu eviction policy.";
+    }
+    c->GetValueFatalIfFail("disk_cache.index_shards", &o.index_shards);
+    c->GetValueFatalIfFail("disk_cache.enable_index", &o.enable_index);
+    if (option->cache_store == "disk" || option->cache_store == "tiered") {
       SplitDiskCacheOption(o, &option->disk_cache_options);
     }
   }
@@ -441,6 +485,8 @@ void InitFuseClientOption(Configuration* conf, FuseClientOption* clientOption) {
                                      &clientOption->enableFuseSplice))
       << "Not found `fuseClient.enableSplice` in conf, use default value `"
       << std::boolalpha << clientOption->enableFuseSplice << '`';
+  conf->GetValueFatalIfFail("fuseClient.enableZeroCopyRead",
+                            &FLAGS_fuse_read_zero_copy);
 
   conf->GetValueFatalIfFail("fuseClient.throttle.avgWriteBytes",
                             &FLAGS_fuseClientAvgWriteBytes);
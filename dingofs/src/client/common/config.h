@@ -122,6 +122,13 @@ struct LookupCacheOption {
   uint64_t lruSize;
   uint32_t negativeTimeoutSec;
   uint32_t minUses;
+  uint32_t positiveTimeoutSec;
+};
+
+struct AttrCacheOption {
+  uint64_t lruSize;  // 0 means disable
+  uint32_t attrTimeoutSec;
+  uint32_t dirAttrTimeoutSec;
 };
 
 struct DirCacheOption {
@@ -155,6 +162,7 @@ struct FileSystemOption {
   uint32_t blockSize = 0x10000u;
   KernelCacheOption kernelCacheOption;
   LookupCacheOption lookupCacheOption;
+  AttrCacheOption attrCacheOption;
   DirCacheOption dirCacheOption;
   OpenFilesOption openFilesOption;
   AttrWatcherOption attrWatcherOption;
@@ -171,6 +179,7 @@ struct BackgroundFlushOption {
 struct FileOption {
   uint64_t flush_workers;
   uint64_t flush_queue_size;
+  uint32_t flush_inflight_blocks;  // per file, 0 means not limited
 };
 
 struct SliceOption {
@@ -187,6 +196,7 @@ struct PageOption {
   uint64_t page_size;
   uint64_t total_size;
   bool use_pool;
+  bool numa_aware;  // split the pool to NUMA nodes
 };
 
 struct DataStreamOption {
@@ -202,7 +212,16 @@ struct DataStreamOption {
 struct DiskCacheOption {
   uint32_t index;
   std::string cache_dir;
-  uint64_t cache_size;  // bytes
+  uint64_t cache_size;          // bytes
+  std::string io_engine;        // posix or io_uring
+  uint64_t fd_cache_capacity;   // max cached fds, 0 means disable
+  std::string eviction_policy;  // lru or tinylfu
+  uint32_t index_shards;        // shards of cache index
+  bool enable_index;            // persist cache index for fast reload
+};
+
+struct MemCacheOption {
+  uint64_t cache_size;  // bytes, 0 means disable
 };
 
 struct BlockCacheOption {
@@ -216,6 +235,8 @@ struct BlockCacheOption {
   uint32_t flush_slice_queue_size;
   uint64_t upload_stage_workers;
   uint64_t upload_stage_queue_size;
+  uint64_t upload_stage_pack_size;  // bytes, 0 means disable pack
+  MemCacheOption mem_cache_option;
   std::vector<DiskCacheOption> disk_cache_options;
 };
 // }
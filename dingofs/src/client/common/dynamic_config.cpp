@@ -43,10 +43,14 @@ DEFINE_bool(block_cache_stage_bandwidth_throttle_enable, false,
             "enable block cache stage bandwidth throttle");
 DEFINE_uint64(block_cache_stage_bandwidth_throttle_mb, 102400,
               "block cache stage bandwidth throttle");
+DEFINE_uint64(block_cache_upload_max_delay_ms, 30000,
+              "stage block waits longer than it is uploaded first, "
+              "0 means disable");
 
 DEFINE_validator(block_cache_logging, &PassBool);
 DEFINE_validator(block_cache_stage_bandwidth_throttle_enable, &PassBool);
 DEFINE_validator(block_cache_stage_bandwidth_throttle_mb, &PassUint64);
+DEFINE_validator(block_cache_upload_max_delay_ms, &PassUint64);
 
 // disk cache
 DEFINE_bool(drop_page_cache, true, "drop page cache for disk cache");
@@ -106,6 +110,19 @@ DEFINE_validator(load_quota_interval_second, &PassUint32);
 DEFINE_uint32(fuse_read_max_retry_s3_not_exist, 60,
               "fuse read max retry when s3 object not exist");
 DEFINE_validator(fuse_read_max_retry_s3_not_exist, &PassUint32);
+// reply read with the cached block buffers (fd or memory) directly,
+// which can be spliced to fuse device without copy
+DEFINE_bool(fuse_read_zero_copy, true,
+            "reply fuse read from block cache buffers without copy");
+DEFINE_validator(fuse_read_zero_copy, &PassBool);
+
+// s3 readahead
+DEFINE_uint32(s3_readahead_max_blocks, 32,
+              "max blocks of readahead window for sequential read");
+DEFINE_uint64(s3_readahead_max_memory_mb, 512,
+              "max memory for readahead blocks when disk cache is disabled");
+DEFINE_validator(s3_readahead_max_blocks, &PassUint32);
+DEFINE_validator(s3_readahead_max_memory_mb, &PassUint64);
 
 }  // namespace common
 }  // namespace client
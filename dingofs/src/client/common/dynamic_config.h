@@ -41,6 +41,7 @@ namespace common {
 DECLARE_bool(block_cache_logging);
 DECLARE_bool(block_cache_stage_bandwidth_throttle_enable);
 DECLARE_uint64(block_cache_stage_bandwidth_throttle_mb);
+DECLARE_uint64(block_cache_upload_max_delay_ms);
 
 // disk cache
 DECLARE_bool(drop_page_cache);
@@ -68,6 +69,11 @@ DECLARE_uint32(load_quota_interval_second);
 
 // fuse client
 DECLARE_uint32(fuse_read_max_retry_s3_not_exist);
+DECLARE_bool(fuse_read_zero_copy);
+
+// s3 readahead
+DECLARE_uint32(s3_readahead_max_blocks);
+DECLARE_uint64(s3_readahead_max_memory_mb);
 
 }  // namespace common
 }  // namespace client
@@ -81,7 +81,7 @@ bool DataStream::Init(DataStreamOption option) {
   {
     auto o = option.page_option;
     if (o.use_pool) {
-      page_allocator_ = std::make_shared<PagePool>();
+      page_allocator_ = std::make_shared<PagePool>(o.numa_aware);
     } else {
       page_allocator_ = std::make_shared<DefaultPageAllocator>();
     }
@@ -127,13 +127,14 @@ char* DataStream::NewPage() { return page_allocator_->Allocate(); }
 void DataStream::FreePage(char* page) { page_allocator_->DeAllocate(page); }
 
 bool DataStream::MemoryNearFull() {
-  double trigger_force_memory_ratio =
-      option_.background_flush_option.trigger_force_memory_ratio;
+  return MemoryUsedRatio() >= TriggerForceMemoryRatio();
+}
+
+double DataStream::MemoryUsedRatio() {
   uint64_t page_size = option_.page_option.page_size;
   uint64_t total_size = option_.page_option.total_size;
-  bool is_full = page_allocator_->GetFreePages() * page_size <=
-                 total_size * (1.0 - trigger_force_memory_ratio);
-  return is_full;
+  uint64_t free_size = page_allocator_->GetFreePages() * page_size;
+  return 1.0 - static_cast<double>(free_size) / total_size;
 }
 
 }  // namespace datastream
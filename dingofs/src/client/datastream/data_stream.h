@@ -65,6 +65,19 @@ class DataStream {
 
   bool MemoryNearFull();
 
+  // The ratio of pages in use, 0 ~ 1.
+  double MemoryUsedRatio();
+
+  // The MemoryNearFull() is true once the used ratio reach it.
+  double TriggerForceMemoryRatio() const {
+    return option_.background_flush_option.trigger_force_memory_ratio;
+  }
+
+  // The max inflight block uploads of one file, 0 means not limited.
+  uint32_t FlushInflightBlocks() const {
+    return option_.file_option.flush_inflight_blocks;
+  }
+
  private:
   std::shared_ptr<TaskThreadPool<>> flush_file_thread_pool_;
   std::shared_ptr<TaskThreadPool<>> flush_chunk_thread_pool_;
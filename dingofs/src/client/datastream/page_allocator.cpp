@@ -22,8 +22,20 @@
 
 #include "dingofs/src/client/datastream/page_allocator.h"
 
+#include <glog/logging.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
 
 namespace dingofs {
 namespace client {
@@ -62,41 +74,345 @@ uint64_t DefaultPageAllocator::GetFreePages() {
   return num_free_pages_;
 }
 
-PagePool::PagePool()
-    : page_size_(0),
+PageStack::PageStack(char* base, uint64_t page_size, uint64_t num_pages)
+    : base_(base),
+      page_size_(page_size),
+      num_pages_(num_pages),
+      head_(kNil) {
+  CHECK(num_pages < kNil) << "too many pages: " << num_pages;
+}
+
+void PageStack::Push(char* page) {
+  uint32_t index = (page - base_) / page_size_;
+  uint64_t head = head_.load(std::memory_order_relaxed);
+  uint64_t new_head;
+  do {
+    __atomic_store_n(reinterpret_cast<uint32_t*>(page),
+                     static_cast<uint32_t>(head), __ATOMIC_RELAXED);
+    new_head = ((head >> 32) + 1) << 32 | index;
+  } while (!head_.compare_exchange_weak(head, new_head,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed));
+}
+
+char* PageStack::Pop() {
+  uint64_t head = head_.load(std::memory_order_acquire);
+  for (;;) {
+    uint32_t index = static_cast<uint32_t>(head);
+    if (index == kNil) {
+      return nullptr;
+    }
+
+    // the page may be popped and reused by others at the same time,
+    // the tag of head will be changed in that case, so CAS will fail.
+    char* page = base_ + index * page_size_;
+    uint32_t next =
+        __atomic_load_n(reinterpret_cast<uint32_t*>(page), __ATOMIC_RELAXED);
+    uint64_t new_head = ((head >> 32) + 1) << 32 | next;
+    if (head_.compare_exchange_weak(head, new_head, std::memory_order_acq_rel,
+                                    std::memory_order_acquire)) {
+      return page;
+    }
+  }
+}
+
+namespace {
+
+// e.g. "0-3,8-11"
+std::vector<int> ParseList(const std::string& list) {
+  std::vector<int> out;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (item.empty()) {
+      continue;
+    }
+    auto pos = item.find('-');
+    int lo = std::stoi(item.substr(0, pos));
+    int hi = (pos == std::string::npos) ? lo : std::stoi(item.substr(pos + 1));
+    for (int i = lo; i <= hi; i++) {
+      out.push_back(i);
+    }
+  }
+  return out;
+}
+
+std::string ReadLine(const std::string& path) {
+  std::ifstream in(path);
+  std::string line;
+  std::getline(in, line);
+  return line;
+}
+
+// Return the cpus of each online NUMA node, or empty if not supported.
+std::vector<std::vector<int>> NumaNodes() {
+  std::vector<std::vector<int>> nodes;
+  auto online = ParseList(ReadLine("/sys/devices/system/node/online"));
+  for (int node : online) {
+    auto cpus = ParseList(ReadLine("/sys/devices/system/node/node" +
+                                   std::to_string(node) + "/cpulist"));
+    if (!cpus.empty()) {
+      nodes.emplace_back(cpus);
+    }
+  }
+  return nodes;
+}
+
+int CurrentCpu() {
+  unsigned cpu = 0;
+  if (syscall(SYS_getcpu, &cpu, nullptr, nullptr) != 0) {
+    return 0;
+  }
+  return static_cast<int>(cpu);
+}
+
+uint32_t ThreadSeq() {
+  static std::atomic<uint32_t> next_seq{0};
+  static thread_local uint32_t seq = next_seq.fetch_add(1);
+  return seq;
+}
+
+}  // namespace
+
+PagePool::PagePool(bool numa_aware)
+    : numa_aware_(numa_aware),
+      page_size_(0),
+      magazine_size_(0),
       num_free_pages_(0),
-      mem_pool_(std::make_unique<MemoryPool>()) {}
+      num_waiters_(0) {}
 
-PagePool::~PagePool() { mem_pool_->DestroyPool(); }
+PagePool::~PagePool() {
+  for (auto& node : nodes_) {
+    node->mem_pool->DestroyPool();
+  }
+}
 
 bool PagePool::Init(uint64_t page_size, uint64_t num_pages) {
   page_size_ = page_size;
-  num_free_pages_ = num_pages;
-  return mem_pool_->CreatePool(page_size, num_pages);
+  if (numa_aware_) {
+    for (auto& cpus : NumaNodes()) {
+      nodes_.emplace_back(std::make_unique<Node>());
+      nodes_.back()->cpus = cpus;
+    }
+    LOG_IF(WARNING, nodes_.size() <= 1)
+        << "NUMA is not available, use one node for page pool.";
+  }
+  if (nodes_.empty()) {
+    nodes_.emplace_back(std::make_unique<Node>());
+  }
+
+  // The pages cached in magazines are stranded for other threads (until
+  // stolen under pressure), so at most 1/4 of pages can be cached.
+  uint32_t num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+  magazine_size_ = std::min<uint64_t>(kMaxMagazineSize,
+                                      num_pages / (4 * num_threads));
+  if (magazine_size_ < 2) {
+    magazine_size_ = 0;
+  }
+
+  uint64_t num_node_pages = num_pages / nodes_.size();
+  for (size_t i = 0; i < nodes_.size(); i++) {
+    uint64_t n = num_node_pages;
+    if (i == 0) {
+      n += num_pages % nodes_.size();
+    }
+    if (!InitNode(nodes_[i].get(), n)) {
+      return false;
+    }
+  }
+
+  num_free_pages_.store(num_pages);
+  LOG(INFO) << "Page pool init success: " << num_pages << " pages in "
+            << nodes_.size() << " node(s), magazine size = " << magazine_size_;
+  return true;
 }
 
-char* PagePool::Allocate() {
-  std::unique_lock<std::mutex> lk(mutex_);
-  while (num_free_pages_ == 0) {
-    can_allocate_.wait(lk);
+bool PagePool::InitNode(Node* node, uint64_t num_pages) {
+  node->mem_pool = std::make_unique<MemoryPool>();
+
+  // The memory is first-touched (placed) when creating the pool, so create
+  // it on the cpus of node.
+  bool ok = false;
+  std::thread thread([&]() {
+    if (!node->cpus.empty()) {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      for (int cpu : node->cpus) {
+        CPU_SET(cpu, &set);
+      }
+      pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+    ok = node->mem_pool->CreatePool(page_size_, num_pages);
+  });
+  thread.join();
+  if (!ok) {
+    return false;
   }
 
-  void* page = mem_pool_->Allocate();
-  assert(page != nullptr);
-  num_free_pages_--;
-  return reinterpret_cast<char*>(page);
+  std::vector<char*> pages;
+  for (uint64_t i = 0; i < num_pages; i++) {
+    pages.emplace_back(reinterpret_cast<char*>(node->mem_pool->Allocate()));
+  }
+  std::sort(pages.begin(), pages.end());
+  node->depot = std::make_unique<PageStack>(
+      pages.empty() ? nullptr : pages.front(), page_size_, num_pages);
+  for (auto iter = pages.rbegin(); iter != pages.rend(); iter++) {
+    node->depot->Push(*iter);
+  }
+
+  size_t num_magazines = std::max(std::thread::hardware_concurrency(), 1U);
+  if (!node->cpus.empty()) {
+    num_magazines = node->cpus.size();
+  }
+  for (size_t i = 0; i < num_magazines; i++) {
+    node->magazines.emplace_back(std::make_unique<Magazine>());
+    node->magazines.back()->pages.resize(magazine_size_);
+  }
+  return true;
+}
+
+char* PagePool::Allocate() {
+  char* page = TryAllocate();
+  if (page == nullptr) {
+    std::unique_lock<std::mutex> lk(mutex_);
+    num_waiters_.fetch_add(1);
+    while ((page = TryAllocate()) == nullptr) {
+      can_allocate_.wait_for(lk, std::chrono::milliseconds(1));
+    }
+    num_waiters_.fetch_sub(1);
+  }
+  num_free_pages_.fetch_sub(1, std::memory_order_relaxed);
+  return page;
 }
 
 void PagePool::DeAllocate(char* page) {
-  std::unique_lock<std::mutex> lk(mutex_);
-  mem_pool_->DeAllocate(reinterpret_cast<void*>(page));
-  num_free_pages_++;
-  can_allocate_.notify_one();
+  num_free_pages_.fetch_add(1, std::memory_order_relaxed);
+
+  // someone is waiting, give it back to depot directly
+  if (magazine_size_ == 0 || num_waiters_.load() > 0) {
+    NodeOf(page)->depot->Push(page);
+    if (num_waiters_.load() > 0) {
+      std::lock_guard<std::mutex> lk(mutex_);
+      can_allocate_.notify_one();
+    }
+    return;
+  }
+
+  auto* magazine = LocalMagazine(LocalNode());
+  magazine->lock.Lock();
+  if (magazine->count == magazine_size_) {
+    Drain(magazine);
+  }
+  magazine->pages[magazine->count++] = page;
+  magazine->lock.UnLock();
 }
 
 uint64_t PagePool::GetFreePages() {
-  std::unique_lock<std::mutex> lk(mutex_);
-  return num_free_pages_;
+  int64_t n = num_free_pages_.load(std::memory_order_relaxed);
+  return n > 0 ? n : 0;
+}
+
+PagePool::Node* PagePool::LocalNode() {
+  if (nodes_.size() == 1) {
+    return nodes_[0].get();
+  }
+
+  // the thread may be migrated, but it's good enough
+  static thread_local int cpu = CurrentCpu();
+  for (auto& node : nodes_) {
+    const auto& cpus = node->cpus;
+    if (std::find(cpus.begin(), cpus.end(), cpu) != cpus.end()) {
+      return node.get();
+    }
+  }
+  return nodes_[0].get();
+}
+
+PagePool::Magazine* PagePool::LocalMagazine(Node* node) {
+  return node->magazines[ThreadSeq() % node->magazines.size()].get();
+}
+
+PagePool::Node* PagePool::NodeOf(const char* page) {
+  for (auto& node : nodes_) {
+    if (node->depot->Contains(page)) {
+      return node.get();
+    }
+  }
+  CHECK(false) << "page not belong to page pool";
+  return nullptr;
+}
+
+char* PagePool::TryAllocate() {
+  auto* node = LocalNode();
+  if (magazine_size_ == 0) {
+    char* page = node->depot->Pop();
+    return page != nullptr ? page : Steal();
+  }
+
+  char* page = nullptr;
+  auto* magazine = LocalMagazine(node);
+  magazine->lock.Lock();
+  if (magazine->count == 0) {
+    Refill(node, magazine);
+  }
+  if (magazine->count > 0) {
+    page = magazine->pages[--magazine->count];
+  }
+  magazine->lock.UnLock();
+  return page != nullptr ? page : Steal();
+}
+
+// Refill half of magazine, prefer the pages of local node.
+void PagePool::Refill(Node* node, Magazine* magazine) {
+  uint32_t batch = magazine_size_ / 2;
+  while (magazine->count < batch) {
+    char* page = node->depot->Pop();
+    if (page == nullptr) {
+      break;
+    }
+    magazine->pages[magazine->count++] = page;
+  }
+
+  for (auto& other : nodes_) {
+    while (magazine->count < batch) {
+      char* page = other->depot->Pop();
+      if (page == nullptr) {
+        break;
+      }
+      magazine->pages[magazine->count++] = page;
+    }
+  }
+}
+
+// Drain half of magazine to the depot which pages belong to.
+void PagePool::Drain(Magazine* magazine) {
+  uint32_t batch = magazine_size_ / 2;
+  while (magazine->count > magazine_size_ - batch) {
+    char* page = magazine->pages[--magazine->count];
+    NodeOf(page)->depot->Push(page);
+  }
+}
+
+// The depots are empty, steal from the magazines of all threads.
+char* PagePool::Steal() {
+  for (auto& node : nodes_) {
+    char* page = node->depot->Pop();
+    if (page != nullptr) {
+      return page;
+    }
+
+    for (auto& magazine : node->magazines) {
+      magazine->lock.Lock();
+      if (magazine->count > 0) {
+        page = magazine->pages[--magazine->count];
+      }
+      magazine->lock.UnLock();
+      if (page != nullptr) {
+        return page;
+      }
+    }
+  }
+  return nullptr;
 }
 
 }  // namespace datastream
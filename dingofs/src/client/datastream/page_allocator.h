@@ -25,10 +25,15 @@
 
 #include <sys/types.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "dingofs/src/client/datastream/memory_pool.h"
+#include "dingofs/src/utils/concurrent/spinlock.h"
 
 namespace dingofs {
 namespace client {
@@ -66,9 +71,62 @@ class DefaultPageAllocator : public PageAllocator {
   std::condition_variable can_allocate_;
 };
 
+// Lock-free stack (Treiber stack) of the free pages in one memory region,
+// the free pages are linked by the index which stored in the first bytes
+// of page, and the head is tagged to avoid ABA problem.
+class PageStack {
+  static constexpr uint32_t kNil = UINT32_MAX;
+
+ public:
+  PageStack(char* base, uint64_t page_size, uint64_t num_pages);
+
+  void Push(char* page);
+
+  char* Pop();
+
+  bool Contains(const char* page) const {
+    return page >= base_ && page < base_ + page_size_ * num_pages_;
+  }
+
+ private:
+  char* base_;
+  uint64_t page_size_;
+  uint64_t num_pages_;
+  std::atomic<uint64_t> head_;  // tag(32 bits) | index(32 bits)
+};
+
+// The page pool with thread local caches:
+//
+//   thread ─> magazine ─(refill/drain in batch)─> depot (lock-free stack)
+//
+// Every thread is bound to a magazine which caches some free pages, most
+// of allocations are served by it without touching shared state, the
+// magazine is refilled from or drained to the global depot in batch.
+// The magazine is protected by spin lock which only contended when
+// threads share the same magazine or the pages are stolen under memory
+// pressure.
+//
+// With |numa_aware|, the memory is split to NUMA nodes (first-touched by
+// the thread running on it), each node has its own depot and magazines,
+// the thread prefers the pages of its local node.
 class PagePool : public PageAllocator {
+  struct Magazine {
+    utils::SpinLock lock;
+    uint32_t count{0};
+    std::vector<char*> pages;
+  };
+
+  struct Node {
+    std::vector<int> cpus;
+    std::unique_ptr<MemoryPool> mem_pool;
+    std::unique_ptr<PageStack> depot;
+    std::vector<std::unique_ptr<Magazine>> magazines;
+  };
+
+  static constexpr uint32_t kMaxMagazineSize = 64;
+
  public:
-  PagePool();
+  explicit PagePool(bool numa_aware = false);
 
   virtual ~PagePool();
 
@@ -81,12 +139,31 @@ class PagePool : public PageAllocator {
   uint64_t GetFreePages() override;
 
  private:
+  bool InitNode(Node* node, uint64_t num_pages);
+
+  Node* LocalNode();
+
+  Magazine* LocalMagazine(Node* node);
+
+  Node* NodeOf(const char* page);
+
+  char* TryAllocate();
+
+  void Refill(Node* node, Magazine* magazine);
+
+  void Drain(Magazine* magazine);
+
+  char* Steal();
+
+ private:
+  bool numa_aware_;
   uint64_t page_size_;
-  uint64_t num_free_pages_;
-  // TODO: use multi-slots or thread local to reduce mutex overhead
-  std::mutex mutex_;
+  uint32_t magazine_size_;  // 0 means no thread local cache
+  std::vector<std::unique_ptr<Node>> nodes_;
+  std::atomic<int64_t> num_free_pages_;
+  std::atomic<uint32_t> num_waiters_;
+  std::mutex mutex_;  // only for waiting free page
   std::condition_variable can_allocate_;
-  std::unique_ptr<MemoryPool> mem_pool_;
 };
 
 }  // namespace datastream
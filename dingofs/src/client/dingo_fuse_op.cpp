@@ -47,6 +47,7 @@
 using dingofs::client::DINGOFS_ERROR;
 using dingofs::client::FuseClient;
 using dingofs::client::FuseS3Client;
+using dingofs::client::ReadBuffer;
 using dingofs::client::blockcache::InitBlockCacheLog;
 using dingofs::client::common::FuseClientOption;
 using dingofs::client::filesystem::AccessLogGuard;
@@ -389,6 +390,16 @@ void FuseOpLookup(fuse_req_t req, fuse_ino_t parent, const char* name) {
   return fs->ReplyEntry(req, &entry_out);
 }
 
+void FuseOpForget(fuse_req_t req, fuse_ino_t ino, uint64_t nlookup) {
+  auto* client = Client();
+  auto fs = client->GetFileSystem();
+  AccessLogGuard log(
+      [&]() { return StrFormat("forget (%d,%d): OK", ino, nlookup); });
+
+  fs->Forget(ino, nlookup);
+  return fs->ReplyNone(req);
+}
+
 void FuseOpGetAttr(fuse_req_t req, fuse_ino_t ino, struct fuse_file_info* fi) {
   DINGOFS_ERROR rc;
   AttrOut attr_out;
@@ -582,7 +593,7 @@ void FuseOpRead(fuse_req_t req, fuse_ino_t ino, size_t size, off_t off,
                 struct fuse_file_info* fi) {
   DINGOFS_ERROR rc;
   size_t r_size = 0;
-  std::unique_ptr<char[]> buffer(new char[size]);
+  ReadBuffer buffer(size);
   auto* client = Client();
   auto fs = client->GetFileSystem();
   METRIC_GUARD(Read);
@@ -592,13 +603,45 @@ void FuseOpRead(fuse_req_t req, fuse_ino_t ino, size_t size, off_t off,
   });
 
   ReadThrottleAdd(size);
-  rc = client->FuseOpRead(req, ino, size, off, fi, buffer.get(), &r_size);
+  rc = client->FuseOpRead(req, ino, size, off, fi, &buffer, &r_size);
   if (rc != DINGOFS_ERROR::OK) {
     return fs->ReplyError(req, rc);
   }
-  struct fuse_bufvec bufvec = FUSE_BUFVEC_INIT(r_size);
-  bufvec.buf[0].mem = buffer.get();
-  return fs->ReplyData(req, &bufvec, FUSE_BUF_SPLICE_MOVE);
+
+  const auto& segments = buffer.Segments();
+  if (segments.empty()) {
+    struct fuse_bufvec bufvec = FUSE_BUFVEC_INIT(r_size);
+    bufvec.buf[0].mem = buffer.Data();
+    return fs->ReplyData(req, &bufvec, FUSE_BUF_SPLICE_MOVE);
+  }
+
+  // zero-copy: reply with the cache buffers directly, the file segment
+  // can be spliced to fuse device. NOTE: the pages of cache file must not
+  // be moved (FUSE_BUF_SPLICE_MOVE), they are still in use by page cache.
+  std::vector<char> storage(sizeof(struct fuse_bufvec) +
+                            (segments.size() - 1) * sizeof(struct fuse_buf));
+  auto* bufvec = reinterpret_cast<struct fuse_bufvec*>(storage.data());
+  bufvec->count = segments.size();
+  bufvec->idx = 0;
+  bufvec->off = 0;
+  for (size_t i = 0; i < segments.size(); i++) {
+    const auto& segment = segments[i];
+    auto& buf = bufvec->buf[i];
+    buf.size = segment.length;
+    buf.flags = static_cast<enum fuse_buf_flags>(0);
+    buf.mem = nullptr;
+    buf.fd = -1;
+    buf.pos = 0;
+    if (segment.mem != nullptr) {
+      buf.mem = const_cast<char*>(segment.mem);
+    } else {
+      buf.flags = static_cast<enum fuse_buf_flags>(FUSE_BUF_IS_FD |
+                                                   FUSE_BUF_FD_SEEK);
+      buf.fd = segment.fd;
+      buf.pos = segment.pos;
+    }
+  }
+  return fs->ReplyData(req, bufvec, static_cast<enum fuse_buf_copy_flags>(0));
 }
 
 void FuseOpWrite(fuse_req_t req, fuse_ino_t ino, const char* buf, size_t size,
@@ -621,6 +664,27 @@ void FuseOpWrite(fuse_req_t req, fuse_ino_t ino, const char* buf, size_t size,
   return fs->ReplyWrite(req, &file_out);
 }
 
+void FuseOpWriteBuf(fuse_req_t req, fuse_ino_t ino, struct fuse_bufvec* bufv,
+                    off_t off, struct fuse_file_info* fi) {
+  DINGOFS_ERROR rc;
+  FileOut file_out;
+  size_t size = fuse_buf_size(bufv);
+  auto* client = Client();
+  auto fs = client->GetFileSystem();
+  METRIC_GUARD(Write);
+  AccessLogGuard log([&]() {
+    return StrFormat("write_buf (%d,%d,%d,%d): %s (%d)", ino, size, off,
+                     fi->fh, StrErr(rc), file_out.nwritten);
+  });
+
+  WriteThrottleAdd(size);
+  rc = client->FuseOpWriteBuf(req, ino, bufv, off, fi, &file_out);
+  if (rc != DINGOFS_ERROR::OK) {
+    return fs->ReplyError(req, rc);
+  }
+  return fs->ReplyWrite(req, &file_out);
+}
+
 void FuseOpFlush(fuse_req_t req, fuse_ino_t ino, struct fuse_file_info* fi) {
   DINGOFS_ERROR rc;
   auto* client = Client();
@@ -715,7 +779,8 @@ void FuseOpReadDirPlus(fuse_req_t req, fuse_ino_t ino, size_t size, off_t off,
     return fs->ReplyError(req, rc);
   }
 
-  return fs->ReplyBuffer(req, buffer, r_size);
+  auto handler = fs->FindHandler(fi->fh);
+  return fs->ReplyDirEntryPlus(req, handler->buffer, off, r_size);
 }
 
 void FuseOpReleaseDir(fuse_req_t req, fuse_ino_t ino,
@@ -732,6 +797,42 @@ void FuseOpReleaseDir(fuse_req_t req, fuse_ino_t ino,
   return fs->ReplyError(req, rc);
 }
 
+void FuseOpForgetMulti(fuse_req_t req, size_t count,
+                       struct fuse_forget_data* forgets) {
+  auto* client = Client();
+  auto fs = client->GetFileSystem();
+  AccessLogGuard log(
+      [&]() { return StrFormat("forget_multi (%d): OK", count); });
+
+  for (size_t i = 0; i < count; i++) {
+    fs->Forget(forgets[i].ino, forgets[i].nlookup);
+  }
+  return fs->ReplyNone(req);
+}
+
+void FuseOpCopyFileRange(fuse_req_t req, fuse_ino_t ino_in, off_t off_in,
+                         struct fuse_file_info* fi_in, fuse_ino_t ino_out,
+                         off_t off_out, struct fuse_file_info* fi_out,
+                         size_t len, int flags) {
+  DINGOFS_ERROR rc;
+  FileOut file_out;
+  auto* client = Client();
+  auto fs = client->GetFileSystem();
+  METRIC_GUARD(CopyFileRange);
+  AccessLogGuard log([&]() {
+    return StrFormat("copy_file_range (%d,%d,%d,%d,%d): %s (%d)", ino_in,
+                     off_in, ino_out, off_out, len, StrErr(rc),
+                     file_out.nwritten);
+  });
+
+  rc = client->FuseOpCopyFileRange(req, ino_in, off_in, fi_in, ino_out,
+                                   off_out, fi_out, len, flags, &file_out);
+  if (rc != DINGOFS_ERROR::OK) {
+    return fs->ReplyError(req, rc);
+  }
+  return fs->ReplyWrite(req, &file_out);
+}
+
 void FuseOpStatFs(fuse_req_t req, fuse_ino_t ino) {
   DINGOFS_ERROR rc;
   struct statvfs stbuf;
@@ -27,6 +27,8 @@
 #include <cstdint>
 #include <deque>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "dingofs/src/utils/concurrent/concurrent.h"
 
@@ -37,6 +39,8 @@ struct DirBufferHead {
   bool wasRead;
   size_t size;
   char* p;
+  // end offset and inode id of each entry added by readdirplus
+  std::vector<std::pair<size_t, uint64_t>> plusEntries;
   DirBufferHead() : wasRead(false), size(0), p(nullptr) {}
 };
 
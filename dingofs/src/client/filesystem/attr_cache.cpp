@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include "dingofs/src/client/filesystem/attr_cache.h"
+
+#include <glog/logging.h>
+
+#include "dingofs/src/client/filesystem/utils.h"
+
+namespace dingofs {
+namespace client {
+namespace filesystem {
+
+using base::time::TimeSpec;
+using common::AttrCacheOption;
+using pb::metaserver::InodeAttr;
+
+AttrCache::AttrCache(AttrCacheOption option)
+    : enable_(option.lruSize > 0), option_(option) {
+  // the LRUCache is protected by its own lock, split it into shards
+  // to reduce the lock contention
+  uint64_t capacity = (option.lruSize + kShards - 1) / kShards;
+  for (uint32_t i = 0; i < kShards; i++) {
+    auto shard = std::make_unique<Shard>();
+    shard->version = 0;
+    shard->lru = std::make_shared<LRUType>(capacity);
+    shards_.emplace_back(std::move(shard));
+  }
+
+  if (enable_) {
+    LOG(INFO) << "Using attribute lru cache"
+              << ", attr timeout = " << option.attrTimeoutSec
+              << ", dir attr timeout = " << option.dirAttrTimeoutSec
+              << ", capacity = " << option.lruSize;
+  }
+}
+
+AttrCache::Shard* AttrCache::GetShard(Ino ino) {
+  return shards_[ino % kShards].get();
+}
+
+bool AttrCache::Get(Ino ino, InodeAttr* attr) {
+  if (!enable_) {
+    return false;
+  }
+
+  CacheEntry entry;
+  auto* shard = GetShard(ino);
+  if (!shard->lru->Get(ino, &entry)) {
+    metric_.AddMiss();
+    return false;
+  } else if (entry.expireTime < Now()) {
+    shard->lru->Remove(ino);
+    metric_.AddMiss();
+    return false;
+  }
+
+  *attr = entry.attr;
+  metric_.AddHit();
+  return true;
+}
+
+uint64_t AttrCache::Version(Ino ino) {
+  auto* shard = GetShard(ino);
+  std::lock_guard<std::mutex> lk(shard->mutex);
+  return shard->version;
+}
+
+bool AttrCache::Put(const InodeAttr& attr, uint64_t version) {
+  if (!enable_) {
+    return false;
+  }
+
+  uint32_t timeout =
+      IsDir(attr) ? option_.dirAttrTimeoutSec : option_.attrTimeoutSec;
+  if (timeout == 0) {
+    return false;
+  }
+
+  CacheEntry entry;
+  entry.attr = attr;
+  entry.expireTime = Now() + TimeSpec(timeout, 0);
+
+  auto* shard = GetShard(attr.inodeid());
+  std::lock_guard<std::mutex> lk(shard->mutex);
+  if (shard->version != version || shard->pinned.count(attr.inodeid()) != 0) {
+    VLOG(6) << "Reject the stale attribute: inodeId=" << attr.inodeid();
+    return false;
+  }
+  shard->lru->Put(attr.inodeid(), entry);
+  return true;
+}
+
+void AttrCache::Delete(Ino ino) {
+  if (!enable_) {
+    return;
+  }
+
+  auto* shard = GetShard(ino);
+  std::lock_guard<std::mutex> lk(shard->mutex);
+  shard->version++;
+  shard->lru->Remove(ino);
+}
+
+void AttrCache::Revalidate(const InodeAttr& attr) {
+  if (!enable_) {
+    return;
+  }
+
+  CacheEntry entry;
+  auto* shard = GetShard(attr.inodeid());
+  if (!shard->lru->Get(attr.inodeid(), &entry)) {
+    return;
+  }
+
+  if (AttrMtime(entry.attr) != AttrMtime(attr) ||
+      AttrCtime(entry.attr) != AttrCtime(attr)) {
+    VLOG(1) << "Attribute modified, drop it from attr cache: inodeId="
+            << attr.inodeid();
+    Delete(attr.inodeid());
+  }
+}
+
+void AttrCache::Pin(Ino ino) {
+  if (!enable_) {
+    return;
+  }
+
+  auto* shard = GetShard(ino);
+  std::lock_guard<std::mutex> lk(shard->mutex);
+  shard->pinned[ino]++;
+  shard->version++;
+  shard->lru->Remove(ino);
+}
+
+// The fills started during the modification are rejected by the version,
+// though they may complete after it.
+void AttrCache::Unpin(Ino ino) {
+  if (!enable_) {
+    return;
+  }
+
+  auto* shard = GetShard(ino);
+  std::lock_guard<std::mutex> lk(shard->mutex);
+  auto iter = shard->pinned.find(ino);
+  if (iter != shard->pinned.end() && --iter->second == 0) {
+    shard->pinned.erase(iter);
+  }
+  shard->version++;
+}
+
+}  // namespace filesystem
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_FILESYSTEM_ATTR_CACHE_H_
+#define DINGOFS_SRC_CLIENT_FILESYSTEM_ATTR_CACHE_H_
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "dingofs/proto/metaserver.pb.h"
+#include "dingofs/src/client/common/config.h"
+#include "dingofs/src/client/filesystem/meta.h"
+#include "dingofs/src/client/filesystem/metric.h"
+#include "dingofs/src/utils/lru_cache.h"
+
+namespace dingofs {
+namespace client {
+namespace filesystem {
+
+// Memory cache for inode attribute, so the repeated getattr of unchanged
+// files (e.g. ls -l, stat) can be served without RPC.
+//
+// The entry expires after the kernel attribute timeout, and it will be
+// dropped on local mutation or once the attribute replied to kernel
+// differs from the cached one in mtime or ctime.
+//
+// The attribute fetched from metaserver may be stale once the inode is
+// modified during the fetch, so the fill must take the |Version| before
+// fetching, and it's rejected if any invalidation happened since then.
+// The inode being modified is pinned, it can't be filled until the
+// modification is done, see |Pin|.
+class AttrCache {
+ public:
+  struct CacheEntry {
+    pb::metaserver::InodeAttr attr;
+    base::time::TimeSpec expireTime;
+  };
+
+  using LRUType = utils::LRUCache<Ino, CacheEntry>;
+
+  static constexpr uint32_t kShards = 32;
+
+ public:
+  explicit AttrCache(common::AttrCacheOption option);
+
+  bool Get(Ino ino, pb::metaserver::InodeAttr* attr);
+
+  // The version should be taken before fetching the attribute.
+  uint64_t Version(Ino ino);
+
+  // Return false if the |attr| is rejected, because the inode was
+  // invalidated or it's pinned since |version|.
+  bool Put(const pb::metaserver::InodeAttr& attr, uint64_t version);
+
+  void Delete(Ino ino);
+
+  // Drop the cached attribute if it's modified, compared with |attr|.
+  void Revalidate(const pb::metaserver::InodeAttr& attr);
+
+  // Drop the cached attribute and reject the fills until |Unpin|, the
+  // pins of the same inode are counted.
+  void Pin(Ino ino);
+
+  void Unpin(Ino ino);
+
+ private:
+  struct Shard {
+    std::mutex mutex;  // protect version and pinned, serialize the fills
+    uint64_t version;  // increased by every invalidation
+    std::unordered_map<Ino, uint32_t> pinned;
+    std::shared_ptr<LRUType> lru;
+  };
+
+  Shard* GetShard(Ino ino);
+
+  bool enable_;
+  common::AttrCacheOption option_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  AttrCacheMetric metric_;
+};
+
+}  // namespace filesystem
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_FILESYSTEM_ATTR_CACHE_H_
@@ -39,12 +39,18 @@ using pb::metaserver::InodeAttr;
 
 AttrWatcher::AttrWatcher(AttrWatcherOption option,
                          std::shared_ptr<OpenFiles> openFiles,
-                         std::shared_ptr<DirCache> dirCache)
+                         std::shared_ptr<DirCache> dirCache,
+                         std::shared_ptr<AttrCache> attrCache)
     : modifiedAt_(std::make_shared<LRUType>(option.lruSize)),
       openFiles_(openFiles),
-      dirCache_(dirCache) {}
+      dirCache_(dirCache),
+      attrCache_(attrCache) {}
 
 void AttrWatcher::RemeberMtime(const InodeAttr& attr) {
+  if (attrCache_ != nullptr) {
+    attrCache_->Revalidate(attr);
+  }
+
   WriteLockGuard lk(rwlock_);
   modifiedAt_->Put(attr.inodeid(), AttrMtime(attr));
 }
@@ -54,6 +60,11 @@ bool AttrWatcher::GetMtime(Ino ino, base::time::TimeSpec* time) {
   return modifiedAt_->Get(ino, time);
 }
 
+void AttrWatcher::ForgetMtime(Ino ino) {
+  WriteLockGuard lk(rwlock_);
+  modifiedAt_->Remove(ino);
+}
+
 void AttrWatcher::UpdateDirEntryAttr(Ino ino, const InodeAttr& attr) {
   std::shared_ptr<DirEntryList> entries;
   for (const auto parent : attr.parent()) {
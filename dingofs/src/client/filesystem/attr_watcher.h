@@ -26,6 +26,7 @@
 #include <memory>
 
 #include "dingofs/src/client/common/config.h"
+#include "dingofs/src/client/filesystem/attr_cache.h"
 #include "dingofs/src/client/filesystem/dir_cache.h"
 #include "dingofs/src/client/filesystem/meta.h"
 #include "dingofs/src/client/filesystem/openfile.h"
@@ -41,12 +42,15 @@ class AttrWatcher {
 
   AttrWatcher(common::AttrWatcherOption option,
               std::shared_ptr<OpenFiles> openFiles,
-              std::shared_ptr<DirCache> dirCache);
+              std::shared_ptr<DirCache> dirCache,
+              std::shared_ptr<AttrCache> attrCache = nullptr);
 
   void RemeberMtime(const pb::metaserver::InodeAttr& attr);
 
   bool GetMtime(Ino ino, base::time::TimeSpec* time);
 
+  void ForgetMtime(Ino ino);
+
   void UpdateDirEntryAttr(Ino ino, const pb::metaserver::InodeAttr& attr);
 
   void UpdateDirEntryLength(Ino ino, const pb::metaserver::InodeAttr& open);
@@ -58,6 +62,7 @@ class AttrWatcher {
   std::shared_ptr<LRUType> modifiedAt_;
   std::shared_ptr<OpenFiles> openFiles_;
   std::shared_ptr<DirCache> dirCache_;
+  std::shared_ptr<AttrCache> attrCache_;
 };
 
 enum class ReplyType { ATTR, ONLY_LENGTH };
@@ -67,7 +72,8 @@ enum class ReplyType { ATTR, ONLY_LENGTH };
  *  before reply:
  *    1) set attibute length if the corresponding file is opened
  *  after reply:
- *    1) remeber attribute modified time.
+ *    1) remeber attribute modified time, and drop the stale attribute
+ *       in attr cache.
  *    2) write back attribute to dir entry cache if |writeBack| is true,
  *       because the dir-entry attribute maybe stale.
  */
@@ -22,8 +22,10 @@
 
 #include "dingofs/src/client/filesystem/filesystem.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <utility>
 
 #include "dingofs/proto/metaserver.pb.h"
 #include "dingofs/src/base/timer/timer_impl.h"
@@ -51,12 +53,15 @@ FileSystem::FileSystem(uint32_t fs_id, FileSystemOption option,
                        ExternalMember member)
     : fs_id_(fs_id), option_(option), member(member) {
   deferSync_ = std::make_shared<DeferSync>(option.deferSyncOption);
-  negative_ = std::make_shared<LookupCache>(option.lookupCacheOption);
+  lookupCache_ = std::make_shared<LookupCache>(option.lookupCacheOption);
   dirCache_ = std::make_shared<DirCache>(option.dirCacheOption);
   openFiles_ = std::make_shared<OpenFiles>(option_.openFilesOption, deferSync_);
-  attrWatcher_ = std::make_shared<AttrWatcher>(option_.attrWatcherOption,
-                                               openFiles_, dirCache_);
+  attrCache_ = std::make_shared<AttrCache>(option_.attrCacheOption);
+  attrWatcher_ = std::make_shared<AttrWatcher>(
+      option_.attrWatcherOption, openFiles_, dirCache_, attrCache_);
   entry_watcher_ = std::make_shared<EntryWatcher>(option_.nocto_suffix);
+  lookupCount_ = std::make_shared<LookupCount>(
+      [this](Ino ino) { OnForget(ino); });
   handlerManager_ = std::make_shared<HandlerManager>();
   rpc_ = std::make_shared<RPCClient>(option.rpcOption, member);
 }
@@ -143,11 +148,20 @@ void FileSystem::SetAttrTimeout(AttrOut* attr_out) {
   }
 }
 
+void FileSystem::OnForget(Ino ino) {
+  attrCache_->Delete(ino);
+  attrWatcher_->ForgetMtime(ino);
+  dirCache_->Drop(ino);
+  openFiles_->Forget(ino);
+}
+
 // fuse reply*
 void FileSystem::ReplyError(Request req, DINGOFS_ERROR code) {
   fuse_reply_err(req, SysErr(code));
 }
 
+void FileSystem::ReplyNone(Request req) { fuse_reply_none(req); }
+
 void FileSystem::ReplyEntry(Request req, EntryOut* entry_out) {
   AttrWatcherGuard watcher(attrWatcher_, &entry_out->attr, ReplyType::ATTR,
                            true);
@@ -156,7 +170,10 @@ void FileSystem::ReplyEntry(Request req, EntryOut* entry_out) {
   fuse_entry_param e;
   SetEntryTimeout(entry_out);
   Entry2Param(entry_out, &e);
-  fuse_reply_entry(req, &e);
+  lookupCount_->Ref(e.ino);
+  if (fuse_reply_entry(req, &e) != 0) {  // kernel never got the reference
+    lookupCount_->Forget(e.ino, 1);
+  }
 }
 
 void FileSystem::ReplyAttr(Request req, AttrOut* attr_out) {
@@ -211,7 +228,10 @@ void FileSystem::ReplyCreate(Request req, EntryOut* entry_out, FileInfo* fi) {
   fuse_entry_param e;
   SetEntryTimeout(entry_out);
   Entry2Param(entry_out, &e);
-  fuse_reply_create(req, &e, fi);
+  lookupCount_->Ref(e.ino);
+  if (fuse_reply_create(req, &e, fi) != 0) {
+    lookupCount_->Forget(e.ino, 1);
+  }
 }
 
 void FileSystem::AddDirEntry(Request req, DirBufferHead* buffer,
@@ -249,6 +269,33 @@ void FileSystem::AddDirEntryPlus(Request req, DirBufferHead* buffer,
                          buffer->p + oldsize,     // char* buf
                          buffer->size - oldsize,  // size_t bufisze
                          name, &e, buffer->size);
+  buffer->plusEntries.emplace_back(buffer->size, e.ino);
+}
+
+void FileSystem::ReplyDirEntryPlus(Request req, DirBufferHead* buffer,
+                                   off_t off, size_t size) {
+  if (size == 0) {
+    fuse_reply_buf(req, nullptr, 0);
+    return;
+  }
+
+  // kernel only takes the reference of entries which entirely replied
+  const auto& entries = buffer->plusEntries;
+  auto first = std::upper_bound(
+      entries.begin(), entries.end(), static_cast<size_t>(off),
+      [](size_t offset, const std::pair<size_t, Ino>& entry) {
+        return offset < entry.first;
+      });
+  auto last = first;
+  for (; last != entries.end() && last->first <= off + size; last++) {
+    lookupCount_->Ref(last->second);
+  }
+
+  if (fuse_reply_buf(req, buffer->p + off, size) != 0) {
+    for (auto iter = first; iter != last; iter++) {
+      lookupCount_->Forget(iter->second, 1);
+    }
+  }
 }
 
 // handler*
@@ -265,7 +312,8 @@ void FileSystem::ReleaseHandler(uint64_t fh) {
 }
 
 FileSystemMember FileSystem::BorrowMember() {
-  return FileSystemMember(deferSync_, openFiles_, attrWatcher_, entry_watcher_);
+  return FileSystemMember(deferSync_, openFiles_, attrWatcher_, entry_watcher_,
+                          attrCache_);
 }
 
 // fuse request*
@@ -275,16 +323,23 @@ DINGOFS_ERROR FileSystem::Lookup(Request req, Ino parent,
     return DINGOFS_ERROR::NAMETOOLONG;
   }
 
-  bool yes = negative_->Get(parent, name);
+  Ino ino;
+  bool yes = lookupCache_->Get(parent, name, &ino);
   if (yes) {
+    auto rc = rpc_->GetAttr(ino, &entry_out->attr);
+    if (rc == DINGOFS_ERROR::OK) {
+      return rc;
+    }
+    lookupCache_->Delete(parent, name);  // maybe deleted by others
+  } else if (lookupCache_->Get(parent, name)) {
     return DINGOFS_ERROR::NOTEXIST;
   }
 
   auto rc = rpc_->Lookup(parent, name, entry_out);
   if (rc == DINGOFS_ERROR::OK) {
-    negative_->Delete(parent, name);
+    lookupCache_->Put(parent, name, entry_out->attr.inodeid());
   } else if (rc == DINGOFS_ERROR::NOTEXIST) {
-    negative_->Put(parent, name);
+    lookupCache_->Put(parent, name);
   }
   return rc;
 }
@@ -311,6 +366,7 @@ DINGOFS_ERROR FileSystem::OpenDir(Request req, Ino ino, FileInfo* fi) {
   if (yes) {
     if (entries->GetMtime() != AttrMtime(attr)) {
       dirCache_->Drop(ino);
+      lookupCache_->DeleteParent(ino);
     }
   }
 
@@ -334,6 +390,9 @@ DINGOFS_ERROR FileSystem::ReadDir(Request req, Ino ino, FileInfo* fi,
 
   (*entries)->SetMtime(FindHandler(fi->fh)->mtime);
   dirCache_->Put(ino, *entries);
+  (*entries)->Iterate([&](DirEntry* dir_entry) {
+    lookupCache_->Put(ino, dir_entry->name, dir_entry->ino);
+  });
   return DINGOFS_ERROR::OK;
 }
 
@@ -382,6 +441,14 @@ DINGOFS_ERROR FileSystem::Release(Request req, Ino ino, FileInfo* fi) {
   return DINGOFS_ERROR::OK;
 }
 
+void FileSystem::Forget(Ino ino, uint64_t nlookup) {
+  lookupCount_->Forget(ino, nlookup);
+}
+
+void FileSystem::InvalidateLookup(Ino parent, const std::string& name) {
+  lookupCache_->Delete(parent, name);
+}
+
 void FileSystem::UpdateFsQuotaUsage(int64_t add_space, int64_t add_inode) {
   fs_stat_manager_->UpdateFsQuotaUsage(add_space, add_inode);
 }
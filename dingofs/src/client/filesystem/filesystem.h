@@ -31,6 +31,7 @@
 
 #include "dingofs/src/base/timer/timer.h"
 #include "dingofs/src/client/common/config.h"
+#include "dingofs/src/client/filesystem/attr_cache.h"
 #include "dingofs/src/client/filesystem/attr_watcher.h"
 #include "dingofs/src/client/filesystem/defer_sync.h"
 #include "dingofs/src/client/filesystem/dir_cache.h"
@@ -40,6 +41,7 @@
 #include "dingofs/src/client/filesystem/error.h"
 #include "dingofs/src/client/filesystem/fs_stat_manager.h"
 #include "dingofs/src/client/filesystem/lookup_cache.h"
+#include "dingofs/src/client/filesystem/lookup_count.h"
 #include "dingofs/src/client/filesystem/meta.h"
 #include "dingofs/src/client/filesystem/openfile.h"
 #include "dingofs/src/client/filesystem/package.h"
@@ -53,16 +55,19 @@ struct FileSystemMember {
   FileSystemMember(std::shared_ptr<DeferSync> deferSync,
                    std::shared_ptr<OpenFiles> openFiles,
                    std::shared_ptr<AttrWatcher> attrWatcher,
-                   std::shared_ptr<EntryWatcher> entry_watcher)
+                   std::shared_ptr<EntryWatcher> entry_watcher,
+                   std::shared_ptr<AttrCache> attrCache)
       : deferSync(deferSync),
         openFiles(openFiles),
         attrWatcher(attrWatcher),
-        entry_watcher(entry_watcher) {}
+        entry_watcher(entry_watcher),
+        attrCache(attrCache) {}
 
   std::shared_ptr<DeferSync> deferSync;
   std::shared_ptr<OpenFiles> openFiles;
   std::shared_ptr<AttrWatcher> attrWatcher;
   std::shared_ptr<EntryWatcher> entry_watcher;
+  std::shared_ptr<AttrCache> attrCache;
 };
 
 class FileSystem {
@@ -91,9 +96,13 @@ class FileSystem {
 
   DINGOFS_ERROR Release(Request req, Ino ino, FileInfo* fi);
 
+  void Forget(Ino ino, uint64_t nlookup);
+
   // fuse reply: we control all replies to vfs layer in same entrance.
   void ReplyError(Request req, DINGOFS_ERROR code);
 
+  void ReplyNone(Request req);
+
   void ReplyEntry(Request req, EntryOut* entry_out);
 
   void ReplyAttr(Request req, AttrOut* attr_out);
@@ -121,6 +130,11 @@ class FileSystem {
 
   void AddDirEntryPlus(Request req, DirBufferHead* buffer, DirEntry* dir_entry);
 
+  // reply [off, off + size) of |buffer| to readdirplus, and reference
+  // the entries with attribute in it once the kernel got them.
+  void ReplyDirEntryPlus(Request req, DirBufferHead* buffer, off_t off,
+                         size_t size);
+
   // utility: file handler
   std::shared_ptr<FileHandler> NewHandler();
 
@@ -131,6 +145,10 @@ class FileSystem {
   // utility: others
   FileSystemMember BorrowMember();
 
+  // drop the cached lookup result once the entry modified by this client,
+  // e.g. create, unlink and rename.
+  void InvalidateLookup(Ino parent, const std::string& name);
+
   // ----------- dispatch request  -----------
   void UpdateFsQuotaUsage(int64_t add_space, int64_t add_inode);
   void UpdateDirQuotaUsage(Ino ino, int64_t add_space, int64_t add_inode);
@@ -163,13 +181,18 @@ class FileSystem {
 
   void SetAttrTimeout(AttrOut* attr_out);
 
+  // drop the inode from client caches once kernel forgot it.
+  void OnForget(Ino ino);
+
   uint32_t fs_id_;
   common::FileSystemOption option_;
   ExternalMember member;
   std::shared_ptr<DeferSync> deferSync_;
-  std::shared_ptr<LookupCache> negative_;
+  std::shared_ptr<LookupCache> lookupCache_;
+  std::shared_ptr<LookupCount> lookupCount_;
   std::shared_ptr<DirCache> dirCache_;
   std::shared_ptr<OpenFiles> openFiles_;
+  std::shared_ptr<AttrCache> attrCache_;
   std::shared_ptr<AttrWatcher> attrWatcher_;
   std::shared_ptr<EntryWatcher> entry_watcher_;
   std::shared_ptr<HandlerManager> handlerManager_;
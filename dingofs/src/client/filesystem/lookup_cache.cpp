@@ -24,6 +24,7 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <ctime>
 
 #include "absl/strings/str_format.h"
@@ -47,11 +48,17 @@ using utils::WriteLockGuard;
   } while (0)
 
 LookupCache::LookupCache(LookupCacheOption option)
-    : enable_(option.negativeTimeoutSec > 0), rwlock_(), option_(option) {
+    : enable_(option.negativeTimeoutSec > 0 || option.positiveTimeoutSec > 0),
+      rwlock_(),
+      option_(option),
+      version_(0),
+      minVersion_(0) {
   lru_ = std::make_shared<LRUType>(option.lruSize);
+  invalidated_ = std::make_shared<VersionLRUType>(option.lruSize);
   if (enable_) {
-    LOG(INFO) << "Using lookup negative lru cache"
-              << ", timeout = " << option.negativeTimeoutSec
+    LOG(INFO) << "Using lookup lru cache"
+              << ", negative timeout = " << option.negativeTimeoutSec
+              << ", positive timeout = " << option.positiveTimeoutSec
               << ", capacity = " << option.lruSize;
   }
 }
@@ -60,42 +67,96 @@ std::string LookupCache::CacheKey(Ino parent, const std::string& name) {
   return absl::StrFormat("%d:%s", parent, name);
 }
 
-bool LookupCache::Get(Ino parent, const std::string& name) {
-  RETURN_FALSE_IF_DISABLED();
-  ReadLockGuard lk(rwlock_);
-  CacheEntry entry;
+// protect by rwlock_
+bool LookupCache::GetEntry(Ino parent, const std::string& name,
+                           CacheEntry* entry) {
   auto key = CacheKey(parent, name);
-  bool yes = lru_->Get(key, &entry);
+  bool yes = lru_->Get(key, entry);
   if (!yes) {
     VLOG(1) << absl::StrFormat("Lookup cache not found: key(%d,%s)", parent,
                                name);
     return false;
-  } else if (entry.uses < option_.minUses) {
+  } else if (entry->expireTime < Now()) {
     return false;
-  } else if (entry.expireTime < Now()) {
+  }
+
+  uint64_t version;
+  yes = invalidated_->Get(parent, &version);
+  if (!yes || version < minVersion_) {
+    version = minVersion_;
+  }
+
+  if (entry->version < version) {
+    VLOG(1) << absl::StrFormat("Lookup cache is stale: key(%d,%s)", parent,
+                               name);
     return false;
   }
   return true;
 }
 
-bool LookupCache::Put(Ino parent, const std::string& name) {
-  RETURN_FALSE_IF_DISABLED();
-  WriteLockGuard lk(rwlock_);
+// protect by rwlock_
+bool LookupCache::PutEntry(Ino parent, const std::string& name, Ino ino,
+                           uint32_t timeoutSec) {
   CacheEntry entry;
   auto key = CacheKey(parent, name);
   bool yes = lru_->Get(key, &entry);
-  if (yes) {
+  if (yes && entry.ino == ino) {
     entry.uses++;
   } else {
     entry.uses = 0;
   }
 
-  entry.expireTime =
-      Now() + base::time::TimeSpec(option_.negativeTimeoutSec, 0);
+  entry.ino = ino;
+  entry.version = version_;
+  entry.expireTime = Now() + base::time::TimeSpec(timeoutSec, 0);
   lru_->Put(key, entry);
   return true;
 }
 
+bool LookupCache::Get(Ino parent, const std::string& name) {
+  RETURN_FALSE_IF_DISABLED();
+  ReadLockGuard lk(rwlock_);
+  CacheEntry entry;
+  bool yes = GetEntry(parent, name, &entry);
+  if (!yes || entry.ino != 0) {
+    return false;
+  } else if (entry.uses < option_.minUses) {
+    return false;
+  }
+  return true;
+}
+
+bool LookupCache::Put(Ino parent, const std::string& name) {
+  RETURN_FALSE_IF_DISABLED();
+  if (option_.negativeTimeoutSec == 0) {
+    return false;
+  }
+  WriteLockGuard lk(rwlock_);
+  return PutEntry(parent, name, 0, option_.negativeTimeoutSec);
+}
+
+bool LookupCache::Get(Ino parent, const std::string& name, Ino* ino) {
+  RETURN_FALSE_IF_DISABLED();
+  ReadLockGuard lk(rwlock_);
+  CacheEntry entry;
+  bool yes = GetEntry(parent, name, &entry);
+  if (!yes || entry.ino == 0) {
+    return false;
+  }
+  *ino = entry.ino;
+  return true;
+}
+
+bool LookupCache::Put(Ino parent, const std::string& name, Ino ino) {
+  RETURN_FALSE_IF_DISABLED();
+  if (option_.positiveTimeoutSec == 0) {
+    Delete(parent, name);  // drop the negative entry
+    return false;
+  }
+  WriteLockGuard lk(rwlock_);
+  return PutEntry(parent, name, ino, option_.positiveTimeoutSec);
+}
+
 bool LookupCache::Delete(Ino parent, const std::string& name) {
   RETURN_FALSE_IF_DISABLED();
   WriteLockGuard lk(rwlock_);
@@ -104,6 +165,16 @@ bool LookupCache::Delete(Ino parent, const std::string& name) {
   return true;
 }
 
+bool LookupCache::DeleteParent(Ino parent) {
+  RETURN_FALSE_IF_DISABLED();
+  WriteLockGuard lk(rwlock_);
+  uint64_t eliminated;
+  if (invalidated_->Put(parent, ++version_, &eliminated)) {
+    minVersion_ = std::max(minVersion_, eliminated);
+  }
+  return true;
+}
+
 }  // namespace filesystem
 }  // namespace client
 }  // namespace dingofs
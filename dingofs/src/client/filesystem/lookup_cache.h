@@ -34,32 +34,60 @@ namespace dingofs {
 namespace client {
 namespace filesystem {
 
-// memory cache for lookup result, now we only support cache negative result,
-// and other positive entry will be cached in kernel.
+// memory cache for lookup result, both negative and positive entries are
+// cached, the positive entry only holds the inode id, its attribute is served
+// by the attribute cache. so the path walk of deep trees can still avoid
+// the GetDentry rpc after the kernel forgot the entries.
 class LookupCache {
  public:
   struct CacheEntry {
     uint32_t uses;
     base::time::TimeSpec expireTime;
+    Ino ino;           // 0 means negative entry
+    uint64_t version;  // version of cache when entry inserted
   };
 
   using LRUType = utils::LRUCache<std::string, CacheEntry>;
+  using VersionLRUType = utils::LRUCache<Ino, uint64_t>;
 
   explicit LookupCache(common::LookupCacheOption option);
 
+  // negative entry
   bool Get(Ino parent, const std::string& name);
 
   bool Put(Ino parent, const std::string& name);
 
+  // positive entry
+  bool Get(Ino parent, const std::string& name, Ino* ino);
+
+  bool Put(Ino parent, const std::string& name, Ino ino);
+
   bool Delete(Ino parent, const std::string& name);
 
+  // invalidate all entries under the |parent|, e.g. the directory
+  // modified by others.
+  bool DeleteParent(Ino parent);
+
  private:
   std::string CacheKey(Ino parent, const std::string& name);
 
+  bool GetEntry(Ino parent, const std::string& name, CacheEntry* entry);
+
+  bool PutEntry(Ino parent, const std::string& name, Ino ino,
+                uint32_t timeoutSec);
+
   bool enable_;
   utils::RWLock rwlock_;
   common::LookupCacheOption option_;
   std::shared_ptr<LRUType> lru_;
+  uint64_t version_;
+  // the version when parent invalidated, entries under the parent which
+  // inserted before it are stale.
+  std::shared_ptr<VersionLRUType> invalidated_;
+  // the highest version evicted from |invalidated_|, entries of any parent
+  // which inserted before it are treated as stale, so the invalidation
+  // is never lost even if its record has been evicted.
+  uint64_t minVersion_;
 };
 
 }  // namespace filesystem
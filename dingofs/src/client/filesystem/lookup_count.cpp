@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include "dingofs/src/client/filesystem/lookup_count.h"
+
+#include <glog/logging.h>
+
+namespace dingofs {
+namespace client {
+namespace filesystem {
+
+using utils::LockGuard;
+
+LookupCount::LookupCount(ForgetFunc on_forget) : on_forget_(on_forget) {
+  for (uint32_t i = 0; i < kShards; i++) {
+    shards_.emplace_back(std::make_unique<Shard>());
+  }
+}
+
+LookupCount::Shard* LookupCount::GetShard(Ino ino) {
+  return shards_[ino % kShards].get();
+}
+
+void LookupCount::Ref(Ino ino) {
+  auto* shard = GetShard(ino);
+  LockGuard lk(shard->mutex);
+  auto ret = shard->counts.emplace(ino, 0);
+  if (ret.second) {
+    metric_.AddInodes(1);
+  }
+  ret.first->second++;
+}
+
+void LookupCount::Forget(Ino ino, uint64_t nlookup) {
+  {
+    auto* shard = GetShard(ino);
+    LockGuard lk(shard->mutex);
+    auto iter = shard->counts.find(ino);
+    if (iter == shard->counts.end()) {
+      // e.g. the reference lost when client restarted, the inode may be
+      // still used by others (e.g. opened file), so leave it alone
+      VLOG(3) << "Forget untracked inode: inodeId=" << ino
+              << ", nlookup=" << nlookup;
+      return;
+    } else if (iter->second > nlookup) {
+      iter->second -= nlookup;
+      return;
+    }
+    shard->counts.erase(iter);
+    metric_.AddInodes(-1);
+  }
+
+  if (on_forget_ != nullptr) {
+    on_forget_(ino);
+  }
+}
+
+uint64_t LookupCount::Get(Ino ino) {
+  auto* shard = GetShard(ino);
+  LockGuard lk(shard->mutex);
+  auto iter = shard->counts.find(ino);
+  return iter == shard->counts.end() ? 0 : iter->second;
+}
+
+size_t LookupCount::Size() {
+  size_t size = 0;
+  for (auto& shard : shards_) {
+    LockGuard lk(shard->mutex);
+    size += shard->counts.size();
+  }
+  return size;
+}
+
+}  // namespace filesystem
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_FILESYSTEM_LOOKUP_COUNT_H_
+#define DINGOFS_SRC_CLIENT_FILESYSTEM_LOOKUP_COUNT_H_
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "dingofs/src/client/filesystem/meta.h"
+#include "dingofs/src/client/filesystem/metric.h"
+#include "dingofs/src/utils/concurrent/concurrent.h"
+
+namespace dingofs {
+namespace client {
+namespace filesystem {
+
+// The lookup count of inodes which referenced by kernel, it increases by one
+// for every entry replied to kernel (lookup, create, readdirplus...) and
+// decreases by forget. Only the inodes which kernel holds are tracked, so
+// the table never outgrows the kernel inode cache.
+//
+// Once the lookup count drops to zero, the kernel has forgotten the inode,
+// and the |on_forget| is invoked (without the shard lock held) to drop the
+// inode from client caches. Forgetting an untracked inode does nothing.
+class LookupCount {
+  struct Shard {
+    utils::Mutex mutex;
+    std::unordered_map<Ino, uint64_t> counts;
+  };
+
+  static constexpr uint32_t kShards = 32;
+
+ public:
+  using ForgetFunc = std::function<void(Ino ino)>;
+
+ public:
+  explicit LookupCount(ForgetFunc on_forget = nullptr);
+
+  // NOTE: reference it before reply to kernel, because the kernel may forget
+  // the inode as soon as it receives the reply.
+  void Ref(Ino ino);
+
+  void Forget(Ino ino, uint64_t nlookup);
+
+  uint64_t Get(Ino ino);
+
+  size_t Size();
+
+ private:
+  Shard* GetShard(Ino ino);
+
+ private:
+  ForgetFunc on_forget_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  LookupCountMetric metric_;
+};
+
+}  // namespace filesystem
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_FILESYSTEM_LOOKUP_COUNT_H_
@@ -61,6 +61,51 @@ class OpenfilesMetric {
   Metric metric_;
 };
 
+class LookupCountMetric {
+ public:
+  LookupCountMetric() = default;
+
+  void AddInodes(int64_t n) { metric_.ninodes << n; }
+
+ private:
+  struct Metric {
+    Metric() : ninodes("filesystem_lookupcount", "ninodes") {}
+    bvar::Adder<int64_t> ninodes;
+  };
+
+  Metric metric_;
+};
+
+class AttrCacheMetric {
+ public:
+  AttrCacheMetric() = default;
+
+  void AddHit() { metric_.hits << 1; }
+
+  void AddMiss() { metric_.misses << 1; }
+
+ private:
+  struct Metric {
+    Metric()
+        : hits("filesystem_attrcache", "hits"),
+          misses("filesystem_attrcache", "misses"),
+          hitRatio("filesystem_attrcache", "hit_ratio", GetHitRatio, this) {}
+
+    static double GetHitRatio(void* arg) {
+      auto* metric = static_cast<Metric*>(arg);
+      int64_t hits = metric->hits.get_value();
+      int64_t total = hits + metric->misses.get_value();
+      return total == 0 ? 0 : static_cast<double>(hits) / total;
+    }
+
+    bvar::Adder<int64_t> hits;
+    bvar::Adder<int64_t> misses;
+    bvar::PassiveStatus<double> hitRatio;
+  };
+
+  Metric metric_;
+};
+
 }  // namespace filesystem
 }  // namespace client
 }  // namespace dingofs
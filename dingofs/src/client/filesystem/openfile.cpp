@@ -101,6 +101,23 @@ void OpenFiles::Close(Ino ino) {
   }
 }
 
+void OpenFiles::Forget(Ino ino) {
+  WriteLockGuard lk(rwlock_);
+
+  auto iter = files_.find(ino);
+  if (iter == files_.end()) {
+    return;
+  }
+
+  // e.g. the release request lost
+  LOG(WARNING) << "Delete open file cache which forgot by kernel: ino = "
+               << ino << ", refs = " << iter->second->refs
+               << ", mtime = " << InodeMtime(iter->second->inode);
+  deferSync_->Push(iter->second->inode);
+  files_.erase(iter);
+  metric_->AddOpenfiles(-1);
+}
+
 void OpenFiles::CloseAll() {
   WriteLockGuard lk(rwlock_);
   auto iter = files_.begin();
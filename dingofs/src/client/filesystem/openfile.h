@@ -58,6 +58,9 @@ class OpenFiles {
 
   void CloseAll();
 
+  // The kernel forgot the inode, so no file handler refers to it any more.
+  void Forget(Ino ino);
+
   bool GetFileAttr(Ino ino, pb::metaserver::InodeAttr* attr);
 
  private:
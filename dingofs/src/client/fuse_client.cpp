@@ -171,8 +171,9 @@ DINGOFS_ERROR FuseClient::Init(const FuseClientOption& option) {
 
   {  // init inode manager
     auto member = fs_->BorrowMember();
-    DINGOFS_ERROR rc = inodeManager_->Init(option.refreshDataOption,
-                                           member.openFiles, member.deferSync);
+    DINGOFS_ERROR rc =
+        inodeManager_->Init(option.refreshDataOption, member.openFiles,
+                            member.deferSync, member.attrCache);
     if (rc != DINGOFS_ERROR::OK) {
       return rc;
     }
@@ -472,6 +473,8 @@ DINGOFS_ERROR FuseClient::MakeNode(
     return ret;
   }
 
+  fs_->InvalidateLookup(parent, name);
+
   ret = UpdateParentMCTimeAndNlink(parent, type, NlinkChange::kAddOne);
   if (ret != DINGOFS_ERROR::OK) {
     LOG(ERROR) << "UpdateParentMCTimeAndNlink failed, parent: " << parent
@@ -564,6 +567,8 @@ DINGOFS_ERROR FuseClient::FuseOpRmDir(fuse_req_t req, fuse_ino_t parent,
       return ret;
     }
 
+    fs_->InvalidateLookup(parent, name);
+
     ret = UpdateParentMCTimeAndNlink(parent, type, NlinkChange::kSubOne);
     if (ret != DINGOFS_ERROR::OK) {
       LOG(ERROR) << "UpdateParentMCTimeAndNlink failed"
@@ -657,6 +662,8 @@ DINGOFS_ERROR FuseClient::CreateManageNode(fuse_req_t req, uint64_t parent,
     return ret;
   }
 
+  fs_->InvalidateLookup(parent, name);
+
   ret = UpdateParentMCTimeAndNlink(parent, type, NlinkChange::kAddOne);
   if (ret != DINGOFS_ERROR::OK) {
     LOG(ERROR) << "UpdateParentMCTimeAndNlink failed, parent: " << parent
@@ -812,6 +819,8 @@ DINGOFS_ERROR FuseClient::OpUnlink(fuse_req_t req, fuse_ino_t parent,
       return ret;
     }
 
+    fs_->InvalidateLookup(parent, name);
+
     ret = UpdateParentMCTimeAndNlink(parent, type, NlinkChange::kSubOne);
     if (ret != DINGOFS_ERROR::OK) {
       LOG(ERROR) << "UpdateParentMCTimeAndNlink failed"
@@ -1032,6 +1041,8 @@ DINGOFS_ERROR FuseClient::FuseOpRename(fuse_req_t req, fuse_ino_t parent,
   }
   renameOp.UpdateInodeCtime();
   renameOp.UpdateCache();
+  fs_->InvalidateLookup(parent, name);
+  fs_->InvalidateLookup(newparent, newname);
 
   renameOp.FinishUpdateUsage(fs_);
 
@@ -1339,6 +1350,8 @@ DINGOFS_ERROR FuseClient::FuseOpSymlink(fuse_req_t req, const char* link,
     return ret;
   }
 
+  fs_->InvalidateLookup(parent, name);
+
   ret = UpdateParentMCTimeAndNlink(parent, FsFileType::TYPE_SYM_LINK,
                                    NlinkChange::kAddOne);
   if (ret != DINGOFS_ERROR::OK) {
@@ -1464,6 +1477,8 @@ DINGOFS_ERROR FuseClient::OpLink(fuse_req_t req, fuse_ino_t ino,
     return ret;
   }
 
+  fs_->InvalidateLookup(newparent, newname);
+
   ret = UpdateParentMCTimeAndNlink(newparent, type, NlinkChange::kAddOne);
   if (ret != DINGOFS_ERROR::OK) {
     LOG(ERROR) << "UpdateParentMCTimeAndNlink failed"
@@ -42,6 +42,7 @@
 #include "dingofs/src/client/fuse_common.h"
 #include "dingofs/src/client/inode_cache_manager.h"
 #include "dingofs/src/client/lease/lease_excutor.h"
+#include "dingofs/src/client/s3/client_s3_read_buffer.h"
 #include "dingofs/src/client/warmup/warmup_manager.h"
 #include "dingofs/src/client/xattr_manager.h"
 #include "dingofs/src/stub/metric/metric.h"
@@ -109,10 +110,44 @@ class FuseClient {
                                     struct fuse_file_info* fi,
                                     filesystem::FileOut* file_out) = 0;
 
+  // Write the data in |bufv|, which may be in the pipe of fuse device
+  // (splice), by default it's copied out and written by FuseOpWrite().
+  virtual DINGOFS_ERROR FuseOpWriteBuf(fuse_req_t req, fuse_ino_t ino,
+                                       struct fuse_bufvec* bufv, off_t off,
+                                       struct fuse_file_info* fi,
+                                       filesystem::FileOut* file_out) {
+    size_t size = fuse_buf_size(bufv);
+    std::unique_ptr<char[]> buffer(new char[size]);
+    struct fuse_bufvec dst = FUSE_BUFVEC_INIT(size);
+    dst.buf[0].mem = buffer.get();
+    ssize_t n = fuse_buf_copy(&dst, bufv, static_cast<fuse_buf_copy_flags>(0));
+    if (n < 0 || static_cast<size_t>(n) != size) {
+      return DINGOFS_ERROR::IO_ERROR;
+    }
+    return FuseOpWrite(req, ino, buffer.get(), size, off, fi, file_out);
+  }
+
   virtual DINGOFS_ERROR FuseOpRead(fuse_req_t req, fuse_ino_t ino, size_t size,
                                    off_t off, struct fuse_file_info* fi,
                                    char* buffer, size_t* rSize) = 0;
 
+  // Read into |buffer| which may reference the cached data without copy.
+  virtual DINGOFS_ERROR FuseOpRead(fuse_req_t req, fuse_ino_t ino, size_t size,
+                                   off_t off, struct fuse_file_info* fi,
+                                   ReadBuffer* buffer, size_t* rSize) {
+    return FuseOpRead(req, ino, size, off, fi, buffer->Data(), rSize);
+  }
+
+  // Copy the data between files without passing it through user space,
+  // NOTSUPPORT lets the kernel fall back to copy by read and write.
+  virtual DINGOFS_ERROR FuseOpCopyFileRange(
+      fuse_req_t req, fuse_ino_t ino_in, off_t off_in,
+      struct fuse_file_info* fi_in, fuse_ino_t ino_out, off_t off_out,
+      struct fuse_file_info* fi_out, size_t len, int flags,
+      filesystem::FileOut* file_out) {
+    return DINGOFS_ERROR::NOTSUPPORT;
+  }
+
   virtual DINGOFS_ERROR FuseOpLookup(fuse_req_t req, fuse_ino_t parent,
                                      const char* name,
                                      filesystem::EntryOut* entryOut);
@@ -22,10 +22,13 @@
 
 #include "dingofs/src/client/fuse_s3_client.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 
 #include "dingofs/src/client/blockcache/block_cache.h"
 #include "dingofs/src/client/blockcache/s3_client.h"
+#include "dingofs/src/client/common/dynamic_config.h"
 #include "dingofs/src/client/datastream/data_stream.h"
 #include "dingofs/src/client/kvclient/memcache_client.h"
 #include "dingofs/src/common/define.h"
@@ -60,6 +63,7 @@ using pb::metaserver::FsFileType;
 using pb::metaserver::InodeAttr;
 
 using common::FLAGS_enableCto;
+using common::FLAGS_fuse_read_zero_copy;
 using common::FLAGS_supportKVcache;
 
 DINGOFS_ERROR FuseS3Client::Init(const common::FuseClientOption& option) {
@@ -168,6 +172,54 @@ DINGOFS_ERROR FuseS3Client::FuseOpWrite(fuse_req_t req, fuse_ino_t ino,
                                         const char* buf, size_t size, off_t off,
                                         struct fuse_file_info* fi,
                                         filesystem::FileOut* file_out) {
+  (void)req;
+  return Write(ino, size, off, fi, file_out,
+               [&]() { return s3Adaptor_->Write(ino, off, size, buf); });
+}
+
+DINGOFS_ERROR FuseS3Client::FuseOpWriteBuf(fuse_req_t req, fuse_ino_t ino,
+                                           struct fuse_bufvec* bufv, off_t off,
+                                           struct fuse_file_info* fi,
+                                           filesystem::FileOut* file_out) {
+  // the data is in memory (no splice), write it directly
+  const struct fuse_buf& buf = bufv->buf[bufv->idx];
+  if (bufv->count == 1 && !(buf.flags & FUSE_BUF_IS_FD)) {
+    return FuseOpWrite(req, ino, static_cast<const char*>(buf.mem) + bufv->off,
+                       buf.size - bufv->off, off, fi, file_out);
+  }
+
+  // the data is in pipe, read it into the pages of DataCache directly
+  size_t size = fuse_buf_size(bufv) - bufv->off;
+  WriteBuffer buffer(off, size, [&](const std::vector<struct iovec>& iovs) {
+    std::vector<char> storage(sizeof(struct fuse_bufvec) +
+                              (iovs.size() - 1) * sizeof(struct fuse_buf));
+    auto* dst = reinterpret_cast<struct fuse_bufvec*>(storage.data());
+    dst->count = iovs.size();
+    dst->idx = 0;
+    dst->off = 0;
+    for (size_t i = 0; i < iovs.size(); i++) {
+      dst->buf[i].size = iovs[i].iov_len;
+      dst->buf[i].flags = static_cast<enum fuse_buf_flags>(0);
+      dst->buf[i].mem = iovs[i].iov_base;
+      dst->buf[i].fd = -1;
+      dst->buf[i].pos = 0;
+    }
+    ssize_t n = fuse_buf_copy(dst, bufv, static_cast<fuse_buf_copy_flags>(0));
+    if (n < 0 || static_cast<size_t>(n) != size) {
+      LOG(ERROR) << "Copy write data from fuse failed: expect " << size
+                 << " bytes, but got " << n;
+      return false;
+    }
+    return true;
+  });
+  return Write(ino, size, off, fi, file_out,
+               [&]() { return s3Adaptor_->WriteBuf(ino, &buffer); });
+}
+
+DINGOFS_ERROR FuseS3Client::Write(fuse_ino_t ino, size_t size, off_t off,
+                                  struct fuse_file_info* fi,
+                                  filesystem::FileOut* file_out,
+                                  std::function<int()> write) {
   size_t* w_size = &file_out->nwritten;
   // check align
   if (fi->flags & O_DIRECT) {
@@ -181,7 +233,7 @@ DINGOFS_ERROR FuseS3Client::FuseOpWrite(fuse_req_t req, fuse_ino_t ino,
   }
 
   uint64_t start = butil::cpuwide_time_us();
-  int w_ret = s3Adaptor_->Write(ino, off, size, buf);
+  int w_ret = write();
   if (w_ret < 0) {
     LOG(ERROR) << "s3Adaptor_ write failed, ret = " << w_ret;
     return DINGOFS_ERROR::INTERNAL;
@@ -236,10 +288,110 @@ DINGOFS_ERROR FuseS3Client::FuseOpWrite(fuse_req_t req, fuse_ino_t ino,
   return ret;
 }
 
+DINGOFS_ERROR FuseS3Client::FuseOpCopyFileRange(
+    fuse_req_t req, fuse_ino_t ino_in, off_t off_in,
+    struct fuse_file_info* fi_in, fuse_ino_t ino_out, off_t off_out,
+    struct fuse_file_info* fi_out, size_t len, int flags,
+    filesystem::FileOut* file_out) {
+  (void)req;
+  (void)fi_in;
+  (void)fi_out;
+  if (flags != 0) {
+    return DINGOFS_ERROR::INVALIDPARAM;
+  }
+
+  // the small range is cheaper to copy by read and write in kernel
+  if (ino_in == ino_out || ino_in == STATSINODEID || ino_out == STATSINODEID ||
+      len < s3Adaptor_->GetBlockSize()) {
+    return DINGOFS_ERROR::NOTSUPPORT;
+  }
+
+  // the objects of source must be uploaded before sharing them, and the
+  // cached data of destination must be flushed before overriding it.
+  DINGOFS_ERROR ret = s3Adaptor_->FlushAllCache(ino_in);
+  if (ret != DINGOFS_ERROR::OK) {
+    return ret;
+  }
+  ret = s3Adaptor_->Flush(ino_out);
+  if (ret != DINGOFS_ERROR::OK) {
+    return ret;
+  }
+
+  std::shared_ptr<InodeWrapper> src;
+  std::shared_ptr<InodeWrapper> dst;
+  ret = inodeManager_->GetInode(ino_in, src);
+  if (ret != DINGOFS_ERROR::OK) {
+    return ret;
+  }
+  ret = inodeManager_->GetInode(ino_out, dst);
+  if (ret != DINGOFS_ERROR::OK) {
+    return ret;
+  }
+
+  uint64_t length = src->GetLength();
+  if (static_cast<uint64_t>(off_in) >= length) {
+    file_out->nwritten = 0;
+    dst->GetInodeAttr(&file_out->attr);
+    return DINGOFS_ERROR::OK;
+  }
+  len = std::min(len, static_cast<size_t>(length - off_in));
+
+  // the copied count is replied in 32 bits (fuse_write_out.size), so copy
+  // at most the block aligned size below UINT32_MAX, the caller will copy
+  // the rest by next call.
+  uint64_t block_size = s3Adaptor_->GetBlockSize();
+  uint64_t max_len = UINT32_MAX / block_size * block_size;
+  len = std::min(len, static_cast<size_t>(max_len));
+
+  if (!fs_->CheckQuota(ino_out, len, 0)) {
+    return DINGOFS_ERROR::NO_SPACE;
+  }
+
+  ret = s3Adaptor_->CopyRange(src.get(), off_in, dst.get(), off_out, len);
+  if (ret != DINGOFS_ERROR::OK) {
+    return ret;
+  }
+  // drop the stale data of destination in cache
+  s3Adaptor_->ReleaseCache(ino_out);
+
+  size_t change_size = 0;
+  {
+    utils::UniqueLock lg_guard = dst->GetUniqueLock();
+
+    file_out->nwritten = len;
+    if (dst->GetLengthLocked() < off_out + len) {
+      change_size = off_out + len - dst->GetLengthLocked();
+      dst->SetLengthLocked(off_out + len);
+    }
+
+    dst->UpdateTimestampLocked(kModifyTime | kChangeTime);
+
+    inodeManager_->ShipToFlush(dst);
+
+    dst->GetInodeAttrUnLocked(&file_out->attr);
+  }
+
+  for (int i = 0; i < file_out->attr.parent_size(); i++) {
+    auto parent = file_out->attr.parent(i);
+    fs_->UpdateDirQuotaUsage(parent, change_size, 0);
+  }
+  fs_->UpdateFsQuotaUsage(change_size, 0);
+
+  return DINGOFS_ERROR::OK;
+}
+
 DINGOFS_ERROR FuseS3Client::FuseOpRead(fuse_req_t req, fuse_ino_t ino,
                                        size_t size, off_t off,
                                        struct fuse_file_info* fi, char* buffer,
                                        size_t* r_size) {
+  ReadBuffer read_buffer(buffer, size);
+  return FuseOpRead(req, ino, size, off, fi, &read_buffer, r_size);
+}
+
+DINGOFS_ERROR FuseS3Client::FuseOpRead(fuse_req_t req, fuse_ino_t ino,
+                                       size_t size, off_t off,
+                                       struct fuse_file_info* fi,
+                                       ReadBuffer* buffer, size_t* r_size) {
   (void)req;
   auto GetReadSize = [](size_t& size, off_t& off, size_t& file_size) -> size_t {
     if (static_cast<int64_t>(file_size) <= off) {
@@ -259,7 +411,7 @@ DINGOFS_ERROR FuseS3Client::FuseOpRead(fuse_req_t req, fuse_ino_t ino,
     size_t len = GetReadSize(size, off, file_size);
     *r_size = len;
     if (len > 0) {
-      memcpy(buffer, data_buf->p + off, len);
+      memcpy(buffer->Data(), data_buf->p + off, len);
     }
     return DINGOFS_ERROR::OK;
   }
@@ -288,7 +440,13 @@ DINGOFS_ERROR FuseS3Client::FuseOpRead(fuse_req_t req, fuse_ino_t ino,
   }
 
   // Read do not change inode. so we do not get lock here.
-  int r_ret = s3Adaptor_->Read(ino, off, len, buffer);
+  int r_ret;
+  if (FLAGS_fuse_read_zero_copy && buffer->ZeroCopyable() &&
+      s3Adaptor_->ReadZeroCopy(ino, off, len, buffer)) {
+    r_ret = len;
+  } else {
+    r_ret = s3Adaptor_->Read(ino, off, len, buffer->Data());
+  }
   if (r_ret < 0) {
     LOG(ERROR) << "s3Adaptor_ read failed, ret = " << r_ret;
     return DINGOFS_ERROR::INTERNAL;
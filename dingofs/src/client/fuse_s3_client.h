@@ -23,7 +23,9 @@
 #ifndef DINGOFS_SRC_CLIENT_FUSE_S3_CLIENT_H_
 #define DINGOFS_SRC_CLIENT_FUSE_S3_CLIENT_H_
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "brpc/server.h"
 #include "dingofs/src/client/fuse_client.h"
@@ -69,10 +71,26 @@ class FuseS3Client : public FuseClient {
                             size_t size, off_t off, struct fuse_file_info* fi,
                             filesystem::FileOut* file_out) override;
 
+  DINGOFS_ERROR FuseOpWriteBuf(fuse_req_t req, fuse_ino_t ino,
+                               struct fuse_bufvec* bufv, off_t off,
+                               struct fuse_file_info* fi,
+                               filesystem::FileOut* file_out) override;
+
   DINGOFS_ERROR FuseOpRead(fuse_req_t req, fuse_ino_t ino, size_t size,
                            off_t off, struct fuse_file_info* fi, char* buffer,
                            size_t* r_size) override;
 
+  DINGOFS_ERROR FuseOpRead(fuse_req_t req, fuse_ino_t ino, size_t size,
+                           off_t off, struct fuse_file_info* fi,
+                           ReadBuffer* buffer, size_t* r_size) override;
+
+  DINGOFS_ERROR FuseOpCopyFileRange(fuse_req_t req, fuse_ino_t ino_in,
+                                    off_t off_in, struct fuse_file_info* fi_in,
+                                    fuse_ino_t ino_out, off_t off_out,
+                                    struct fuse_file_info* fi_out, size_t len,
+                                    int flags,
+                                    filesystem::FileOut* file_out) override;
+
   DINGOFS_ERROR FuseOpCreate(fuse_req_t req, fuse_ino_t parent,
                              const char* name, mode_t mode,
                              struct fuse_file_info* fi,
@@ -100,6 +118,11 @@ class FuseS3Client : public FuseClient {
  private:
   bool InitKVCache(const common::KVClientManagerOpt& opt);
 
+  // |write| writes the data to s3 adaptor and returns the written bytes.
+  DINGOFS_ERROR Write(fuse_ino_t ino, size_t size, off_t off,
+                      struct fuse_file_info* fi, filesystem::FileOut* file_out,
+                      std::function<int()> write);
+
   void FlushData() override;
 
   DINGOFS_ERROR InitBrpcServer() override;
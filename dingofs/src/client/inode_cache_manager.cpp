@@ -103,6 +103,7 @@ DINGOFS_ERROR InodeCacheManagerImpl::GetInode(
   out = std::make_shared<InodeWrapper>(std::move(inode), metaClient_,
                                        s3ChunkInfoMetric_, option_.maxDataSize,
                                        option_.refreshDataIntervalSec);
+  PinAttr(out);
 
   // refresh data
   rc = RefreshData(out, streaming);
@@ -122,6 +123,14 @@ DINGOFS_ERROR InodeCacheManagerImpl::GetInodeAttr(uint64_t inode_id,
   if (rc == DINGOFS_ERROR::OK) {
     inode_wrapper->GetInodeAttr(out);
     return rc;
+  } else if (attrCache_ != nullptr && attrCache_->Get(inode_id, out)) {
+    VLOG(6) << "GetInodeAttr from attrCache, inodeId=" << inode_id;
+    return DINGOFS_ERROR::OK;
+  }
+
+  uint64_t version = 0;
+  if (attrCache_ != nullptr) {
+    version = attrCache_->Version(inode_id);
   }
 
   std::set<uint64_t> inode_ids;
@@ -144,6 +153,9 @@ DINGOFS_ERROR InodeCacheManagerImpl::GetInodeAttr(uint64_t inode_id,
   }
 
   *out = *attrs.begin();
+  if (attrCache_ != nullptr) {
+    attrCache_->Put(*out, version);
+  }
   return DINGOFS_ERROR::OK;
 }
 
@@ -181,6 +193,13 @@ DINGOFS_ERROR InodeCacheManagerImpl::BatchGetInodeAttrAsync(
     return DINGOFS_ERROR::NOTEXIST;
   }
 
+  std::map<uint64_t, uint64_t> versions;
+  if (attrCache_ != nullptr) {
+    for (const auto& inode_id : *inode_ids) {
+      versions.emplace(inode_id, attrCache_->Version(inode_id));
+    }
+  }
+
   ::dingofs::utils::Mutex mutex;
   std::shared_ptr<CountDownEvent> cond =
       std::make_shared<CountDownEvent>(inode_groups.size());
@@ -198,6 +217,16 @@ DINGOFS_ERROR InodeCacheManagerImpl::BatchGetInodeAttrAsync(
 
   // wait for all sudrequest finished
   cond->Wait();
+
+  // the attributes are fresh, cache them for the following stats
+  if (attrCache_ != nullptr && attrs != nullptr) {
+    for (const auto& item : *attrs) {
+      auto iter = versions.find(item.first);
+      if (iter != versions.end()) {
+        attrCache_->Put(item.second, iter->second);
+      }
+    }
+  }
   return DINGOFS_ERROR::OK;
 }
 
@@ -227,6 +256,7 @@ DINGOFS_ERROR InodeCacheManagerImpl::CreateInode(
   out = std::make_shared<InodeWrapper>(std::move(inode), metaClient_,
                                        s3ChunkInfoMetric_, option_.maxDataSize,
                                        option_.refreshDataIntervalSec);
+  PinAttr(out);
   return DINGOFS_ERROR::OK;
 }
 
@@ -242,12 +272,19 @@ DINGOFS_ERROR InodeCacheManagerImpl::CreateManageInode(
   out = std::make_shared<InodeWrapper>(std::move(inode), metaClient_,
                                        s3ChunkInfoMetric_, option_.maxDataSize,
                                        option_.refreshDataIntervalSec);
+  PinAttr(out);
   return DINGOFS_ERROR::OK;
 }
 
 DINGOFS_ERROR InodeCacheManagerImpl::DeleteInode(uint64_t inode_id) {
   NameLockGuard lock(nameLock_, std::to_string(inode_id));
+  if (attrCache_ != nullptr) {
+    attrCache_->Pin(inode_id);
+  }
   MetaStatusCode ret = metaClient_->DeleteInode(m_fs_id, inode_id);
+  if (attrCache_ != nullptr) {
+    attrCache_->Unpin(inode_id);
+  }
   if (ret != MetaStatusCode::OK && ret != MetaStatusCode::NOT_FOUND) {
     LOG(ERROR) << "metaClient_ DeleteInode failed, MetaStatusCode = " << ret
                << ", MetaStatusCode_Name = " << MetaStatusCode_Name(ret)
@@ -262,6 +299,21 @@ void InodeCacheManagerImpl::ShipToFlush(
   deferSync_->Push(inode);
 }
 
+// The inode may be modified through the wrapper, so keep the attribute out
+// of cache until the wrapper released, which is after the modifications
+// synced to metaserver.
+void InodeCacheManagerImpl::PinAttr(
+    const std::shared_ptr<InodeWrapper>& inode) {
+  if (attrCache_ == nullptr) {
+    return;
+  }
+
+  uint64_t inode_id = inode->GetInodeId();
+  attrCache_->Pin(inode_id);
+  inode->SetReleaseCallback(
+      [attr_cache = attrCache_, inode_id]() { attr_cache->Unpin(inode_id); });
+}
+
 DINGOFS_ERROR InodeCacheManagerImpl::RefreshData(
     std::shared_ptr<InodeWrapper>& inode, bool streaming) {
   auto type = inode->GetType();
@@ -31,6 +31,7 @@
 
 #include "dingofs/proto/metaserver.pb.h"
 #include "dingofs/src/client/common/config.h"
+#include "dingofs/src/client/filesystem/attr_cache.h"
 #include "dingofs/src/client/filesystem/defer_sync.h"
 #include "dingofs/src/client/filesystem/error.h"
 #include "dingofs/src/client/filesystem/openfile.h"
@@ -50,10 +51,12 @@ class InodeCacheManager {
 
   void SetFsId(uint32_t fs_id) { m_fs_id = fs_id; }
 
+  // The |attr_cache| may be nullptr, which means no attribute cached.
   virtual DINGOFS_ERROR Init(
       common::RefreshDataOption option,
       std::shared_ptr<filesystem::OpenFiles> open_files,
-      std::shared_ptr<filesystem::DeferSync> defer_sync) = 0;
+      std::shared_ptr<filesystem::DeferSync> defer_sync,
+      std::shared_ptr<filesystem::AttrCache> attr_cache) = 0;
 
   virtual DINGOFS_ERROR GetInode(
       uint64_t inode_id,
@@ -106,11 +109,13 @@ class InodeCacheManagerImpl
   DINGOFS_ERROR Init(
       common::RefreshDataOption option,
       std::shared_ptr<filesystem::OpenFiles> open_files,
-      std::shared_ptr<filesystem::DeferSync> defer_sync) override {
+      std::shared_ptr<filesystem::DeferSync> defer_sync,
+      std::shared_ptr<filesystem::AttrCache> attr_cache) override {
     option_ = option;
     s3ChunkInfoMetric_ = std::make_shared<stub::metric::S3ChunkInfoMetric>();
     openFiles_ = open_files;
     deferSync_ = defer_sync;
+    attrCache_ = attr_cache;
     return DINGOFS_ERROR::OK;
   }
 
@@ -149,6 +154,8 @@ class InodeCacheManagerImpl
   DINGOFS_ERROR GetInodeFromCachedUnlocked(uint64_t inode_id,
                                            std::shared_ptr<InodeWrapper>& out);
 
+  void PinAttr(const std::shared_ptr<InodeWrapper>& inode);
+
   static DINGOFS_ERROR RefreshData(std::shared_ptr<InodeWrapper>& inode,
                                    bool streaming = true);
 
@@ -159,6 +166,8 @@ class InodeCacheManagerImpl
 
   std::shared_ptr<filesystem::DeferSync> deferSync_;
 
+  std::shared_ptr<filesystem::AttrCache> attrCache_;
+
   dingofs::utils::GenericNameLock<utils::Mutex> nameLock_;
 
   dingofs::utils::GenericNameLock<utils::Mutex> asyncNameLock_;
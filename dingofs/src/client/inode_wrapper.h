@@ -28,6 +28,7 @@
 
 #include <climits>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -88,6 +89,15 @@ class InodeWrapper : public std::enable_shared_from_this<InodeWrapper> {
   ~InodeWrapper() {
     UpdateS3ChunkInfoMetric(-s3ChunkInfoSize_ - s3ChunkInfoAddSize_);
     g_alive_inode_count << -1;
+    if (onRelease_) {
+      onRelease_();
+    }
+  }
+
+  // The |on_release| is invoked once the wrapper destroyed, it's after all
+  // the modifications through it are done.
+  void SetReleaseCallback(std::function<void()> on_release) {
+    onRelease_ = std::move(on_release);
   }
 
   uint64_t GetInodeId() const { return inode_.inodeid(); }
@@ -360,6 +370,9 @@ class InodeWrapper : public std::enable_shared_from_this<InodeWrapper> {
   std::shared_ptr<stub::rpcclient::MetaServerClient> metaClient_;
   std::shared_ptr<stub::metric::S3ChunkInfoMetric> s3ChunkInfoMetric_;
   bool dirty_;
+
+  std::function<void()> onRelease_;
+
   mutable utils::Mutex mtx_;
 
   mutable utils::Mutex syncingInodeMtx_;
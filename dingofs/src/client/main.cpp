@@ -32,7 +32,7 @@ static const struct fuse_lowlevel_ops fuse_op = {
     .init = FuseOpInit,
     .destroy = FuseOpDestroy,
     .lookup = FuseOpLookup,
-    .forget = nullptr,
+    .forget = FuseOpForget,
     .getattr = FuseOpGetAttr,
     .setattr = FuseOpSetAttr,
     .readlink = FuseOpReadLink,
@@ -72,9 +72,9 @@ static const struct fuse_lowlevel_ops fuse_op = {
     .poll = nullptr,
 #endif
 #if FUSE_VERSION >= FUSE_MAKE_VERSION(2, 9)
-    .write_buf = nullptr,
+    .write_buf = FuseOpWriteBuf,
     .retrieve_reply = nullptr,
-    .forget_multi = nullptr,
+    .forget_multi = FuseOpForgetMulti,
     .flock = nullptr,
     .fallocate = nullptr,
 #endif
@@ -84,7 +84,7 @@ static const struct fuse_lowlevel_ops fuse_op = {
     .readdirplus = nullptr,
 #endif
 #if FUSE_VERSION >= FUSE_MAKE_VERSION(3, 4)
-    .copy_file_range = nullptr,
+    .copy_file_range = FuseOpCopyFileRange,
 #endif
 #if FUSE_VERSION >= FUSE_MAKE_VERSION(3, 8)
     .lseek = 0
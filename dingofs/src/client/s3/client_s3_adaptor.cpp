@@ -25,11 +25,15 @@
 #include <brpc/channel.h>
 #include <brpc/controller.h>
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "dingofs/src/client/blockcache/error.h"
 #include "dingofs/src/client/datastream/data_stream.h"
 #include "dingofs/src/client/s3/client_s3_cache_manager.h"
+#include "dingofs/src/stub/metric/metric.h"
+#include "dingofs/src/utils/concurrent/count_down_event.h"
 
 namespace dingofs {
 
@@ -37,10 +41,12 @@ namespace client {
 
 using blockcache::BCACHE_ERROR;
 using blockcache::BlockCache;
+using blockcache::BlockKey;
 using blockcache::S3Client;
 using common::S3ClientAdaptorOption;
 using datastream::DataStream;
 using filesystem::FileSystem;
+using stub::metric::WriteBackMetric;
 using stub::rpcclient::MdsClient;
 using utils::Thread;
 
@@ -78,7 +84,7 @@ S3ClientAdaptorImpl::Init(const S3ClientAdaptorOption& option,
   inodeManager_ = inodeManager;
   mdsClient_ = mdsClient;
   fsCacheManager_ = fsCacheManager;
-  waitInterval_.Init(option.intervalMs);
+  bgFlushIntervalMs_ = option.intervalMs;
   filesystem_ = filesystem;
   block_cache_ = block_cache;
   kvClientManager_ = std::move(kvClientManager);
@@ -92,18 +98,29 @@ S3ClientAdaptorImpl::Init(const S3ClientAdaptorOption& option,
     }
   }
 
-  if (HasDiskCache()) {
-    // init rpc send exec-queue
-    downloadTaskQueues_.resize(prefetchExecQueueNum_);
-    for (auto& q : downloadTaskQueues_) {
-      int rc = bthread::execution_queue_start(
-          &q, nullptr, &S3ClientAdaptorImpl::ExecAsyncDownloadTask, this);
-      if (rc != 0) {
-        LOG(ERROR) << "Init AsyncRpcQueues failed";
-        return DINGOFS_ERROR::INTERNAL;
-      }
+  // init rpc send exec-queue, the readahead works with or without disk cache
+  downloadTaskQueues_.resize(prefetchExecQueueNum_);
+  for (auto& q : downloadTaskQueues_) {
+    int rc = bthread::execution_queue_start(
+        &q, nullptr, &S3ClientAdaptorImpl::ExecAsyncDownloadTask, this);
+    if (rc != 0) {
+      LOG(ERROR) << "Init AsyncRpcQueues failed";
+      return DINGOFS_ERROR::INTERNAL;
     }
   }
+  // the writers are throttled once the memory used ratio reaches the
+  // nearfullRatio, and blocked at the ratio of force flush
+  {
+    auto& data_stream = DataStream::GetInstance();
+    WriteThrottle::Option o;
+    o.background_ratio = option.nearfullRatio / 100.0;
+    o.limit_ratio = data_stream.TriggerForceMemoryRatio();
+    o.base_pause_us = option.baseSleepUs;
+    throttle_ = std::make_unique<WriteThrottle>(
+        o, [&data_stream]() { return data_stream.MemoryUsedRatio(); },
+        [this]() { FsSyncSignal(); });
+  }
+
   if (startBackGround) {
     toStop_.store(false, std::memory_order_release);
     bgFlushThread_ = Thread(&S3ClientAdaptorImpl::BackGroundFlush, this);
@@ -128,20 +145,35 @@ int S3ClientAdaptorImpl::Write(uint64_t inodeId, uint64_t offset,
                                uint64_t length, const char* buf) {
   VLOG(6) << "write start offset:" << offset << ", len:" << length
           << ", fsId:" << fsId_ << ", inodeId=" << inodeId;
-  {
-    std::lock_guard<std::mutex> lock_guard(ioMtx_);
-    // TODO: maybe no need add then dec
-    fsCacheManager_->DataCacheByteInc(length);
+  // TODO: maybe no need add then dec
+  fsCacheManager_->DataCacheByteInc(length);
+  throttle_->Throttle();
 
-    // Write stall for memory near full
-    while (DataStream::GetInstance().MemoryNearFull()) {
-      std::this_thread::sleep_for(std::chrono::microseconds(100));
-    }
+  FileCacheManagerPtr file_cache_manager =
+      fsCacheManager_->FindOrCreateFileCacheManager(fsId_, inodeId);
+  int ret = file_cache_manager->Write(offset, length, buf);
+  fsCacheManager_->DataCacheByteDec(length);
+  VLOG(6) << "write end inodeId=" << inodeId << ", ret: " << ret;
+  return ret;
+}
+
+int S3ClientAdaptorImpl::WriteBuf(uint64_t inodeId, WriteBuffer* buffer) {
+  uint64_t length = buffer->Length();
+  VLOG(6) << "write start offset:" << buffer->Offset() << ", len:" << length
+          << ", fsId:" << fsId_ << ", inodeId=" << inodeId;
+  fsCacheManager_->DataCacheByteInc(length);
+  throttle_->Throttle();
+
+  // the pages are allocated after stall, just like DataCache does
+  if (!buffer->Fill(pageSize_)) {
+    fsCacheManager_->DataCacheByteDec(length);
+    LOG(ERROR) << "Fill write buffer failed, inodeId=" << inodeId;
+    return -1;
   }
 
   FileCacheManagerPtr file_cache_manager =
       fsCacheManager_->FindOrCreateFileCacheManager(fsId_, inodeId);
-  int ret = file_cache_manager->Write(offset, length, buf);
+  int ret = file_cache_manager->WriteBuf(buffer);
   fsCacheManager_->DataCacheByteDec(length);
   VLOG(6) << "write end inodeId=" << inodeId << ", ret: " << ret;
   return ret;
@@ -165,6 +197,15 @@ int S3ClientAdaptorImpl::Read(uint64_t inode_id, uint64_t offset,
   return ret;
 }
 
+bool S3ClientAdaptorImpl::ReadZeroCopy(uint64_t inode_id, uint64_t offset,
+                                       uint64_t length, ReadBuffer* buffer) {
+  FileCacheManagerPtr file_cache_manager =
+      fsCacheManager_->FindOrCreateFileCacheManager(fsId_, inode_id);
+  bool ok = file_cache_manager->ReadZeroCopy(inode_id, offset, length, buffer);
+  VLOG(6) << "read zero copy end inodeId=" << inode_id << ", ok:" << ok;
+  return ok;
+}
+
 DINGOFS_ERROR S3ClientAdaptorImpl::Truncate(InodeWrapper* inodeWrapper,
                                             uint64_t size) {
   const auto* inode = inodeWrapper->GetInodeLocked();
@@ -233,6 +274,175 @@ DINGOFS_ERROR S3ClientAdaptorImpl::Truncate(InodeWrapper* inodeWrapper,
   }
 }
 
+// NOTE: the inode lock of |dst| should not be acquired before calling this
+// function, because it's acquired by appending the chunk info.
+DINGOFS_ERROR S3ClientAdaptorImpl::CopyRange(InodeWrapper* src, uint64_t srcOff,
+                                             InodeWrapper* dst, uint64_t dstOff,
+                                             uint64_t length) {
+  // the block index of object is decided by its position in chunk, so the
+  // objects can be shared only if the ranges are at the same position.
+  if (length == 0 || srcOff % chunkSize_ != dstOff % chunkSize_) {
+    return DINGOFS_ERROR::NOTSUPPORT;
+  }
+
+  struct CopySlice {
+    S3ChunkInfo from;
+    S3ChunkInfo to;
+  };
+
+  struct CopyBlock {
+    size_t slice;
+    BlockKey from;
+    BlockKey to;
+    BCACHE_ERROR rc;
+    bool packed;  // the block has no object but in the pack of |pack_index|
+    uint64_t pack_index;
+  };
+
+  // 1) collect the chunk info overlapped with the range in the same order,
+  //    because the latter one overrides the former one.
+  uint64_t srcEnd = srcOff + length;
+  std::vector<CopySlice> slices;
+  {
+    utils::UniqueLock lk = src->GetUniqueLock();
+    const auto* s3ChunkInfoMap = src->GetChunkInfoMap();
+    for (uint64_t index = srcOff / chunkSize_;
+         index <= (srcEnd - 1) / chunkSize_; index++) {
+      auto iter = s3ChunkInfoMap->find(index);
+      if (iter == s3ChunkInfoMap->end()) {
+        continue;
+      }
+
+      for (const auto& info : iter->second.s3chunks()) {
+        uint64_t begin = std::max(info.offset(), srcOff);
+        uint64_t end = std::min(info.offset() + info.len(), srcEnd);
+        if (begin >= end) {
+          continue;
+        } else if (begin != info.offset() && !info.zero()) {
+          // the data of first object starts at the offset of chunk info,
+          // it can't be referenced from the middle.
+          VLOG(3) << "CopyRange unaligned chunk info, inodeId="
+                  << src->GetInodeId() << ", chunkid=" << info.chunkid()
+                  << ", offset=" << info.offset() << ", srcOff=" << srcOff;
+          return DINGOFS_ERROR::NOTSUPPORT;
+        }
+
+        CopySlice slice{info, info};
+        slice.to.set_compaction(0);
+        slice.to.set_offset(begin - srcOff + dstOff);
+        slice.to.set_len(end - begin);
+        slice.to.set_size(end - begin);
+        slices.emplace_back(slice);
+      }
+    }
+  }
+
+  // 2) allocate chunk id, the range of |dst| is filled with zero first,
+  //    so the holes in |src| are copied too.
+  uint64_t dstEnd = dstOff + length;
+  uint64_t firstIndex = dstOff / chunkSize_;
+  uint64_t lastIndex = (dstEnd - 1) / chunkSize_;
+  uint64_t chunkId;
+  uint32_t chunkIdNum = lastIndex - firstIndex + 1 + slices.size();
+  FSStatusCode ret = AllocS3ChunkId(fsId_, chunkIdNum, &chunkId);
+  if (ret != FSStatusCode::OK) {
+    LOG(ERROR) << "CopyRange alloc s3 chunkid fail. ret:" << ret;
+    return DINGOFS_ERROR::INTERNAL;
+  }
+
+  std::vector<std::pair<uint64_t, S3ChunkInfo>> infos;  // chunk index, info
+  for (uint64_t index = firstIndex; index <= lastIndex; index++) {
+    uint64_t begin = std::max(index * chunkSize_, dstOff);
+    uint64_t end = std::min((index + 1) * chunkSize_, dstEnd);
+    S3ChunkInfo info;
+    info.set_chunkid(chunkId++);
+    info.set_compaction(0);
+    info.set_offset(begin);
+    info.set_len(end - begin);
+    info.set_size(end - begin);
+    info.set_zero(true);
+    infos.emplace_back(index, info);
+  }
+
+  std::vector<CopyBlock> blocks;
+  for (size_t i = 0; i < slices.size(); i++) {
+    auto& slice = slices[i];
+    slice.to.set_chunkid(chunkId++);
+    infos.emplace_back(slice.to.offset() / chunkSize_, slice.to);
+    if (slice.from.zero()) {
+      continue;
+    }
+
+    uint64_t chunkPos = slice.from.offset() % chunkSize_;
+    uint64_t first = chunkPos / blockSize_;
+    uint64_t last = (chunkPos + slice.to.len() - 1) / blockSize_;
+    for (uint64_t index = first; index <= last; index++) {
+      BlockKey from(fsId_, src->GetInodeId(), slice.from.chunkid(), index,
+                    slice.from.compaction());
+      BlockKey to(fsId_, dst->GetInodeId(), slice.to.chunkid(), index, 0);
+      blocks.emplace_back(CopyBlock{i, from, to, BCACHE_ERROR::OK, false, 0});
+    }
+  }
+
+  // 3) copy the objects in storage side concurrently, the block without
+  //    object may be packed into the object of previous block, see BlockPack,
+  //    which copied with the pack.
+  utils::CountDownEvent done(blocks.size());
+  for (auto& block : blocks) {
+    PushAsyncTask([this, &block, &done]() {
+      block.rc = client_->Copy(block.from.StoreKey(), block.to.StoreKey());
+      if (block.rc == BCACHE_ERROR::NOT_FOUND) {
+        BlockKey pack_key;
+        size_t offset, length;
+        auto rc = blockcache::LocatePackedBlock(client_.get(), block.from,
+                                                &pack_key, &offset, &length);
+        if (rc != BCACHE_ERROR::NOT_FOUND) {
+          block.rc = rc;
+          block.packed = (rc == BCACHE_ERROR::OK);
+          block.pack_index = pack_key.index;
+        }
+      }
+      done.Signal();
+    });
+  }
+  done.Wait();
+
+  // the pack should be copied in the same slice, otherwise the copied objects
+  // are orphans which never referenced, remove them.
+  size_t first = 0;
+  for (size_t i = 0; i < blocks.size(); i++) {
+    const auto& block = blocks[i];
+    if (block.slice != blocks[first].slice) {
+      first = i;
+    }
+    if (block.rc == BCACHE_ERROR::OK &&
+        (!block.packed || block.pack_index >= blocks[first].from.index)) {
+      continue;
+    }
+
+    LOG(WARNING) << "CopyRange copy object " << block.from.StoreKey()
+                 << " failed, rc = " << blockcache::StrErr(block.rc)
+                 << ", packed = " << block.packed;
+    for (const auto& copied : blocks) {
+      if (copied.rc == BCACHE_ERROR::OK && !copied.packed) {
+        client_->Delete(copied.to.StoreKey());
+      }
+    }
+    return DINGOFS_ERROR::NOTSUPPORT;
+  }
+
+  // 4) reference the copied objects
+  for (const auto& item : infos) {
+    dst->AppendS3ChunkInfo(item.first, item.second);
+  }
+
+  VLOG(3) << "CopyRange from inodeId=" << src->GetInodeId() << " [" << srcOff
+          << "," << srcEnd << ") to inodeId=" << dst->GetInodeId() << " at "
+          << dstOff << ", " << slices.size() << " chunk info and "
+          << blocks.size() << " objects copied";
+  return DINGOFS_ERROR::OK;
+}
+
 void S3ClientAdaptorImpl::ReleaseCache(uint64_t inodeId) {
   FileCacheManagerPtr fileCacheManager =
       fsCacheManager_->FindFileCacheManager(inodeId);
@@ -278,8 +488,19 @@ void S3ClientAdaptorImpl::BackGroundFlush() {
               << fsCacheManager_->GetDataCacheNum();
       fsCacheManager_->FsSync(true);
 
-    } else {
-      waitInterval_.WaitForNextExcution();
+    } else if (throttle_->NeedFlush()) {
+      VLOG(3) << "BackGroundFlush early, write cache num is: "
+              << fsCacheManager_->GetDataCacheNum();
+      WriteBackMetric::GetInstance().memory_pressure_flushes << 1;
+      uint64_t flushed_bytes = 0;
+      auto rc = fsCacheManager_->FlushDirtiest(&flushed_bytes);
+      if (rc != DINGOFS_ERROR::OK || flushed_bytes == 0) {
+        // The pages may be held by others than dirty data (e.g. inflight
+        // uploads), flushing again immediately makes no progress.
+        WaitForFlushBackoff();
+      }
+
+    } else if (WaitForNextFlush()) {
       VLOG(6) << "BackGroundFlush, write cache num is:"
               << fsCacheManager_->GetDataCacheNum();
       fsCacheManager_->FsSync(false);
@@ -288,19 +509,36 @@ void S3ClientAdaptorImpl::BackGroundFlush() {
   }
 }
 
+// Wait for the flush interval, return false if it's woken up early by
+// stop or the throttled writer.
+bool S3ClientAdaptorImpl::WaitForNextFlush() {
+  std::unique_lock<std::mutex> lck(mtx_);
+  return !cond_.wait_for(
+      lck, std::chrono::milliseconds(bgFlushIntervalMs_), [this]() {
+        return toStop_.load(std::memory_order_acquire) ||
+               throttle_->NeedFlush();
+      });
+}
+
+// Only woken up by stop, the throttled writers keep signaling while the
+// memory is under pressure.
+void S3ClientAdaptorImpl::WaitForFlushBackoff() {
+  std::unique_lock<std::mutex> lck(mtx_);
+  cond_.wait_for(lck, std::chrono::milliseconds(kFlushBackoffMs), [this]() {
+    return toStop_.load(std::memory_order_acquire);
+  });
+}
+
 int S3ClientAdaptorImpl::Stop() {
   LOG(INFO) << "start Stopping S3ClientAdaptor.";
-  waitInterval_.StopWait();
   toStop_.store(true, std::memory_order_release);
   FsSyncSignal();
   if (bgFlushThread_.joinable()) {
     bgFlushThread_.join();
   }
-  if (HasDiskCache()) {
-    for (auto& q : downloadTaskQueues_) {
-      bthread::execution_queue_stop(q);
-      bthread::execution_queue_join(q);
-    }
+  for (auto& q : downloadTaskQueues_) {
+    bthread::execution_queue_stop(q);
+    bthread::execution_queue_join(q);
   }
   block_cache_->Shutdown();
   return 0;
@@ -35,8 +35,10 @@
 #include "dingofs/src/client/filesystem/filesystem.h"
 #include "dingofs/src/client/inode_cache_manager.h"
 #include "dingofs/src/client/s3/client_s3_cache_manager.h"
+#include "dingofs/src/client/s3/client_s3_read_buffer.h"
+#include "dingofs/src/client/s3/client_s3_write_buffer.h"
+#include "dingofs/src/client/s3/client_s3_write_throttle.h"
 #include "dingofs/src/stub/rpcclient/mds_client.h"
-#include "dingofs/src/utils/wait_interval.h"
 
 namespace dingofs {
 namespace client {
@@ -69,9 +71,20 @@ class S3ClientAdaptor {
    */
   virtual int Write(uint64_t inodeId, uint64_t offset, uint64_t length,
                     const char* buf) = 0;
+  // write the data which is filled into pages by |buffer| directly
+  virtual int WriteBuf(uint64_t inodeId, WriteBuffer* buffer) = 0;
   virtual int Read(uint64_t inodeId, uint64_t offset, uint64_t length,
                    char* buf) = 0;
+  // read without copy if possible, see FileCacheManager::ReadZeroCopy()
+  virtual bool ReadZeroCopy(uint64_t inodeId, uint64_t offset,
+                            uint64_t length, ReadBuffer* buffer) = 0;
   virtual DINGOFS_ERROR Truncate(InodeWrapper* inodeWrapper, uint64_t size) = 0;
+  // copy [srcOff, srcOff + length) of |src| to |dst| at |dstOff| by copying
+  // objects in storage side and appending the chunk info to |dst|, it
+  // returns NOTSUPPORT if the range can't be copied in this way.
+  virtual DINGOFS_ERROR CopyRange(InodeWrapper* src, uint64_t srcOff,
+                                  InodeWrapper* dst, uint64_t dstOff,
+                                  uint64_t length) = 0;
   virtual void ReleaseCache(uint64_t inodeId) = 0;
   virtual DINGOFS_ERROR Flush(uint64_t inodeId) = 0;
   virtual DINGOFS_ERROR FlushAllCache(uint64_t inodeId) = 0;
@@ -125,10 +138,17 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
   int Write(uint64_t inodeId, uint64_t offset, uint64_t length,
             const char* buf) override;
 
+  int WriteBuf(uint64_t inodeId, WriteBuffer* buffer) override;
+
   int Read(uint64_t inode_id, uint64_t offset, uint64_t length,
            char* buf) override;
 
+  bool ReadZeroCopy(uint64_t inode_id, uint64_t offset, uint64_t length,
+                    ReadBuffer* buffer) override;
+
   DINGOFS_ERROR Truncate(InodeWrapper* inodeWrapper, uint64_t size) override;
+  DINGOFS_ERROR CopyRange(InodeWrapper* src, uint64_t srcOff, InodeWrapper* dst,
+                          uint64_t dstOff, uint64_t length) override;
   void ReleaseCache(uint64_t inodeId) override;
   DINGOFS_ERROR Flush(uint64_t inode_id) override;
   DINGOFS_ERROR FlushAllCache(uint64_t inodeId) override;
@@ -152,6 +172,11 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
     return block_cache_->GetStoreType() == blockcache::StoreType::DISK;
   }
 
+  // whether the block can be cached by block cache (disk or memory)
+  bool HasCacheStore() {
+    return block_cache_->GetStoreType() != blockcache::StoreType::NONE;
+  }
+
   std::shared_ptr<InodeCacheManager> GetInodeCacheManager() {
     return inodeManager_;
   }
@@ -191,6 +216,10 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
  private:
   void BackGroundFlush();
 
+  bool WaitForNextFlush();
+
+  void WaitForFlushBackoff();
+
   using AsyncDownloadTask = std::function<void()>;
 
   static int ExecAsyncDownloadTask(
@@ -198,6 +227,11 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
 
  public:
   void PushAsyncTask(const AsyncDownloadTask& task) {
+    if (DINGO_UNLIKELY(downloadTaskQueues_.empty())) {
+      task();
+      return;
+    }
+
     static thread_local unsigned int seed = time(nullptr);
 
     int idx = rand_r(&seed) % downloadTaskQueues_.size();
@@ -211,6 +245,8 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
   void Enqueue(std::shared_ptr<FlushChunkCacheContext> context);
 
  private:
+  static constexpr uint64_t kFlushBackoffMs = 10;
+
   std::shared_ptr<blockcache::S3Client> client_;
   uint64_t blockSize_;
   uint64_t chunkSize_;
@@ -226,9 +262,9 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
   utils::Thread bgFlushThread_;
   std::atomic<bool> toStop_;
   std::mutex mtx_;
-  std::mutex ioMtx_;
   std::condition_variable cond_;
-  dingofs::utils::WaitInterval waitInterval_;
+  uint64_t bgFlushIntervalMs_;
+  std::unique_ptr<WriteThrottle> throttle_;
   std::shared_ptr<FsCacheManager> fsCacheManager_;
   std::shared_ptr<InodeCacheManager> inodeManager_;
   std::shared_ptr<filesystem::FileSystem> filesystem_;
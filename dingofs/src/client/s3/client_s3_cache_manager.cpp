@@ -33,6 +33,7 @@
 #include "dingofs/src/client/blockcache/cache_store.h"
 #include "dingofs/src/client/blockcache/error.h"
 #include "dingofs/src/client/blockcache/local_filesystem.h"
+#include "dingofs/src/client/blockcache/s3_client.h"
 #include "dingofs/src/client/common/dynamic_config.h"
 #include "dingofs/src/client/datastream/data_stream.h"
 #include "dingofs/src/client/filesystem/meta.h"
@@ -48,7 +49,6 @@ namespace client {
 
 using aws::GetObjectAsyncCallBack;
 using aws::GetObjectAsyncContext;
-using aws::PutObjectAsyncCallBack;
 using aws::PutObjectAsyncContext;
 
 using blockcache::BCACHE_ERROR;
@@ -61,7 +61,9 @@ using blockcache::StrErr;
 using datastream::DataStream;
 using filesystem::Ino;
 using stub::metric::MetricGuard;
+using stub::metric::ReadaheadMetric;
 using stub::metric::S3Metric;
+using stub::metric::WriteBackMetric;
 using utils::CountDownEvent;
 using utils::ReadLockGuard;
 using utils::RWLock;
@@ -73,6 +75,7 @@ using pb::metaserver::S3ChunkInfo;
 using pb::metaserver::S3ChunkInfoList;
 
 using common::FLAGS_fuse_read_max_retry_s3_not_exist;
+using common::FLAGS_s3_readahead_max_blocks;
 
 void FsCacheManager::DataCacheNumInc() {
   g_s3MultiManagerMetric->writeDataCacheNum << 1;
@@ -218,7 +221,49 @@ DINGOFS_ERROR FsCacheManager::FsSync(bool force) {
     WriteLockGuard writeLockGuard(rwLock_);
     pending = fileCacheManagerMap_;
   }
+  return FlushFiles(pending, force);
+}
+
+DINGOFS_ERROR FsCacheManager::FlushDirtiest(uint64_t* flushed_bytes) {
+  std::vector<std::pair<uint64_t, FileCacheManagerPtr>> files;
+  {
+    ReadLockGuard readLockGuard(rwLock_);
+    files.assign(fileCacheManagerMap_.begin(), fileCacheManagerMap_.end());
+  }
+
+  std::vector<std::pair<uint64_t, FileCacheManagerPtr>> dirty;
+  uint64_t total = 0;
+  for (const auto& item : files) {
+    uint64_t bytes = item.second->GetDirtyBytes();
+    if (bytes > 0) {
+      dirty.emplace_back(bytes, item.second);
+      total += bytes;
+    }
+  }
+  std::sort(dirty.begin(), dirty.end(),
+            [](const std::pair<uint64_t, FileCacheManagerPtr>& a,
+               const std::pair<uint64_t, FileCacheManagerPtr>& b) {
+              return a.first > b.first;
+            });
 
+  std::unordered_map<uint64_t, FileCacheManagerPtr> pending;
+  uint64_t bytes = 0;
+  for (const auto& item : dirty) {
+    if (bytes * 2 >= total) {
+      break;
+    }
+    pending.emplace(item.second->GetInodeId(), item.second);
+    bytes += item.first;
+  }
+  VLOG(3) << "Flush " << pending.size() << " dirtiest files, dirty bytes "
+          << bytes << "/" << total;
+  *flushed_bytes = bytes;
+  return FlushFiles(pending, true);
+}
+
+DINGOFS_ERROR FsCacheManager::FlushFiles(
+    const std::unordered_map<uint64_t, FileCacheManagerPtr>& pending,
+    bool force) {
   auto post_flush = [&](Ino ino, FileCacheManagerPtr file, DINGOFS_ERROR ret) {
     if (ret == DINGOFS_ERROR::OK) {
       WriteLockGuard writeLockGuard(rwLock_);
@@ -273,6 +318,15 @@ DINGOFS_ERROR FsCacheManager::FsSync(bool force) {
   return rc;
 }
 
+uint64_t FileCacheManager::GetDirtyBytes() {
+  ReadLockGuard readLockGuard(rwLock_);
+  uint64_t bytes = 0;
+  for (const auto& item : chunkCacheMap_) {
+    bytes += item.second->GetDirtyBytes();
+  }
+  return bytes;
+}
+
 int FileCacheManager::Write(uint64_t offset, uint64_t length,
                             const char* dataBuf) {
   uint64_t chunk_size = s3ClientAdaptor_->GetChunkSize();
@@ -323,6 +377,57 @@ void FileCacheManager::WriteChunk(uint64_t index, uint64_t chunkPos,
           << ", chunkPos: " << chunkPos;
 }
 
+int FileCacheManager::WriteBuf(WriteBuffer* buffer) {
+  uint64_t chunk_size = s3ClientAdaptor_->GetChunkSize();
+  uint64_t length = buffer->Length();
+  uint64_t index = buffer->Offset() / chunk_size;
+  uint64_t chunk_pos = buffer->Offset() % chunk_size;
+  uint64_t write_len = 0;
+  uint64_t write_offset = 0;
+
+  while (length > 0) {
+    if (chunk_pos + length > chunk_size) {
+      write_len = chunk_size - chunk_pos;
+    } else {
+      write_len = length;
+    }
+
+    WriteChunk(index, chunk_pos, write_len, buffer, write_offset);
+
+    length -= write_len;
+    index++;
+    write_offset += write_len;
+    chunk_pos = (chunk_pos + write_len) % chunk_size;
+  }
+
+  return write_offset;
+}
+
+void FileCacheManager::WriteChunk(uint64_t index, uint64_t chunkPos,
+                                  uint64_t writeLen, WriteBuffer* buffer,
+                                  uint64_t bufPos) {
+  ChunkCacheManagerPtr chunk_cache_manager =
+      FindOrCreateChunkCacheManager(index);
+  WriteLockGuard write_lock_guard(chunk_cache_manager->rwLockChunk_);
+
+  std::vector<DataCachePtr> merge_data_cache_ver;
+  DataCachePtr data_cache = chunk_cache_manager->FindWriteableDataCache(
+      chunkPos, writeLen, &merge_data_cache_ver, inode_);
+  if (data_cache == nullptr) {
+    chunk_cache_manager->WriteNewDataCache(s3ClientAdaptor_, chunkPos,
+                                           writeLen, buffer, bufPos);
+  } else if (merge_data_cache_ver.empty() &&
+             chunkPos > data_cache->GetChunkPos()) {
+    // the common case for sequential write: append to the DataCache
+    data_cache->WriteBuf(chunkPos, writeLen, buffer, bufPos);
+  } else {
+    // overwrite or merge, it's rare, just copy it out
+    std::unique_ptr<char[]> data(new char[writeLen]);
+    buffer->CopyTo(bufPos, writeLen, data.get());
+    data_cache->Write(chunkPos, writeLen, data.get(), merge_data_cache_ver);
+  }
+}
+
 ChunkCacheManagerPtr FileCacheManager::FindOrCreateChunkCacheManager(
     uint64_t index) {
   WriteLockGuard writeLockGuard(rwLock_);
@@ -333,7 +438,7 @@ ChunkCacheManagerPtr FileCacheManager::FindOrCreateChunkCacheManager(
   }
 
   ChunkCacheManagerPtr chunkCacheManager = std::make_shared<ChunkCacheManager>(
-      index, s3ClientAdaptor_, kvClientManager_);
+      index, s3ClientAdaptor_, kvClientManager_, flushWindow_);
   auto ret = chunkCacheMap_.emplace(index, chunkCacheManager);
   g_s3MultiManagerMetric->chunkManagerNum << 1;
   assert(ret.second);
@@ -473,6 +578,12 @@ int FileCacheManager::Read(uint64_t inode_id, uint64_t offset, uint64_t length,
                            char* data_buf) {
   VLOG(3) << "read inodeId=" << inode_id << ", offset=" << offset
           << ", length=" << length;
+  // 0. update access pattern for readahead
+  uint32_t readahead_blocks = readaheadWindow_.Update(
+      offset, length, s3ClientAdaptor_->GetBlockSize(),
+      s3ClientAdaptor_->GetPrefetchBlocks(), FLAGS_s3_readahead_max_blocks,
+      DataStream::GetInstance().MemoryNearFull());
+
   // 1. read from memory cache
   uint64_t actual_read_len = 0;
   std::vector<ReadRequest> mem_cache_miss_request;
@@ -500,8 +611,8 @@ int FileCacheManager::Read(uint64_t inode_id, uint64_t offset, uint64_t length,
     // read from kv cluster (localcache -> remote kv cluster -> s3)
     // localcache/remote kv cluster fail will not return error code.
     // Failure to read from s3 will eventually return failure.
-    ReadStatus ret =
-        ReadKVRequest(kv_requests, data_buf, inode_wrapper->GetLength());
+    ReadStatus ret = ReadKVRequest(kv_requests, data_buf,
+                                   inode_wrapper->GetLength(), readahead_blocks);
     if (ret == ReadStatus::OK) {
       break;
     }
@@ -522,6 +633,137 @@ int FileCacheManager::Read(uint64_t inode_id, uint64_t offset, uint64_t length,
   return actual_read_len;
 }
 
+bool FileCacheManager::ReadZeroCopy(uint64_t inode_id, uint64_t offset,
+                                    uint64_t length, ReadBuffer* buffer) {
+  if (!s3ClientAdaptor_->HasCacheStore() || !IsMemCacheEmpty(offset, length)) {
+    return false;
+  }
+
+  std::shared_ptr<InodeWrapper> inode_wrapper;
+  auto inode_manager = s3ClientAdaptor_->GetInodeCacheManager();
+  if (DINGOFS_ERROR::OK != inode_manager->GetInode(inode_id, inode_wrapper)) {
+    return false;
+  }
+
+  // the holes are filled with zero in buffer by GenerateKVRequest()
+  std::vector<ReadRequest> requests;
+  std::vector<S3ReadRequest> kv_requests;
+  GenerateChunkRequest(offset, length, &requests);
+  GenerateKVRequest(inode_wrapper, requests, buffer->Data(), &kv_requests);
+  std::sort(kv_requests.begin(), kv_requests.end(),
+            [](const S3ReadRequest& lhs, const S3ReadRequest& rhs) {
+              return lhs.readOffset < rhs.readOffset;
+            });
+
+  uint64_t buf_offset = 0;
+  for (const auto& req : kv_requests) {
+    if (req.readOffset > buf_offset) {
+      buffer->Append(buf_offset, req.readOffset - buf_offset);
+    }
+    if (!AppendKVRequest(req, buffer)) {
+      buffer->Reset();
+      return false;
+    }
+    buf_offset = req.readOffset + req.len;
+  }
+  if (buf_offset < length) {
+    buffer->Append(buf_offset, length - buf_offset);
+  }
+
+  // keep the readahead going for sequential read
+  uint32_t readahead_blocks = readaheadWindow_.Update(
+      offset, length, s3ClientAdaptor_->GetBlockSize(),
+      s3ClientAdaptor_->GetPrefetchBlocks(), FLAGS_s3_readahead_max_blocks,
+      DataStream::GetInstance().MemoryNearFull());
+  if (readahead_blocks > 0) {
+    for (const auto& req : kv_requests) {
+      uint64_t chunk_index, chunk_pos, block_index, block_pos;
+      GetBlockLoc(req.offset, &chunk_index, &chunk_pos, &block_index,
+                  &block_pos);
+      PrefetchForBlock(req, inode_wrapper->GetLength(),
+                       s3ClientAdaptor_->GetBlockSize(),
+                       s3ClientAdaptor_->GetChunkSize(), block_index,
+                       readahead_blocks);
+    }
+  }
+  return true;
+}
+
+bool FileCacheManager::IsMemCacheEmpty(uint64_t offset, uint64_t length) {
+  uint64_t chunk_size = s3ClientAdaptor_->GetChunkSize();
+  uint64_t first = offset / chunk_size;
+  uint64_t last = (offset + length - 1) / chunk_size;
+
+  ReadLockGuard lg(rwLock_);
+  for (auto iter = chunkCacheMap_.lower_bound(first);
+       iter != chunkCacheMap_.end() && iter->first <= last; iter++) {
+    if (!iter->second->IsMemEmpty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void FileCacheManager::GenerateChunkRequest(
+    uint64_t offset, uint64_t length, std::vector<ReadRequest>* requests) {
+  uint64_t index = 0, chunk_pos = 0, chunk_size = 0;
+  GetChunkLoc(offset, &index, &chunk_pos, &chunk_size);
+
+  uint64_t buf_offset = 0;
+  while (length > 0) {
+    ReadRequest request;
+    request.index = index;
+    request.chunkPos = chunk_pos;
+    request.len = std::min(length, chunk_size - chunk_pos);
+    request.bufOffset = buf_offset;
+    requests->emplace_back(request);
+
+    length -= request.len;
+    buf_offset += request.len;
+    index++;
+    chunk_pos = 0;
+  }
+}
+
+bool FileCacheManager::AppendKVRequest(const S3ReadRequest& req,
+                                       ReadBuffer* buffer) {
+  uint64_t chunk_index = 0;
+  uint64_t chunk_pos = 0;
+  uint64_t block_index = 0;
+  uint64_t block_pos = 0;
+  GetBlockLoc(req.offset, &chunk_index, &chunk_pos, &block_index, &block_pos);
+
+  auto block_cache = s3ClientAdaptor_->GetBlockCache();
+  const uint64_t block_size = s3ClientAdaptor_->GetBlockSize();
+  uint64_t length = req.len;
+  uint64_t object_offset = req.objectOffset;
+  while (length > 0) {
+    uint64_t current_read_len =
+        length + block_pos > block_size ? block_size - block_pos : length;
+    BlockKey key(req.fsId, req.inodeId, req.chunkId, block_index,
+                 req.compaction);
+
+    std::shared_ptr<blockcache::BlockReader> reader;
+    auto rc = block_cache->Load(key, reader);
+    if (rc != BCACHE_ERROR::OK) {
+      return false;
+    } else if (!buffer->Append(reader, block_pos - object_offset,
+                               current_read_len)) {
+      reader->Close();
+      return false;
+    }
+    if (readaheadHistory_.Contains(key.StoreKey())) {
+      ReadaheadMetric::GetInstance().hits << 1;
+    }
+
+    length -= current_read_len;
+    block_index++;
+    block_pos = (block_pos + current_read_len) % block_size;
+    object_offset = 0;
+  }
+  return true;
+}
+
 bool FileCacheManager::ReadKVRequestFromLocalCache(const BlockKey& key,
                                                    char* buffer,
                                                    uint64_t offset,
@@ -541,6 +783,15 @@ bool FileCacheManager::ReadKVRequestFromLocalCache(const BlockKey& key,
   return true;
 }
 
+bool FileCacheManager::ReadKVRequestFromReadahead(const std::string& name,
+                                                  char* buffer, uint64_t offset,
+                                                  uint64_t length) {
+  if (s3ClientAdaptor_->HasCacheStore()) {
+    return false;  // the blocks are prefetched into block cache
+  }
+  return readaheadBuffer_.Get(name, offset, length, buffer);
+}
+
 bool FileCacheManager::ReadKVRequestFromRemoteCache(const std::string& name,
                                                     char* databuf,
                                                     uint64_t offset,
@@ -562,11 +813,17 @@ bool FileCacheManager::ReadKVRequestFromRemoteCache(const std::string& name,
   return task->res;
 }
 
-bool FileCacheManager::ReadKVRequestFromS3(const std::string& name,
-                                           char* databuf, uint64_t offset,
-                                           uint64_t length, BCACHE_ERROR* rc) {
+bool FileCacheManager::ReadKVRequestFromS3(const BlockKey& key, char* databuf,
+                                           uint64_t offset, uint64_t length,
+                                           BCACHE_ERROR* rc) {
   {
-    *rc = s3ClientAdaptor_->GetS3Client()->Range(name, offset, length, databuf);
+    std::string name = key.StoreKey();
+    auto s3 = s3ClientAdaptor_->GetS3Client();
+    *rc = s3->Range(name, offset, length, databuf);
+    if (*rc == BCACHE_ERROR::NOT_FOUND) {  // maybe packed with other blocks
+      *rc = blockcache::RangePackedBlock(s3.get(), key, offset, length,
+                                         databuf);
+    }
     if (*rc != BCACHE_ERROR::OK) {
       LOG(ERROR) << "Object " << name << " read from s3 failed" << ", rc=" << rc
                  << ", " << StrErr(*rc);
@@ -579,7 +836,7 @@ bool FileCacheManager::ReadKVRequestFromS3(const std::string& name,
 
 FileCacheManager::ReadStatus FileCacheManager::ReadKVRequest(
     const std::vector<S3ReadRequest>& kv_requests, char* data_buf,
-    uint64_t file_len) {
+    uint64_t file_len, uint32_t readahead_blocks) {
   absl::BlockingCounter counter(kv_requests.size());
   std::once_flag cancel_flag;
   std::atomic<bool> is_canceled{false};
@@ -592,8 +849,8 @@ FileCacheManager::ReadStatus FileCacheManager::ReadKVRequest(
         LOG(WARNING) << "kv request is canceled " << req.DebugString();
         return;
       }
-      ProcessKVRequest(req, data_buf, file_len, cancel_flag, is_canceled,
-                       ret_code);
+      ProcessKVRequest(req, data_buf, file_len, readahead_blocks, cancel_flag,
+                       is_canceled, ret_code);
     });
   }
 
@@ -607,6 +864,7 @@ FileCacheManager::ReadStatus FileCacheManager::ReadKVRequest(
 
 void FileCacheManager::ProcessKVRequest(const S3ReadRequest& req,
                                         char* data_buf, uint64_t file_len,
+                                        uint32_t readahead_blocks,
                                         std::once_flag& cancel_flag,
                                         std::atomic<bool>& is_canceled,
                                         std::atomic<BCACHE_ERROR>& ret_code) {
@@ -620,9 +878,10 @@ void FileCacheManager::ProcessKVRequest(const S3ReadRequest& req,
 
   const uint64_t chunk_size = s3ClientAdaptor_->GetChunkSize();
   const uint64_t block_size = s3ClientAdaptor_->GetBlockSize();
-  // prefetch
-  if (s3ClientAdaptor_->HasDiskCache()) {
-    PrefetchForBlock(req, file_len, block_size, chunk_size, block_index);
+  // prefetch, into disk cache if exists, otherwise into memory
+  if (readahead_blocks > 0) {
+    PrefetchForBlock(req, file_len, block_size, chunk_size, block_index,
+                     readahead_blocks);
   }
 
   // read request
@@ -645,12 +904,30 @@ void FileCacheManager::ProcessKVRequest(const S3ReadRequest& req,
                  req.compaction);
     char* current_buf = data_buf + req.readOffset + read_buf_offset;
 
-    // read from localcache -> remotecache -> s3
+    // read from readahead -> localcache -> remotecache -> s3
     do {
       std::string name = key.Filename();
       std::string store_key = key.StoreKey();
-      if (ReadKVRequestFromLocalCache(
-              key, current_buf, block_pos - object_offset, current_read_len)) {
+      if (ReadKVRequestFromReadahead(store_key, current_buf,
+                                     block_pos - object_offset,
+                                     current_read_len)) {
+        VLOG(9) << "inodeId=" << inode_ << " read " << store_key
+                << " from readahead ok";
+        ReadaheadMetric::GetInstance().hits << 1;
+        break;
+      }
+
+      bool local = ReadKVRequestFromLocalCache(
+          key, current_buf, block_pos - object_offset, current_read_len);
+
+      // only the blocks prefetched by readahead count as readahead hits
+      if (local && readaheadHistory_.Contains(store_key)) {
+        ReadaheadMetric::GetInstance().hits << 1;
+      } else if (readahead_blocks > 0) {
+        ReadaheadMetric::GetInstance().misses << 1;
+      }
+
+      if (local) {
         VLOG(9) << "inodeId=" << inode_ << " read " << store_key
                 << " from local cache ok";
         break;
@@ -664,7 +941,7 @@ void FileCacheManager::ProcessKVRequest(const S3ReadRequest& req,
       }
 
       BCACHE_ERROR rc = BCACHE_ERROR::OK;
-      if (ReadKVRequestFromS3(store_key, current_buf, block_pos - object_offset,
+      if (ReadKVRequestFromS3(key, current_buf, block_pos - object_offset,
                               current_read_len, &rc)) {
         VLOG(9) << "inodeId=" << inode_ << " read " << store_key
                 << " from s3 ok";
@@ -697,8 +974,8 @@ void FileCacheManager::ProcessKVRequest(const S3ReadRequest& req,
 void FileCacheManager::PrefetchForBlock(const S3ReadRequest& req,
                                         uint64_t fileLen, uint64_t blockSize,
                                         uint64_t chunkSize,
-                                        uint64_t startBlockIndex) {
-  uint32_t prefetchBlocks = s3ClientAdaptor_->GetPrefetchBlocks();
+                                        uint64_t startBlockIndex,
+                                        uint32_t prefetchBlocks) {
   uint32_t objectPrefix = s3ClientAdaptor_->GetObjectPrefix();
   std::vector<std::pair<BlockKey, uint64_t>> prefetchObjs;
 
@@ -750,12 +1027,23 @@ class AsyncPrefetchCallback {
       return;
     }
 
-    auto block_cache = s3Client_->GetBlockCache();
-    Block block(context->buf, context->actualLen);
-    auto rc = block_cache->Cache(key, block);
-    if (rc != BCACHE_ERROR::OK) {
-      LOG_EVERY_SECOND(INFO)
-          << "Cache block( " << key.Filename() << ") failed: " << StrErr(rc);
+    ReadaheadMetric::GetInstance().prefetch_bytes << context->actualLen;
+    if (s3Client_->HasCacheStore()) {
+      auto block_cache = s3Client_->GetBlockCache();
+      Block block(context->buf, context->actualLen);
+      auto rc = block_cache->Cache(key, block);
+      if (rc != BCACHE_ERROR::OK) {
+        LOG_EVERY_SECOND(INFO)
+            << "Cache block( " << key.Filename() << ") failed: " << StrErr(rc);
+      } else {
+        file_cache->readaheadHistory_.Add(context->key,
+                                          2 * FLAGS_s3_readahead_max_blocks);
+      }
+    } else if (!file_cache->readaheadBuffer_.Put(
+                   context->key, std::move(guard), context->actualLen,
+                   FLAGS_s3_readahead_max_blocks)) {
+      VLOG(9) << "Drop readahead block " << context->key
+              << ", memory used: " << ReadaheadBuffer::UsedBytes();
     }
 
     {
@@ -784,7 +1072,8 @@ void FileCacheManager::PrefetchS3Objs(
               << ", size: " << downloadingObj_.size();
       continue;
     }
-    if (s3ClientAdaptor_->GetBlockCache()->IsCached(key)) {
+    if (s3ClientAdaptor_->GetBlockCache()->IsCached(key) ||
+        readaheadBuffer_.IsCached(name)) {
       VLOG(9) << "inodeId=" << key.ino
               << " downloading is exist in cache: " << name
               << ", size: " << downloadingObj_.size();
@@ -1068,6 +1357,8 @@ void FileCacheManager::ReleaseCache() {
 
   chunkCacheMap_.clear();
   g_s3MultiManagerMetric->chunkManagerNum << -1 * chunNum;
+  readaheadBuffer_.Clear();
+  readaheadHistory_.Clear();
 }
 
 void FileCacheManager::TruncateCache(uint64_t offset, uint64_t fileSize) {
@@ -1418,11 +1709,33 @@ void ChunkCacheManager::ReadByReadCache(uint64_t chunkPos, uint64_t readLen,
   return;
 }
 
+// protect by flushingDataCacheMtx_
 void ChunkCacheManager::ReadByFlushData(uint64_t chunkPos, uint64_t readLen,
                                         char* dataBuf, uint64_t dataBufOffset,
                                         std::vector<ReadRequest>* requests) {
-  uint64_t dcChunkPos = flushingDataCache_->GetChunkPos();
-  uint64_t dcLen = flushingDataCache_->GetLen();
+  // the flushing DataCaches never overlap, so the missed parts of one
+  // DataCache are read from the others
+  std::vector<ReadRequest> missRequests{
+      ReadRequest{index_, chunkPos, readLen, dataBufOffset}};
+  for (const auto& dataCache : flushingDataCaches_) {
+    std::vector<ReadRequest> tmpRequests;
+    for (const auto& request : missRequests) {
+      ReadByFlushingDataCache(dataCache, request.chunkPos, request.len,
+                              dataBuf, request.bufOffset, &tmpRequests);
+    }
+    missRequests.swap(tmpRequests);
+    if (missRequests.empty()) {
+      break;
+    }
+  }
+  requests->insert(requests->end(), missRequests.begin(), missRequests.end());
+}
+
+void ChunkCacheManager::ReadByFlushingDataCache(
+    const DataCachePtr& dataCache, uint64_t chunkPos, uint64_t readLen,
+    char* dataBuf, uint64_t dataBufOffset, std::vector<ReadRequest>* requests) {
+  uint64_t dcChunkPos = dataCache->GetChunkPos();
+  uint64_t dcLen = dataCache->GetLen();
   ReadRequest request;
   VLOG(9) << "Try to ReadByFlushData chunkPos: " << chunkPos
           << ", readLen: " << readLen << ", dcChunkPos: " << dcChunkPos
@@ -1447,9 +1760,8 @@ void ChunkCacheManager::ReadByFlushData(uint64_t chunkPos, uint64_t readLen,
             ------           DataCache
     */
     if (chunkPos + readLen <= dcChunkPos + dcLen) {
-      flushingDataCache_->CopyDataCacheToBuf(
-          0, chunkPos + readLen - dcChunkPos,
-          dataBuf + request.len + dataBufOffset);
+      dataCache->CopyDataCacheToBuf(0, chunkPos + readLen - dcChunkPos,
+                                    dataBuf + request.len + dataBufOffset);
       readLen = 0;
       return;
       /*
@@ -1457,8 +1769,8 @@ void ChunkCacheManager::ReadByFlushData(uint64_t chunkPos, uint64_t readLen,
               ------           DataCache
       */
     } else {
-      flushingDataCache_->CopyDataCacheToBuf(
-          0, dcLen, dataBuf + request.len + dataBufOffset);
+      dataCache->CopyDataCacheToBuf(0, dcLen,
+                                    dataBuf + request.len + dataBufOffset);
       readLen = chunkPos + readLen - (dcChunkPos + dcLen);
       dataBufOffset = dcChunkPos + dcLen - chunkPos + dataBufOffset;
       chunkPos = dcChunkPos + dcLen;
@@ -1469,8 +1781,8 @@ void ChunkCacheManager::ReadByFlushData(uint64_t chunkPos, uint64_t readLen,
            ---------           DataCache
     */
     if (chunkPos + readLen <= dcChunkPos + dcLen) {
-      flushingDataCache_->CopyDataCacheToBuf(chunkPos - dcChunkPos, readLen,
-                                             dataBuf + dataBufOffset);
+      dataCache->CopyDataCacheToBuf(chunkPos - dcChunkPos, readLen,
+                                    dataBuf + dataBufOffset);
       readLen = 0;
       return;
       /*
@@ -1478,9 +1790,9 @@ void ChunkCacheManager::ReadByFlushData(uint64_t chunkPos, uint64_t readLen,
              ---------                DataCache
       */
     } else {
-      flushingDataCache_->CopyDataCacheToBuf(chunkPos - dcChunkPos,
-                                             dcChunkPos + dcLen - chunkPos,
-                                             dataBuf + dataBufOffset);
+      dataCache->CopyDataCacheToBuf(chunkPos - dcChunkPos,
+                                    dcChunkPos + dcLen - chunkPos,
+                                    dataBuf + dataBufOffset);
       readLen = chunkPos + readLen - dcChunkPos - dcLen;
       dataBufOffset = dcChunkPos + dcLen - chunkPos + dataBufOffset;
       chunkPos = dcChunkPos + dcLen;
@@ -1537,8 +1849,7 @@ DataCachePtr ChunkCacheManager::FindWriteableDataCache(
         s3ClientAdaptor_->GetFsCacheManager()->DataCacheNumFetchSub(1);
         VLOG(9) << "FindWriteableDataCache() DataCacheByteDec1 len:"
                 << iter->second->GetLen();
-        s3ClientAdaptor_->GetFsCacheManager()->DataCacheByteDec(
-            iter->second->GetActualLen());
+        DataCacheByteDec(iter->second->GetActualLen());
         dataWCacheMap_.erase(iter);
       }
       return dataCache;
@@ -1553,7 +1864,22 @@ void ChunkCacheManager::WriteNewDataCache(S3ClientAdaptorImpl* s3ClientAdaptor,
   DataCachePtr data_cache =
       std::make_shared<DataCache>(s3ClientAdaptor, this->shared_from_this(),
                                   chunkPos, len, data, kvClientManager_);
-  VLOG(9) << "WriteNewDataCache chunkPos:" << chunkPos << ", len:" << len
+  AddNewDataCache(data_cache);
+}
+
+void ChunkCacheManager::WriteNewDataCache(S3ClientAdaptorImpl* s3ClientAdaptor,
+                                          uint32_t chunkPos, uint32_t len,
+                                          WriteBuffer* buffer,
+                                          uint64_t bufPos) {
+  DataCachePtr data_cache = std::make_shared<DataCache>(
+      s3ClientAdaptor, this->shared_from_this(), chunkPos, len, buffer, bufPos,
+      kvClientManager_);
+  AddNewDataCache(data_cache);
+}
+
+void ChunkCacheManager::AddNewDataCache(const DataCachePtr& data_cache) {
+  uint64_t chunkPos = data_cache->GetChunkPos();
+  VLOG(9) << "WriteNewDataCache chunkPos:" << chunkPos
           << ", new len:" << data_cache->GetLen() << ", chunkIndex:" << index_;
   WriteLockGuard write_lock_guard(rwLockWrite_);
   auto ret = dataWCacheMap_.emplace(chunkPos, data_cache);
@@ -1563,8 +1889,7 @@ void ChunkCacheManager::WriteNewDataCache(S3ClientAdaptorImpl* s3ClientAdaptor,
   }
 
   s3ClientAdaptor_->FsSyncSignalAndDataCacheInc();
-  s3ClientAdaptor_->GetFsCacheManager()->DataCacheByteInc(
-      data_cache->GetActualLen());
+  DataCacheByteInc(data_cache->GetActualLen());
 }
 
 // TODO: remove read cache becase read performance is degraded compare to cto
@@ -1626,8 +1951,7 @@ void ChunkCacheManager::ReleaseCache() {
 
     for (auto& dataWCache : dataWCacheMap_) {
       s3ClientAdaptor_->GetFsCacheManager()->DataCacheNumFetchSub(1);
-      s3ClientAdaptor_->GetFsCacheManager()->DataCacheByteDec(
-          dataWCache.second->GetActualLen());
+      DataCacheByteDec(dataWCache.second->GetActualLen());
     }
     dataWCacheMap_.clear();
   }
@@ -1659,12 +1983,11 @@ void ChunkCacheManager::TruncateWriteCache(uint64_t chunkPos) {
     uint64_t dcActualLen = rIter->second->GetActualLen();
     if (dcChunkPos >= chunkPos) {
       s3ClientAdaptor_->GetFsCacheManager()->DataCacheNumFetchSub(1);
-      s3ClientAdaptor_->GetFsCacheManager()->DataCacheByteDec(dcActualLen);
+      DataCacheByteDec(dcActualLen);
       dataWCacheMap_.erase(next(rIter).base());
     } else if ((dcChunkPos < chunkPos) && ((dcChunkPos + dcLen) > chunkPos)) {
       rIter->second->Truncate(chunkPos - dcChunkPos);
-      s3ClientAdaptor_->GetFsCacheManager()->DataCacheByteDec(
-          dcActualLen - rIter->second->GetActualLen());
+      DataCacheByteDec(dcActualLen - rIter->second->GetActualLen());
       break;
     } else {
       break;
@@ -1691,76 +2014,95 @@ void ChunkCacheManager::TruncateReadCache(uint64_t chunkPos) {
   }
 }
 
+void ChunkCacheManager::DataCacheByteInc(uint64_t v) {
+  DirtyBytesInc(v);
+  s3ClientAdaptor_->GetFsCacheManager()->DataCacheByteInc(v);
+}
+
+void ChunkCacheManager::DataCacheByteDec(uint64_t v) {
+  DirtyBytesDec(v);
+  s3ClientAdaptor_->GetFsCacheManager()->DataCacheByteDec(v);
+}
+
 void ChunkCacheManager::ReleaseWriteDataCache(const DataCachePtr& dataCache) {
   s3ClientAdaptor_->GetFsCacheManager()->DataCacheNumFetchSub(1);
   VLOG(9) << "chunk flush DataCacheByteDec len:" << dataCache->GetActualLen();
-  s3ClientAdaptor_->GetFsCacheManager()->DataCacheByteDec(
-      dataCache->GetActualLen());
+  DataCacheByteDec(dataCache->GetActualLen());
 }
 
+// The flushable DataCaches are picked in rounds, the DataCaches picked in
+// one round never overlap, so their block uploads are pipelined (bounded
+// by the flush window of file) and the S3ChunkInfos are committed in the
+// order of picking. The next round starts after all of them committed,
+// so the later written data always has the larger chunk id.
 DINGOFS_ERROR ChunkCacheManager::Flush(uint64_t inodeId, bool force,
                                        bool toS3) {
-  std::map<uint64_t, DataCachePtr> tmp;
   dingofs::utils::LockGuard lg(flushMtx_);
-  DINGOFS_ERROR ret = DINGOFS_ERROR::OK;
-  // DataCachePtr dataCache;
   while (1) {
-    bool isFlush = false;
+    std::vector<DataCachePtr> flushing;
     {
       WriteLockGuard writeLockGuard(rwLockChunk_);
 
       auto iter = dataWCacheMap_.begin();
       while (iter != dataWCacheMap_.end()) {
         if (iter->second->CanFlush(force)) {
-          {
-            dingofs::utils::LockGuard lg(flushingDataCacheMtx_);
-            flushingDataCache_ = std::move(iter->second);
-          }
-          dataWCacheMap_.erase(iter);
-          isFlush = true;
-          break;
+          flushing.emplace_back(std::move(iter->second));
+          iter = dataWCacheMap_.erase(iter);
         } else {
           iter++;
         }
       }
-    }
-    if (isFlush) {
-      VLOG(9) << "Flush datacache chunkPos:"
-              << flushingDataCache_->GetChunkPos()
-              << ", len:" << flushingDataCache_->GetLen()
-              << ", inodeId=" << inodeId << ", chunkIndex:" << index_;
-      assert(flushingDataCache_->IsDirty());
-      do {
-        ret = flushingDataCache_->Flush(inodeId, toS3);
-        if (ret == DINGOFS_ERROR::NOTEXIST) {
-          LOG(WARNING) << "dataCache flush failed. ret:" << ret
-                       << ", index:" << index_ << ", data chunkpos:"
-                       << flushingDataCache_->GetChunkPos();
-          ReleaseWriteDataCache(flushingDataCache_);
-          break;
-        } else if (ret == DINGOFS_ERROR::INTERNAL) {
-          LOG(WARNING) << "dataCache flush failed. ret:" << ret
-                       << ", index:" << index_ << ", data chunkpos:"
-                       << flushingDataCache_->GetChunkPos()
-                       << ", should retry.";
-          ::sleep(3);
-          continue;
-        }
-        VLOG(9) << "ReleaseWriteDataCache chunkPos:"
-                << flushingDataCache_->GetChunkPos()
-                << ", len:" << flushingDataCache_->GetLen()
-                << ", inodeId=" << inodeId << ", chunkIndex:" << index_;
-        ReleaseWriteDataCache(flushingDataCache_);
-      } while (ret != DINGOFS_ERROR::OK);
-      {
+
+      if (!flushing.empty()) {
         dingofs::utils::LockGuard lg(flushingDataCacheMtx_);
-        flushingDataCache_ = nullptr;
+        flushingDataCaches_ = flushing;
       }
-    } else {
+    }
+    if (flushing.empty()) {
       VLOG(9) << "can not find flush datacache, inodeId=" << inodeId
               << ", chunkIndex:" << index_;
       break;
     }
+
+    std::vector<DINGOFS_ERROR> rets;
+    for (const auto& dataCache : flushing) {
+      VLOG(9) << "Flush datacache chunkPos:" << dataCache->GetChunkPos()
+              << ", len:" << dataCache->GetLen() << ", inodeId=" << inodeId
+              << ", chunkIndex:" << index_;
+      assert(dataCache->IsDirty());
+      rets.emplace_back(dataCache->FlushAsync(inodeId, toS3, flushWindow_));
+    }
+
+    for (size_t i = 0; i < flushing.size(); i++) {
+      const auto& dataCache = flushing[i];
+      DINGOFS_ERROR ret = rets[i];
+      if (ret == DINGOFS_ERROR::OK) {
+        ret = dataCache->WaitFlush(inodeId);
+      }
+      while (ret == DINGOFS_ERROR::INTERNAL) {
+        LOG(WARNING) << "dataCache flush failed. ret:" << ret
+                     << ", index:" << index_
+                     << ", data chunkpos:" << dataCache->GetChunkPos()
+                     << ", should retry.";
+        ::sleep(3);
+        ret = dataCache->Flush(inodeId, toS3);
+      }
+
+      if (ret != DINGOFS_ERROR::OK) {
+        LOG(WARNING) << "dataCache flush failed. ret:" << ret
+                     << ", index:" << index_
+                     << ", data chunkpos:" << dataCache->GetChunkPos();
+      }
+      VLOG(9) << "ReleaseWriteDataCache chunkPos:" << dataCache->GetChunkPos()
+              << ", len:" << dataCache->GetLen() << ", inodeId=" << inodeId
+              << ", chunkIndex:" << index_;
+      ReleaseWriteDataCache(dataCache);
+    }
+
+    {
+      dingofs::utils::LockGuard lg(flushingDataCacheMtx_);
+      flushingDataCaches_.clear();
+    }
   }
   return DINGOFS_ERROR::OK;
 }
@@ -1785,216 +2127,137 @@ void ChunkCacheManager::AddWriteDataCacheForTest(DataCachePtr dataCache) {
 
   dataWCacheMap_.emplace(dataCache->GetChunkPos(), dataCache);
   s3ClientAdaptor_->GetFsCacheManager()->DataCacheNumInc();
-  s3ClientAdaptor_->GetFsCacheManager()->DataCacheByteInc(
-      dataCache->GetActualLen());
+  DataCacheByteInc(dataCache->GetActualLen());
 }
 
 DataCache::DataCache(S3ClientAdaptorImpl* s3ClientAdaptor,
                      ChunkCacheManagerPtr chunkCacheManager, uint64_t chunkPos,
                      uint64_t len, const char* data,
                      std::shared_ptr<KVClientManager> kvClientManager)
-    : s3ClientAdaptor_(std::move(s3ClientAdaptor)),
+    : s3ClientAdaptor_(s3ClientAdaptor),
       chunkCacheManager_(chunkCacheManager),
+      chunkPos_(chunkPos),
+      len_(0),
+      actualChunkPos_(chunkPos - chunkPos % s3ClientAdaptor->GetPageSize()),
+      actualLen_(0),
+      createTime_(::dingofs::utils::TimeUtility::GetTimeofDaySec()),
       status_(DataCacheStatus::Dirty),
-      inReadCache_(false) {
-  uint64_t blockSize = s3ClientAdaptor->GetBlockSize();
-  uint32_t pageSize = s3ClientAdaptor->GetPageSize();
-  chunkPos_ = chunkPos;
-  len_ = len;
-  actualChunkPos_ = chunkPos - chunkPos % pageSize;
-
-  uint64_t headZeroLen = chunkPos - actualChunkPos_;
-  uint64_t blockIndex = chunkPos / blockSize;
-  uint64_t blockPos = chunkPos % blockSize;
-  uint64_t pageIndex, pagePos;
-  uint64_t n, m, blockLen;
-  uint64_t dataOffset = 0;
-  uint64_t tailZeroLen = 0;
-
-  while (len > 0) {
-    if (blockPos + len > blockSize) {
-      n = blockSize - blockPos;
-    } else {
-      n = len;
-    }
-    PageDataMap& pdMap = dataMap_[blockIndex];
-    blockLen = n;
-    pageIndex = blockPos / pageSize;
-    pagePos = blockPos % pageSize;
-    while (blockLen > 0) {
-      if (pagePos + blockLen > pageSize) {
-        m = pageSize - pagePos;
-      } else {
-        m = blockLen;
-      }
-
-      PageData* pageData = new PageData();
-      pageData->data = DataStream::GetInstance().NewPage();
-      memcpy(pageData->data + pagePos, data + dataOffset, m);
-      if (pagePos + m < pageSize) {
-        tailZeroLen = pageSize - pagePos - m;
-      }
-      pageData->index = pageIndex;
-      assert(pdMap.count(pageIndex) == 0);
-      pdMap.emplace(pageIndex, pageData);
-      pageIndex++;
-      blockLen -= m;
-      dataOffset += m;
-      pagePos = (pagePos + m) % pageSize;
-    }
-
-    blockIndex++;
-    len -= n;
-    blockPos = (blockPos + n) % blockSize;
-  }
-  actualLen_ = headZeroLen + len_ + tailZeroLen;
-  assert((actualLen_ % pageSize) == 0);
-  assert((actualChunkPos_ % pageSize) == 0);
-  createTime_ = ::dingofs::utils::TimeUtility::GetTimeofDaySec();
+      inReadCache_(false),
+      kvClientManager_(std::move(kvClientManager)) {
+  // every page covered by the data is new, so the actualLen_ is aligned
+  CopyBufToDataCache(0, len, data);
+  assert((actualLen_ % s3ClientAdaptor->GetPageSize()) == 0);
+}
 
-  kvClientManager_ = std::move(kvClientManager);
+DataCache::DataCache(S3ClientAdaptorImpl* s3ClientAdaptor,
+                     ChunkCacheManagerPtr chunkCacheManager, uint64_t chunkPos,
+                     uint64_t len, WriteBuffer* buffer, uint64_t bufPos,
+                     std::shared_ptr<KVClientManager> kvClientManager)
+    : s3ClientAdaptor_(s3ClientAdaptor),
+      chunkCacheManager_(chunkCacheManager),
+      chunkPos_(chunkPos),
+      len_(0),
+      actualChunkPos_(chunkPos - chunkPos % s3ClientAdaptor->GetPageSize()),
+      actualLen_(0),
+      createTime_(::dingofs::utils::TimeUtility::GetTimeofDaySec()),
+      status_(DataCacheStatus::Dirty),
+      inReadCache_(false),
+      kvClientManager_(std::move(kvClientManager)) {
+  // every page covered by the data is new, so the actualLen_ is aligned
+  CopyBufToDataCache(0, len, buffer, bufPos);
+  assert((actualLen_ % s3ClientAdaptor->GetPageSize()) == 0);
 }
 
 void DataCache::CopyBufToDataCache(uint64_t dataCachePos, uint64_t len,
                                    const char* data) {
-  uint64_t blockSize = s3ClientAdaptor_->GetBlockSize();
   uint32_t pageSize = s3ClientAdaptor_->GetPageSize();
   uint64_t pos = chunkPos_ + dataCachePos;
-  uint64_t blockIndex = pos / blockSize;
-  uint64_t blockPos = pos % blockSize;
-  uint64_t pageIndex, pagePos;
-  uint64_t n, blockLen, m;
+  uint64_t pageIndex = pos / pageSize;
+  uint64_t pagePos = pos % pageSize;
   uint64_t dataOffset = 0;
-  uint64_t addLen = 0;
+  uint64_t n;
+  bool created;
 
   VLOG(9) << "CopyBufToDataCache() dataCachePos:" << dataCachePos
           << ", len:" << len << ", chunkPos_:" << chunkPos_
           << ", len_:" << len_;
+  if (dataCachePos + len > len_) {
+    len_ = dataCachePos + len;
+  }
+  while (dataOffset < len) {
+    n = std::min(len - dataOffset, pageSize - pagePos);
+    char* page = pages_.GetOrNew(pageIndex, &created);
+    if (created) {
+      actualLen_ += pageSize;
+    }
+    memcpy(page + pagePos, data + dataOffset, n);
+    pageIndex++;
+    dataOffset += n;
+    pagePos = 0;
+  }
+  VLOG(9) << "chunkPos:" << chunkPos_ << ", len:" << len_
+          << ", actualChunkPos_:" << actualChunkPos_
+          << ", actualLen:" << actualLen_;
+}
+
+// Same as above, but the page which fully covered by the data and not
+// exist yet is taken from |buffer| directly.
+void DataCache::CopyBufToDataCache(uint64_t dataCachePos, uint64_t len,
+                                   WriteBuffer* buffer, uint64_t bufPos) {
+  uint32_t pageSize = s3ClientAdaptor_->GetPageSize();
+  uint64_t pos = chunkPos_ + dataCachePos;
+  uint64_t pageIndex = pos / pageSize;
+  uint64_t pagePos = pos % pageSize;
+  uint64_t dataOffset = bufPos;
+  uint64_t n;
+  bool created;
+
   if (dataCachePos + len > len_) {
     len_ = dataCachePos + len;
   }
   while (len > 0) {
-    if (blockPos + len > blockSize) {
-      n = blockSize - blockPos;
+    n = std::min(len, pageSize - pagePos);
+    if (n == pageSize && pages_.Get(pageIndex) == nullptr) {
+      pages_.Put(pageIndex, buffer->TakePage(dataOffset));
+      actualLen_ += pageSize;
     } else {
-      n = len;
-    }
-    blockLen = n;
-    PageDataMap& pdMap = dataMap_[blockIndex];
-    PageData* pageData;
-    pageIndex = blockPos / pageSize;
-    pagePos = blockPos % pageSize;
-    while (blockLen > 0) {
-      if (pagePos + blockLen > pageSize) {
-        m = pageSize - pagePos;
-      } else {
-        m = blockLen;
-      }
-      if (pdMap.count(pageIndex)) {
-        pageData = pdMap[pageIndex];
-      } else {
-        pageData = new PageData();
-        pageData->data = DataStream::GetInstance().NewPage();
-        pageData->index = pageIndex;
-        pdMap.emplace(pageIndex, pageData);
-        addLen += pageSize;
+      char* page = pages_.GetOrNew(pageIndex, &created);
+      if (created) {
+        actualLen_ += pageSize;
       }
-      memcpy(pageData->data + pagePos, data + dataOffset, m);
-      pageIndex++;
-      blockLen -= m;
-      dataOffset += m;
-      pagePos = (pagePos + m) % pageSize;
+      memcpy(page + pagePos, buffer->Data(dataOffset), n);
     }
-
-    blockIndex++;
+    pageIndex++;
     len -= n;
-    blockPos = (blockPos + n) % blockSize;
+    dataOffset += n;
+    pagePos = 0;
   }
-  actualLen_ += addLen;
-  VLOG(9) << "chunkPos:" << chunkPos_ << ", len:" << len_
-          << ", actualChunkPos_:" << actualChunkPos_
-          << ", actualLen:" << actualLen_;
 }
 
 void DataCache::AddDataBefore(uint64_t len, const char* data) {
-  uint64_t blockSize = s3ClientAdaptor_->GetBlockSize();
   uint32_t pageSize = s3ClientAdaptor_->GetPageSize();
-  uint64_t tmpLen = len;
-  uint64_t newChunkPos = chunkPos_ - len;
-  uint64_t blockIndex = newChunkPos / blockSize;
-  uint64_t blockPos = newChunkPos % blockSize;
-  uint64_t pageIndex, pagePos;
-  uint64_t n, m, blockLen;
-  uint64_t dataOffset = 0;
 
   VLOG(9) << "AddDataBefore() len:" << len << ", len_:" << len_
           << "chunkPos:" << chunkPos_ << ", actualChunkPos:" << actualChunkPos_
           << ", len:" << len_ << ", actualLen:" << actualLen_;
-  while (tmpLen > 0) {
-    if (blockPos + tmpLen > blockSize) {
-      n = blockSize - blockPos;
-    } else {
-      n = tmpLen;
-    }
-
-    PageDataMap& pdMap = dataMap_[blockIndex];
-    blockLen = n;
-    PageData* pageData = NULL;
-    pageIndex = blockPos / pageSize;
-    pagePos = blockPos % pageSize;
-    while (blockLen > 0) {
-      if (pagePos + blockLen > pageSize) {
-        m = pageSize - pagePos;
-      } else {
-        m = blockLen;
-      }
-
-      if (pdMap.count(pageIndex)) {
-        pageData = pdMap[pageIndex];
-      } else {
-        pageData = new PageData();
-        pageData->data = DataStream::GetInstance().NewPage();
-        pageData->index = pageIndex;
-        pdMap.emplace(pageIndex, pageData);
-      }
-      memcpy(pageData->data + pagePos, data + dataOffset, m);
-      pageIndex++;
-      blockLen -= m;
-      dataOffset += m;
-      pagePos = (pagePos + m) % pageSize;
-    }
-    blockIndex++;
-    tmpLen -= n;
-    blockPos = (blockPos + n) % blockSize;
-  }
-  chunkPos_ = newChunkPos;
+  chunkPos_ -= len;
   actualChunkPos_ = chunkPos_ - chunkPos_ % pageSize;
   len_ += len;
-  if ((chunkPos_ + len_ - actualChunkPos_) % pageSize == 0) {
-    actualLen_ = chunkPos_ + len_ - actualChunkPos_;
-  } else {
-    actualLen_ =
-        ((chunkPos_ + len_ - actualChunkPos_) / pageSize + 1) * pageSize;
-  }
-  VLOG(9) << "chunkPos:" << chunkPos_ << ", len:" << len_
-          << ", actualChunkPos_:" << actualChunkPos_
-          << ", actualLen:" << actualLen_;
+  CopyBufToDataCache(0, len, data);
+}
+
+void DataCache::DataCacheByteInc(uint64_t v) {
+  chunkCacheManager_->DirtyBytesInc(v);
+  s3ClientAdaptor_->GetFsCacheManager()->DataCacheByteInc(v);
 }
 
 void DataCache::MergeDataCacheToDataCache(DataCachePtr mergeDataCache,
                                           uint64_t dataOffset, uint64_t len) {
-  uint64_t blockSize = s3ClientAdaptor_->GetBlockSize();
   uint32_t pageSize = s3ClientAdaptor_->GetPageSize();
-  uint64_t maxPageInBlock = blockSize / pageSize;
   uint64_t chunkPos = mergeDataCache->GetChunkPos() + dataOffset;
   assert(chunkPos == (chunkPos_ + len_));
-  uint64_t blockIndex = chunkPos / blockSize;
-  uint64_t blockPos = chunkPos % blockSize;
-  uint64_t pageIndex = blockPos / pageSize;
-  uint64_t pagePos = blockPos % pageSize;
-  char* data = nullptr;
-  PageData* mergePage = nullptr;
-  PageDataMap* pdMap = &dataMap_[blockIndex];
+  uint64_t pageIndex = chunkPos / pageSize;
+  uint64_t pagePos = chunkPos % pageSize;
   uint64_t n = 0;
 
   VLOG(9) << "MergeDataCacheToDataCache dataOffset:" << dataOffset
@@ -2005,43 +2268,27 @@ void DataCache::MergeDataCacheToDataCache(DataCachePtr mergeDataCache,
   assert((dataOffset + len) == mergeDataCache->GetLen());
   len_ += len;
   while (len > 0) {
-    if (pageIndex == maxPageInBlock) {
-      blockIndex++;
-      pageIndex = 0;
-      pdMap = &dataMap_[blockIndex];
-    }
-    mergePage = mergeDataCache->GetPageData(blockIndex, pageIndex);
-    assert(mergePage);
-    if (pdMap->count(pageIndex)) {
-      data = (*pdMap)[pageIndex]->data;
-      if (pagePos + len > pageSize) {
-        n = pageSize - pagePos;
-      } else {
-        n = len;
-      }
+    n = std::min(len, pageSize - pagePos);
+    char* page = pages_.Get(pageIndex);
+    if (page != nullptr) {
+      char* mergePage = mergeDataCache->GetPage(pageIndex);
+      assert(mergePage);
       VLOG(9) << "MergeDataCacheToDataCache n:" << n << ", pagePos:" << pagePos;
-      memcpy(data + pagePos, mergePage->data + pagePos, n);
-      // mergeDataCache->ReleasePageData(blockIndex, pageIndex);
+      memcpy(page + pagePos, mergePage + pagePos, n);
     } else {
-      pdMap->emplace(pageIndex, mergePage);
-      mergeDataCache->ErasePageData(blockIndex, pageIndex);
-      n = pageSize;
+      char* mergePage = mergeDataCache->TakePage(pageIndex);
+      assert(mergePage);
+      pages_.Put(pageIndex, mergePage);
       actualLen_ += pageSize;
       VLOG(9) << "MergeDataCacheToDataCache n:" << n;
     }
-
-    if (len >= n) {
-      len -= n;
-    } else {
-      len = 0;
-    }
+    len -= n;
     pageIndex++;
     pagePos = 0;
   }
   VLOG(9) << "MergeDataCacheToDataCache end chunkPos:" << chunkPos_
           << ", len:" << len_ << ", actualChunkPos:" << actualChunkPos_
           << ",  actualLen:" << actualLen_;
-  return;
 }
 
 void DataCache::Write(uint64_t chunkPos, uint64_t len, const char* data,
@@ -2072,7 +2319,7 @@ void DataCache::Write(uint64_t chunkPos, uint64_t len, const char* data,
                          data + chunkPos_ - chunkPos);
       AddDataBefore(chunkPos_ - chunkPos, data);
       addByte = actualLen_ - oldSize;
-      s3ClientAdaptor_->GetFsCacheManager()->DataCacheByteInc(addByte);
+      DataCacheByteInc(addByte);
       chunkCacheManager_->UpdateWriteCacheMap(oldChunkPos, this);
       chunkCacheManager_->rwLockWrite_.Unlock();
       return;
@@ -2094,7 +2341,7 @@ void DataCache::Write(uint64_t chunkPos, uint64_t len, const char* data,
               (*iter)->GetChunkPos() + (*iter)->GetLen() - chunkPos - len);
           AddDataBefore(chunkPos_ - chunkPos, data);
           addByte = actualLen_ - oldSize;
-          s3ClientAdaptor_->GetFsCacheManager()->DataCacheByteInc(addByte);
+          DataCacheByteInc(addByte);
           chunkCacheManager_->UpdateWriteCacheMap(oldChunkPos, this);
           chunkCacheManager_->rwLockWrite_.Unlock();
           return;
@@ -2110,7 +2357,7 @@ void DataCache::Write(uint64_t chunkPos, uint64_t len, const char* data,
                          data + chunkPos_ - chunkPos);
       AddDataBefore(chunkPos_ - chunkPos, data);
       addByte = actualLen_ - oldSize;
-      s3ClientAdaptor_->GetFsCacheManager()->DataCacheByteInc(addByte);
+      DataCacheByteInc(addByte);
       chunkCacheManager_->UpdateWriteCacheMap(oldChunkPos, this);
       chunkCacheManager_->rwLockWrite_.Unlock();
       return;
@@ -2141,7 +2388,7 @@ void DataCache::Write(uint64_t chunkPos, uint64_t len, const char* data,
               (*iter), chunkPos + len - (*iter)->GetChunkPos(),
               (*iter)->GetChunkPos() + (*iter)->GetLen() - chunkPos - len);
           addByte = actualLen_ - oldSize;
-          s3ClientAdaptor_->GetFsCacheManager()->DataCacheByteInc(addByte);
+          DataCacheByteInc(addByte);
           return;
         }
       }
@@ -2152,65 +2399,47 @@ void DataCache::Write(uint64_t chunkPos, uint64_t len, const char* data,
       oldSize = actualLen_;
       CopyBufToDataCache(chunkPos - chunkPos_, len, data);
       addByte = actualLen_ - oldSize;
-      s3ClientAdaptor_->GetFsCacheManager()->DataCacheByteInc(addByte);
+      DataCacheByteInc(addByte);
     }
   }
   return;
 }
 
+void DataCache::WriteBuf(uint64_t chunkPos, uint64_t len,
+                         WriteBuffer* buffer, uint64_t bufPos) {
+  VLOG(9) << "DataCache WriteBuf() chunkPos:" << chunkPos << ", len:" << len
+          << ", dataCache's chunkPos:" << chunkPos_
+          << ", dataCache's len:" << len_ << ", actualLen:" << actualLen_;
+  assert(chunkPos > chunkPos_);
+  dingofs::utils::LockGuard lg(mtx_);
+  status_.store(DataCacheStatus::Dirty, std::memory_order_release);
+  uint64_t oldSize = actualLen_;
+  CopyBufToDataCache(chunkPos - chunkPos_, len, buffer, bufPos);
+  DataCacheByteInc(actualLen_ - oldSize);
+}
+
 void DataCache::Truncate(uint64_t size) {
-  uint64_t blockSize = s3ClientAdaptor_->GetBlockSize();
   uint32_t pageSize = s3ClientAdaptor_->GetPageSize();
   assert(size <= len_);
 
   dingofs::utils::LockGuard lg(mtx_);
   uint64_t truncatePos = chunkPos_ + size;
-  uint64_t truncateLen = len_ - size;
-  uint64_t blockIndex = truncatePos / blockSize;
-  uint64_t pageIndex = truncatePos % blockSize / pageSize;
-  uint64_t blockPos = truncatePos % blockSize;
-  int n, m, blockLen;
-  while (truncateLen > 0) {
-    if (blockPos + truncateLen > blockSize) {
-      n = blockSize - blockPos;
-    } else {
-      n = truncateLen;
-    }
-    PageDataMap& pdMap = dataMap_[blockIndex];
-    blockLen = n;
-    pageIndex = blockPos / pageSize;
-    uint64_t pagePos = blockPos % pageSize;
-    PageData* pageData = nullptr;
-    while (blockLen > 0) {
-      if (pagePos + blockLen > pageSize) {
-        m = pageSize - pagePos;
-      } else {
-        m = blockLen;
-      }
-
-      if (pagePos == 0) {
-        if (pdMap.count(pageIndex)) {
-          pageData = pdMap[pageIndex];
-          DataStream::GetInstance().FreePage(pageData->data);
-          pdMap.erase(pageIndex);
-          actualLen_ -= pageSize;
-        }
-      } else {
-        if (pdMap.count(pageIndex)) {
-          pageData = pdMap[pageIndex];
-          memset(pageData->data + pagePos, 0, m);
-        }
-      }
-      pageIndex++;
-      blockLen -= m;
-      pagePos = (pagePos + m) % pageSize;
+  uint64_t endPos = chunkPos_ + len_;
+  uint64_t pageIndex = truncatePos / pageSize;
+  uint64_t pagePos = truncatePos % pageSize;
+  if (pagePos != 0 && truncatePos < endPos) {
+    char* page = pages_.Get(pageIndex);
+    if (page != nullptr) {
+      memset(page + pagePos, 0,
+             std::min(endPos - truncatePos, pageSize - pagePos));
     }
-    if (pdMap.empty()) {
-      dataMap_.erase(blockIndex);
+    pageIndex++;
+  }
+  for (; pageIndex * pageSize < endPos; pageIndex++) {
+    if (pages_.Get(pageIndex) != nullptr) {
+      pages_.Free(pageIndex);
+      actualLen_ -= pageSize;
     }
-    blockIndex++;
-    truncateLen -= n;
-    blockPos = (blockPos + n) % blockSize;
   }
 
   len_ = size;
@@ -2232,81 +2461,73 @@ void DataCache::Release() {
 
 void DataCache::CopyDataCacheToBuf(uint64_t offset, uint64_t len, char* data) {
   assert(offset + len <= len_);
-  uint64_t blockSize = s3ClientAdaptor_->GetBlockSize();
   uint32_t pageSize = s3ClientAdaptor_->GetPageSize();
   uint64_t newChunkPos = chunkPos_ + offset;
-  uint64_t blockIndex = newChunkPos / blockSize;
-  uint64_t blockPos = newChunkPos % blockSize;
-  uint64_t pagePos, pageIndex;
-  uint64_t n, m, blockLen;
+  uint64_t pageIndex = newChunkPos / pageSize;
+  uint64_t pagePos = newChunkPos % pageSize;
   uint64_t dataOffset = 0;
+  uint64_t n;
 
   VLOG(9) << "CopyDataCacheToBuf start Offset:" << offset
           << ", newChunkPos:" << newChunkPos << ", len:" << len;
 
-  while (len > 0) {
-    if (blockPos + len > blockSize) {
-      n = blockSize - blockPos;
-    } else {
-      n = len;
-    }
-    blockLen = n;
-    PageDataMap& pdMap = dataMap_[blockIndex];
-    PageData* pageData = NULL;
-    pageIndex = blockPos / pageSize;
-    pagePos = blockPos % pageSize;
-    while (blockLen > 0) {
-      if (pagePos + blockLen > pageSize) {
-        m = pageSize - pagePos;
-      } else {
-        m = blockLen;
-      }
-
-      assert(pdMap.count(pageIndex));
-      pageData = pdMap[pageIndex];
-      memcpy(data + dataOffset, pageData->data + pagePos, m);
-      pageIndex++;
-      blockLen -= m;
-      dataOffset += m;
-      pagePos = (pagePos + m) % pageSize;
-    }
-
-    blockIndex++;
-    len -= n;
-    blockPos = (blockPos + n) % blockSize;
+  while (dataOffset < len) {
+    n = std::min(len - dataOffset, pageSize - pagePos);
+    char* page = pages_.Get(pageIndex);
+    assert(page != nullptr);
+    memcpy(data + dataOffset, page + pagePos, n);
+    pageIndex++;
+    dataOffset += n;
+    pagePos = 0;
   }
   VLOG(9) << "CopyDataCacheToBuf end.";
 }
 
 DINGOFS_ERROR DataCache::Flush(uint64_t inodeId, bool toS3) {
+  DINGOFS_ERROR ret = FlushAsync(inodeId, toS3, nullptr);
+  if (ret != DINGOFS_ERROR::OK) {
+    return ret;
+  }
+  return WaitFlush(inodeId);
+}
+
+DINGOFS_ERROR DataCache::FlushAsync(uint64_t inodeId, bool toS3,
+                                    std::shared_ptr<FlushWindow> window) {
   VLOG(9) << "DataCache Flush. chunkPos=" << chunkPos_ << ", len=" << len_
           << ", chunkIndex=" << chunkCacheManager_->GetIndex()
           << ", inodeId=" << inodeId;
 
   // generate flush task
-  std::vector<FlushBlock> s3Tasks;
-  std::vector<std::shared_ptr<SetKVCacheTask>> kvCacheTasks;
-  char* data = reinterpret_cast<char*>(memalign(IO_ALIGNED_BLOCK_SIZE, len_));
-  if (!data) {
+  auto pending = std::make_shared<PendingFlush>();
+  pending->data =
+      reinterpret_cast<char*>(memalign(IO_ALIGNED_BLOCK_SIZE, len_));
+  if (!pending->data) {
     LOG(ERROR) << "new data failed.";
     return DINGOFS_ERROR::INTERNAL;
   }
-  CopyDataCacheToBuf(0, len_, data);
-  uint64_t writeOffset = 0;
-  uint64_t chunkId = 0;
-  DINGOFS_ERROR ret = PrepareFlushTasks(inodeId, data, &s3Tasks, &kvCacheTasks,
-                                        &chunkId, &writeOffset);
+  CopyDataCacheToBuf(0, len_, pending->data);
+  DINGOFS_ERROR ret = PrepareFlushTasks(
+      inodeId, pending->data, &pending->s3Tasks, &pending->kvCacheTasks,
+      &pending->chunkId, &pending->writeOffset);
   if (DINGOFS_ERROR::OK != ret) {
     return ret;
   }
 
   // exec flush task
-  FlushTaskExecute(toS3, s3Tasks, kvCacheTasks);
-  free(data);
+  FlushTaskExecute(toS3, pending, window);
+  pendingFlush_ = std::move(pending);
+  return DINGOFS_ERROR::OK;
+}
+
+DINGOFS_ERROR DataCache::WaitFlush(uint64_t inodeId) {
+  auto pending = std::move(pendingFlush_);
+  assert(pending != nullptr);
+  pending->kvTaskEvent.Wait();
+  pending->s3TaskEvent.Wait();
 
   // inode ship to flush
   std::shared_ptr<InodeWrapper> inodeWrapper;
-  ret =
+  DINGOFS_ERROR ret =
       s3ClientAdaptor_->GetInodeCacheManager()->GetInode(inodeId, inodeWrapper);
   if (ret != DINGOFS_ERROR::OK) {
     LOG(WARNING) << "get inode fail, ret:" << ret;
@@ -2318,9 +2539,11 @@ DINGOFS_ERROR DataCache::Flush(uint64_t inodeId, bool toS3) {
   uint64_t chunkIndex = chunkCacheManager_->GetIndex();
   uint64_t chunkSize = s3ClientAdaptor_->GetChunkSize();
   int64_t offset = chunkIndex * chunkSize + chunkPos_;
-  PrepareS3ChunkInfo(chunkId, offset, writeOffset, &info);
+  PrepareS3ChunkInfo(pending->chunkId, offset, pending->writeOffset, &info);
   inodeWrapper->AppendS3ChunkInfo(chunkIndex, info);
   s3ClientAdaptor_->GetInodeCacheManager()->ShipToFlush(inodeWrapper);
+  WriteBackMetric::GetInstance().flush_lag
+      << ::dingofs::utils::TimeUtility::GetTimeofDaySec() - createTime_;
 
   return DINGOFS_ERROR::OK;
 }
@@ -2374,67 +2597,54 @@ DINGOFS_ERROR DataCache::PrepareFlushTasks(
   return DINGOFS_ERROR::OK;
 }
 
-void DataCache::FlushTaskExecute(
-    bool to_s3, const std::vector<FlushBlock>& s3Tasks,
-    const std::vector<std::shared_ptr<SetKVCacheTask>>& kvCacheTasks) {
-  // callback
-  std::atomic<uint64_t> s3PendingTaskCal(s3Tasks.size());
-  std::atomic<uint64_t> kvPendingTaskCal(kvCacheTasks.size());
-  CountDownEvent s3TaskEvent(s3PendingTaskCal);
-  CountDownEvent kvTaskEvent(kvPendingTaskCal);
-
-  // success callback
-  PutObjectAsyncCallBack callback =
-      [&](const std::shared_ptr<PutObjectAsyncContext>& context) {
-        // move metrics collection to block_cache.cpp
-
-        // Don't move the if sentence to the front
-        // it will cause core dumped because s3Metric_
-        // will be destructed before being accessed
-        s3TaskEvent.Signal();
-      };
-
-  SetKVCacheDone kvdone = [&](const std::shared_ptr<SetKVCacheTask>& task) {
-    kvTaskEvent.Signal();
-    return;
-  };
+void DataCache::FlushTaskExecute(bool to_s3,
+                                 const std::shared_ptr<PendingFlush>& pending,
+                                 const std::shared_ptr<FlushWindow>& window) {
+  (void)to_s3;
+  pending->s3TaskEvent.Reset(pending->s3Tasks.size());
+  pending->kvTaskEvent.Reset(kvClientManager_ ? pending->kvCacheTasks.size()
+                                              : 0);
 
-  // s3task execute
+  // s3task execute, the |pending| is kept alive by the tasks until all
+  // of the blocks are put
   auto fs = s3ClientAdaptor_->GetFileSystem();
   auto entry_watcher = fs->BorrowMember().entry_watcher;
   auto block_cache = s3ClientAdaptor_->GetBlockCache();
-  if (s3PendingTaskCal.load()) {
-    for (const auto& fblock : s3Tasks) {
-      auto context = fblock.context;
-      BlockKey key = fblock.key;
-      Block block(context->buffer, context->bufferSize);
-      auto from = entry_watcher->ShouldWriteback(key.ino)
-                      ? BlockFrom::NOCTO_FLUSH
-                      : BlockFrom::CTO_FLUSH;
-      BlockContext ctx(from);
-      DataStream::GetInstance().EnterFlushSliceQueue(
-          [&, key, block, ctx, callback]() {
-            for (;;) {
-              auto rc = block_cache->Put(key, block, ctx);
-              if (rc == BCACHE_ERROR::OK) {
-                callback(context);
-                break;
-              }
-            }
-          });
+  for (const auto& fblock : pending->s3Tasks) {
+    BlockKey key = fblock.key;
+    Block block(fblock.context->buffer, fblock.context->bufferSize);
+    auto from = entry_watcher->ShouldWriteback(key.ino) ? BlockFrom::NOCTO_FLUSH
+                                                        : BlockFrom::CTO_FLUSH;
+    BlockContext ctx(from);
+    if (window != nullptr) {
+      window->Acquire();
     }
-  }
-  // kvtask execute
-  if (kvClientManager_ && kvPendingTaskCal.load()) {
-    std::for_each(kvCacheTasks.begin(), kvCacheTasks.end(),
-                  [&](const std::shared_ptr<SetKVCacheTask>& task) {
-                    task->done = kvdone;
-                    kvClientManager_->Set(task);
-                  });
-    kvTaskEvent.Wait();
+    DataStream::GetInstance().EnterFlushSliceQueue(
+        [pending, window, block_cache, key, block, ctx]() {
+          for (;;) {
+            auto rc = block_cache->Put(key, block, ctx);
+            if (rc == BCACHE_ERROR::OK) {
+              break;
+            }
+          }
+          if (window != nullptr) {
+            window->Release();
+          }
+          pending->s3TaskEvent.Signal();
+        });
   }
 
-  s3TaskEvent.Wait();
+  // kvtask execute, the |pending| is waited by WaitFlush() before it's
+  // released, so the raw pointer is safe
+  if (kvClientManager_) {
+    auto* event = &pending->kvTaskEvent;
+    for (const auto& task : pending->kvCacheTasks) {
+      task->done = [event](const std::shared_ptr<SetKVCacheTask>&) {
+        event->Signal();
+      };
+      kvClientManager_->Set(task);
+    }
+  }
 }
 
 void DataCache::PrepareS3ChunkInfo(uint64_t chunkId, uint64_t offset,
@@ -23,6 +23,7 @@
 #define DINGOFS_SRC_CLIENT_S3_CLIENT_S3_CACHE_MANAGER_H_
 
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <list>
 #include <map>
@@ -39,6 +40,11 @@
 #include "dingofs/src/client/filesystem/error.h"
 #include "dingofs/src/client/inode_wrapper.h"
 #include "dingofs/src/client/kvclient/kvclient_manager.h"
+#include "dingofs/src/client/s3/client_s3_flush_window.h"
+#include "dingofs/src/client/s3/client_s3_page_table.h"
+#include "dingofs/src/client/s3/client_s3_read_buffer.h"
+#include "dingofs/src/client/s3/client_s3_readahead.h"
+#include "dingofs/src/client/s3/client_s3_write_buffer.h"
 #include "dingofs/src/utils/concurrent/concurrent.h"
 
 namespace dingofs {
@@ -103,12 +109,6 @@ struct ObjectChunkInfo {
   uint64_t objectOffset;  // s3 object's begin in the block
 };
 
-struct PageData {
-  uint64_t index;
-  char* data;
-};
-using PageDataMap = std::map<uint64_t, PageData*>;
-
 enum DataCacheStatus {
   Dirty = 1,
   Flush = 2,
@@ -130,45 +130,42 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
             ChunkCacheManagerPtr chunkCacheManager, uint64_t chunkPos,
             uint64_t len, const char* data,
             std::shared_ptr<KVClientManager> kvClientManager);
-  virtual ~DataCache() {
-    auto iter = dataMap_.begin();
-    for (; iter != dataMap_.end(); iter++) {
-      auto pageIter = iter->second.begin();
-      for (; pageIter != iter->second.end(); pageIter++) {
-        datastream::DataStream::GetInstance().FreePage(pageIter->second->data);
-        delete pageIter->second;
-      }
-    }
-  }
+  // The data is [bufPos, bufPos + len) of |buffer|.
+  DataCache(S3ClientAdaptorImpl* s3ClientAdaptor,
+            ChunkCacheManagerPtr chunkCacheManager, uint64_t chunkPos,
+            uint64_t len, WriteBuffer* buffer, uint64_t bufPos,
+            std::shared_ptr<KVClientManager> kvClientManager);
+  virtual ~DataCache() = default;
 
   virtual void Write(uint64_t chunkPos, uint64_t len, const char* data,
                      const std::vector<DataCachePtr>& mergeDataCacheVer);
+  // Write [bufPos, bufPos + len) of |buffer| which behind the chunkPos of
+  // this DataCache and no need to merge others, the pages of |buffer|
+  // are adopted if possible.
+  void WriteBuf(uint64_t chunkPos, uint64_t len, WriteBuffer* buffer,
+                uint64_t bufPos);
   virtual void Truncate(uint64_t size);
   uint64_t GetChunkPos() { return chunkPos_; }
   uint64_t GetLen() { return len_; }
-  PageData* GetPageData(uint64_t blockIndex, uint64_t pageIndex) {
-    PageDataMap& pdMap = dataMap_[blockIndex];
-    if (pdMap.count(pageIndex)) {
-      return pdMap[pageIndex];
-    }
-    return nullptr;
-  }
+  // The |pageIndex| is the page index in chunk (chunkPos / pageSize).
+  char* GetPage(uint64_t pageIndex) { return pages_.Get(pageIndex); }
 
-  void ErasePageData(uint64_t blockIndex, uint64_t pageIndex) {
+  char* TakePage(uint64_t pageIndex) {
     dingofs::utils::LockGuard lg(mtx_);
-    PageDataMap& pdMap = dataMap_[blockIndex];
-    auto iter = pdMap.find(pageIndex);
-    if (iter != pdMap.end()) {
-      pdMap.erase(iter);
-    }
-    if (pdMap.empty()) {
-      dataMap_.erase(blockIndex);
-    }
+    return pages_.Take(pageIndex);
   }
 
   uint64_t GetActualLen() { return actualLen_; }
 
+  // Flush synchronously, it's FlushAsync() and then WaitFlush().
   virtual DINGOFS_ERROR Flush(uint64_t inodeId, bool toS3 = false);
+  // Issue the block uploads without waiting for them, the inflight blocks
+  // are bounded by |window| if it isn't nullptr.
+  virtual DINGOFS_ERROR FlushAsync(uint64_t inodeId, bool toS3,
+                                   std::shared_ptr<FlushWindow> window);
+  // Wait for the uploads issued by FlushAsync(), and then append the
+  // S3ChunkInfo to inode.
+  virtual DINGOFS_ERROR WaitFlush(uint64_t inodeId);
   void Release();
   bool IsDirty() {
     return status_.load(std::memory_order_acquire) == DataCacheStatus::Dirty;
@@ -190,20 +187,37 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
                                  uint64_t dataOffset, uint64_t len);
 
  private:
+  // The uploads issued by FlushAsync(), the data is freed once all of
+  // the uploads are done.
+  struct PendingFlush {
+    ~PendingFlush() { free(data); }
+
+    char* data{nullptr};
+    uint64_t chunkId{0};
+    uint64_t writeOffset{0};
+    std::vector<FlushBlock> s3Tasks;
+    std::vector<std::shared_ptr<SetKVCacheTask>> kvCacheTasks;
+    utils::CountDownEvent s3TaskEvent;
+    utils::CountDownEvent kvTaskEvent;
+  };
+
   void PrepareS3ChunkInfo(uint64_t chunkId, uint64_t offset, uint64_t len,
                           pb::metaserver::S3ChunkInfo* info);
   void CopyBufToDataCache(uint64_t dataCachePos, uint64_t len,
                           const char* data);
+  void CopyBufToDataCache(uint64_t dataCachePos, uint64_t len,
+                          WriteBuffer* buffer, uint64_t bufPos);
   void AddDataBefore(uint64_t len, const char* data);
+  void DataCacheByteInc(uint64_t v);
 
   DINGOFS_ERROR PrepareFlushTasks(
       uint64_t inodeId, char* data, std::vector<FlushBlock>* s3Tasks,
       std::vector<std::shared_ptr<SetKVCacheTask>>* kvCacheTasks,
       uint64_t* chunkId, uint64_t* writeOffset);
 
-  void FlushTaskExecute(
-      bool to_s3, const std::vector<FlushBlock>& s3Tasks,
-      const std::vector<std::shared_ptr<SetKVCacheTask>>& kvCacheTasks);
+  void FlushTaskExecute(bool to_s3,
+                        const std::shared_ptr<PendingFlush>& pending,
+                        const std::shared_ptr<FlushWindow>& window);
 
   S3ClientAdaptorImpl* s3ClientAdaptor_;
   ChunkCacheManagerPtr chunkCacheManager_;
@@ -215,7 +229,8 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
   uint64_t createTime_;
   std::atomic<int> status_;
   std::atomic<bool> inReadCache_;
-  std::map<uint64_t, PageDataMap> dataMap_;  // first is block index
+  PageTable pages_;
+  std::shared_ptr<PendingFlush> pendingFlush_;
 
   std::shared_ptr<KVClientManager> kvClientManager_;
 };
@@ -237,11 +252,15 @@ class S3ReadResponse {
 class ChunkCacheManager
     : public std::enable_shared_from_this<ChunkCacheManager> {
  public:
+  // The |flushWindow| is shared by all chunks of a file, nullptr means
+  // the uploads are not bounded.
   ChunkCacheManager(uint64_t index, S3ClientAdaptorImpl* s3ClientAdaptor,
-                    std::shared_ptr<KVClientManager> kvClientManager)
+                    std::shared_ptr<KVClientManager> kvClientManager,
+                    std::shared_ptr<FlushWindow> flushWindow = nullptr)
       : index_(index),
         s3ClientAdaptor_(s3ClientAdaptor),
-        flushingDataCache_(nullptr),
+        dirtyBytes_(0),
+        flushWindow_(std::move(flushWindow)),
         kvClientManager_(std::move(kvClientManager)) {}
   virtual ~ChunkCacheManager() = default;
   void ReadChunk(uint64_t index, uint64_t chunkPos, uint64_t readLen,
@@ -250,6 +269,9 @@ class ChunkCacheManager
   virtual void WriteNewDataCache(S3ClientAdaptorImpl* s3ClientAdaptor,
                                  uint32_t chunkPos, uint32_t len,
                                  const char* data);
+  void WriteNewDataCache(S3ClientAdaptorImpl* s3ClientAdaptor,
+                         uint32_t chunkPos, uint32_t len, WriteBuffer* buffer,
+                         uint64_t bufPos);
   virtual void AddReadDataCache(DataCachePtr dataCache);
   virtual DataCachePtr FindWriteableDataCache(
       uint64_t pos, uint64_t len, std::vector<DataCachePtr>* mergeDataCacheVer,
@@ -269,10 +291,25 @@ class ChunkCacheManager
     utils::ReadLockGuard writeCacheLock(rwLockChunk_);
     return (dataWCacheMap_.empty() && dataRCacheMap_.empty());
   }
+  // no data in write, flushing and read cache
+  bool IsMemEmpty() {
+    dingofs::utils::LockGuard lg(flushingDataCacheMtx_);
+    return IsEmpty() && IsFlushDataEmpty();
+  }
   virtual void ReleaseReadDataCache(uint64_t key);
   virtual void ReleaseCache();
   void TruncateCache(uint64_t chunkPos);
   void UpdateWriteCacheMap(uint64_t oldChunkPos, DataCache* dataCache);
+  // dirty bytes of write cache in this chunk
+  uint64_t GetDirtyBytes() {
+    return dirtyBytes_.load(std::memory_order_relaxed);
+  }
+  void DirtyBytesInc(uint64_t v) {
+    dirtyBytes_.fetch_add(v, std::memory_order_relaxed);
+  }
+  void DirtyBytesDec(uint64_t v) {
+    dirtyBytes_.fetch_sub(v, std::memory_order_relaxed);
+  }
   // for unit test
   void AddWriteDataCacheForTest(DataCachePtr dataCache);
   void ReleaseCacheForTest() {
@@ -288,10 +325,17 @@ class ChunkCacheManager
   utils::RWLock rwLockWrite_;  //  for dataWCacheMap_
 
  private:
+  void AddNewDataCache(const DataCachePtr& data_cache);
   void ReleaseWriteDataCache(const DataCachePtr& dataCache);
+  void DataCacheByteInc(uint64_t v);
+  void DataCacheByteDec(uint64_t v);
   void TruncateWriteCache(uint64_t chunkPos);
   void TruncateReadCache(uint64_t chunkPos);
-  bool IsFlushDataEmpty() { return flushingDataCache_ == nullptr; }
+  bool IsFlushDataEmpty() { return flushingDataCaches_.empty(); }
+  void ReadByFlushingDataCache(const DataCachePtr& dataCache,
+                               uint64_t chunkPos, uint64_t readLen,
+                               char* dataBuf, uint64_t dataBufOffset,
+                               std::vector<ReadRequest>* requests);
 
   uint64_t index_;
   std::map<uint64_t, DataCachePtr> dataWCacheMap_;  // first is pos in chunk
@@ -301,8 +345,11 @@ class ChunkCacheManager
   utils::RWLock rwLockRead_;  //  for read cache
   S3ClientAdaptorImpl* s3ClientAdaptor_;
   dingofs::utils::Mutex flushMtx_;
-  DataCachePtr flushingDataCache_;
+  // the DataCaches being flushed, they never overlap with each other
+  std::vector<DataCachePtr> flushingDataCaches_;
   dingofs::utils::Mutex flushingDataCacheMtx_;
+  std::atomic<uint64_t> dirtyBytes_;
+  std::shared_ptr<FlushWindow> flushWindow_;
 
   std::shared_ptr<KVClientManager> kvClientManager_;
 };
@@ -317,7 +364,9 @@ class FileCacheManager {
         inode_(inode),
         s3ClientAdaptor_(s3ClientAdaptor),
         kvClientManager_(std::move(kvClientManager)),
-        readTaskPool_(threadPool) {}
+        readTaskPool_(threadPool),
+        flushWindow_(std::make_shared<FlushWindow>(
+            datastream::DataStream::GetInstance().FlushInflightBlocks())) {}
   FileCacheManager() = default;
   ~FileCacheManager() = default;
 
@@ -331,11 +380,25 @@ class FileCacheManager {
 
   virtual int Write(uint64_t offset, uint64_t length, const char* dataBuf);
 
+  // Write the data of |buffer| which is already in pages, the pages are
+  // handed over to DataCache instead of copying if possible.
+  int WriteBuf(WriteBuffer* buffer);
+
   virtual int Read(uint64_t inode_id, uint64_t offset, uint64_t length,
                    char* data_buf);
 
+  // Read without copy, it only works when no data in memory cache and
+  // all blocks are cached in block cache, the data is described by the
+  // segments of |buffer|. Return false if it can't, the caller should
+  // fall back to Read().
+  virtual bool ReadZeroCopy(uint64_t inode_id, uint64_t offset,
+                            uint64_t length, ReadBuffer* buffer);
+
   bool IsEmpty() { return chunkCacheMap_.empty(); }
 
+  // dirty bytes of write cache in all chunks
+  uint64_t GetDirtyBytes();
+
   uint64_t GetInodeId() const { return inode_; }
 
   void SetChunkCacheManagerForTest(uint64_t index,
@@ -350,6 +413,8 @@ class FileCacheManager {
  private:
   void WriteChunk(uint64_t index, uint64_t chunkPos, uint64_t writeLen,
                   const char* dataBuf);
+  void WriteChunk(uint64_t index, uint64_t chunkPos, uint64_t writeLen,
+                  WriteBuffer* buffer, uint64_t bufPos);
   void GenerateS3Request(ReadRequest request,
                          const pb::metaserver::S3ChunkInfoList& s3ChunkInfoList,
                          char* dataBuf, std::vector<S3ReadRequest>* requests,
@@ -378,6 +443,16 @@ class FileCacheManager {
   void GetBlockLoc(uint64_t offset, uint64_t* chunkIndex, uint64_t* chunkPos,
                    uint64_t* blockIndex, uint64_t* blockPos);
 
+  // whether no data of [offset, offset + length) in memory cache
+  bool IsMemCacheEmpty(uint64_t offset, uint64_t length);
+
+  // split [offset, offset + length) into requests by chunk
+  void GenerateChunkRequest(uint64_t offset, uint64_t length,
+                            std::vector<ReadRequest>* requests);
+
+  // append the blocks of kv request to |buffer| without copy
+  bool AppendKVRequest(const S3ReadRequest& req, ReadBuffer* buffer);
+
   // read data from memory read/write cache
   void ReadFromMemCache(uint64_t offset, uint64_t length, char* dataBuf,
                         uint64_t* actualReadLen,
@@ -407,14 +482,20 @@ class FileCacheManager {
 
   // read kv request, need
   ReadStatus ReadKVRequest(const std::vector<S3ReadRequest>& kv_requests,
-                           char* data_buf, uint64_t file_len);
+                           char* data_buf, uint64_t file_len,
+                           uint32_t readahead_blocks);
 
   // thread function for ReadKVRequest
   void ProcessKVRequest(const S3ReadRequest& req, char* data_buf,
-                        uint64_t file_len, std::once_flag& cancel_flag,
+                        uint64_t file_len, uint32_t readahead_blocks,
+                        std::once_flag& cancel_flag,
                         std::atomic<bool>& is_canceled,
                         std::atomic<blockcache::BCACHE_ERROR>& ret_code);
 
+  // read kv request from blocks which prefetched into memory
+  bool ReadKVRequestFromReadahead(const std::string& name, char* buffer,
+                                  uint64_t offset, uint64_t length);
+
   // read kv request from local disk cache
   bool ReadKVRequestFromLocalCache(const blockcache::BlockKey& key,
                                    char* buffer, uint64_t offset,
@@ -425,7 +506,7 @@ class FileCacheManager {
                                     uint64_t offset, uint64_t length);
 
   // read kv request from s3
-  bool ReadKVRequestFromS3(const std::string& name, char* databuf,
+  bool ReadKVRequestFromS3(const blockcache::BlockKey& key, char* databuf,
                            uint64_t offset, uint64_t length,
                            blockcache::BCACHE_ERROR* rc);
 
@@ -436,7 +517,7 @@ class FileCacheManager {
   // prefetch for block
   void PrefetchForBlock(const S3ReadRequest& req, uint64_t fileLen,
                         uint64_t blockSize, uint64_t chunkSize,
-                        uint64_t startBlockIndex);
+                        uint64_t startBlockIndex, uint32_t prefetchBlocks);
 
   friend class AsyncPrefetchCallback;
 
@@ -448,9 +529,14 @@ class FileCacheManager {
   S3ClientAdaptorImpl* s3ClientAdaptor_;
   dingofs::utils::Mutex downloadMtx_;
   std::set<std::string> downloadingObj_;
+  ReadaheadWindow readaheadWindow_;
+  ReadaheadBuffer readaheadBuffer_;  // only used without cache store
+  ReadaheadHistory readaheadHistory_;  // only used with cache store
 
   std::shared_ptr<KVClientManager> kvClientManager_;
   std::shared_ptr<utils::TaskThreadPool<>> readTaskPool_;
+  // bound the inflight block uploads of all chunks in this file
+  std::shared_ptr<FlushWindow> flushWindow_;
 };
 
 class FsCacheManager {
@@ -481,6 +567,10 @@ class FsCacheManager {
   void Get(std::list<DataCachePtr>::iterator iter);
 
   DINGOFS_ERROR FsSync(bool force);
+  // Flush the dirtiest files which hold at least half of the dirty bytes,
+  // it's used to flush early before the memory is full. The |flushed_bytes|
+  // is the dirty bytes of files it picked.
+  DINGOFS_ERROR FlushDirtiest(uint64_t* flushed_bytes);
   uint64_t GetDataCacheNum() {
     return wDataCacheNum_.load(std::memory_order_relaxed);
   }
@@ -529,6 +619,10 @@ class FsCacheManager {
     std::thread t_;
   };
 
+  DINGOFS_ERROR FlushFiles(
+      const std::unordered_map<uint64_t, FileCacheManagerPtr>& files,
+      bool force);
+
   std::unordered_map<uint64_t, FileCacheManagerPtr>
       fileCacheManagerMap_;  // first is inodeid
   utils::RWLock rwLock_;
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include "dingofs/src/client/s3/client_s3_flush_window.h"
+
+namespace dingofs {
+namespace client {
+
+FlushWindow::FlushWindow(uint32_t size) : size_(size), inflight_(0) {}
+
+void FlushWindow::Acquire() {
+  std::unique_lock<std::mutex> lk(mutex_);
+  if (size_ > 0) {
+    cond_.wait(lk, [this]() { return inflight_ < size_; });
+  }
+  inflight_++;
+}
+
+void FlushWindow::Release() {
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    inflight_--;
+  }
+  cond_.notify_one();
+}
+
+uint32_t FlushWindow::Inflight() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  return inflight_;
+}
+
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_S3_CLIENT_S3_FLUSH_WINDOW_H_
+#define DINGOFS_SRC_CLIENT_S3_CLIENT_S3_FLUSH_WINDOW_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace dingofs {
+namespace client {
+
+// Bound the inflight block uploads of a file. The uploads of successive
+// slices and chunks in the same file are issued without waiting for each
+// other, the window keeps a single large writer from occupying all the
+// flush workers and memory.
+class FlushWindow {
+ public:
+  // |size| is the max inflight blocks, 0 means not limited.
+  explicit FlushWindow(uint32_t size);
+
+  // Block until there is a free slot in window.
+  void Acquire();
+
+  void Release();
+
+  uint32_t Inflight();
+
+ private:
+  const uint32_t size_;
+  uint32_t inflight_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+};
+
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_S3_CLIENT_S3_FLUSH_WINDOW_H_
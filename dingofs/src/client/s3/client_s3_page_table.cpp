@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+#include "dingofs/src/client/s3/client_s3_page_table.h"
+
+#include <glog/logging.h>
+
+#include "dingofs/src/client/datastream/data_stream.h"
+
+namespace dingofs {
+namespace client {
+
+using datastream::DataStream;
+
+PageTable::PageTable() : first_(0), num_pages_(0) {}
+
+PageTable::~PageTable() {
+  for (auto* page : pages_) {
+    if (page != nullptr) {
+      DataStream::GetInstance().FreePage(page);
+    }
+  }
+}
+
+char* PageTable::GetOrNew(uint64_t index, bool* created) {
+  char*& page = Slot(index);
+  *created = (page == nullptr);
+  if (page == nullptr) {
+    page = DataStream::GetInstance().NewPage();
+    num_pages_++;
+  }
+  return page;
+}
+
+void PageTable::Put(uint64_t index, char* page) {
+  char*& slot = Slot(index);
+  CHECK(slot == nullptr) << "page " << index << " already exists";
+  slot = page;
+  num_pages_++;
+}
+
+char* PageTable::Take(uint64_t index) {
+  if (Get(index) == nullptr) {
+    return nullptr;
+  }
+
+  char* page = pages_[index - first_];
+  pages_[index - first_] = nullptr;
+  num_pages_--;
+  Shrink();
+  return page;
+}
+
+void PageTable::Free(uint64_t index) {
+  char* page = Take(index);
+  if (page != nullptr) {
+    DataStream::GetInstance().FreePage(page);
+  }
+}
+
+// Extend the array to cover the |index|, the DataCache grows by
+// appending mostly, prepending is rare (see DataCache::AddDataBefore).
+char*& PageTable::Slot(uint64_t index) {
+  if (pages_.empty()) {
+    first_ = index;
+    pages_.emplace_back(nullptr);
+  } else if (index < first_) {
+    pages_.insert(pages_.begin(), first_ - index, nullptr);
+    first_ = index;
+  } else if (index - first_ >= pages_.size()) {
+    pages_.resize(index - first_ + 1, nullptr);
+  }
+  return pages_[index - first_];
+}
+
+// Drop the absent pages at the end, the ones at the front are kept,
+// because the merge takes pages from the front one by one.
+void PageTable::Shrink() {
+  if (num_pages_ == 0) {
+    pages_.clear();
+    first_ = 0;
+    return;
+  }
+
+  while (pages_.back() == nullptr) {
+    pages_.pop_back();
+  }
+}
+
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+#ifndef DINGOFS_SRC_CLIENT_S3_CLIENT_S3_PAGE_TABLE_H_
+#define DINGOFS_SRC_CLIENT_S3_CLIENT_S3_PAGE_TABLE_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace dingofs {
+namespace client {
+
+// The pages of one DataCache, indexed by the page index in chunk
+// (chunkPos / pageSize). The data of DataCache is contiguous, so are
+// the pages, they are kept in a flat array which can grow at both ends:
+//
+//   first_
+//     |
+//   [page 3][page 4][page 5][page 6]...
+//
+// The absent page is nullptr, e.g. the page which taken by merge.
+// All the pages are allocated from and freed to DataStream.
+class PageTable {
+ public:
+  PageTable();
+
+  ~PageTable();
+
+  PageTable(const PageTable&) = delete;
+
+  PageTable& operator=(const PageTable&) = delete;
+
+  // Return the page, nullptr if it's absent.
+  char* Get(uint64_t index) const {
+    if (index < first_ || index - first_ >= pages_.size()) {
+      return nullptr;
+    }
+    return pages_[index - first_];
+  }
+
+  // Return the page, allocate a new one if it's absent.
+  char* GetOrNew(uint64_t index, bool* created);
+
+  // Put the page which is absent, the table takes the ownership of it.
+  void Put(uint64_t index, char* page);
+
+  // Take away the page, nullptr if it's absent.
+  char* Take(uint64_t index);
+
+  // Free the page if it's present.
+  void Free(uint64_t index);
+
+  // The number of present pages.
+  uint64_t NumPages() const { return num_pages_; }
+
+ private:
+  char*& Slot(uint64_t index);
+
+  void Shrink();
+
+ private:
+  uint64_t first_;  // page index of pages_[0]
+  uint64_t num_pages_;
+  std::vector<char*> pages_;
+};
+
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_S3_CLIENT_S3_PAGE_TABLE_H_
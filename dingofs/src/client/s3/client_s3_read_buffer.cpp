@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include "dingofs/src/client/s3/client_s3_read_buffer.h"
+
+namespace dingofs {
+namespace client {
+
+using blockcache::BlockBuffer;
+using blockcache::BlockReader;
+
+ReadBufferPool::~ReadBufferPool() {
+  for (auto& buffers : free_) {
+    for (auto* data : buffers) {
+      delete[] data;
+    }
+  }
+}
+
+size_t ReadBufferPool::SizeClass(size_t size, size_t* capacity) {
+  size_t index = 0;
+  *capacity = kMinSize;
+  while (*capacity < size) {
+    *capacity <<= 1;
+    index++;
+  }
+  return index;
+}
+
+char* ReadBufferPool::Alloc(size_t size, size_t* capacity) {
+  size_t index = SizeClass(size, capacity);
+  if (index < kNumClasses) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto& buffers = free_[index];
+    if (!buffers.empty()) {
+      char* data = buffers.back();
+      buffers.pop_back();
+      return data;
+    }
+  }
+  return new char[*capacity];
+}
+
+void ReadBufferPool::Free(char* data, size_t capacity) {
+  size_t real_capacity;
+  size_t index = SizeClass(capacity, &real_capacity);
+  if (index < kNumClasses) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto& buffers = free_[index];
+    if (buffers.size() < kMaxFreeBuffers) {
+      buffers.emplace_back(data);
+      return;
+    }
+  }
+  delete[] data;
+}
+
+size_t ReadBufferPool::NumFreeBuffers() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  size_t n = 0;
+  for (const auto& buffers : free_) {
+    n += buffers.size();
+  }
+  return n;
+}
+
+ReadBuffer::ReadBuffer(size_t size) : size_(size) {
+  data_ = ReadBufferPool::GetInstance().Alloc(size, &capacity_);
+}
+
+ReadBuffer::ReadBuffer(char* data, size_t size)
+    : data_(data), size_(size), capacity_(0) {}
+
+ReadBuffer::~ReadBuffer() {
+  Reset();
+  if (capacity_ > 0) {
+    ReadBufferPool::GetInstance().Free(data_, capacity_);
+  }
+}
+
+bool ReadBuffer::Append(std::shared_ptr<BlockReader> reader, off_t offset,
+                        size_t length) {
+  BlockBuffer buffer;
+  if (!reader->GetBuffer(offset, length, &buffer)) {
+    return false;
+  }
+
+  segments_.emplace_back(Segment{buffer.mem, buffer.fd, buffer.pos, length});
+  readers_.emplace_back(reader);
+  return true;
+}
+
+void ReadBuffer::Append(size_t offset, size_t length) {
+  segments_.emplace_back(Segment{data_ + offset, -1, 0, length});
+}
+
+void ReadBuffer::Reset() {
+  for (auto& reader : readers_) {
+    reader->Close();
+  }
+  readers_.clear();
+  segments_.clear();
+}
+
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_S3_CLIENT_S3_READ_BUFFER_H_
+#define DINGOFS_SRC_CLIENT_S3_CLIENT_S3_READ_BUFFER_H_
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "dingofs/src/client/blockcache/cache_store.h"
+
+namespace dingofs {
+namespace client {
+
+// Pool of read buffers in power-of-two size classes, so the read request
+// don't need to allocate a new buffer every time.
+class ReadBufferPool {
+  static constexpr size_t kMinSize = 4096;
+  static constexpr size_t kNumClasses = 9;  // 4KiB, 8KiB, ..., 1MiB
+  static constexpr size_t kMaxFreeBuffers = 64;  // for each class
+
+ public:
+  static ReadBufferPool& GetInstance() {
+    static ReadBufferPool instance;
+    return instance;
+  }
+
+  // The |capacity| is the real size of buffer which should be passed
+  // to Free().
+  char* Alloc(size_t size, size_t* capacity);
+
+  void Free(char* data, size_t capacity);
+
+  size_t NumFreeBuffers();
+
+ private:
+  ReadBufferPool() = default;
+
+  ~ReadBufferPool();
+
+  static size_t SizeClass(size_t size, size_t* capacity);
+
+ private:
+  std::mutex mutex_;
+  std::vector<char*> free_[kNumClasses];
+};
+
+// The data of one read request, which is either in the buffer or in the
+// cache blocks (zero-copy), see FileCacheManager::ReadZeroCopy().
+//
+// The segments describe the data in order, for cache block the block
+// reader is kept open until the buffer destroyed, so the data can be
+// spliced to fuse safely.
+class ReadBuffer {
+ public:
+  struct Segment {
+    const char* mem;  // memory, or
+    int fd;           // file, read from |pos|
+    off_t pos;
+    size_t length;
+  };
+
+ public:
+  // Use the buffer from pool.
+  explicit ReadBuffer(size_t size);
+
+  // Use the external |data|, the zero-copy is disabled.
+  ReadBuffer(char* data, size_t size);
+
+  ~ReadBuffer();
+
+  char* Data() { return data_; }
+
+  size_t Size() const { return size_; }
+
+  bool ZeroCopyable() const { return capacity_ > 0; }
+
+  // Append [offset, offset + length) of the block which |reader| loaded,
+  // return false if the reader doesn't support zero-copy.
+  bool Append(std::shared_ptr<blockcache::BlockReader> reader, off_t offset,
+              size_t length);
+
+  // Append [offset, offset + length) of the buffer.
+  void Append(size_t offset, size_t length);
+
+  const std::vector<Segment>& Segments() const { return segments_; }
+
+  // Drop the segments, the data is in the buffer only.
+  void Reset();
+
+ private:
+  char* data_;
+  size_t size_;
+  size_t capacity_;  // 0 means external buffer
+  std::vector<Segment> segments_;
+  std::vector<std::shared_ptr<blockcache::BlockReader>> readers_;
+};
+
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_S3_CLIENT_S3_READ_BUFFER_H_
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include "dingofs/src/client/s3/client_s3_readahead.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "dingofs/src/client/common/dynamic_config.h"
+#include "dingofs/src/stub/metric/metric.h"
+
+namespace dingofs {
+namespace client {
+
+USING_FLAG(s3_readahead_max_memory_mb);
+
+using stub::metric::ReadaheadMetric;
+
+uint32_t ReadaheadWindow::Update(uint64_t offset, uint64_t length,
+                                 uint64_t block_size, uint32_t init_blocks,
+                                 uint32_t max_blocks, bool memory_pressure) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (length == 0) {
+    return window_;
+  }
+
+  uint64_t end = offset + length;
+  bool sequential = IsSequential(offset);
+  bool cross_block =
+      first_ || (end - 1) / block_size != (next_offset_ - 1) / block_size;
+  first_ = false;
+  next_offset_ = end;
+
+  if (!sequential || max_blocks == 0) {
+    window_ = 0;
+    return 0;
+  }
+
+  if (window_ == 0) {
+    window_ = std::min(std::max(init_blocks, 1U), max_blocks);
+  } else if (cross_block) {
+    window_ = std::min(window_ * 2, max_blocks);
+  }
+
+  if (memory_pressure) {
+    window_ = std::max(window_ / 2, 1U);
+  }
+  return window_;
+}
+
+uint32_t ReadaheadWindow::Window() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  return window_;
+}
+
+bool ReadaheadWindow::IsSequential(uint64_t offset) const {
+  if (first_) {
+    return offset == 0;
+  }
+  return offset == next_offset_;
+}
+
+void ReadaheadHistory::Add(const std::string& name, uint32_t capacity) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (names_.find(name) != names_.end()) {
+    return;
+  }
+
+  order_.emplace_back(name);
+  names_.emplace(name, std::prev(order_.end()));
+  while (names_.size() > std::max(capacity, 1U)) {
+    names_.erase(order_.front());
+    order_.pop_front();
+  }
+}
+
+bool ReadaheadHistory::Contains(const std::string& name) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  return names_.find(name) != names_.end();
+}
+
+void ReadaheadHistory::Clear() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  names_.clear();
+  order_.clear();
+}
+
+std::atomic<uint64_t> ReadaheadBuffer::used_bytes_{0};
+
+ReadaheadBuffer::~ReadaheadBuffer() { Clear(); }
+
+bool ReadaheadBuffer::Put(const std::string& name, std::unique_ptr<char[]> data,
+                          uint64_t length, uint32_t max_blocks) {
+  auto& metric = ReadaheadMetric::GetInstance();
+  uint64_t max_bytes = FLAGS_s3_readahead_max_memory_mb * 1024 * 1024;
+
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (buffers_.find(name) != buffers_.end() ||
+      used_bytes_.load() + length > max_bytes) {
+    metric.wasted_bytes << length;
+    return false;
+  }
+
+  order_.emplace_back(name);
+  buffers_.emplace(name,
+                   Buffer{std::move(data), length, 0, std::prev(order_.end())});
+  used_bytes_.fetch_add(length);
+  metric.memory_bytes << static_cast<int64_t>(length);
+
+  // The blocks which behind the window will never be read for sequential
+  // read, drop the oldest one.
+  while (buffers_.size() > std::max(max_blocks, 1U)) {
+    EraseLocked(buffers_.find(order_.front()));
+  }
+  return true;
+}
+
+bool ReadaheadBuffer::Get(const std::string& name, uint64_t offset,
+                          uint64_t length, char* buffer) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  auto iter = buffers_.find(name);
+  if (iter == buffers_.end()) {
+    return false;
+  }
+
+  auto& buf = iter->second;
+  if (offset + length > buf.length) {
+    return false;
+  }
+
+  std::memcpy(buffer, buf.data.get() + offset, length);
+  buf.consumed += length;
+  if (buf.consumed >= buf.length) {  // read entirely
+    EraseLocked(iter);
+  }
+  return true;
+}
+
+bool ReadaheadBuffer::IsCached(const std::string& name) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  return buffers_.find(name) != buffers_.end();
+}
+
+void ReadaheadBuffer::Clear() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  while (!buffers_.empty()) {
+    EraseLocked(buffers_.begin());
+  }
+}
+
+void ReadaheadBuffer::EraseLocked(
+    std::unordered_map<std::string, Buffer>::iterator iter) {
+  auto& metric = ReadaheadMetric::GetInstance();
+  auto& buf = iter->second;
+  if (buf.consumed < buf.length) {
+    metric.wasted_bytes << buf.length - buf.consumed;
+  }
+  used_bytes_.fetch_sub(buf.length);
+  metric.memory_bytes << -static_cast<int64_t>(buf.length);
+
+  order_.erase(buf.iter);
+  buffers_.erase(iter);
+}
+
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_S3_CLIENT_S3_READAHEAD_H_
+#define DINGOFS_SRC_CLIENT_S3_CLIENT_S3_READAHEAD_H_
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace dingofs {
+namespace client {
+
+// Track the access pattern of an opened file and decide how many blocks
+// should be read ahead:
+//
+//   sequential: 0 -> init -> init*2 -> ... -> max  (grow once per block)
+//   random:     * -> 0
+//
+// The window is halved when the memory is near full.
+class ReadaheadWindow {
+ public:
+  ReadaheadWindow() = default;
+
+  // Update the pattern by read request [offset, offset+length) and return
+  // the number of blocks to read ahead, 0 means no readahead.
+  uint32_t Update(uint64_t offset, uint64_t length, uint64_t block_size,
+                  uint32_t init_blocks, uint32_t max_blocks,
+                  bool memory_pressure);
+
+  uint32_t Window();
+
+ private:
+  // Only the request which starts exactly at the end of the last one
+  // is sequential, any gap, overlap or reorder collapses the window.
+  bool IsSequential(uint64_t offset) const;
+
+ private:
+  std::mutex mutex_;
+  bool first_{true};
+  uint64_t next_offset_{0};
+  uint32_t window_{0};
+};
+
+// The blocks which prefetched into block cache by readahead, it's used to
+// tell a readahead hit from a plain cache hit. Only the newest |capacity|
+// blocks are remembered.
+class ReadaheadHistory {
+ public:
+  ReadaheadHistory() = default;
+
+  void Add(const std::string& name, uint32_t capacity);
+
+  bool Contains(const std::string& name);
+
+  void Clear();
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::list<std::string>::iterator> names_;
+  std::list<std::string> order_;  // from oldest to newest
+};
+
+// The blocks which prefetched into memory for file, it's used when
+// the disk cache is disabled. The memory is bounded by
+// |FLAGS_s3_readahead_max_memory_mb| for all files, the block will be
+// dropped once it's read entirely.
+class ReadaheadBuffer {
+  struct Buffer {
+    std::unique_ptr<char[]> data;
+    uint64_t length;
+    uint64_t consumed;
+    std::list<std::string>::iterator iter;  // position in |order_|
+  };
+
+ public:
+  ReadaheadBuffer() = default;
+
+  ~ReadaheadBuffer();
+
+  // Return false if the memory budget is exhausted, the data is dropped.
+  bool Put(const std::string& name, std::unique_ptr<char[]> data,
+           uint64_t length, uint32_t max_blocks);
+
+  bool Get(const std::string& name, uint64_t offset, uint64_t length,
+           char* buffer);
+
+  bool IsCached(const std::string& name);
+
+  void Clear();
+
+  static uint64_t UsedBytes() { return used_bytes_.load(); }
+
+ private:
+  void EraseLocked(std::unordered_map<std::string, Buffer>::iterator iter);
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, Buffer> buffers_;
+  std::list<std::string> order_;  // from oldest to newest
+  static std::atomic<uint64_t> used_bytes_;
+};
+
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_S3_CLIENT_S3_READAHEAD_H_
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+#include "dingofs/src/client/s3/client_s3_write_buffer.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "dingofs/src/client/datastream/data_stream.h"
+
+namespace dingofs {
+namespace client {
+
+using datastream::DataStream;
+
+WriteBuffer::WriteBuffer(uint64_t offset, uint64_t length, FillFunc fill)
+    : offset_(offset),
+      length_(length),
+      fill_(fill),
+      page_size_(0),
+      head_(0) {}
+
+WriteBuffer::~WriteBuffer() {
+  for (auto* page : pages_) {
+    if (page != nullptr) {
+      DataStream::GetInstance().FreePage(page);
+    }
+  }
+}
+
+bool WriteBuffer::Fill(uint32_t page_size) {
+  CHECK(pages_.empty()) << "write buffer already filled";
+  page_size_ = page_size;
+  head_ = offset_ % page_size;
+  if (length_ == 0) {
+    return true;
+  }
+
+  uint64_t num_pages = (head_ + length_ + page_size - 1) / page_size;
+  std::vector<struct iovec> iovs;
+  iovs.reserve(num_pages);
+  for (uint64_t pos = 0; pos < length_;) {
+    char* page = DataStream::GetInstance().NewPage();
+    uint64_t page_pos = (head_ + pos) % page_size;
+    uint64_t n = std::min(length_ - pos, page_size - page_pos);
+    pages_.emplace_back(page);
+    iovs.push_back(iovec{page + page_pos, n});
+    pos += n;
+  }
+  return fill_(iovs);
+}
+
+const char* WriteBuffer::Data(uint64_t pos) const {
+  DCHECK(pos < length_);
+  uint64_t real_pos = head_ + pos;
+  return pages_[real_pos / page_size_] + real_pos % page_size_;
+}
+
+char* WriteBuffer::TakePage(uint64_t pos) {
+  uint64_t real_pos = head_ + pos;
+  DCHECK(real_pos % page_size_ == 0 && pos + page_size_ <= length_);
+  char*& page = pages_[real_pos / page_size_];
+  char* taken = page;
+  page = nullptr;
+  return taken;
+}
+
+void WriteBuffer::CopyTo(uint64_t pos, uint64_t length, char* data) const {
+  while (length > 0) {
+    uint64_t page_pos = (head_ + pos) % page_size_;
+    uint64_t n = std::min(length, page_size_ - page_pos);
+    std::memcpy(data, Data(pos), n);
+    data += n;
+    pos += n;
+    length -= n;
+  }
+}
+
+}  // namespace client
+}  // namespace dingofs
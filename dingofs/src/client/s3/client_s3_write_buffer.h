@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+#ifndef DINGOFS_SRC_CLIENT_S3_CLIENT_S3_WRITE_BUFFER_H_
+#define DINGOFS_SRC_CLIENT_S3_CLIENT_S3_WRITE_BUFFER_H_
+
+#include <sys/uio.h>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace dingofs {
+namespace client {
+
+// The data of one write request which is held in pages of DataStream,
+// the pages are aligned to the page size of file offset as the pages of
+// DataCache, so the fully covered page can be handed over to DataCache
+// without copy, see DataCache::WriteBuf().
+//
+//   offset
+//     |-------------------- length -------------------|
+//   |-----------|-----------|-----------|-----------|-----------|
+//      page 0      page 1      page 2      page 3      page 4
+//
+// The data is copied into the pages only once, by |fill| which usually
+// reads it from the pipe of fuse device (splice).
+class WriteBuffer {
+ public:
+  using FillFunc = std::function<bool(const std::vector<struct iovec>& iovs)>;
+
+ public:
+  WriteBuffer(uint64_t offset, uint64_t length, FillFunc fill);
+
+  ~WriteBuffer();
+
+  // Allocate the pages and fill them, it may block if there is no free
+  // page in DataStream.
+  bool Fill(uint32_t page_size);
+
+  uint64_t Offset() const { return offset_; }
+
+  uint64_t Length() const { return length_; }
+
+  // Return the data at |pos| of buffer, it's contiguous until the end
+  // of page.
+  const char* Data(uint64_t pos) const;
+
+  // Take over the page which starts at |pos| of buffer (page aligned).
+  char* TakePage(uint64_t pos);
+
+  void CopyTo(uint64_t pos, uint64_t length, char* data) const;
+
+ private:
+  uint64_t offset_;
+  uint64_t length_;
+  FillFunc fill_;
+  uint32_t page_size_;
+  uint64_t head_;  // offset_ % page_size_
+  std::vector<char*> pages_;
+};
+
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_S3_CLIENT_S3_WRITE_BUFFER_H_
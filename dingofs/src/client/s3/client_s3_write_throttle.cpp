@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+#include "dingofs/src/client/s3/client_s3_write_throttle.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "dingofs/src/stub/metric/metric.h"
+
+namespace dingofs {
+namespace client {
+
+using stub::metric::WriteBackMetric;
+
+WriteThrottle::WriteThrottle(Option option, RatioFunc used_ratio,
+                             WakeupFunc wakeup)
+    : option_(option), used_ratio_(used_ratio), wakeup_(wakeup) {
+  option_.background_ratio =
+      std::min(option_.background_ratio, option_.limit_ratio);
+}
+
+uint64_t WriteThrottle::Throttle() {
+  double ratio = used_ratio_();
+  if (ratio < option_.background_ratio) {
+    return 0;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  wakeup_();
+  if (ratio < option_.limit_ratio) {
+    std::this_thread::sleep_for(std::chrono::microseconds(PauseUs(ratio)));
+  } else {
+    while (used_ratio_() >= option_.limit_ratio) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+
+  uint64_t stall_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+  auto& metric = WriteBackMetric::GetInstance();
+  metric.throttled_writes << 1;
+  metric.stall_us << stall_us;
+  return stall_us;
+}
+
+bool WriteThrottle::NeedFlush() const {
+  return used_ratio_() >= option_.background_ratio;
+}
+
+uint64_t WriteThrottle::PauseUs(double ratio) const {
+  if (ratio < option_.background_ratio) {
+    return 0;
+  }
+
+  uint64_t max_pause_us = option_.base_pause_us * kMaxPauseFactor;
+  double range = option_.limit_ratio - option_.background_ratio;
+  double x = (ratio - option_.background_ratio) / range;
+  if (range <= 0 || x >= 1) {
+    return max_pause_us;
+  }
+  return std::min(max_pause_us,
+                  static_cast<uint64_t>(option_.base_pause_us / (1 - x)));
+}
+
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+#ifndef DINGOFS_SRC_CLIENT_S3_CLIENT_S3_WRITE_THROTTLE_H_
+#define DINGOFS_SRC_CLIENT_S3_CLIENT_S3_WRITE_THROTTLE_H_
+
+#include <cstdint>
+#include <functional>
+
+namespace dingofs {
+namespace client {
+
+// Throttle the writers gradually as the memory of write cache rises,
+// instead of stopping all of them at the limit which gives sawtooth
+// latency under sustained writes:
+//
+//   used ratio            pause per write
+//   [0, background)       none
+//   [background, limit)   base_pause_us / (1 - x), capped at kMaxPauseFactor
+//                         times of base_pause_us, where
+//                         x = (ratio - background) / (limit - background)
+//   [limit, 1]            until the ratio drops below the limit
+//
+// The flusher is woken up once the ratio crosses the background ratio,
+// so it starts flushing early and the writers are slowed down to the
+// flush bandwidth rather than stopped.
+class WriteThrottle {
+ public:
+  struct Option {
+    double background_ratio;
+    double limit_ratio;
+    uint64_t base_pause_us;
+  };
+
+  using RatioFunc = std::function<double()>;
+  using WakeupFunc = std::function<void()>;
+
+  static constexpr uint64_t kMaxPauseFactor = 64;
+
+ public:
+  WriteThrottle(Option option, RatioFunc used_ratio, WakeupFunc wakeup);
+
+  // Pause the writer according to the used ratio of memory, return the
+  // stalled time in microseconds.
+  uint64_t Throttle();
+
+  // Whether the flusher should flush early.
+  bool NeedFlush() const;
+
+  uint64_t PauseUs(double ratio) const;
+
+ private:
+  Option option_;
+  RatioFunc used_ratio_;
+  WakeupFunc wakeup_;
+};
+
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_S3_CLIENT_S3_WRITE_THROTTLE_H_
@@ -244,6 +244,20 @@ bool CopysetNode::GetLeaderStatus(braft::NodeStatus* leaderStatus) {
   return FetchLeaderStatus(status.leader_id, leaderStatus);
 }
 
+bool CopysetNode::IsLeaseLeader() const {
+  int64_t term = LeaderTerm();
+  if (term <= 0) {
+    return false;
+  }
+
+  // a valid lease guarantees that no other peer can be elected as leader,
+  // and logs committed before current term have been pushed into apply
+  // queue by on_apply before on_leader_start is called
+  braft::LeaderLeaseStatus status;
+  raftNode_->get_leader_lease_status(&status);
+  return status.state == braft::LEASE_VALID && status.term == term;
+}
+
 void CopysetNode::on_apply(braft::Iterator& iter) {
   for (; iter.valid(); iter.next()) {
     braft::AsyncClosureGuard doneGuard(iter.done());
@@ -271,9 +285,13 @@ void CopysetNode::on_apply(braft::Iterator& iter) {
       butil::Timer timer;
       timer.start();
       auto hashcode = metaOperator->HashCode();
-      auto task =
-          std::bind(&MetaOperator::OnApplyFromLog, metaOperator.release(),
-                    TimeUtility::GetTimeofDayUs());
+      // applied index is also tracked on followers, so that follower can
+      // serve readonly requests whose appliedindex it has reached
+      auto task = [this, op = metaOperator.release(), index = iter.index(),
+                   startTimeUs = TimeUtility::GetTimeofDayUs()]() {
+        op->OnApplyFromLog(startTimeUs);
+        UpdateAppliedIndex(index);
+      };
       applyQueue_->Push(hashcode, std::move(task));
       timer.stop();
       g_concurrent_apply_from_log_wait_latency << timer.u_elapsed();
@@ -420,6 +438,7 @@ int CopysetNode::on_snapshot_load(braft::SnapshotReader* reader) {
             << "' success, update load snapshot index from " << prevIndex
             << " to " << latestLoadSnapshotIndex_;
 
+  UpdateAppliedIndex(meta.last_included_index());
   return 0;
 }
 
@@ -73,6 +73,13 @@ class CopysetNode : public braft::StateMachine {
 
   virtual bool IsLeaderTerm() const;
 
+  /**
+   * @brief Whether current node is leader and holds a valid leader lease of
+   *        current term, if so, read requests can be served locally
+   *        without proposing to raft
+   */
+  virtual bool IsLeaseLeader() const;
+
   PoolId GetPoolId() const;
 
   const braft::PeerId& GetPeerId() const;
@@ -116,6 +116,15 @@ void MetaOperator::Propose() {
 
   // check if current node is leader
   if (!IsLeaderTerm()) {
+    // follower can serve readonly request if it has applied the log that
+    // client has seen
+    if (CanReadFromFollower()) {
+      node_->GetMetric()->OnFollowerRead(GetOperatorType());
+      FastApplyTask();
+      doneGuard.release();
+      return;
+    }
+
     RedirectRequest();
     return;
   }
@@ -168,14 +177,40 @@ void MetaOperator::FastApplyTask() {
   g_concurrent_fast_apply_wait_latency << timer.u_elapsed();
 }
 
+namespace {
+
+// A readonly request can be served locally if current node has applied the
+// log that client has seen, or current node holds a valid leader lease.
+template <typename RequestT>
+bool CanServeReadLocally(const CopysetNode* node, const RequestT* req) {
+  if (req->has_appliedindex() &&
+      node->GetAppliedIndex() >= req->appliedindex()) {
+    return true;
+  }
+
+  return node->IsLeaseLeader();
+}
+
+// Follower read is bounded by the appliedindex that client has seen, request
+// without it is always redirected to leader.
+// It's safe because on_apply pushes every log entry to the apply queue in log
+// order before any higher index is published, and the read is pushed to the
+// same worker as the writes of its partition, so it runs after them.
+template <typename RequestT>
+bool CanServeFollowerRead(const CopysetNode* node, const RequestT* req) {
+  return req->has_appliedindex() && req->appliedindex() > 0 &&
+         node->GetAppliedIndex() >= req->appliedindex();
+}
+
+}  // namespace
+
 #define OPERATOR_CAN_BYPASS_PROPOSE(TYPE) \
   bool TYPE##Operator::CanBypassPropose() const { return false; }
 
 #define READONLY_OPERATOR_CAN_BYPASS_PROPOSE(TYPE)                           \
   bool TYPE##Operator::CanBypassPropose() const {                            \
     auto* req = static_cast<const pb::metaserver::TYPE##Request*>(request_); \
-    return req->has_appliedindex() &&                                        \
-           node_->GetAppliedIndex() >= req->appliedindex();                  \
+    return CanServeReadLocally(node_, req);                                  \
   }
 
 OPERATOR_CAN_BYPASS_PROPOSE(SetFsQuota);
@@ -190,38 +225,47 @@ READONLY_OPERATOR_CAN_BYPASS_PROPOSE(LoadDirQuotas);
 
 bool GetInodeOperator::CanBypassPropose() const {
   auto* req = static_cast<const GetInodeRequest*>(request_);
-  return req->has_appliedindex() &&
-         node_->GetAppliedIndex() >= req->appliedindex();
+  return CanServeReadLocally(node_, req);
 }
 
 bool ListDentryOperator::CanBypassPropose() const {
   auto* req = static_cast<const ListDentryRequest*>(request_);
-  return req->has_appliedindex() &&
-         node_->GetAppliedIndex() >= req->appliedindex();
+  return CanServeReadLocally(node_, req);
 }
 
 bool BatchGetInodeAttrOperator::CanBypassPropose() const {
   auto* req = static_cast<const BatchGetInodeAttrRequest*>(request_);
-  return req->has_appliedindex() &&
-         node_->GetAppliedIndex() >= req->appliedindex();
+  return CanServeReadLocally(node_, req);
 }
 
 bool BatchGetXAttrOperator::CanBypassPropose() const {
   auto* req = static_cast<const BatchGetXAttrRequest*>(request_);
-  return req->has_appliedindex() &&
-         node_->GetAppliedIndex() >= req->appliedindex();
+  return CanServeReadLocally(node_, req);
 }
 
 bool GetDentryOperator::CanBypassPropose() const {
   auto* req = static_cast<const GetDentryRequest*>(request_);
-  return req->has_appliedindex() &&
-         node_->GetAppliedIndex() >= req->appliedindex();
+  return CanServeReadLocally(node_, req);
 }
 
 bool GetVolumeExtentOperator::CanBypassPropose() const {
   const auto* req = static_cast<const GetVolumeExtentRequest*>(request_);
-  return req->has_appliedindex() &&
-         node_->GetAppliedIndex() >= req->appliedindex();
+  return CanServeReadLocally(node_, req);
+}
+
+bool GetInodeOperator::CanReadFromFollower() const {
+  auto* req = static_cast<const GetInodeRequest*>(request_);
+  return CanServeFollowerRead(node_, req);
+}
+
+bool ListDentryOperator::CanReadFromFollower() const {
+  auto* req = static_cast<const ListDentryRequest*>(request_);
+  return CanServeFollowerRead(node_, req);
+}
+
+bool BatchGetInodeAttrOperator::CanReadFromFollower() const {
+  auto* req = static_cast<const BatchGetInodeAttrRequest*>(request_);
+  return CanServeFollowerRead(node_, req);
 }
 
 #define OPERATOR_ON_APPLY(TYPE)                                                \
@@ -130,10 +130,17 @@ class MetaOperator {
   /**
    * @brief Whether an operator can bypass propose to raft,
    *        return true if operator is readonly and request carry with
-   *        an valid appliedindex
+   *        an valid appliedindex or current node holds a valid leader lease
    */
   virtual bool CanBypassPropose() const { return false; }
 
+  /**
+   * @brief Whether an operator can be served by a follower,
+   *        return true if operator supports follower read and request
+   *        carry with an appliedindex that current node has reached
+   */
+  virtual bool CanReadFromFollower() const { return false; }
+
  protected:
   CopysetNode* node_;
 
@@ -227,6 +234,8 @@ class ListDentryOperator : public MetaOperator {
   void OnFailed(pb::metaserver::MetaStatusCode code) override;
 
   bool CanBypassPropose() const override;
+
+  bool CanReadFromFollower() const override;
 };
 
 class CreateDentryOperator : public MetaOperator {
@@ -286,6 +295,8 @@ class GetInodeOperator : public MetaOperator {
   void OnFailed(pb::metaserver::MetaStatusCode code) override;
 
   bool CanBypassPropose() const override;
+
+  bool CanReadFromFollower() const override;
 };
 
 class BatchGetInodeAttrOperator : public MetaOperator {
@@ -307,6 +318,8 @@ class BatchGetInodeAttrOperator : public MetaOperator {
   void OnFailed(pb::metaserver::MetaStatusCode code) override;
 
   bool CanBypassPropose() const override;
+
+  bool CanReadFromFollower() const override;
 };
 
 class BatchGetXAttrOperator : public MetaOperator {
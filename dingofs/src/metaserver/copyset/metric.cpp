@@ -89,6 +89,13 @@ void OperatorMetric::NewArrival(OperatorType type) {
   }
 }
 
+void OperatorMetric::OnFollowerRead(OperatorType type) {
+  auto index = static_cast<uint32_t>(type);
+  if (index < kTotalOperatorNum) {
+    opMetrics_[index]->followerReadCount << 1;
+  }
+}
+
 }  // namespace copyset
 }  // namespace metaserver
 }  // namespace dingofs
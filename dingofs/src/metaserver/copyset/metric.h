@@ -56,6 +56,8 @@ class OperatorMetric {
 
   void NewArrival(OperatorType type);
 
+  void OnFollowerRead(OperatorType type);
+
   OperatorMetric(const OperatorMetric&) = delete;
   OperatorMetric& operator=(const OperatorMetric&) = delete;
 
@@ -68,7 +70,8 @@ class OperatorMetric {
           rcount(prefix, "_rcount"),
           rps(prefix, "_rps", &rcount, 1),
           executeLatency(prefix, "_execute_latency"),
-          waitInQueueLatency(prefix, "_wait_in_queue_latency") {}
+          waitInQueueLatency(prefix, "_wait_in_queue_latency"),
+          followerReadCount(prefix, "_follower_read_count") {}
 
     // latency recorder support latency/qps/count
     bvar::LatencyRecorder latRecorder;
@@ -88,6 +91,9 @@ class OperatorMetric {
 
     // latency of request wait in queue
     bvar::LatencyRecorder waitInQueueLatency;
+
+    // readonly requests served by current node as a follower
+    bvar::Adder<uint64_t> followerReadCount;
   };
 
  private:
@@ -41,6 +41,7 @@
 #include "dingofs/src/metaserver/register.h"
 #include "dingofs/src/metaserver/resource_statistic.h"
 #include "dingofs/src/metaserver/s3compact_manager.h"
+#include "dingofs/src/metaserver/storage/converter.h"
 #include "dingofs/src/metaserver/storage/rocksdb_options.h"
 #include "dingofs/src/metaserver/storage/rocksdb_perf.h"
 #include "dingofs/src/metaserver/trash_manager.h"
@@ -56,6 +57,7 @@ DECLARE_bool(raft_sync_meta);
 DECLARE_bool(raft_sync_segments);
 DECLARE_bool(raft_use_fsync_rather_than_fdatasync);
 DECLARE_int32(raft_max_install_snapshot_tasks_num);
+DECLARE_bool(raft_enable_leader_lease);
 
 }  // namespace braft
 
@@ -606,6 +608,7 @@ void Metaserver::InitStorage() {
                                        &options.maxDiskQuotaBytes));
   LOG_IF(FATAL, !conf_->GetBoolValue("storage.memory.compression",
                                      &options.compression));
+  conf_->GetBoolValue("storage.binary_key", &FLAGS_storage_binary_key);
 
   conf_->GetValueFatalIfFail("storage.rocksdb.perf_level",
                              &FLAGS_rocksdb_perf_level);
@@ -728,6 +731,8 @@ void Metaserver::InitBRaftFlags(const std::shared_ptr<Configuration>& conf) {
   dummy(conf, "raft_max_install_snapshot_tasks_num",
         "braft.raft_max_install_snapshot_tasks_num",
         &braft::FLAGS_raft_max_install_snapshot_tasks_num);
+  dummy(conf, "raft_enable_leader_lease", "braft.raft_enable_leader_lease",
+        &braft::FLAGS_raft_enable_leader_lease);
 }
 
 }  // namespace metaserver
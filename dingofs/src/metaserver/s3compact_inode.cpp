@@ -23,6 +23,7 @@
 #include "dingofs/src/metaserver/s3compact_inode.h"
 
 #include <algorithm>
+#include <cerrno>
 #include <list>
 #include <map>
 #include <memory>
@@ -34,6 +35,7 @@
 #include "absl/cleanup/cleanup.h"
 #include "dingofs/proto/common.pb.h"
 #include "dingofs/proto/metaserver.pb.h"
+#include "dingofs/src/client/blockcache/block_pack.h"
 #include "dingofs/src/common/s3util.h"
 #include "dingofs/src/metaserver/copyset/meta_operator.h"
 #include "dingofs/src/metaserver/s3compact_manager.h"
@@ -42,6 +44,8 @@ namespace dingofs {
 namespace metaserver {
 
 using aws::S3Adapter;
+using client::blockcache::BlockKey;
+using client::blockcache::BlockPack;
 using copyset::GetOrModifyS3ChunkInfoOperator;
 
 using pb::common::S3Info;
@@ -283,6 +287,9 @@ int CompactInodeJob::ReadFullChunk(const struct S3CompactCtx& ctx,
       // which means you cannot read data from s3
       // we have to wait data to be flushed to s3
       int ret = ctx.s3adapter->GetObject(aws_key, &buf);
+      if (ret != 0 && ReadPackedBlock(ctx, objName, &buf)) {
+        ret = 0;
+      }
       if (ret != 0) {
         LOG(WARNING) << "s3compact: get s3 obj " << objName << " failed";
         if (retry == maxRetry) return -1;  // no chance
@@ -307,6 +314,64 @@ int CompactInodeJob::ReadFullChunk(const struct S3CompactCtx& ctx,
   return 0;
 }
 
+// The small blocks uploaded by client may be packed into the object of
+// previous block, see client::blockcache::BlockPack. Only the block whose
+// object not found may be packed, and only if the filesystem has the pack
+// marker.
+bool CompactInodeJob::ReadPackedBlock(const struct S3CompactCtx& ctx,
+                                      const std::string& objName,
+                                      std::string* buf) {
+  BlockKey key;
+  auto pos = objName.rfind('/');
+  if (pos == std::string::npos ||
+      !key.ParseFilename(objName.substr(pos + 1))) {
+    return false;
+  }
+
+  uint64_t size;
+  const Aws::String obj_key(objName.c_str(), objName.size());
+  if (ctx.s3adapter->GetObjectSize(obj_key, &size) != -ENOENT) {
+    return false;
+  }
+  std::string marker = BlockPack::MarkerKey(key.fs_id);
+  if (ctx.s3adapter->GetObjectSize(Aws::String(marker.c_str(), marker.size()),
+                                   &size) != 0) {
+    return false;
+  }
+
+  for (const auto& candidate : BlockPack::Candidates(key)) {
+    std::string name = candidate.StoreKey();
+    uint64_t pack_size;
+    int ret = ctx.s3adapter->GetObjectSize(
+        Aws::String(name.c_str(), name.size()), &pack_size);
+    if (ret == -ENOENT) {
+      continue;  // try the previous one
+    } else if (ret != 0) {
+      return false;
+    }
+
+    // only fetch the entries and footer to locate the block
+    size_t offset, length;
+    std::string tail(std::min<uint64_t>(pack_size, BlockPack::kMaxTailSize),
+                     '\0');
+    if (ctx.s3adapter->GetObject(name, tail.data(), pack_size - tail.size(),
+                                 tail.size()) != 0 ||
+        !BlockPack::LookupTail(tail.data(), tail.size(), pack_size, key.index,
+                               &offset, &length)) {
+      return false;
+    }
+
+    buf->resize(length);
+    if (length > 0 &&
+        ctx.s3adapter->GetObject(name, buf->data(), offset, length) != 0) {
+      return false;
+    }
+    VLOG(9) << "s3compact: read " << objName << " from packed obj " << name;
+    return true;
+  }
+  return false;
+}
+
 MetaStatusCode CompactInodeJob::UpdateInode(
     copyset::CopysetNode* copysetNode, const pb::common::PartitionInfo& pinfo,
     uint64_t inodeId,
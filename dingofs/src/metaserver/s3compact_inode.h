@@ -167,6 +167,8 @@ class CompactInodeJob {
                     const std::list<struct Node>& validList,
                     std::string* fullChunk,
                     struct S3NewChunkInfo* newChunkInfo);
+  bool ReadPackedBlock(const struct S3CompactCtx& ctx,
+                       const std::string& objName, std::string* buf);
   virtual pb::metaserver::MetaStatusCode UpdateInode(
       copyset::CopysetNode* copysetNode, const pb::common::PartitionInfo& pinfo,
       uint64_t inodeId,
@@ -22,6 +22,7 @@
 
 #include "dingofs/src/metaserver/storage/converter.h"
 
+#include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <inttypes.h>
 
@@ -38,6 +39,12 @@
 #include "absl/strings/str_format.h"
 #include "dingofs/src/utils/string_util.h"
 
+// A metaserver of older version can't parse the binary key, which may come
+// from the raft snapshot of another member, so enable it only after every
+// metaserver in the cluster has been upgraded.
+DEFINE_bool(storage_binary_key, false,
+            "serialize the storage keys in order-preserving binary format");
+
 namespace dingofs {
 namespace metaserver {
 namespace storage {
@@ -54,6 +61,95 @@ static bool CompareType(const std::string& str, KEY_TYPE keyType) {
   return StringToUl(str, &n) && n == keyType;
 }
 
+/* NOTE: the binary key is encoded as below, the numbers are encoded in
+ * big-endian with fixed length, so the keys are ordered numerically:
+ *   | version (1 byte) | key type (1 byte) | field | field | ... |
+ * the first byte of the legacy key is a decimal digit, e.g: 1:100:1000,
+ * so the version byte of binary key never conflicts with it.
+ */
+static const char kKeyVersion = '\x01';
+
+static bool IsBinaryKey(const std::string& key) {
+  return !key.empty() && key[0] == kKeyVersion;
+}
+
+class KeyEncoder {
+ public:
+  explicit KeyEncoder(KEY_TYPE type) {
+    key_.reserve(32);
+    key_.push_back(kKeyVersion);
+    key_.push_back(static_cast<char>(type));
+  }
+
+  KeyEncoder& Put(uint32_t n) { return PutBigEndian(n); }
+
+  KeyEncoder& Put(uint64_t n) { return PutBigEndian(n); }
+
+  KeyEncoder& Put(const std::string& str) {
+    key_.append(str);
+    return *this;
+  }
+
+  std::string Key() { return std::move(key_); }
+
+ private:
+  template <typename Int>
+  KeyEncoder& PutBigEndian(Int n) {
+    for (int i = sizeof(Int) - 1; i >= 0; i--) {
+      key_.push_back(static_cast<char>((n >> (i * 8)) & 0xff));
+    }
+    return *this;
+  }
+
+ private:
+  std::string key_;
+};
+
+class KeyDecoder {
+ public:
+  KeyDecoder(const std::string& key, KEY_TYPE type)
+      : key_(key),
+        pos_(2),
+        ok_(key.size() >= 2 && key[0] == kKeyVersion &&
+            key[1] == static_cast<char>(type)) {}
+
+  KeyDecoder& Get(uint32_t* n) { return GetBigEndian(n); }
+
+  KeyDecoder& Get(uint64_t* n) { return GetBigEndian(n); }
+
+  // the string must be the last field
+  KeyDecoder& Get(std::string* str) {
+    if (ok_) {
+      str->assign(key_, pos_, std::string::npos);
+      pos_ = key_.size();
+    }
+    return *this;
+  }
+
+  bool Done() const { return ok_ && pos_ == key_.size(); }
+
+ private:
+  template <typename Int>
+  KeyDecoder& GetBigEndian(Int* n) {
+    if (!ok_ || key_.size() - pos_ < sizeof(Int)) {
+      ok_ = false;
+      return *this;
+    }
+
+    Int value = 0;
+    for (size_t i = 0; i < sizeof(Int); i++) {
+      value = (value << 8) | static_cast<unsigned char>(key_[pos_++]);
+    }
+    *n = value;
+    return *this;
+  }
+
+ private:
+  const std::string& key_;
+  size_t pos_;
+  bool ok_;
+};
+
 NameGenerator::NameGenerator(uint32_t partitionId)
     : tableName4Inode_(Format(kTypeInode, partitionId)),
       tableName4S3ChunkInfo_(Format(kTypeS3ChunkInfo, partitionId)),
@@ -116,10 +212,17 @@ bool Key4Inode::operator==(const Key4Inode& rhs) {
 }
 
 std::string Key4Inode::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(keyType_).Put(fsId).Put(inodeId).Key();
+  }
   return absl::StrCat(keyType_, ":", fsId, ":", inodeId);
 }
 
 bool Key4Inode::ParseFromString(const std::string& value) {
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, keyType_).Get(&fsId).Get(&inodeId).Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, ":", &items);
   return items.size() == 3 && CompareType(items[0], keyType_) &&
@@ -127,10 +230,17 @@ bool Key4Inode::ParseFromString(const std::string& value) {
 }
 
 std::string Prefix4AllInode::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(keyType_).Key();
+  }
   return absl::StrCat(keyType_, ":");
 }
 
 bool Prefix4AllInode::ParseFromString(const std::string& value) {
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, keyType_).Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, ":", &items);
   return items.size() == 1 && CompareType(items[0], keyType_);
@@ -159,6 +269,16 @@ Key4S3ChunkInfoList::Key4S3ChunkInfoList(uint32_t fsId, uint64_t inodeId,
       size(size) {}
 
 std::string Key4S3ChunkInfoList::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(keyType_)
+        .Put(fsId)
+        .Put(inodeId)
+        .Put(chunkIndex)
+        .Put(firstChunkId)
+        .Put(lastChunkId)
+        .Put(size)
+        .Key();
+  }
   return absl::StrCat(keyType_, ":", fsId, ":", inodeId, ":", chunkIndex, ":",
                       absl::StrFormat("%020" PRIu64 "", firstChunkId), ":",
                       absl::StrFormat("%020" PRIu64 "", lastChunkId), ":",
@@ -166,6 +286,17 @@ std::string Key4S3ChunkInfoList::SerializeToString() const {
 }
 
 bool Key4S3ChunkInfoList::ParseFromString(const std::string& value) {
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, keyType_)
+        .Get(&fsId)
+        .Get(&inodeId)
+        .Get(&chunkIndex)
+        .Get(&firstChunkId)
+        .Get(&lastChunkId)
+        .Get(&size)
+        .Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, ":", &items);
   return items.size() == 7 && CompareType(items[0], keyType_) &&
@@ -183,11 +314,22 @@ Prefix4ChunkIndexS3ChunkInfoList::Prefix4ChunkIndexS3ChunkInfoList(
     : fsId(fsId), inodeId(inodeId), chunkIndex(chunkIndex) {}
 
 std::string Prefix4ChunkIndexS3ChunkInfoList::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(keyType_).Put(fsId).Put(inodeId).Put(chunkIndex).Key();
+  }
   return absl::StrCat(keyType_, ":", fsId, ":", inodeId, ":", chunkIndex, ":");
 }
 
 bool Prefix4ChunkIndexS3ChunkInfoList::ParseFromString(
     const std::string& value) {
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, keyType_)
+        .Get(&fsId)
+        .Get(&inodeId)
+        .Get(&chunkIndex)
+        .Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, ":", &items);
   return items.size() == 4 && CompareType(items[0], keyType_) &&
@@ -203,10 +345,17 @@ Prefix4InodeS3ChunkInfoList::Prefix4InodeS3ChunkInfoList(uint32_t fsId,
     : fsId(fsId), inodeId(inodeId) {}
 
 std::string Prefix4InodeS3ChunkInfoList::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(keyType_).Put(fsId).Put(inodeId).Key();
+  }
   return absl::StrCat(keyType_, ":", fsId, ":", inodeId, ":");
 }
 
 bool Prefix4InodeS3ChunkInfoList::ParseFromString(const std::string& value) {
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, keyType_).Get(&fsId).Get(&inodeId).Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, ":", &items);
   return items.size() == 3 && CompareType(items[0], keyType_) &&
@@ -214,10 +363,17 @@ bool Prefix4InodeS3ChunkInfoList::ParseFromString(const std::string& value) {
 }
 
 std::string Prefix4AllS3ChunkInfoList::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(keyType_).Key();
+  }
   return absl::StrCat(kTypeS3ChunkInfo, ":");
 }
 
 bool Prefix4AllS3ChunkInfoList::ParseFromString(const std::string& value) {
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, keyType_).Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, ":", &items);
   return items.size() == 1 && CompareType(items[0], keyType_);
@@ -228,11 +384,22 @@ Key4Dentry::Key4Dentry(uint32_t fsId, uint64_t parentInodeId,
     : fsId(fsId), parentInodeId(parentInodeId), name(name) {}
 
 std::string Key4Dentry::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(keyType_).Put(fsId).Put(parentInodeId).Put(name).Key();
+  }
   return absl::StrCat(keyType_, kDelimiter, fsId, kDelimiter, parentInodeId,
                       kDelimiter, name);
 }
 
 bool Key4Dentry::ParseFromString(const std::string& value) {
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, keyType_)
+        .Get(&fsId)
+        .Get(&parentInodeId)
+        .Get(&name)
+        .Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, ":", &items);
   if (items.size() < 3 || !CompareType(items[0], keyType_) ||
@@ -254,11 +421,18 @@ Prefix4SameParentDentry::Prefix4SameParentDentry(uint32_t fsId,
     : fsId(fsId), parentInodeId(parentInodeId) {}
 
 std::string Prefix4SameParentDentry::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(keyType_).Put(fsId).Put(parentInodeId).Key();
+  }
   return absl::StrCat(keyType_, kDelimiter, fsId, kDelimiter, parentInodeId,
                       kDelimiter);
 }
 
 bool Prefix4SameParentDentry::ParseFromString(const std::string& value) {
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, keyType_).Get(&fsId).Get(&parentInodeId).Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, ":", &items);
   return items.size() == 3 && CompareType(items[0], keyType_) &&
@@ -266,10 +440,17 @@ bool Prefix4SameParentDentry::ParseFromString(const std::string& value) {
 }
 
 std::string Prefix4AllDentry::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(keyType_).Key();
+  }
   return absl::StrCat(keyType_, ":");
 }
 
 bool Prefix4AllDentry::ParseFromString(const std::string& value) {
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, keyType_).Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, ":", &items);
   return items.size() == 1 && CompareType(items[0], keyType_);
@@ -280,14 +461,22 @@ Key4VolumeExtentSlice::Key4VolumeExtentSlice(uint32_t fsId, uint64_t inodeId,
     : fsId_(fsId), inodeId_(inodeId), offset_(offset) {}
 
 std::string Key4VolumeExtentSlice::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(keyType_).Put(fsId_).Put(inodeId_).Put(offset_).Key();
+  }
   return absl::StrCat(keyType_, kDelimiter, fsId_, kDelimiter, inodeId_,
                       kDelimiter, offset_);
 }
 
 bool Key4VolumeExtentSlice::ParseFromString(const std::string& value) {
-  // TODO(wuhanqing): reduce unnecessary creation of temporary strings,
-  //                  but, currently, `absl::from_chars` only support floating
-  //                  point
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, keyType_)
+        .Get(&fsId_)
+        .Get(&inodeId_)
+        .Get(&offset_)
+        .Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, kDelimiter, &items);
   return items.size() == 4 && CompareType(items[0], keyType_) &&
@@ -300,11 +489,18 @@ Prefix4InodeVolumeExtent::Prefix4InodeVolumeExtent(uint32_t fsId,
     : fsId_(fsId), inodeId_(inodeId) {}
 
 std::string Prefix4InodeVolumeExtent::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(keyType_).Put(fsId_).Put(inodeId_).Key();
+  }
   return absl::StrCat(keyType_, kDelimiter, fsId_, kDelimiter, inodeId_,
                       kDelimiter);
 }
 
 bool Prefix4InodeVolumeExtent::ParseFromString(const std::string& value) {
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, keyType_).Get(&fsId_).Get(&inodeId_).Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, kDelimiter, &items);
   return items.size() == 3 && CompareType(items[0], keyType_) &&
@@ -312,10 +508,17 @@ bool Prefix4InodeVolumeExtent::ParseFromString(const std::string& value) {
 }
 
 std::string Prefix4AllVolumeExtent::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(keyType_).Key();
+  }
   return absl::StrCat(keyType_, kDelimiter);
 }
 
 bool Prefix4AllVolumeExtent::ParseFromString(const std::string& value) {
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, keyType_).Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, kDelimiter, &items);
   return items.size() == 1 && CompareType(items[0], keyType_);
@@ -325,10 +528,17 @@ Key4InodeAuxInfo::Key4InodeAuxInfo(uint32_t fsId, uint64_t inodeId)
     : fsId(fsId), inodeId(inodeId) {}
 
 std::string Key4InodeAuxInfo::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(keyType_).Put(fsId).Put(inodeId).Key();
+  }
   return absl::StrCat(keyType_, kDelimiter, fsId, kDelimiter, inodeId);
 }
 
 bool Key4InodeAuxInfo::ParseFromString(const std::string& value) {
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, keyType_).Get(&fsId).Get(&inodeId).Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, kDelimiter, &items);
   return items.size() == 3 && CompareType(items[0], keyType_) &&
@@ -338,10 +548,17 @@ bool Key4InodeAuxInfo::ParseFromString(const std::string& value) {
 Key4FsQuota::Key4FsQuota(uint32_t fs_id) : fs_id(fs_id) {}
 
 std::string Key4FsQuota::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(kKeyType).Put(fs_id).Key();
+  }
   return absl::StrCat(kKeyType, kDelimiter, fs_id);
 }
 
 bool Key4FsQuota::ParseFromString(const std::string& value) {
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, kKeyType).Get(&fs_id).Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, kDelimiter, &items);
   return items.size() == 2 && CompareType(items[0], kKeyType) &&
@@ -352,10 +569,17 @@ Key4DirQuota::Key4DirQuota(uint32_t fs_id, uint64_t dir_inode_id)
     : fs_id(fs_id), dir_inode_id(dir_inode_id) {}
 
 std::string Key4DirQuota::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(kKeyType).Put(fs_id).Put(dir_inode_id).Key();
+  }
   return absl::StrCat(kKeyType, kDelimiter, fs_id, kDelimiter, dir_inode_id);
 }
 
 bool Key4DirQuota::ParseFromString(const std::string& value) {
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, kKeyType).Get(&fs_id).Get(&dir_inode_id).Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, kDelimiter, &items);
   return items.size() == 3 && CompareType(items[0], kKeyType) &&
@@ -365,10 +589,17 @@ bool Key4DirQuota::ParseFromString(const std::string& value) {
 Prefix4DirQuotas::Prefix4DirQuotas(uint32_t fs_id) : fs_id(fs_id) {}
 
 std::string Prefix4DirQuotas::SerializeToString() const {
+  if (FLAGS_storage_binary_key) {
+    return KeyEncoder(kKeyType).Put(fs_id).Key();
+  }
   return absl::StrCat(kKeyType, kDelimiter, fs_id, kDelimiter);
 }
 
 bool Prefix4DirQuotas::ParseFromString(const std::string& value) {
+  if (IsBinaryKey(value)) {
+    return KeyDecoder(value, kKeyType).Get(&fs_id).Done();
+  }
+
   std::vector<std::string> items;
   SplitString(value, kDelimiter, &items);
   return items.size() == 2 && CompareType(items[0], kKeyType) &&
@@ -379,6 +610,51 @@ std::string Converter::SerializeToString(const StorageKey& key) {
   return key.SerializeToString();
 }
 
+template <typename Key>
+static bool ConvertKeyAs(const std::string& key, std::string* out) {
+  Key k;
+  if (!k.ParseFromString(key)) {
+    return false;
+  }
+  *out = k.SerializeToString();
+  return true;
+}
+
+bool Converter::ConvertKey(const std::string& key, std::string* out) {
+  uint32_t type;
+  if (IsBinaryKey(key)) {
+    if (key.size() < 2) {
+      return false;
+    }
+    type = static_cast<unsigned char>(key[1]);
+  } else {
+    std::vector<std::string> items;
+    SplitString(key, kDelimiter, &items);
+    if (items.empty() || !StringToUl(items[0], &type)) {
+      return false;
+    }
+  }
+
+  switch (type) {
+    case kTypeInode:
+      return ConvertKeyAs<Key4Inode>(key, out);
+    case kTypeS3ChunkInfo:
+      return ConvertKeyAs<Key4S3ChunkInfoList>(key, out);
+    case kTypeDentry:
+      return ConvertKeyAs<Key4Dentry>(key, out);
+    case kTypeVolumeExtent:
+      return ConvertKeyAs<Key4VolumeExtentSlice>(key, out);
+    case kTypeInodeAuxInfo:
+      return ConvertKeyAs<Key4InodeAuxInfo>(key, out);
+    case kTypeFsQuota:
+      return ConvertKeyAs<Key4FsQuota>(key, out);
+    case kTypeDirQuota:
+      return ConvertKeyAs<Key4DirQuota>(key, out);
+    default:
+      return false;
+  }
+}
+
 bool Converter::SerializeToString(const google::protobuf::Message& entry,
                                   std::string* value) {
   if (!entry.IsInitialized()) {
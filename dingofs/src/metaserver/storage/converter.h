@@ -23,6 +23,7 @@
 #ifndef DINGOFS_SRC_METASERVER_STORAGE_CONVERTER_H_
 #define DINGOFS_SRC_METASERVER_STORAGE_CONVERTER_H_
 
+#include <gflags/gflags.h>
 #include <google/protobuf/message.h>
 
 #include <string>
@@ -30,6 +31,8 @@
 
 #include "dingofs/proto/metaserver.pb.h"
 
+DECLARE_bool(storage_binary_key);
+
 namespace dingofs {
 namespace metaserver {
 
@@ -91,7 +94,9 @@ class StorageKey {
   virtual bool ParseFromString(const std::string& value) = 0;
 };
 
-/* rules for key serialization:
+/* rules for key serialization (if FLAGS_storage_binary_key is set, the key is
+ * encoded in binary with the same order, prefixed with version and key type,
+ * see converter.cpp):
  *   Key4Inode                        : kTypeInode:fsId:InodeId
  *   Prefix4AllInode                  : kTypeInode:
  *   Key4S3ChunkInfoList              :
@@ -387,6 +392,10 @@ class Converter {
   // for key
   std::string SerializeToString(const StorageKey& key);
 
+  // convert the key in either format to the format which keys are
+  // serialized in, see FLAGS_storage_binary_key.
+  bool ConvertKey(const std::string& key, std::string* out);
+
   // for value
   bool SerializeToString(const google::protobuf::Message& entry,
                          std::string* value);
@@ -32,6 +32,7 @@
 #include "dingofs/src/metaserver/storage/rocksdb_perf.h"
 #include "dingofs/src/metaserver/storage/storage.h"
 #include "rocksdb/utilities/checkpoint.h"
+#include "rocksdb/write_batch.h"
 #include "dingofs/src/fs/local_filesystem.h"
 
 namespace dingofs {
@@ -40,6 +41,17 @@ namespace storage {
 
 const std::string RocksDBStorage::kDelimiter_ = ":";  // NOLINT
 
+namespace {
+
+// the format which keys of table are stored in, the database without this key
+// is in legacy format, see Converter::ConvertKey().
+const char* const kKeyFormatKey = "format";
+const char* const kKeyFormatLegacy = "legacy";
+const char* const kKeyFormatBinary = "binary";
+const size_t kConvertBatchSize = 4096;
+
+}  // namespace
+
 Status ToStorageStatus(const ROCKSDB_NAMESPACE::Status& s) {
   if (s.ok()) {
     return Status::OK();
@@ -116,6 +128,12 @@ bool RocksDBStorage::Open() {
   db_ = txnDB_->GetBaseDB();
 
   inited_ = true;
+  if (!ConvertKeys()) {
+    LOG(ERROR) << "Convert keys of rocksdb database at `" << options_.dataDir
+               << "` failed";
+    Close();
+    return false;
+  }
   return true;
 }
 
@@ -330,6 +348,81 @@ Status RocksDBStorage::Rollback() {
   return ToStorageStatus(s);
 }
 
+bool RocksDBStorage::IsTableKey(const rocksdb::Slice& key) {
+  return key.size() > GetKeyPrefixLength() && (key[0] == '0' || key[0] == '1');
+}
+
+bool RocksDBStorage::ConvertKeys() {
+  auto handle = GetColumnFamilyHandle(false);
+  std::string format = kKeyFormatLegacy;
+  std::string target =
+      FLAGS_storage_binary_key ? kKeyFormatBinary : kKeyFormatLegacy;
+  auto s = db_->Get(dbReadOptions_, handle, kKeyFormatKey, &format);
+  if (!s.ok() && !s.IsNotFound()) {
+    LOG(ERROR) << "Get key format failed, status = " << s.ToString();
+    return false;
+  } else if (format == target) {
+    return true;
+  }
+
+  // NOTE: the old and new key are replaced in the same batch,
+  // so it's safe to convert again if crashed in the middle.
+  Converter conv;
+  uint64_t count = 0;
+  rocksdb::WriteBatch batch;
+  rocksdb::ReadOptions options = dbReadOptions_;
+  options.total_order_seek = true;
+  for (auto* cf : handles_) {
+    std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, cf));
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      if (!IsTableKey(iter->key())) {
+        continue;
+      }
+
+      std::string ikey = iter->key().ToString();
+      std::string ukey = ToUserKey(ikey);
+      std::string newKey;
+      if (!conv.ConvertKey(ukey, &newKey)) {
+        LOG(WARNING) << "Skip convert unknown key, ikey = " << ikey;
+        continue;
+      } else if (newKey == ukey) {
+        continue;
+      }
+
+      batch.Delete(cf, ikey);
+      batch.Put(cf, ikey.substr(0, ikey.size() - ukey.size()) + newKey,
+                iter->value());
+      count++;
+      if (batch.Count() >= kConvertBatchSize) {
+        s = db_->Write(dbWriteOptions_, &batch);
+        if (!s.ok()) {
+          LOG(ERROR) << "Write converted keys failed, status = "
+                     << s.ToString();
+          return false;
+        }
+        batch.Clear();
+      }
+    }
+
+    if (!iter->status().ok()) {
+      LOG(ERROR) << "Convert keys failed, status = "
+                 << iter->status().ToString();
+      return false;
+    }
+  }
+
+  batch.Put(handle, kKeyFormatKey, target);
+  s = db_->Write(dbWriteOptions_, &batch);
+  if (!s.ok()) {
+    LOG(ERROR) << "Write converted keys failed, status = " << s.ToString();
+    return false;
+  }
+
+  LOG(INFO) << "Converted " << count << " keys from " << format << " to "
+            << target << " format at `" << options_.dataDir << "`";
+  return true;
+}
+
 StorageOptions RocksDBStorage::GetStorageOptions() const { return options_; }
 
 void RocksDBStorage::InitDbOptions() {
@@ -155,6 +155,13 @@ class RocksDBStorage : public KVStorage, public StorageTransaction {
 
   Status Clear(const std::string& name, bool ordered);
 
+  // key format
+  static bool IsTableKey(const rocksdb::Slice& key);
+
+  // convert the keys of table to the format which keys are serialized in,
+  // e.g. the database is recovered from the snapshot of another member.
+  bool ConvertKeys();
+
  private:
   friend class RocksDBStorageIterator;
   friend class RocksDBStorageTest;
@@ -42,6 +42,10 @@ struct MetaCacheOpt {
 
   uint16_t getPartitionCountOnce = 3;
   uint16_t createPartitionOnce = 3;
+
+  // whether readonly requests can be sent to followers whose applied index
+  // has reached the one client has seen
+  bool followerRead = false;
 };
 
 struct ExcutorOpt {
@@ -232,6 +232,21 @@ struct DINGO_CACHELINE_ALIGNMENT CopysetInfo {
     return 0;
   }
 
+  /**
+   * Get the peer at |seq| modulo the number of peers,
+   * used to spread follower reads across replicas
+   */
+  int GetPeerInfo(uint64_t seq, T* peerid, EndPoint* ep) const {
+    if (csinfos_.empty()) {
+      return -1;
+    }
+
+    const auto& peer = csinfos_[seq % csinfos_.size()];
+    *peerid = peer.peerID;
+    *ep = peer.externalAddr.addr_;
+    return 0;
+  }
+
   /**
    * 添加copyset的peerinfo
    * @param: csinfo为待添加的peer信息
@@ -36,6 +36,8 @@ const std::string S3MultiManagerMetric::prefix =
 const std::string FSMetric::prefix = "dingofs_filesystem";            // NOLINT
 const std::string S3Metric::prefix = "dingofs_s3";                    // NOLINT
 const std::string DiskCacheMetric::prefix = "dingofs_diskcache";      // NOLINT
+const std::string ReadaheadMetric::prefix = "dingofs_readahead";      // NOLINT
+const std::string WriteBackMetric::prefix = "dingofs_write_back";     // NOLINT
 const std::string KVClientMetric::prefix = "dingofs_kvclient";        // NOLINT
 const std::string S3ChunkInfoMetric::prefix = "inode_s3_chunk_info";  // NOLINT
 const std::string WarmupManagerS3Metric::prefix = "dingofs_warmup";   // NOLINT
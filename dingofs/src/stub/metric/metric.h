@@ -200,6 +200,7 @@ struct ClientOpMetric {
   OpMetric opFlush;
   OpMetric opRead;
   OpMetric opWrite;
+  OpMetric opCopyFileRange;
   OpMetric opAll;
 
   ClientOpMetric()
@@ -226,6 +227,7 @@ struct ClientOpMetric {
         opFlush(prefix, "opFlush"),
         opRead(prefix, "opRead"),
         opWrite(prefix, "opWrite"),
+        opCopyFileRange(prefix, "opCopyFileRange"),
         opAll(prefix, "opAll") {}
 };
 
@@ -306,6 +308,66 @@ struct DiskCacheMetric {
   }
 };
 
+struct ReadaheadMetric {
+  static const std::string prefix;
+
+  bvar::Adder<uint64_t> hits;
+  bvar::Adder<uint64_t> misses;
+  bvar::PassiveStatus<double> hit_ratio;
+  bvar::Adder<uint64_t> prefetch_bytes;
+  bvar::Adder<uint64_t> wasted_bytes;  // prefetched but never read
+  bvar::Adder<int64_t> memory_bytes;
+
+ private:
+  explicit ReadaheadMetric()
+      : hits(prefix, "hits"),
+        misses(prefix, "misses"),
+        hit_ratio(prefix, "hit_ratio", &ReadaheadMetric::GetHitRatio, this),
+        prefetch_bytes(prefix, "prefetch_bytes"),
+        wasted_bytes(prefix, "wasted_bytes"),
+        memory_bytes(prefix, "memory_bytes") {}
+  ReadaheadMetric(const ReadaheadMetric&) = delete;
+  ReadaheadMetric& operator=(const ReadaheadMetric&) = delete;
+
+  static double GetHitRatio(void* arg) {
+    auto* metric = static_cast<ReadaheadMetric*>(arg);
+    uint64_t hits = metric->hits.get_value();
+    uint64_t total = hits + metric->misses.get_value();
+    return total == 0 ? 0 : static_cast<double>(hits) / total;
+  }
+
+ public:
+  static ReadaheadMetric& GetInstance() {
+    static ReadaheadMetric instance_;
+    return instance_;
+  }
+};
+
+struct WriteBackMetric {
+  static const std::string prefix;
+
+  bvar::Adder<uint64_t> throttled_writes;
+  bvar::LatencyRecorder stall_us;       // time the throttled writer paused
+  // flushes since the memory used ratio of data stream crossed nearfullRatio
+  bvar::Adder<uint64_t> memory_pressure_flushes;
+  bvar::LatencyRecorder flush_lag;      // seconds from dirty to flushed
+
+ private:
+  explicit WriteBackMetric()
+      : throttled_writes(prefix, "throttled_writes"),
+        stall_us(prefix, "stall_us"),
+        memory_pressure_flushes(prefix, "memory_pressure_flushes"),
+        flush_lag(prefix, "flush_lag") {}
+  WriteBackMetric(const WriteBackMetric&) = delete;
+  WriteBackMetric& operator=(const WriteBackMetric&) = delete;
+
+ public:
+  static WriteBackMetric& GetInstance() {
+    static WriteBackMetric instance_;
+    return instance_;
+  }
+};
+
 struct KVClientMetric {
   static const std::string prefix;
   InterfaceMetric kvClientGet;
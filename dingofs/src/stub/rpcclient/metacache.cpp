@@ -153,6 +153,34 @@ bool MetaCache::SelectTarget(uint32_t fsID, CopysetTarget* target,
   return GetTargetLeader(target, applyIndex);
 }
 
+bool MetaCache::GetTargetForRead(uint32_t fsID, uint64_t inodeID,
+                                 CopysetTarget* target, uint64_t* applyIndex) {
+  if (!GetTarget(fsID, inodeID, target, applyIndex)) {
+    return false;
+  }
+
+  // follower can't serve request until client has seen an applied index
+  if (!metacacheopt_.followerRead || *applyIndex == 0) {
+    return true;
+  }
+
+  CopysetInfo<MetaserverID> copysetInfo;
+  if (!GetCopysetInfowithCopySetID(target->groupID, &copysetInfo)) {
+    return true;
+  }
+
+  MetaserverID peerId = 0;
+  butil::EndPoint endPoint;
+  if (0 == copysetInfo.GetPeerInfo(
+               readSeq_.fetch_add(1, std::memory_order_relaxed), &peerId,
+               &endPoint)) {
+    target->metaServerID = peerId;
+    target->endPoint = endPoint;
+  }
+
+  return true;
+}
+
 void MetaCache::UpdateApplyIndex(const CopysetGroupID& groupID,
                                  uint64_t applyIndex) {
   const auto key = CalcLogicPoolCopysetID(groupID);
@@ -128,6 +128,11 @@ class MetaCache {
   virtual bool SelectTarget(uint32_t fsID, CopysetTarget* target,
                             uint64_t* applyIndex);
 
+  // get target for readonly request, if follower read is enabled, replicas
+  // of the copyset are selected in turn, otherwise it's same as GetTarget
+  virtual bool GetTargetForRead(uint32_t fsID, uint64_t inodeID,
+                                CopysetTarget* target, uint64_t* applyIndex);
+
   virtual void UpdateApplyIndex(const CopysetGroupID& groupID,
                                 uint64_t applyIndex);
 
@@ -211,6 +216,9 @@ class MetaCache {
 
   uint32_t fsID_;
   std::atomic_bool init_;
+
+  // sequence to select replica for follower read
+  std::atomic<uint64_t> readSeq_{0};
 };
 
 }  // namespace rpcclient
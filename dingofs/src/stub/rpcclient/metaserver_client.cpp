@@ -95,13 +95,13 @@ using dingofs::common::StreamStatus;
 
 using CreateDentryExcutor = TaskExecutor;
 using GetDentryExcutor = TaskExecutor;
-using ListDentryExcutor = TaskExecutor;
+using ListDentryExcutor = FollowerReadExcutor;
 using DeleteDentryExcutor = TaskExecutor;
 using PrepareRenameTxExcutor = TaskExecutor;
 using DeleteInodeExcutor = TaskExecutor;
 using UpdateInodeExcutor = TaskExecutor;
-using GetInodeExcutor = TaskExecutor;
-using BatchGetInodeAttrExcutor = TaskExecutor;
+using GetInodeExcutor = FollowerReadExcutor;
+using BatchGetInodeAttrExcutor = FollowerReadExcutor;
 using BatchGetXAttrExcutor = TaskExecutor;
 using GetOrModifyS3ChunkInfoExcutor = TaskExecutor;
 using UpdateVolumeExtentExecutor = TaskExecutor;
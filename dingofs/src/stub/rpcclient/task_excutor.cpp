@@ -333,6 +333,32 @@ bool CreateInodeExcutor::GetTarget() {
   return true;
 }
 
+bool FollowerReadExcutor::GetTarget() {
+  if (!metaCache_->GetTargetForRead(task_->fsID, task_->inodeID,
+                                    &task_->target, &task_->applyIndex)) {
+    LOG(ERROR) << "fetch target for task fail, " << task_->TaskContextStr();
+    return false;
+  }
+  return true;
+}
+
+// The follower redirects the request which it hasn't caught up with, the
+// leader is still valid, so retry on the cached one without refreshing it.
+// Only the redirection from leader itself means the leader may change.
+void FollowerReadExcutor::OnReDirected() {
+  MetaserverID oldTarget = task_->target.metaServerID;
+  bool ok =
+      metaCache_->GetTargetLeader(&task_->target, &task_->applyIndex, false);
+  if (ok && oldTarget != task_->target.metaServerID) {
+    VLOG(3) << "redirected by follower " << oldTarget << ", retry on leader "
+            << task_->target.metaServerID << ", " << task_->TaskContextStr();
+    task_->retryDirectly = true;
+    return;
+  }
+
+  RefreshLeader();
+}
+
 }  // namespace rpcclient
 }  // namespace stub
 }  // namespace dingofs
@@ -127,7 +127,7 @@ class TaskExecutor {
 
   // handle a returned rpc
   void OnSuccess();
-  void OnReDirected();
+  virtual void OnReDirected();
   void OnCopysetNotExist();
   bool OnPartitionNotExist();
   void OnPartitionAllocIDFail();
@@ -242,6 +242,25 @@ class CreateInodeExcutor : public TaskExecutor {
   bool GetTarget() override;
 };
 
+// Executor for readonly requests which may be served by followers, request
+// redirected by follower is retried on the cached leader, and the following
+// retries stick to the leader.
+class FollowerReadExcutor : public TaskExecutor {
+ public:
+  explicit FollowerReadExcutor(
+      const common::ExcutorOpt& opt,
+      const std::shared_ptr<MetaCache>& metaCache,
+      const std::shared_ptr<ChannelManager<common::MetaserverID>>&
+          channelManager,
+      const std::shared_ptr<TaskContext>& task)
+      : TaskExecutor(opt, metaCache, channelManager, task) {}
+
+ protected:
+  bool GetTarget() override;
+
+  void OnReDirected() override;
+};
+
 }  // namespace rpcclient
 }  // namespace stub
 }  // namespace dingofs
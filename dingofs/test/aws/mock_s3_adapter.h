@@ -55,6 +55,8 @@ class MockS3Adapter : public S3Adapter {
   MOCK_METHOD1(DeleteObject, int(const Aws::String&));
   MOCK_METHOD1(DeleteObjects, int(const std::list<Aws::String>& keyList));
   MOCK_METHOD1(ObjectExist, bool(const Aws::String&));
+  MOCK_METHOD2(GetObjectSize, int(const Aws::String&, uint64_t*));
+  MOCK_METHOD2(CopyObject, int(const Aws::String&, const Aws::String&));
   /*
       MOCK_METHOD2(UpdateObjectMeta, int(const Aws::String &,
                            const Aws::Map<Aws::String, Aws::String> &));
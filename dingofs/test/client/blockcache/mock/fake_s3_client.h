@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#ifndef DINGOFS_TEST_CLIENT_BLOCKCACHE_MOCK_FAKE_S3_CLIENT_H_
+#define DINGOFS_TEST_CLIENT_BLOCKCACHE_MOCK_FAKE_S3_CLIENT_H_
+
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "dingofs/src/client/blockcache/s3_client.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::aws::GetObjectAsyncContext;
+using ::dingofs::aws::PutObjectAsyncContext;
+using ::dingofs::aws::S3AdapterOption;
+
+// In-memory object storage, every put costs |latency_us|.
+class FakeS3Client : public S3Client {
+ public:
+  explicit FakeS3Client(uint64_t latency_us = 0) : latency_us_(latency_us) {}
+
+  void Init(const S3AdapterOption&) override {}
+
+  void Destroy() override {}
+
+  BCACHE_ERROR Put(const std::string& key, const char* buffer,
+                   size_t length) override {
+    std::this_thread::sleep_for(std::chrono::microseconds(latency_us_));
+    std::lock_guard<std::mutex> lk(mutex_);
+    objects_[key] = std::string(buffer, length);
+    num_puts_++;
+    return BCACHE_ERROR::OK;
+  }
+
+  BCACHE_ERROR Range(const std::string& key, off_t offset, size_t length,
+                     char* buffer) override {
+    std::lock_guard<std::mutex> lk(mutex_);
+    num_gets_++;
+    auto iter = objects_.find(key);
+    if (iter == objects_.end()) {
+      return BCACHE_ERROR::NOT_FOUND;
+    } else if (static_cast<size_t>(offset) + length > iter->second.size()) {
+      return BCACHE_ERROR::END_OF_FILE;
+    }
+    get_bytes_ += length;
+    std::memcpy(buffer, iter->second.data() + offset, length);
+    return BCACHE_ERROR::OK;
+  }
+
+  BCACHE_ERROR Get(const std::string& key, std::string* data) override {
+    std::lock_guard<std::mutex> lk(mutex_);
+    num_gets_++;
+    auto iter = objects_.find(key);
+    if (iter == objects_.end()) {
+      return BCACHE_ERROR::NOT_FOUND;
+    }
+    *data = iter->second;
+    get_bytes_ += data->size();
+    return BCACHE_ERROR::OK;
+  }
+
+  BCACHE_ERROR Size(const std::string& key, size_t* size) override {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto iter = objects_.find(key);
+    if (iter == objects_.end()) {
+      return BCACHE_ERROR::NOT_FOUND;
+    }
+    *size = iter->second.size();
+    return BCACHE_ERROR::OK;
+  }
+
+  BCACHE_ERROR Copy(const std::string& src_key,
+                    const std::string& dst_key) override {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto iter = objects_.find(src_key);
+    if (iter == objects_.end()) {
+      return BCACHE_ERROR::NOT_FOUND;
+    }
+    objects_[dst_key] = iter->second;
+    return BCACHE_ERROR::OK;
+  }
+
+  BCACHE_ERROR Delete(const std::string& key) override {
+    std::lock_guard<std::mutex> lk(mutex_);
+    objects_.erase(key);
+    return BCACHE_ERROR::OK;
+  }
+
+  void AsyncPut(const std::string& key, const char* buffer, size_t length,
+                RetryCallback callback) override {
+    while (callback(Put(key, buffer, length) == BCACHE_ERROR::OK ? 0 : -1)) {
+    }
+  }
+
+  void AsyncPut(std::shared_ptr<PutObjectAsyncContext>) override {}
+
+  void AsyncGet(std::shared_ptr<GetObjectAsyncContext>) override {}
+
+  uint64_t NumPuts() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return num_puts_;
+  }
+
+  // The number of GET requests and bytes they fetched.
+  uint64_t NumGets() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return num_gets_;
+  }
+
+  uint64_t GetBytes() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return get_bytes_;
+  }
+
+ private:
+  uint64_t latency_us_;
+  std::mutex mutex_;
+  uint64_t num_puts_{0};
+  uint64_t num_gets_{0};
+  uint64_t get_bytes_{0};
+  std::map<std::string, std::string> objects_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_TEST_CLIENT_BLOCKCACHE_MOCK_FAKE_S3_CLIENT_H_
@@ -51,6 +51,9 @@ class MockBlockCache : public BlockCache {
   MOCK_METHOD5(Range, BCACHE_ERROR(const BlockKey& key, off_t offset,
                                    size_t size, char* buffer, bool retrive));
 
+  MOCK_METHOD2(Load, BCACHE_ERROR(const BlockKey& key,
+                                  std::shared_ptr<BlockReader>& reader));
+
   MOCK_METHOD2(Cache, BCACHE_ERROR(const BlockKey& key, const Block& block));
 
   MOCK_METHOD1(Flush, BCACHE_ERROR(uint64_t ino));
@@ -61,6 +61,15 @@ class MockS3Client : public S3Client {
   MOCK_METHOD4(Range, BCACHE_ERROR(const std::string& key, off_t offset,
                                    size_t length, char* buffer));
 
+  MOCK_METHOD2(Get, BCACHE_ERROR(const std::string& key, std::string* data));
+
+  MOCK_METHOD2(Size, BCACHE_ERROR(const std::string& key, size_t* size));
+
+  MOCK_METHOD2(Copy, BCACHE_ERROR(const std::string& src_key,
+                                  const std::string& dst_key));
+
+  MOCK_METHOD1(Delete, BCACHE_ERROR(const std::string& key));
+
   MOCK_METHOD4(AsyncPut, void(const std::string& key, const char* buffer,
                               size_t length, RetryCallback callback));
 
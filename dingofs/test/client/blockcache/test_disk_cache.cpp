@@ -141,6 +141,73 @@ TEST_F(DiskCacheTest, Cache) {
   ASSERT_EQ(std::string(buffer, 3), "xyz");
 }
 
+TEST_F(DiskCacheTest, LoadWithFdCache) {
+  auto builder = DiskCacheBuilder();
+  builder.SetOption(
+      [](DiskCacheOption* option) { option->fd_cache_capacity = 16; });
+  auto _ = MakeCleanup([&]() { builder.Cleanup(); });
+
+  auto disk_cache = builder.Build();
+  auto rc = disk_cache->Init(
+      [](const BlockKey&, const std::string&, BlockContext) {});
+  ASSERT_EQ(rc, BCACHE_ERROR::OK);
+  auto defer = MakeCleanup([&]() { disk_cache->Shutdown(); });
+
+  auto key = BlockKeyBuilder().Build(100);
+  auto block = BlockBuilder().Build("xyz");
+  rc = disk_cache->Cache(key, block);
+  ASSERT_EQ(rc, BCACHE_ERROR::OK);
+
+  // the fd is shared by concurrent readers
+  char buffer[5];
+  std::shared_ptr<BlockReader> reader1, reader2;
+  ASSERT_EQ(disk_cache->Load(key, reader1), BCACHE_ERROR::OK);
+  ASSERT_EQ(disk_cache->Load(key, reader2), BCACHE_ERROR::OK);
+  ASSERT_EQ(reader2->ReadAt(1, 2, buffer), BCACHE_ERROR::OK);
+  ASSERT_EQ(std::string(buffer, 2), "yz");
+  ASSERT_EQ(reader1->ReadAt(0, 3, buffer), BCACHE_ERROR::OK);
+  ASSERT_EQ(std::string(buffer, 3), "xyz");
+  reader1->Close();
+  reader2->Close();
+
+  // read from cached fd
+  std::shared_ptr<BlockReader> reader3;
+  ASSERT_EQ(disk_cache->Load(key, reader3), BCACHE_ERROR::OK);
+  ASSERT_EQ(reader3->ReadAt(0, 1, buffer), BCACHE_ERROR::OK);
+  ASSERT_EQ(std::string(buffer, 1), "x");
+  reader3->Close();
+}
+
+TEST_F(DiskCacheTest, GetBuffer) {
+  auto builder = DiskCacheBuilder();
+  auto _ = MakeCleanup([&]() { builder.Cleanup(); });
+
+  auto disk_cache = builder.Build();
+  auto rc = disk_cache->Init(
+      [](const BlockKey&, const std::string&, BlockContext) {});
+  ASSERT_EQ(rc, BCACHE_ERROR::OK);
+  auto defer = MakeCleanup([&]() { disk_cache->Shutdown(); });
+
+  auto key = BlockKeyBuilder().Build(100);
+  auto block = BlockBuilder().Build("xyz");
+  rc = disk_cache->Cache(key, block);
+  ASSERT_EQ(rc, BCACHE_ERROR::OK);
+
+  std::shared_ptr<BlockReader> reader;
+  ASSERT_EQ(disk_cache->Load(key, reader), BCACHE_ERROR::OK);
+  auto close = MakeCleanup([&]() { reader->Close(); });
+
+  BlockBuffer buffer;
+  ASSERT_TRUE(reader->GetBuffer(1, 2, &buffer));
+  ASSERT_GE(buffer.fd, 0);
+  ASSERT_EQ(buffer.pos, 1);
+
+  // beyond the end of cache file
+  ASSERT_FALSE(reader->GetBuffer(1, 3, &buffer));
+  ASSERT_FALSE(reader->GetBuffer(4, 1, &buffer));
+  ASSERT_FALSE(reader->GetBuffer(-1, 1, &buffer));
+}
+
 TEST_F(DiskCacheTest, IsCached) {
   auto builder = DiskCacheBuilder();
   auto _ = MakeCleanup([&]() { builder.Cleanup(); });
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "dingofs/src/base/string/string.h"
+#include "dingofs/src/client/blockcache/disk_cache_index.h"
+#include "dingofs/src/client/blockcache/disk_cache_layout.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::base::string::GenUuid;
+
+class DiskCacheIndexTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    root_dir_ = "." + GenUuid();
+    layout_ = std::make_shared<DiskCacheLayout>(root_dir_);
+    system(("mkdir -p " + layout_->GetIndexDir()).c_str());
+  }
+
+  void TearDown() override { system(("rm -r " + root_dir_).c_str()); }
+
+  static CacheKey Key(uint64_t id) { return CacheKey(1, 1, id, 0, 0); }
+
+  static CacheValue Value(uint64_t size) { return CacheValue(size, 100); }
+
+  // Load the index by a new instance, like restarting.
+  BCACHE_ERROR Reload(std::map<uint64_t, uint64_t>* blocks) {
+    DiskCacheIndex index(layout_);
+    return index.Load([&](const CacheKey& key, const CacheValue& value) {
+      (*blocks)[key.id] = value.size;
+    });
+  }
+
+  void AppendGarbage(const std::string& name, size_t length) {
+    auto path = layout_->GetIndexDir() + "/" + name;
+    int fd = ::open(path.c_str(), O_WRONLY | O_APPEND);
+    ASSERT_GE(fd, 0);
+    std::string garbage(length, 'x');
+    ASSERT_EQ(::write(fd, garbage.data(), length), length);
+    ::close(fd);
+  }
+
+ protected:
+  std::string root_dir_;
+  std::shared_ptr<DiskCacheLayout> layout_;
+};
+
+TEST_F(DiskCacheIndexTest, NotFound) {
+  std::map<uint64_t, uint64_t> blocks;
+  ASSERT_EQ(Reload(&blocks), BCACHE_ERROR::NOT_FOUND);
+  ASSERT_TRUE(blocks.empty());
+}
+
+TEST_F(DiskCacheIndexTest, CompactAndReplay) {
+  auto index = std::make_shared<DiskCacheIndex>(layout_);
+  index->Reset();
+  ASSERT_FALSE(index->Ready());
+
+  // snapshot: 1, 2, 3
+  ASSERT_EQ(index->Compact([](DiskCacheIndex::LoadFunc handler) {
+    for (uint64_t id = 1; id <= 3; id++) {
+      handler(Key(id), Value(id * 10));
+    }
+  }),
+            BCACHE_ERROR::OK);
+  ASSERT_TRUE(index->Ready());
+
+  // journal: +4, -2
+  index->Add(Key(4), Value(40));
+  index->Delete(Key(2));
+  index->Close();
+
+  std::map<uint64_t, uint64_t> blocks;
+  ASSERT_EQ(Reload(&blocks), BCACHE_ERROR::OK);
+  ASSERT_EQ(blocks, (std::map<uint64_t, uint64_t>{{1, 10}, {3, 30}, {4, 40}}));
+}
+
+TEST_F(DiskCacheIndexTest, CompactFailed) {
+  auto index = std::make_shared<DiskCacheIndex>(layout_);
+  index->Reset();
+  ASSERT_EQ(index->Compact([](DiskCacheIndex::LoadFunc handler) {
+    handler(Key(1), Value(10));
+  }),
+            BCACHE_ERROR::OK);
+
+  // snapshot can't be written
+  auto tmp_path = layout_->GetIndexDir() + "/snapshot.tmp";
+  system(("mkdir -p " + tmp_path).c_str());
+  auto dump = [](DiskCacheIndex::LoadFunc) {};
+
+  // CASE 1: journal (+2) is rotated to journal.old
+  index->Add(Key(2), Value(20));
+  ASSERT_NE(index->Compact(dump), BCACHE_ERROR::OK);
+
+  // CASE 2: journal (+3) must not overwrite journal.old
+  index->Add(Key(3), Value(30));
+  ASSERT_NE(index->Compact(dump), BCACHE_ERROR::OK);
+  index->Close();
+
+  std::map<uint64_t, uint64_t> blocks;
+  ASSERT_EQ(Reload(&blocks), BCACHE_ERROR::OK);
+  ASSERT_EQ(blocks, (std::map<uint64_t, uint64_t>{{1, 10}, {2, 20}, {3, 30}}));
+
+  // CASE 3: compact success drops journal.old
+  system(("rm -r " + tmp_path).c_str());
+  index = std::make_shared<DiskCacheIndex>(layout_);
+  ASSERT_EQ(index->Load([](const CacheKey&, const CacheValue&) {}),
+            BCACHE_ERROR::OK);
+  ASSERT_EQ(index->Compact([](DiskCacheIndex::LoadFunc handler) {
+    for (uint64_t id = 1; id <= 3; id++) {
+      handler(Key(id), Value(id * 10));
+    }
+  }),
+            BCACHE_ERROR::OK);
+  index->Add(Key(4), Value(40));
+  index->Close();
+
+  ASSERT_NE(::access((layout_->GetIndexDir() + "/journal.old").c_str(), F_OK),
+            0);
+  blocks.clear();
+  ASSERT_EQ(Reload(&blocks), BCACHE_ERROR::OK);
+  ASSERT_EQ(blocks, (std::map<uint64_t, uint64_t>{
+                        {1, 10}, {2, 20}, {3, 30}, {4, 40}}));
+}
+
+TEST_F(DiskCacheIndexTest, TornJournalTail) {
+  auto index = std::make_shared<DiskCacheIndex>(layout_);
+  index->Reset();
+  ASSERT_EQ(index->Compact([](DiskCacheIndex::LoadFunc) {}), BCACHE_ERROR::OK);
+  index->Add(Key(1), Value(10));
+  index->Close();
+
+  // crashed while appending
+  AppendGarbage("journal", 10);
+
+  std::map<uint64_t, uint64_t> blocks;
+  ASSERT_EQ(Reload(&blocks), BCACHE_ERROR::OK);
+  ASSERT_EQ(blocks, (std::map<uint64_t, uint64_t>{{1, 10}}));
+
+  // the torn tail is truncated after loaded, new records still valid
+  {
+    DiskCacheIndex index2(layout_);
+    ASSERT_EQ(index2.Load([](const CacheKey&, const CacheValue&) {}),
+              BCACHE_ERROR::OK);
+    index2.Add(Key(2), Value(20));
+  }
+  blocks.clear();
+  ASSERT_EQ(Reload(&blocks), BCACHE_ERROR::OK);
+  ASSERT_EQ(blocks, (std::map<uint64_t, uint64_t>{{1, 10}, {2, 20}}));
+}
+
+TEST_F(DiskCacheIndexTest, Corrupted) {
+  auto index = std::make_shared<DiskCacheIndex>(layout_);
+  index->Reset();
+  ASSERT_EQ(index->Compact([](DiskCacheIndex::LoadFunc handler) {
+    handler(Key(1), Value(10));
+  }),
+            BCACHE_ERROR::OK);
+  index->Close();
+
+  // a whole record with bad checksum
+  AppendGarbage("journal", 64);
+
+  std::map<uint64_t, uint64_t> blocks;
+  ASSERT_NE(Reload(&blocks), BCACHE_ERROR::OK);
+  ASSERT_TRUE(blocks.empty());  // nothing loaded if inconsistent
+
+  // reset makes it empty again
+  index = std::make_shared<DiskCacheIndex>(layout_);
+  index->Reset();
+  index->Close();
+  ASSERT_EQ(Reload(&blocks), BCACHE_ERROR::NOT_FOUND);
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
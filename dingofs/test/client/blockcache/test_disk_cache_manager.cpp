@@ -20,11 +20,19 @@
  * Author: Jingli Chen (Wine93)
  */
 
+#include <butil/time.h>
+
+#include <cstdlib>
+#include <set>
 #include <sstream>
 #include <thread>
+#include <vector>
 
 #include "absl/cleanup/cleanup.h"
+#include "dingofs/src/base/string/string.h"
 #include "dingofs/src/client/blockcache/cache_store.h"
+#include "dingofs/src/client/blockcache/disk_cache_index.h"
+#include "dingofs/src/client/blockcache/disk_cache_manager.h"
 #include "dingofs/src/client/blockcache/log.h"
 #include "dingofs/test/client/blockcache/builder/builder.h"
 #include "glog/logging.h"
@@ -35,6 +43,9 @@ namespace client {
 namespace blockcache {
 
 using ::absl::MakeCleanup;
+using ::butil::Timer;
+using ::dingofs::base::string::GenUuid;
+using ::dingofs::base::time::TimeNow;
 
 class DiskCacheManagerTest : public ::testing::Test {
  protected:
@@ -95,6 +106,142 @@ TEST_F(DiskCacheManagerTest, CleanupExpire) {
   ASSERT_FALSE(disk_cache->IsCached(key));
 }
 
+TEST_F(DiskCacheManagerTest, ShardedCleanupFull) {
+  auto builder = DiskCacheBuilder();
+  builder.SetOption([](DiskCacheOption* option) {
+    option->cache_size = 30;
+    option->index_shards = 4;
+  });
+  auto disk_cache = builder.Build();
+  auto defer = MakeCleanup([&]() {
+    disk_cache->Shutdown();
+    builder.Cleanup();
+  });
+
+  auto rc = disk_cache->Init(
+      [](const BlockKey&, const std::string&, BlockContext) {});
+  ASSERT_EQ(rc, BCACHE_ERROR::OK);
+
+  // the capacity is accounted globally, not per shard
+  auto block = BlockBuilder().Build(std::string(10, '0'));
+  auto ctx = BlockContext(BlockFrom::CTO_FLUSH);
+  for (uint64_t id = 1; id <= 10; id++) {
+    auto key = BlockKeyBuilder().Build(id);
+    ASSERT_EQ(disk_cache->Stage(key, block, ctx), BCACHE_ERROR::OK);
+  }
+
+  int num_cached = 0;
+  for (uint64_t id = 1; id <= 10; id++) {
+    if (disk_cache->IsCached(BlockKeyBuilder().Build(id))) {
+      num_cached++;
+    }
+  }
+  ASSERT_EQ(num_cached, 2);
+}
+
+// Concurrent Get/Add throughput for different shards, e.g. 64 FUSE readers.
+TEST_F(DiskCacheManagerTest, DISABLED_ShardedThroughput) {
+  constexpr int kThreads = 16;
+  constexpr uint64_t kBlocks = 100000;
+  constexpr uint64_t kOpsPerThread = 200000;
+
+  auto option = DiskCacheBuilder::DefaultOption();
+  auto fs = NewTempLocalFileSystem();
+  for (uint32_t shards : {1, 4, 16, 64}) {
+    auto manager = std::make_unique<DiskCacheManager>(
+        option.cache_size, std::make_shared<DiskCacheLayout>("."), fs,
+        std::make_shared<FdCache>(0, fs),
+        std::make_shared<DiskCacheMetric>(option), kLRUPolicy, shards);
+
+    Timer timer;
+    timer.start();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; i++) {
+      threads.emplace_back([&, i]() {
+        CacheValue value;
+        for (uint64_t n = 0; n < kOpsPerThread; n++) {
+          auto key = BlockKeyBuilder().Build((n * kThreads + i) % kBlocks);
+          if (manager->Get(key, &value) != BCACHE_ERROR::OK) {
+            manager->Add(key, CacheValue(1, TimeNow()));
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    timer.stop();
+
+    LOG(INFO) << "shards=" << shards << ", ops/s="
+              << kThreads * kOpsPerThread * 1e6 / timer.u_elapsed();
+    CacheValue value;
+    ASSERT_EQ(manager->Get(BlockKeyBuilder().Build(0), &value),
+              BCACHE_ERROR::OK);
+  }
+}
+
+// The index must end up with the same blocks as the policy, even if the
+// same key is added and deleted concurrently.
+TEST_F(DiskCacheManagerTest, IndexFollowPolicy) {
+  constexpr uint64_t kKeys = 64;
+  constexpr int kAdders = 4;
+
+  std::string root_dir = "." + GenUuid();
+  auto layout = std::make_shared<DiskCacheLayout>(root_dir);
+  std::system(("mkdir -p " + layout->GetIndexDir()).c_str());
+  auto defer = MakeCleanup(
+      [&]() { std::system(("rm -rf " + root_dir).c_str()); });
+
+  auto index = std::make_shared<DiskCacheIndex>(layout);
+  index->Reset();
+  ASSERT_EQ(index->Compact([](DiskCacheIndex::LoadFunc) {}),
+            BCACHE_ERROR::OK);
+
+  auto option = DiskCacheBuilder::DefaultOption();
+  auto fs = NewTempLocalFileSystem();
+  auto manager = std::make_unique<DiskCacheManager>(
+      option.cache_size, layout, fs, std::make_shared<FdCache>(0, fs),
+      std::make_shared<DiskCacheMetric>(option), kLRUPolicy, 4, index);
+
+  // every key has only one adder, so it's never added twice
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kAdders; i++) {
+    threads.emplace_back([&, i]() {
+      CacheValue value;
+      for (int n = 0; n < 20000; n++) {
+        auto key = BlockKeyBuilder().Build(n % kKeys);
+        if (n % kAdders == i && manager->Get(key, &value) != BCACHE_ERROR::OK) {
+          manager->Add(key, CacheValue(1, TimeNow()));
+        }
+      }
+    });
+    threads.emplace_back([&, i]() {
+      for (int n = 0; n < 20000; n++) {
+        manager->Delete(BlockKeyBuilder().Build((n * 7 + i) % kKeys));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  index->Close();
+
+  std::set<uint64_t> indexed;
+  DiskCacheIndex reloaded(layout);
+  ASSERT_EQ(reloaded.Load([&](const CacheKey& key, const CacheValue&) {
+    indexed.insert(key.id);
+  }),
+            BCACHE_ERROR::OK);
+  reloaded.Close();
+
+  for (uint64_t id = 0; id < kKeys; id++) {
+    CacheValue value;
+    bool cached =
+        manager->Get(BlockKeyBuilder().Build(id), &value) == BCACHE_ERROR::OK;
+    ASSERT_EQ(cached, indexed.count(id) == 1) << "id=" << id;
+  }
+}
+
 }  // namespace blockcache
 }  // namespace client
 }  // namespace dingofs
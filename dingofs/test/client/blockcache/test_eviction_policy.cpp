@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "dingofs/src/base/time/time.h"
+#include "dingofs/src/client/blockcache/eviction_policy.h"
+#include "dingofs/src/client/blockcache/tiny_lfu.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+// Replay block access trace to the eviction policy, same as how the
+// disk cache manager does: lookup first, and cache the block if miss.
+class Simulator {
+ public:
+  struct Result {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t admits = 0;  // blocks written to cache
+
+    double HitRatio() const {
+      return static_cast<double>(hits) / (hits + misses);
+    }
+  };
+
+ public:
+  Simulator(std::unique_ptr<EvictionPolicy> policy, size_t capacity)
+      : policy_(std::move(policy)), capacity_(capacity) {}
+
+  Result Replay(const std::vector<uint64_t>& trace) {
+    Result result;
+    CacheValue value;
+    for (auto id : trace) {
+      auto key = BlockKey(1, 1, id, 0, 0);
+      if (policy_->Get(key, &value)) {
+        result.hits++;
+        continue;
+      }
+
+      result.misses++;
+      if (policy_->Size() >= capacity_ && !policy_->Admit(key)) {
+        continue;
+      }
+      policy_->Add(key, CacheValue(1, TimeSpec(0, 0)));
+      result.admits++;
+      if (policy_->Size() > capacity_) {
+        policy_->Evict([&](const CacheValue&) {
+          return policy_->Size() <= capacity_ ? FilterStatus::FINISH
+                                              : FilterStatus::EVICT_IT;
+        });
+      }
+    }
+    return result;
+  }
+
+ private:
+  std::unique_ptr<EvictionPolicy> policy_;
+  size_t capacity_;
+};
+
+class EvictionPolicyTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+  void TearDown() override {}
+
+  CacheKey Key(uint64_t id) { return BlockKey(1, 1, id, 0, 0); }
+
+  // The hot working set which accessed with zipf-like distribution,
+  // and a full-dataset scan interleaved in.
+  static std::vector<uint64_t> ScanTrace(uint64_t hot_blocks,
+                                         uint64_t scan_blocks,
+                                         uint64_t rounds) {
+    std::mt19937 gen(0);
+    std::vector<double> weights;
+    for (uint64_t i = 1; i <= hot_blocks; i++) {
+      weights.push_back(1.0 / i);
+    }
+    std::discrete_distribution<uint64_t> hot(weights.begin(), weights.end());
+
+    std::vector<uint64_t> trace;
+    uint64_t next_scan = 1000000;
+    for (uint64_t round = 0; round < rounds; round++) {
+      for (uint64_t i = 0; i < hot_blocks * 4; i++) {
+        trace.push_back(hot(gen));
+        if (i % 2 == 0) {
+          trace.push_back(next_scan++);
+        }
+      }
+      for (uint64_t i = 0; i < scan_blocks; i++) {
+        trace.push_back(next_scan++);
+      }
+    }
+    return trace;
+  }
+};
+
+TEST_F(EvictionPolicyTest, NewEvictionPolicy) {
+  ASSERT_EQ(NewEvictionPolicy("")->Name(), kLRUPolicy);
+  ASSERT_EQ(NewEvictionPolicy("lru")->Name(), kLRUPolicy);
+  ASSERT_EQ(NewEvictionPolicy("tinylfu")->Name(), kTinyLFUPolicy);
+  ASSERT_EQ(NewEvictionPolicy("unknown")->Name(), kLRUPolicy);
+}
+
+TEST_F(EvictionPolicyTest, CountMinSketch) {
+  CountMinSketch sketch(16);
+  ASSERT_EQ(sketch.Estimate(1), 0);
+
+  for (int i = 0; i < 5; i++) {
+    sketch.Increment(1);
+  }
+  ASSERT_GE(sketch.Estimate(1), 5);
+
+  // saturated at 15
+  for (int i = 0; i < 20; i++) {
+    sketch.Increment(2);
+  }
+  ASSERT_LE(sketch.Estimate(2), 15);
+
+  // aging: all counters are halved after 160 (16 * 10) increments
+  for (int i = 0; i < 200; i++) {
+    sketch.Increment(3);
+  }
+  ASSERT_LT(sketch.Estimate(2), 15);
+}
+
+TEST_F(EvictionPolicyTest, TinyLFUAdmit) {
+  auto cache = std::make_unique<TinyLFUCache>();
+  ASSERT_TRUE(cache->Admit(Key(1)));  // empty
+
+  CacheValue value;
+  cache->Add(Key(1), CacheValue(1, TimeSpec(0, 0)));
+  cache->Get(Key(1), &value);
+  cache->Get(Key(1), &value);
+
+  // victim (key 1) is more frequent than key 2
+  cache->Get(Key(2), &value);
+  ASSERT_FALSE(cache->Admit(Key(2)));
+
+  cache->Get(Key(2), &value);
+  cache->Get(Key(2), &value);
+  ASSERT_TRUE(cache->Admit(Key(2)));
+}
+
+TEST_F(EvictionPolicyTest, SimulateScan) {
+  auto trace = ScanTrace(1000, 5000, 20);
+  auto lru = Simulator(NewEvictionPolicy(kLRUPolicy), 1000).Replay(trace);
+  auto tinylfu =
+      Simulator(NewEvictionPolicy(kTinyLFUPolicy), 1000).Replay(trace);
+
+  LOG(INFO) << "lru: hit_ratio=" << lru.HitRatio()
+            << ", admits=" << lru.admits;
+  LOG(INFO) << "tinylfu: hit_ratio=" << tinylfu.HitRatio()
+            << ", admits=" << tinylfu.admits;
+  ASSERT_GT(tinylfu.HitRatio(), lru.HitRatio());
+  ASSERT_LT(tinylfu.admits, lru.admits);
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dingofs/src/base/filepath/filepath.h"
+#include "dingofs/src/client/blockcache/io_engine.h"
+#include "dingofs/src/client/blockcache/local_filesystem.h"
+#include "dingofs/src/utils/uuid.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::base::filepath::PathJoin;
+using ::dingofs::utils::UUIDGenerator;
+
+class IOEngineTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    root_dir_ = "." + UUIDGenerator().GenerateUUID();
+    std::system(("mkdir -p " + root_dir_).c_str());
+  }
+
+  void TearDown() override { std::system(("rm -rf " + root_dir_).c_str()); }
+
+  void WriteAndRead(std::shared_ptr<IOEngine> engine) {
+    auto fs = std::make_shared<LocalFileSystem>(nullptr, engine);
+    std::string path = PathJoin({root_dir_, engine->Name()});
+    std::string data(3 * 1024 * 1024 + 17, '\0');  // span multi segments
+    for (size_t i = 0; i < data.size(); i++) {
+      data[i] = 'a' + (i % 26);
+    }
+
+    ASSERT_EQ(fs->WriteFile(path, data.c_str(), data.size()),
+              BCACHE_ERROR::OK);
+
+    size_t length;
+    std::shared_ptr<char> buffer;
+    ASSERT_EQ(fs->ReadFile(path, buffer, &length), BCACHE_ERROR::OK);
+    ASSERT_EQ(length, data.size());
+    ASSERT_EQ(std::string(buffer.get(), length), data);
+
+    // range read
+    int fd;
+    char range[100];
+    auto rc = fs->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
+      auto rc = posix->Open(path, O_RDONLY, &fd);
+      if (rc == BCACHE_ERROR::OK) {
+        rc = posix->PRead(fd, range, sizeof(range), 1024 * 1024 + 3);
+        posix->Close(fd);
+      }
+      return rc;
+    });
+    ASSERT_EQ(rc, BCACHE_ERROR::OK);
+    ASSERT_EQ(std::string(range, sizeof(range)),
+              data.substr(1024 * 1024 + 3, sizeof(range)));
+  }
+
+  void MisalignedDirectWrite(std::shared_ptr<IOEngine> engine) {
+    auto fs = std::make_shared<LocalFileSystem>(nullptr, engine);
+    std::string path = PathJoin({root_dir_, engine->Name()});
+    size_t length = 1024 * 1024 + 4096;  // aligned length, multi segments
+    char* aligned;
+    ASSERT_EQ(::posix_memalign(reinterpret_cast<void**>(&aligned),
+                               IO_ALIGNED_BLOCK_SIZE, length + 1),
+              0);
+    char* misaligned = aligned + 1;
+    for (size_t i = 0; i < length; i++) {
+      misaligned[i] = 'a' + (i % 26);
+    }
+
+    ASSERT_EQ(fs->WriteFile(path, misaligned, length, true),
+              BCACHE_ERROR::OK);
+
+    size_t n;
+    std::shared_ptr<char> buffer;
+    ASSERT_EQ(fs->ReadFile(path, buffer, &n), BCACHE_ERROR::OK);
+    ASSERT_EQ(n, length);
+    ASSERT_EQ(std::string(buffer.get(), n), std::string(misaligned, length));
+    ::free(aligned);
+  }
+
+  bool SupportDirectIO() {
+    std::string path = PathJoin({root_dir_, "direct"});
+    int fd = ::open(path.c_str(), O_CREAT | O_WRONLY | O_DIRECT, 0644);
+    if (fd < 0) {
+      return false;
+    }
+    ::close(fd);
+    return true;
+  }
+
+ protected:
+  std::string root_dir_;
+};
+
+TEST_F(IOEngineTest, NewIOEngine) {
+  ASSERT_EQ(NewIOEngine("")->Name(), kPosixIOEngine);
+  ASSERT_EQ(NewIOEngine("posix")->Name(), kPosixIOEngine);
+  ASSERT_EQ(NewIOEngine("unknown")->Name(), kPosixIOEngine);
+
+  // fallback to posix if io_uring is not available
+  auto engine = NewIOEngine("io_uring");
+  ASSERT_TRUE(engine->Name() == kPosixIOEngine ||
+              engine->Name() == kUringIOEngine);
+}
+
+TEST_F(IOEngineTest, PosixIOEngine) {
+  WriteAndRead(NewIOEngine(kPosixIOEngine));
+}
+
+TEST_F(IOEngineTest, UringIOEngine) {
+  WriteAndRead(NewIOEngine(kUringIOEngine));
+}
+
+TEST_F(IOEngineTest, MisalignedDirectWrite) {
+  if (!SupportDirectIO()) {
+    GTEST_SKIP() << "O_DIRECT is not supported by test directory";
+  }
+
+  // posix engine fallback to buffered IO, io_uring engine use direct IO
+  MisalignedDirectWrite(NewIOEngine(kPosixIOEngine));
+  MisalignedDirectWrite(NewIOEngine(kUringIOEngine));
+}
+
+TEST_F(IOEngineTest, ConcurrentIO) {
+  auto engine = NewIOEngine(kUringIOEngine);
+  auto fs = std::make_shared<LocalFileSystem>(nullptr, engine);
+  std::vector<std::thread> threads;
+  std::atomic<int> failed(0);
+  for (int i = 0; i < 16; i++) {
+    threads.emplace_back([&, i]() {
+      std::string path = PathJoin({root_dir_, std::to_string(i)});
+      std::string data(2 * 1024 * 1024, 'a' + i);
+      size_t length;
+      std::shared_ptr<char> buffer;
+      if (fs->WriteFile(path, data.c_str(), data.size()) != BCACHE_ERROR::OK ||
+          fs->ReadFile(path, buffer, &length) != BCACHE_ERROR::OK ||
+          std::string(buffer.get(), length) != data) {
+        failed++;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(failed.load(), 0);
+  engine->Shutdown();
+}
+
+// Random 4KiB reads from concurrent threads, run it with
+// --gtest_also_run_disabled_tests.
+TEST_F(IOEngineTest, DISABLED_BenchmarkRandomRead) {
+  constexpr size_t kFileSize = 256 * 1024 * 1024;
+  constexpr size_t kIOSize = 4096;
+  constexpr int kThreads = 16;
+  constexpr int kIOsPerThread = 20000;
+
+  for (const auto* name : {kPosixIOEngine, kUringIOEngine}) {
+    auto engine = NewIOEngine(name);
+    auto fs = std::make_shared<LocalFileSystem>(nullptr, engine);
+    std::string path = PathJoin({root_dir_, engine->Name()});
+    std::string data(kFileSize, 'x');
+    ASSERT_EQ(fs->WriteFile(path, data.c_str(), data.size()),
+              BCACHE_ERROR::OK);
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    std::vector<std::vector<uint64_t>> latencies(kThreads);
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kThreads; i++) {
+      threads.emplace_back([&, i]() {
+        std::mt19937_64 rand(i);
+        char buffer[kIOSize];
+        for (int j = 0; j < kIOsPerThread; j++) {
+          off_t offset = (rand() % (kFileSize / kIOSize)) * kIOSize;
+          auto t0 = std::chrono::steady_clock::now();
+          CHECK_EQ(engine->PRead(fd, buffer, kIOSize, offset), 0);
+          latencies[i].push_back(
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - t0)
+                  .count());
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    ::close(fd);
+
+    std::vector<uint64_t> all;
+    for (const auto& l : latencies) {
+      all.insert(all.end(), l.begin(), l.end());
+    }
+    std::sort(all.begin(), all.end());
+    LOG(INFO) << "io engine (" << engine->Name()
+              << "): iops=" << static_cast<uint64_t>(all.size() / seconds)
+              << ", p99=" << all[all.size() * 99 / 100] << "us";
+    engine->Shutdown();
+  }
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
@@ -20,7 +20,8 @@
  * Author: Jingli Chen (Wine93)
  */
 
-#include <sstream>
+#include <memory>
+#include <string>
 
 #include "dingofs/src/client/blockcache/cache_store.h"
 #include "dingofs/src/client/blockcache/mem_cache.h"
@@ -35,16 +36,28 @@ class MemCacheTest : public ::testing::Test {
  protected:
   void SetUp() override {}
   void TearDown() override {}
+
+  static BlockKey Key(uint64_t id) { return BlockKey(1, 1, id, 0, 0); }
+
+  static BCACHE_ERROR Cache(MemCache* store, uint64_t id, size_t size,
+                            char c) {
+    std::string data(size, c);
+    return store->Cache(Key(id), Block(data.data(), data.size()));
+  }
+
+  static bool Hit(MemCache* store, uint64_t id) {
+    std::shared_ptr<BlockReader> reader;
+    return store->Load(Key(id), reader) == BCACHE_ERROR::OK;
+  }
 };
 
-TEST_F(MemCacheTest, Basic) {
+TEST_F(MemCacheTest, Disabled) {
   auto store = std::make_unique<MemCache>();
   BlockKey key;
   Block block(nullptr, 0);
   std::shared_ptr<BlockReader> reader;
 
   ASSERT_EQ(store->Init(nullptr), BCACHE_ERROR::OK);
-  ASSERT_EQ(store->Shutdown(), BCACHE_ERROR::OK);
   ASSERT_EQ(store->Stage(key, block, BlockContext(BlockFrom::CTO_FLUSH)),
             BCACHE_ERROR::NOT_SUPPORTED);
   ASSERT_EQ(store->RemoveStage(key, BlockContext(BlockFrom::CTO_FLUSH)),
@@ -53,6 +66,99 @@ TEST_F(MemCacheTest, Basic) {
   ASSERT_EQ(store->Load(key, reader), BCACHE_ERROR::NOT_SUPPORTED);
   ASSERT_FALSE(store->IsCached(key));
   ASSERT_EQ(store->Id(), "memory_cache");
+  ASSERT_EQ(store->Shutdown(), BCACHE_ERROR::OK);
+}
+
+TEST_F(MemCacheTest, CacheAndLoad) {
+  auto store = std::make_unique<MemCache>(MemCacheOption{1024});
+  ASSERT_EQ(store->Init(nullptr), BCACHE_ERROR::OK);
+
+  // stage is not supported
+  std::string data = "hello world";
+  Block block(data.data(), data.size());
+  ASSERT_EQ(store->Stage(Key(1), block, BlockContext(BlockFrom::CTO_FLUSH)),
+            BCACHE_ERROR::NOT_SUPPORTED);
+
+  // cache
+  std::shared_ptr<BlockReader> reader;
+  ASSERT_EQ(store->Load(Key(1), reader), BCACHE_ERROR::NOT_FOUND);
+  ASSERT_EQ(store->Cache(Key(1), block), BCACHE_ERROR::OK);
+  ASSERT_TRUE(store->IsCached(Key(1)));
+  ASSERT_EQ(store->UsedBytes(), data.size());
+
+  // load
+  ASSERT_EQ(store->Load(Key(1), reader), BCACHE_ERROR::OK);
+  char buffer[16];
+  ASSERT_EQ(reader->ReadAt(6, 5, buffer), BCACHE_ERROR::OK);
+  ASSERT_EQ(std::string(buffer, 5), "world");
+  ASSERT_EQ(reader->ReadAt(6, 6, buffer), BCACHE_ERROR::END_OF_FILE);
+  reader->Close();
+
+  // block larger than capacity
+  ASSERT_EQ(Cache(store.get(), 2, 2048, 'x'), BCACHE_ERROR::CACHE_FULL);
+  ASSERT_FALSE(store->IsCached(Key(2)));
+
+  ASSERT_EQ(store->Shutdown(), BCACHE_ERROR::OK);
+  ASSERT_FALSE(store->IsCached(Key(1)));
+  ASSERT_EQ(store->UsedBytes(), 0);
+}
+
+TEST_F(MemCacheTest, CapacityBound) {
+  auto store = std::make_unique<MemCache>(MemCacheOption{1000});
+  ASSERT_EQ(store->Init(nullptr), BCACHE_ERROR::OK);
+
+  for (uint64_t id = 1; id <= 20; id++) {
+    ASSERT_EQ(Cache(store.get(), id, 100, 'a'), BCACHE_ERROR::OK);
+    ASSERT_LE(store->UsedBytes(), 1000);
+  }
+
+  // evict the oldest blocks
+  for (uint64_t id = 1; id <= 10; id++) {
+    ASSERT_FALSE(store->IsCached(Key(id)));
+  }
+  for (uint64_t id = 11; id <= 20; id++) {
+    ASSERT_TRUE(store->IsCached(Key(id)));
+  }
+}
+
+TEST_F(MemCacheTest, ScanResistant) {
+  auto store = std::make_unique<MemCache>(MemCacheOption{1000});
+  ASSERT_EQ(store->Init(nullptr), BCACHE_ERROR::OK);
+
+  // hot blocks: accessed more than once
+  for (uint64_t id = 1; id <= 5; id++) {
+    ASSERT_EQ(Cache(store.get(), id, 100, 'a'), BCACHE_ERROR::OK);
+    ASSERT_TRUE(Hit(store.get(), id));
+  }
+
+  // a large scan which only accessed once
+  for (uint64_t id = 100; id < 200; id++) {
+    ASSERT_EQ(Cache(store.get(), id, 100, 'b'), BCACHE_ERROR::OK);
+  }
+
+  for (uint64_t id = 1; id <= 5; id++) {
+    ASSERT_TRUE(store->IsCached(Key(id)));
+  }
+  ASSERT_FALSE(store->IsCached(Key(100)));
+  ASSERT_TRUE(store->IsCached(Key(199)));
+}
+
+TEST_F(MemCacheTest, ReadAfterEvict) {
+  auto store = std::make_unique<MemCache>(MemCacheOption{100});
+  ASSERT_EQ(store->Init(nullptr), BCACHE_ERROR::OK);
+
+  ASSERT_EQ(Cache(store.get(), 1, 100, 'a'), BCACHE_ERROR::OK);
+  std::shared_ptr<BlockReader> reader;
+  ASSERT_EQ(store->Load(Key(1), reader), BCACHE_ERROR::OK);
+
+  // the block is evicted, but the reader still holds it
+  ASSERT_EQ(Cache(store.get(), 2, 100, 'b'), BCACHE_ERROR::OK);
+  ASSERT_FALSE(store->IsCached(Key(1)));
+
+  char buffer[100];
+  ASSERT_EQ(reader->ReadAt(0, 100, buffer), BCACHE_ERROR::OK);
+  ASSERT_EQ(std::string(buffer, 100), std::string(100, 'a'));
+  reader->Close();
 }
 
 }  // namespace blockcache
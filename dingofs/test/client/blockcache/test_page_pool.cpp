@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include <glog/logging.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "dingofs/src/base/math/math.h"
+#include "dingofs/src/client/datastream/memory_pool.h"
+#include "dingofs/src/client/datastream/page_allocator.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::base::math::kKiB;
+using ::dingofs::client::datastream::MemoryPool;
+using ::dingofs::client::datastream::PageAllocator;
+using ::dingofs::client::datastream::PagePool;
+
+class PagePoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(PagePoolTest, AllocateAll) {
+  uint64_t num_pages = 1024;
+  auto pool = std::make_unique<PagePool>();
+  ASSERT_TRUE(pool->Init(64 * kKiB, num_pages));
+  ASSERT_EQ(pool->GetFreePages(), num_pages);
+
+  std::set<char*> pages;
+  for (uint64_t i = 0; i < num_pages; i++) {
+    char* page = pool->Allocate();
+    ASSERT_TRUE(page != nullptr);
+    std::memset(page, 0, 64 * kKiB);
+    ASSERT_TRUE(pages.insert(page).second);  // no duplicate
+  }
+  ASSERT_EQ(pool->GetFreePages(), 0);
+
+  for (auto* page : pages) {
+    pool->DeAllocate(page);
+  }
+  ASSERT_EQ(pool->GetFreePages(), num_pages);
+}
+
+TEST_F(PagePoolTest, StealFromOtherThreads) {
+  uint64_t num_pages = 1024;
+  auto pool = std::make_unique<PagePool>();
+  ASSERT_TRUE(pool->Init(4 * kKiB, num_pages));
+
+  // the pages freed by one thread are cached in its magazine
+  std::vector<char*> pages;
+  std::thread t1([&]() {
+    for (uint64_t i = 0; i < num_pages; i++) {
+      pages.emplace_back(pool->Allocate());
+    }
+    for (auto* page : pages) {
+      pool->DeAllocate(page);
+    }
+  });
+  t1.join();
+
+  // other thread still can allocate all pages
+  std::thread t2([&]() {
+    for (uint64_t i = 0; i < num_pages; i++) {
+      ASSERT_TRUE(pool->Allocate() != nullptr);
+    }
+  });
+  t2.join();
+  ASSERT_EQ(pool->GetFreePages(), 0);
+}
+
+TEST_F(PagePoolTest, WaitForFreePage) {
+  auto pool = std::make_unique<PagePool>();
+  ASSERT_TRUE(pool->Init(4 * kKiB, 1));
+  char* page = pool->Allocate();
+
+  std::atomic<bool> allocated(false);
+  std::thread thread([&]() {
+    ASSERT_EQ(pool->Allocate(), page);
+    allocated.store(true);
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_FALSE(allocated.load());
+  pool->DeAllocate(page);
+  thread.join();
+  ASSERT_TRUE(allocated.load());
+}
+
+TEST_F(PagePoolTest, NumaAware) {
+  // fallback to one node if NUMA is not available
+  uint64_t num_pages = 1024;
+  auto pool = std::make_unique<PagePool>(true);
+  ASSERT_TRUE(pool->Init(4 * kKiB, num_pages));
+
+  std::vector<char*> pages;
+  for (uint64_t i = 0; i < num_pages; i++) {
+    pages.emplace_back(pool->Allocate());
+  }
+  ASSERT_EQ(pool->GetFreePages(), 0);
+  for (auto* page : pages) {
+    pool->DeAllocate(page);
+  }
+  ASSERT_EQ(pool->GetFreePages(), num_pages);
+}
+
+// The page pool before thread local cache, for comparison.
+class MutexPagePool : public PageAllocator {
+ public:
+  bool Init(uint64_t page_size, uint64_t num_pages) override {
+    return mem_pool_.CreatePool(page_size, num_pages);
+  }
+
+  char* Allocate() override {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return reinterpret_cast<char*>(mem_pool_.Allocate());
+  }
+
+  void DeAllocate(char* page) override {
+    std::lock_guard<std::mutex> lk(mutex_);
+    mem_pool_.DeAllocate(page);
+  }
+
+  uint64_t GetFreePages() override {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return mem_pool_.GetFreeBlocks();
+  }
+
+ private:
+  std::mutex mutex_;
+  MemoryPool mem_pool_;
+};
+
+// Every thread allocates a batch of pages then frees them, like writing
+// and flushing DataCache.
+TEST_F(PagePoolTest, DISABLED_BenchmarkContention) {
+  const uint64_t kNumPages = 4096;
+  const int kLoops = 2000;
+  const int kBatch = 16;
+
+  auto run = [&](const std::string& name, PageAllocator* pool, int nthreads) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nthreads; i++) {
+      threads.emplace_back([&]() {
+        char* pages[kBatch];
+        for (int loop = 0; loop < kLoops; loop++) {
+          for (auto& page : pages) {
+            page = pool->Allocate();
+          }
+          for (auto* page : pages) {
+            pool->DeAllocate(page);
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    double ops = 2.0 * nthreads * kLoops * kBatch;
+    LOG(INFO) << name << " (" << nthreads
+              << " threads): " << ops / seconds / 1e6 << " Mops/s";
+    ASSERT_EQ(pool->GetFreePages(), kNumPages);
+  };
+
+  for (int nthreads : {1, 4, 16}) {
+    MutexPagePool mutex_pool;
+    ASSERT_TRUE(mutex_pool.Init(4 * kKiB, kNumPages));
+    run("mutex", &mutex_pool, nthreads);
+
+    PagePool page_pool;
+    ASSERT_TRUE(page_pool.Init(4 * kKiB, kNumPages));
+    run("magazine", &page_pool, nthreads);
+  }
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
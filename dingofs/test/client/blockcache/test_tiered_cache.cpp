@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include <memory>
+#include <string>
+
+#include "absl/cleanup/cleanup.h"
+#include "dingofs/src/client/blockcache/cache_store.h"
+#include "dingofs/src/client/blockcache/tiered_cache.h"
+#include "dingofs/test/client/blockcache/builder/builder.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::absl::MakeCleanup;
+
+class TieredCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    disk_option_ = DiskCacheBuilder::DefaultOption();
+    system(("mkdir -p " + disk_option_.cache_dir).c_str());
+  }
+
+  void TearDown() override {
+    system(("rm -r " + disk_option_.cache_dir).c_str());
+  }
+
+  std::unique_ptr<TieredCache> Build(size_t mem_cache_size) {
+    auto store = std::make_unique<TieredCache>(
+        MemCacheOption{mem_cache_size},
+        std::vector<DiskCacheOption>{disk_option_});
+    auto rc =
+        store->Init([](const BlockKey&, const std::string&, BlockContext) {});
+    EXPECT_EQ(rc, BCACHE_ERROR::OK);
+    return store;
+  }
+
+  static std::string Read(std::shared_ptr<BlockReader> reader,
+                          size_t length) {
+    std::string buffer(length, '\0');
+    EXPECT_EQ(reader->ReadAt(0, length, buffer.data()), BCACHE_ERROR::OK);
+    return buffer;
+  }
+
+  DiskCacheOption disk_option_;
+};
+
+TEST_F(TieredCacheTest, CacheAndLoad) {
+  auto store = Build(1024);
+  auto defer = MakeCleanup([&]() { store->Shutdown(); });
+
+  auto key = BlockKeyBuilder().Build(100);
+  std::string data(100, 'a');
+  ASSERT_FALSE(store->IsCached(key));
+  ASSERT_EQ(store->Cache(key, Block(data.data(), data.size())),
+            BCACHE_ERROR::OK);
+  ASSERT_TRUE(store->IsCached(key));
+
+  std::shared_ptr<BlockReader> reader;
+  ASSERT_EQ(store->Load(key, reader), BCACHE_ERROR::OK);
+  ASSERT_EQ(Read(reader, data.size()), data);
+
+  // the block which exceed memory capacity goes to disk tier directly
+  auto key2 = BlockKeyBuilder().Build(200);
+  std::string data2(2048, 'b');
+  ASSERT_EQ(store->Cache(key2, Block(data2.data(), data2.size())),
+            BCACHE_ERROR::OK);
+  ASSERT_TRUE(store->IsCached(key2));
+  ASSERT_EQ(store->Load(key2, reader), BCACHE_ERROR::OK);
+  ASSERT_EQ(Read(reader, data2.size()), data2);
+}
+
+TEST_F(TieredCacheTest, DemoteOnEvict) {
+  auto store = Build(1024);
+  auto defer = MakeCleanup([&]() { store->Shutdown(); });
+
+  // the first block will be evicted from memory tier by the later one
+  std::string data(600, 'a');
+  for (uint64_t id = 1; id <= 2; id++) {
+    auto key = BlockKeyBuilder().Build(id);
+    ASSERT_EQ(store->Cache(key, Block(data.data(), data.size())),
+              BCACHE_ERROR::OK);
+  }
+
+  auto key = BlockKeyBuilder().Build(1);
+  ASSERT_TRUE(store->IsCached(key));
+  std::shared_ptr<BlockReader> reader;
+  ASSERT_EQ(store->Load(key, reader), BCACHE_ERROR::OK);
+  ASSERT_EQ(Read(reader, data.size()), data);
+}
+
+TEST_F(TieredCacheTest, PromoteOnRepeatedDiskHit) {
+  auto store = Build(4096);
+  auto defer = MakeCleanup([&]() { store->Shutdown(); });
+
+  // stage block always goes to disk tier
+  auto key = BlockKeyBuilder().Build(100);
+  std::string data(100, 'a');
+  auto ctx = BlockContext(BlockFrom::CTO_FLUSH);
+  ASSERT_EQ(store->Stage(key, Block(data.data(), data.size()), ctx),
+            BCACHE_ERROR::OK);
+  ASSERT_TRUE(store->IsCached(key));
+
+  std::shared_ptr<BlockReader> reader;
+  ASSERT_EQ(store->Load(key, reader), BCACHE_ERROR::OK);
+  ASSERT_EQ(dynamic_cast<MemBlockReader*>(reader.get()), nullptr);
+
+  // promoted on the second hit
+  ASSERT_EQ(store->Load(key, reader), BCACHE_ERROR::OK);
+  ASSERT_NE(dynamic_cast<MemBlockReader*>(reader.get()), nullptr);
+  ASSERT_EQ(Read(reader, data.size()), data);
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
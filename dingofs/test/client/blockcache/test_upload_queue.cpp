@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+
+#include <chrono>
+#include <thread>
+
+#include "dingofs/src/client/blockcache/block_cache_uploader_cmmon.h"
+#include "dingofs/src/client/common/dynamic_config.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+USING_FLAG(block_cache_upload_max_delay_ms);
+
+class UploadQueueTest : public ::testing::Test {
+ protected:
+  void SetUp() override { FLAGS_block_cache_upload_max_delay_ms = 0; }
+
+  void TearDown() override { FLAGS_block_cache_upload_max_delay_ms = 30000; }
+
+  static StageBlock NewBlock(uint64_t ino, uint64_t index, BlockFrom from) {
+    static uint64_t seq_num = 0;
+    BlockKey key(1, ino, 1, index, 0);
+    return StageBlock(seq_num++, key, "", BlockContext(from));
+  }
+
+  static void Push(PendingQueue* queue, uint64_t ino, uint64_t n,
+                   BlockFrom from) {
+    for (uint64_t i = 0; i < n; i++) {
+      queue->Push(NewBlock(ino, i, from));
+    }
+  }
+
+  static void AssertBlocks(const std::vector<StageBlock>& stage_blocks,
+                           uint64_t ino, size_t n) {
+    ASSERT_EQ(stage_blocks.size(), n);
+    for (const auto& stage_block : stage_blocks) {
+      ASSERT_EQ(stage_block.key.ino, ino);
+    }
+  }
+};
+
+TEST_F(UploadQueueTest, RoundRobinBetweenInodes) {
+  PendingQueue queue;
+  Push(&queue, 1, 40, BlockFrom::NOCTO_FLUSH);
+  Push(&queue, 2, 2, BlockFrom::NOCTO_FLUSH);
+  ASSERT_EQ(queue.Size(), 42);
+
+  AssertBlocks(queue.Pop(), 1, 16);
+  AssertBlocks(queue.Pop(), 2, 2);  // not wait for inode 1
+  auto stage_blocks = queue.Pop();
+  AssertBlocks(stage_blocks, 1, 16);
+  ASSERT_EQ(stage_blocks[0].key.index, 16);  // in staged order
+  AssertBlocks(queue.Pop(), 1, 8);
+  ASSERT_EQ(queue.Size(), 0);
+  ASSERT_TRUE(queue.Pop().empty());
+}
+
+TEST_F(UploadQueueTest, ClassPriority) {
+  PendingQueue queue;
+  Push(&queue, 1, 1, BlockFrom::RELOAD);
+  Push(&queue, 2, 1, BlockFrom::NOCTO_FLUSH);
+  Push(&queue, 3, 1, BlockFrom::CTO_FLUSH);
+
+  StatBlocks stat;
+  queue.Stat(&stat);
+  ASSERT_EQ(stat.num_total, 3);
+  ASSERT_EQ(stat.num_from_cto, 1);
+
+  AssertBlocks(queue.Pop(), 3, 1);
+  ASSERT_TRUE(queue.Pop(true).empty());  // only cto
+  AssertBlocks(queue.Pop(), 2, 1);
+  AssertBlocks(queue.Pop(), 1, 1);
+}
+
+TEST_F(UploadQueueTest, UrgeFlushingInode) {
+  PendingQueue queue;
+  Push(&queue, 1, 2, BlockFrom::CTO_FLUSH);
+  Push(&queue, 2, 2, BlockFrom::CTO_FLUSH);
+  Push(&queue, 2, 1, BlockFrom::NOCTO_FLUSH);
+
+  queue.Urge(2);
+  queue.Urge(2);  // nested
+  queue.Push(NewBlock(2, 2, BlockFrom::CTO_FLUSH));
+  auto stage_blocks = queue.Pop();
+  AssertBlocks(stage_blocks, 2, 3);
+  for (const auto& stage_block : stage_blocks) {
+    ASSERT_TRUE(stage_block.urgent);
+    ASSERT_EQ(stage_block.ctx.from, BlockFrom::CTO_FLUSH);
+  }
+
+  queue.Unurge(2);
+  queue.Push(NewBlock(2, 3, BlockFrom::CTO_FLUSH));
+  queue.Push(NewBlock(1, 2, BlockFrom::CTO_FLUSH));
+  queue.Unurge(2);  // back to normal queue
+  stage_blocks = queue.Pop();
+  AssertBlocks(stage_blocks, 1, 3);
+  ASSERT_FALSE(stage_blocks[0].urgent);
+  stage_blocks = queue.Pop();
+  AssertBlocks(stage_blocks, 2, 1);
+  ASSERT_FALSE(stage_blocks[0].urgent);
+  ASSERT_EQ(stage_blocks[0].key.index, 3);
+  AssertBlocks(queue.Pop(), 2, 1);  // nocto
+  ASSERT_EQ(queue.Size(), 0);
+}
+
+TEST_F(UploadQueueTest, MaxDelay) {
+  FLAGS_block_cache_upload_max_delay_ms = 1;
+
+  PendingQueue queue;
+  Push(&queue, 1, 1, BlockFrom::RELOAD);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  Push(&queue, 2, 1, BlockFrom::CTO_FLUSH);
+  AssertBlocks(queue.Pop(), 1, 1);  // starved
+  AssertBlocks(queue.Pop(), 2, 1);
+
+  FLAGS_block_cache_upload_max_delay_ms = 0;
+  Push(&queue, 1, 1, BlockFrom::RELOAD);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  Push(&queue, 2, 1, BlockFrom::CTO_FLUSH);
+  AssertBlocks(queue.Pop(), 2, 1);
+  AssertBlocks(queue.Pop(), 1, 1);
+}
+
+TEST_F(UploadQueueTest, UploadingOrder) {
+  UploadingQueue queue(10);
+  queue.Push(NewBlock(3, 0, BlockFrom::NOCTO_FLUSH));
+  queue.Push(NewBlock(2, 0, BlockFrom::CTO_FLUSH));
+  queue.Push(NewBlock(1, 0, BlockFrom::CTO_FLUSH));  // pushed after inode 2
+  auto stage_block = NewBlock(4, 0, BlockFrom::CTO_FLUSH);
+  stage_block.urgent = true;
+  queue.Push(stage_block);
+  ASSERT_EQ(queue.Size(), 4);
+
+  std::vector<uint64_t> inodes;
+  while (queue.Pop(&stage_block, 0)) {
+    inodes.emplace_back(stage_block.key.ino);
+  }
+  ASSERT_EQ(inodes, (std::vector<uint64_t>{4, 2, 1, 3}));
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
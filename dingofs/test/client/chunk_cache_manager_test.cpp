@@ -312,10 +312,12 @@ TEST_F(ChunkCacheManagerTest, test_flush) {
   char* buf = new char[len];
   auto dataCache = std::make_shared<MockDataCache>(
       s3ClientAdaptor_, chunkCacheManager_, offset, len, buf, nullptr);
-  EXPECT_CALL(*dataCache, Flush(_, _))
+  EXPECT_CALL(*dataCache, FlushAsync(_, _, _))
       .WillOnce(Return(DINGOFS_ERROR::OK))
-      .WillOnce(Return(DINGOFS_ERROR::INTERNAL))
-      .WillOnce(Return(DINGOFS_ERROR::OK));
+      .WillOnce(Return(DINGOFS_ERROR::INTERNAL));
+  EXPECT_CALL(*dataCache, WaitFlush(_)).WillOnce(Return(DINGOFS_ERROR::OK));
+  // retry synchronously
+  EXPECT_CALL(*dataCache, Flush(_, _)).WillOnce(Return(DINGOFS_ERROR::OK));
   EXPECT_CALL(*dataCache, CanFlush(_))
       .WillOnce(Return(true))
       .WillOnce(Return(false))
@@ -333,6 +335,37 @@ TEST_F(ChunkCacheManagerTest, test_flush) {
   delete[] buf;
 }
 
+TEST_F(ChunkCacheManagerTest, test_flush_pipelined) {
+  uint64_t inodeId = 1;
+  uint64_t len = 1024 * 1024;
+  char* buf = new char[len];
+  auto dataCache1 = std::make_shared<MockDataCache>(
+      s3ClientAdaptor_, chunkCacheManager_, 0, len, buf, nullptr);
+  auto dataCache2 = std::make_shared<MockDataCache>(
+      s3ClientAdaptor_, chunkCacheManager_, 2 * len, len, buf, nullptr);
+  EXPECT_CALL(*dataCache1, CanFlush(_)).WillOnce(Return(true));
+  EXPECT_CALL(*dataCache2, CanFlush(_)).WillOnce(Return(true));
+
+  // all uploads are issued before waiting, and committed in order
+  {
+    ::testing::InSequence seq;
+    EXPECT_CALL(*dataCache1, FlushAsync(_, _, _))
+        .WillOnce(Return(DINGOFS_ERROR::OK));
+    EXPECT_CALL(*dataCache2, FlushAsync(_, _, _))
+        .WillOnce(Return(DINGOFS_ERROR::OK));
+    EXPECT_CALL(*dataCache1, WaitFlush(_)).WillOnce(Return(DINGOFS_ERROR::OK));
+    EXPECT_CALL(*dataCache2, WaitFlush(_))
+        .WillOnce(Return(DINGOFS_ERROR::NOTEXIST));
+  }
+
+  chunkCacheManager_->AddWriteDataCacheForTest(dataCache1);
+  chunkCacheManager_->AddWriteDataCacheForTest(dataCache2);
+  ASSERT_EQ(DINGOFS_ERROR::OK, chunkCacheManager_->Flush(inodeId, true, true));
+  ASSERT_TRUE(chunkCacheManager_->IsMemEmpty());
+
+  delete[] buf;
+}
+
 TEST_F(ChunkCacheManagerTest, test_release_read_dataCache) {
   uint64_t offset = 0;
   uint64_t len = 1024 * 1024;
@@ -27,10 +27,14 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <string>
 
 #include "dingofs/src/client/blockcache/block_cache.h"
+#include "dingofs/src/client/blockcache/block_pack.h"
 #include "dingofs/src/client/blockcache/error.h"
+#include "dingofs/src/client/blockcache/s3_client.h"
 #include "dingofs/src/client/inode_wrapper.h"
+#include "dingofs/test/client/blockcache/mock/fake_s3_client.h"
 #include "dingofs/test/client/blockcache/mock/mock_block_cache.h"
 #include "dingofs/test/client/mock_client_s3.h"
 #include "dingofs/test/client/mock_client_s3_cache_manager.h"
@@ -45,12 +49,17 @@ using ::testing::Return;
 using ::testing::SetArgPointee;
 
 using dingofs::client::blockcache::BCACHE_ERROR;
+using dingofs::client::blockcache::BlockKey;
+using dingofs::client::blockcache::BlockPack;
+using dingofs::client::blockcache::FakeS3Client;
 using dingofs::client::blockcache::MockBlockCache;
+using dingofs::client::blockcache::RangePackedBlock;
 using dingofs::client::blockcache::StoreType;
 using dingofs::client::common::S3ClientAdaptorOption;
 using dingofs::stub::rpcclient::MockMdsClient;
 
 using dingofs::pb::mds::FSStatusCode;
+using dingofs::pb::metaserver::S3ChunkInfo;
 
 class ClientS3AdaptorTest : public testing::Test {
  protected:
@@ -217,6 +226,214 @@ TEST_F(ClientS3AdaptorTest, truncate_big_more_chunkId) {
   ASSERT_EQ(1000, s3ChunkInfo1.chunkid());
 }
 
+TEST_F(ClientS3AdaptorTest, copy_range_not_support) {
+  auto src = InitInode();
+  auto dst = InitInode();
+
+  // CASE 1: not at the same position of chunk
+  ASSERT_EQ(DINGOFS_ERROR::NOTSUPPORT,
+            s3ClientAdaptor_->CopyRange(src.get(), 0, dst.get(), 1024,
+                                        1024 * 1024));
+
+  // CASE 2: copy from the middle of chunk info
+  S3ChunkInfo info;
+  info.set_chunkid(1);
+  info.set_compaction(0);
+  info.set_offset(0);
+  info.set_len(2 * 1024 * 1024);
+  info.set_size(2 * 1024 * 1024);
+  info.set_zero(false);
+  src->AppendS3ChunkInfo(0, info);
+  ASSERT_EQ(DINGOFS_ERROR::NOTSUPPORT,
+            s3ClientAdaptor_->CopyRange(src.get(), 1024 * 1024, dst.get(),
+                                        1024 * 1024, 1024 * 1024));
+  ASSERT_TRUE(dst->GetChunkInfoMap()->empty());
+}
+
+TEST_F(ClientS3AdaptorTest, copy_range_hole) {
+  auto src = InitInode();
+  auto dst = InitInode();
+
+  S3ChunkInfo info;
+  info.set_chunkid(1);
+  info.set_compaction(0);
+  info.set_offset(0);
+  info.set_len(4 * 1024 * 1024);
+  info.set_size(4 * 1024 * 1024);
+  info.set_zero(true);
+  src->AppendS3ChunkInfo(0, info);
+
+  uint64_t chunkId = 999;
+  EXPECT_CALL(*mockMdsClient_, AllocS3ChunkId(_, 2, _))
+      .WillOnce(DoAll(SetArgPointee<2>(chunkId), Return(FSStatusCode::OK)));
+  ASSERT_EQ(DINGOFS_ERROR::OK,
+            s3ClientAdaptor_->CopyRange(src.get(), 1024 * 1024, dst.get(),
+                                        5 * 1024 * 1024, 2 * 1024 * 1024));
+
+  auto s3ChunkInfoMap = dst->GetChunkInfoMap();
+  auto iter = s3ChunkInfoMap->find(1);
+  ASSERT_NE(iter, s3ChunkInfoMap->end());
+  ASSERT_EQ(2, iter->second.s3chunks_size());
+  auto fill = iter->second.s3chunks(0);
+  ASSERT_EQ(999, fill.chunkid());
+  ASSERT_EQ(5 * 1024 * 1024, fill.offset());
+  ASSERT_EQ(2 * 1024 * 1024, fill.len());
+  ASSERT_TRUE(fill.zero());
+  auto hole = iter->second.s3chunks(1);
+  ASSERT_EQ(1000, hole.chunkid());
+  ASSERT_EQ(5 * 1024 * 1024, hole.offset());
+  ASSERT_EQ(2 * 1024 * 1024, hole.len());
+  ASSERT_TRUE(hole.zero());
+}
+
+// Copy the objects in an in-memory object storage, the block size is 4KiB
+// and the chunk size is 64KiB, the chunk id is allocated from 100.
+class ClientS3AdaptorCopyTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    s3_ = std::make_shared<FakeS3Client>();
+    mockMdsClient_ = std::make_shared<MockMdsClient>();
+    EXPECT_CALL(*mockMdsClient_, AllocS3ChunkId(_, _, _))
+        .WillRepeatedly(
+            DoAll(SetArgPointee<2>(100), Return(FSStatusCode::OK)));
+
+    S3ClientAdaptorOption option{};
+    option.blockSize = 4 * kKiB;
+    option.chunkSize = 64 * kKiB;
+    option.pageSize = 4 * kKiB;
+    s3ClientAdaptor_ = std::make_shared<S3ClientAdaptorImpl>();
+    ASSERT_EQ(s3ClientAdaptor_->Init(option, s3_, nullptr, mockMdsClient_,
+                                     nullptr, nullptr,
+                                     std::make_shared<MockBlockCache>(),
+                                     nullptr),
+              DINGOFS_ERROR::OK);
+    s3ClientAdaptor_->SetFsId(1);
+  }
+
+  static std::unique_ptr<InodeWrapper> NewInode(uint64_t ino) {
+    Inode inode;
+    inode.set_inodeid(ino);
+    inode.set_fsid(1);
+    inode.set_type(dingofs::pb::metaserver::FsFileType::TYPE_S3);
+    return absl::make_unique<InodeWrapper>(std::move(inode), nullptr);
+  }
+
+  static S3ChunkInfo NewChunkInfo(uint64_t chunkId, uint64_t offset,
+                                  uint64_t length) {
+    S3ChunkInfo info;
+    info.set_chunkid(chunkId);
+    info.set_compaction(0);
+    info.set_offset(offset);
+    info.set_len(length);
+    info.set_size(length);
+    info.set_zero(false);
+    return info;
+  }
+
+ protected:
+  static constexpr uint64_t kKiB = 1024;
+  std::shared_ptr<FakeS3Client> s3_;
+  std::shared_ptr<MockMdsClient> mockMdsClient_;
+  std::shared_ptr<S3ClientAdaptorImpl> s3ClientAdaptor_;
+};
+
+TEST_F(ClientS3AdaptorCopyTest, copy_range_objects) {
+  auto src = NewInode(1);
+  auto dst = NewInode(2);
+  std::string block(4 * kKiB, 'a');
+  for (uint64_t index = 0; index < 2; index++) {
+    BlockKey key(1, 1, 1, index, 0);
+    ASSERT_EQ(s3_->Put(key.StoreKey(), block.data(), block.size()),
+              BCACHE_ERROR::OK);
+  }
+  src->AppendS3ChunkInfo(0, NewChunkInfo(1, 0, 8 * kKiB));
+
+  // the objects are copied to the chunk 101, the chunk 100 fills zero
+  ASSERT_EQ(s3ClientAdaptor_->CopyRange(src.get(), 0, dst.get(), 64 * kKiB,
+                                        8 * kKiB),
+            DINGOFS_ERROR::OK);
+  for (uint64_t index = 0; index < 2; index++) {
+    size_t size;
+    ASSERT_EQ(s3_->Size(BlockKey(1, 2, 101, index, 0).StoreKey(), &size),
+              BCACHE_ERROR::OK);
+    ASSERT_EQ(size, block.size());
+  }
+
+  auto* infos = dst->GetChunkInfoMap();
+  auto iter = infos->find(1);
+  ASSERT_NE(iter, infos->end());
+  ASSERT_EQ(iter->second.s3chunks_size(), 2);
+  ASSERT_TRUE(iter->second.s3chunks(0).zero());
+  auto copied = iter->second.s3chunks(1);
+  ASSERT_EQ(copied.chunkid(), 101);
+  ASSERT_EQ(copied.offset(), 64 * kKiB);
+  ASSERT_EQ(copied.len(), 8 * kKiB);
+  ASSERT_FALSE(copied.zero());
+}
+
+TEST_F(ClientS3AdaptorCopyTest, copy_range_packed) {
+  BlockPack pack;
+  for (uint64_t index = 0; index < 3; index++) {
+    std::string block(4 * kKiB, 'a' + index);
+    pack.Add(BlockKey(1, 1, 1, index, 0), block.data(), block.size());
+  }
+  auto data = pack.Finish();
+  ASSERT_EQ(s3_->Put(BlockPack::MarkerKey(1), "", 0), BCACHE_ERROR::OK);
+  ASSERT_EQ(s3_->Put(BlockKey(1, 1, 1, 0, 0).StoreKey(), data.data(),
+                     data.size()),
+            BCACHE_ERROR::OK);
+
+  auto src = NewInode(1);
+  auto dst = NewInode(2);
+  src->AppendS3ChunkInfo(0, NewChunkInfo(1, 0, 12 * kKiB));
+
+  // the pack is copied, other blocks are read from it
+  ASSERT_EQ(s3ClientAdaptor_->CopyRange(src.get(), 0, dst.get(), 0, 12 * kKiB),
+            DINGOFS_ERROR::OK);
+  char buffer[4 * kKiB];
+  for (uint64_t index = 1; index < 3; index++) {
+    ASSERT_EQ(RangePackedBlock(s3_.get(), BlockKey(1, 2, 101, index, 0), 0,
+                               sizeof(buffer), buffer),
+              BCACHE_ERROR::OK);
+    ASSERT_EQ(buffer[0], 'a' + index);
+  }
+}
+
+TEST_F(ClientS3AdaptorCopyTest, copy_range_missing_object) {
+  auto src = NewInode(1);
+  auto dst = NewInode(2);
+  std::string block(4 * kKiB, 'a');
+  ASSERT_EQ(s3_->Put(BlockPack::MarkerKey(1), "", 0), BCACHE_ERROR::OK);
+  ASSERT_EQ(s3_->Put(BlockKey(1, 1, 1, 0, 0).StoreKey(), block.data(),
+                     block.size()),
+            BCACHE_ERROR::OK);
+
+  // CASE 1: the block 1 is neither stored nor packed, the copied object of
+  //         block 0 is removed.
+  src->AppendS3ChunkInfo(0, NewChunkInfo(1, 0, 8 * kKiB));
+  ASSERT_EQ(s3ClientAdaptor_->CopyRange(src.get(), 0, dst.get(), 0, 8 * kKiB),
+            DINGOFS_ERROR::NOTSUPPORT);
+  size_t size;
+  ASSERT_EQ(s3_->Size(BlockKey(1, 2, 101, 0, 0).StoreKey(), &size),
+            BCACHE_ERROR::NOT_FOUND);
+  ASSERT_TRUE(dst->GetChunkInfoMap()->empty());
+
+  // CASE 2: the block is packed, but the pack is out of the range
+  BlockPack pack;
+  pack.Add(BlockKey(1, 3, 3, 0, 0), block.data(), block.size());
+  pack.Add(BlockKey(1, 3, 3, 1, 0), block.data(), block.size());
+  auto data = pack.Finish();
+  ASSERT_EQ(s3_->Put(BlockKey(1, 3, 3, 0, 0).StoreKey(), data.data(),
+                     data.size()),
+            BCACHE_ERROR::OK);
+  src = NewInode(3);
+  src->AppendS3ChunkInfo(0, NewChunkInfo(3, 4 * kKiB, 4 * kKiB));
+  ASSERT_EQ(s3ClientAdaptor_->CopyRange(src.get(), 4 * kKiB, dst.get(),
+                                        4 * kKiB, 4 * kKiB),
+            DINGOFS_ERROR::NOTSUPPORT);
+  ASSERT_TRUE(dst->GetChunkInfoMap()->empty());
+}
+
 TEST_F(ClientS3AdaptorTest, flush_no_file_cache) {
   uint64_t inodeId = 1;
 
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dingofs/src/client/s3/client_s3_flush_window.h"
+
+namespace dingofs {
+namespace client {
+
+TEST(FlushWindowTest, Unlimited) {
+  FlushWindow window(0);
+  for (int i = 0; i < 100; i++) {
+    window.Acquire();
+  }
+  ASSERT_EQ(window.Inflight(), 100);
+}
+
+TEST(FlushWindowTest, BlockWhenFull) {
+  FlushWindow window(2);
+  window.Acquire();
+  window.Acquire();
+
+  std::atomic<bool> acquired(false);
+  std::thread t([&]() {
+    window.Acquire();
+    acquired.store(true);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_FALSE(acquired.load());
+
+  window.Release();
+  t.join();
+  ASSERT_TRUE(acquired.load());
+  ASSERT_EQ(window.Inflight(), 2);
+}
+
+// Compare the flush time of a file with |kSlices| slices, each slice has
+// |kBlocks| blocks and every PUT takes |kPutMs|:
+//   serial:    wait for all blocks of a slice before the next slice
+//   pipelined: issue the blocks of all slices bounded by flush window
+TEST(FlushWindowTest, DISABLED_BenchmarkPipelinedFlush) {
+  const int kSlices = 8;
+  const int kBlocks = 4;
+  const int kPutMs = 10;
+
+  auto put = [&](FlushWindow* window, std::atomic<int>* pending) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(kPutMs));
+    if (window != nullptr) {
+      window->Release();
+    }
+    pending->fetch_sub(1);
+  };
+
+  auto run = [&](const std::string& name, std::shared_ptr<FlushWindow> window,
+                 bool pipelined) {
+    std::vector<std::thread> threads;
+    std::atomic<int> pending(0);
+    auto wait = [&]() {
+      while (pending.load() > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (int slice = 0; slice < kSlices; slice++) {
+      for (int block = 0; block < kBlocks; block++) {
+        if (window != nullptr) {
+          window->Acquire();
+        }
+        pending.fetch_add(1);
+        threads.emplace_back(put, window.get(), &pending);
+      }
+      if (!pipelined) {
+        wait();
+      }
+    }
+    wait();
+    double ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+    for (auto& t : threads) {
+      t.join();
+    }
+    LOG(INFO) << name << ": " << ms << " ms for " << kSlices * kBlocks
+              << " blocks";
+    return ms;
+  };
+
+  double serial = run("serial", nullptr, false);
+  double pipelined = run("pipelined", std::make_shared<FlushWindow>(16), true);
+  ASSERT_LT(pipelined, serial);
+}
+
+}  // namespace client
+}  // namespace dingofs
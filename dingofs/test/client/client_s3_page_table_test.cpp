@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "dingofs/src/client/datastream/data_stream.h"
+#include "dingofs/src/client/s3/client_s3_page_table.h"
+
+namespace dingofs {
+namespace client {
+
+using datastream::DataStream;
+
+static constexpr uint64_t kKiB = 1024;
+static constexpr uint64_t kMiB = 1024 * kKiB;
+static constexpr uint64_t kPageSize = 64 * kKiB;
+
+class PageTableTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    common::DataStreamOption option;
+    option.background_flush_option.trigger_force_memory_ratio = 0.9;
+    option.file_option = {1, 16};
+    option.chunk_option = {1, 16};
+    option.slice_option = {1, 16};
+    option.page_option = {kPageSize, 256 * kMiB, false};
+    ASSERT_TRUE(DataStream::GetInstance().Init(option));
+  }
+};
+
+TEST_F(PageTableTest, GetOrNew) {
+  PageTable table;
+  bool created;
+  ASSERT_EQ(table.Get(3), nullptr);
+
+  char* page = table.GetOrNew(3, &created);
+  ASSERT_TRUE(created);
+  ASSERT_EQ(table.GetOrNew(3, &created), page);
+  ASSERT_FALSE(created);
+  ASSERT_EQ(table.Get(3), page);
+  ASSERT_EQ(table.Get(2), nullptr);
+  ASSERT_EQ(table.Get(4), nullptr);
+  ASSERT_EQ(table.NumPages(), 1);
+
+  // grow at both ends
+  char* page1 = table.GetOrNew(1, &created);
+  char* page5 = table.GetOrNew(5, &created);
+  ASSERT_EQ(table.Get(1), page1);
+  ASSERT_EQ(table.Get(3), page);
+  ASSERT_EQ(table.Get(5), page5);
+  ASSERT_EQ(table.Get(2), nullptr);
+  ASSERT_EQ(table.NumPages(), 3);
+}
+
+TEST_F(PageTableTest, TakeAndPut) {
+  PageTable table;
+  bool created;
+  for (uint64_t index = 0; index < 4; index++) {
+    table.GetOrNew(index, &created);
+  }
+
+  // take from front, like merging into another DataCache
+  PageTable table2;
+  for (uint64_t index = 0; index < 4; index++) {
+    char* page = table.Take(index);
+    ASSERT_NE(page, nullptr);
+    ASSERT_EQ(table.Take(index), nullptr);
+    table2.Put(index, page);
+  }
+  ASSERT_EQ(table.NumPages(), 0);
+  ASSERT_EQ(table2.NumPages(), 4);
+
+  // free from tail, like truncate
+  table2.Free(3);
+  table2.Free(2);
+  table2.Free(2);
+  ASSERT_EQ(table2.NumPages(), 2);
+  ASSERT_EQ(table2.Get(2), nullptr);
+  ASSERT_NE(table2.Get(1), nullptr);
+
+  // the table can be reused after empty
+  table.GetOrNew(100, &created);
+  ASSERT_TRUE(created);
+  ASSERT_EQ(table.NumPages(), 1);
+}
+
+// The page index of DataCache before PageTable, for comparison: a node
+// per block and per page.
+class MapPageTable {
+  struct PageData {
+    uint64_t index;
+    char* data;
+  };
+  using PageDataMap = std::map<uint64_t, PageData*>;
+
+ public:
+  explicit MapPageTable(uint64_t pages_per_block)
+      : pages_per_block_(pages_per_block) {}
+
+  ~MapPageTable() {
+    for (auto& block : blocks_) {
+      for (auto& page : block.second) {
+        DataStream::GetInstance().FreePage(page.second->data);
+        delete page.second;
+      }
+    }
+  }
+
+  char* GetOrNew(uint64_t index, bool* created) {
+    PageDataMap& pdMap = blocks_[index / pages_per_block_];
+    uint64_t pageIndex = index % pages_per_block_;
+    *created = (pdMap.count(pageIndex) == 0);
+    if (*created) {
+      PageData* pageData = new PageData();
+      pageData->data = DataStream::GetInstance().NewPage();
+      pageData->index = pageIndex;
+      pdMap.emplace(pageIndex, pageData);
+    }
+    return pdMap[pageIndex]->data;
+  }
+
+  // Estimated heap bytes of index (rb-tree node is 4 words + value).
+  uint64_t IndexBytes() const {
+    uint64_t num_pages = 0;
+    for (const auto& block : blocks_) {
+      num_pages += block.second.size();
+    }
+    uint64_t node = 4 * sizeof(void*) + sizeof(std::pair<uint64_t, void*>);
+    return blocks_.size() * (node + sizeof(PageDataMap)) +
+           num_pages * (node + sizeof(PageData));
+  }
+
+ private:
+  uint64_t pages_per_block_;
+  std::map<uint64_t, PageDataMap> blocks_;
+};
+
+// Write a 64MiB chunk sequentially by 4KiB and 128KiB requests, then
+// overwrite it, compare the throughput and index overhead.
+TEST_F(PageTableTest, DISABLED_BenchmarkWrite) {
+  const uint64_t kChunkSize = 64 * kMiB;
+  const uint64_t kPagesPerBlock = 4 * kMiB / kPageSize;
+  const int kRounds = 4;
+
+  auto run = [&](const std::string& name, auto new_table,
+                 uint64_t request_size) {
+    std::string data(request_size, 'x');
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < kRounds; round++) {
+      auto table = new_table();
+      for (int pass = 0; pass < 2; pass++) {  // write then overwrite
+        for (uint64_t pos = 0; pos < kChunkSize;) {
+          uint64_t n = std::min(request_size, kPageSize - pos % kPageSize);
+          bool created;
+          char* page = table->GetOrNew(pos / kPageSize, &created);
+          std::memcpy(page + pos % kPageSize, data.data(), n);
+          pos += n;
+        }
+      }
+    }
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    double gib = 2.0 * kChunkSize * kRounds / (1024 * kMiB);
+    LOG(INFO) << name << " (" << request_size / kKiB
+              << "KiB): throughput=" << gib / seconds << " GiB/s";
+  };
+
+  for (uint64_t request_size : {4 * kKiB, 128 * kKiB}) {
+    run(
+        "map",
+        [&]() { return std::make_unique<MapPageTable>(kPagesPerBlock); },
+        request_size);
+    run(
+        "flat", []() { return std::make_unique<PageTable>(); }, request_size);
+  }
+
+  MapPageTable map_table(kPagesPerBlock);
+  bool created;
+  for (uint64_t index = 0; index < kChunkSize / kPageSize; index++) {
+    map_table.GetOrNew(index, &created);
+  }
+  LOG(INFO) << "index overhead of " << kChunkSize / kPageSize
+            << " pages: map=" << map_table.IndexBytes()
+            << " bytes, flat=" << kChunkSize / kPageSize * sizeof(char*)
+            << " bytes";
+}
+
+}  // namespace client
+}  // namespace dingofs
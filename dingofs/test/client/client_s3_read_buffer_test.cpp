@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include <fcntl.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "dingofs/src/client/blockcache/mem_cache.h"
+#include "dingofs/src/client/s3/client_s3_read_buffer.h"
+
+namespace dingofs {
+namespace client {
+
+using blockcache::BCACHE_ERROR;
+using blockcache::BlockBuffer;
+using blockcache::BlockReader;
+using blockcache::MemBlock;
+using blockcache::MemBlockReader;
+
+static constexpr size_t kKiB = 1024;
+static constexpr size_t kMiB = 1024 * kKiB;
+
+// The block reader which backed by file, like the disk cache.
+class FileBlockReader : public BlockReader {
+ public:
+  explicit FileBlockReader(int fd) : fd_(fd) {}
+
+  BCACHE_ERROR ReadAt(off_t offset, size_t length, char* buffer) override {
+    ssize_t n = ::pread(fd_, buffer, length, offset);
+    return n == static_cast<ssize_t>(length) ? BCACHE_ERROR::OK
+                                              : BCACHE_ERROR::IO_ERROR;
+  }
+
+  bool GetBuffer(off_t offset, size_t, BlockBuffer* buffer) override {
+    buffer->fd = fd_;
+    buffer->pos = offset;
+    return true;
+  }
+
+  void Close() override { closed_ = true; }
+
+  bool Closed() const { return closed_; }
+
+ private:
+  int fd_;
+  bool closed_{false};
+};
+
+// The block reader which doesn't support zero-copy.
+class CopyBlockReader : public BlockReader {
+ public:
+  BCACHE_ERROR ReadAt(off_t, size_t, char*) override {
+    return BCACHE_ERROR::OK;
+  }
+
+  void Close() override {}
+};
+
+class ReadBufferTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char path[] = "/tmp/dingofs_read_buffer_XXXXXX";
+    fd_ = ::mkstemp(path);
+    ASSERT_GE(fd_, 0);
+    ::unlink(path);
+  }
+
+  void TearDown() override { ::close(fd_); }
+
+  void WriteFile(size_t length, char c) {
+    std::string data(length, c);
+    ASSERT_EQ(::pwrite(fd_, data.data(), length, 0), length);
+  }
+
+ protected:
+  int fd_;
+};
+
+TEST_F(ReadBufferTest, PoolReuse) {
+  auto& pool = ReadBufferPool::GetInstance();
+  size_t capacity;
+  char* data = pool.Alloc(5 * kKiB, &capacity);
+  ASSERT_EQ(capacity, 8 * kKiB);
+
+  size_t nfree = pool.NumFreeBuffers();
+  pool.Free(data, capacity);
+  ASSERT_EQ(pool.NumFreeBuffers(), nfree + 1);
+  ASSERT_EQ(pool.Alloc(7 * kKiB, &capacity), data);  // same size class
+  pool.Free(data, capacity);
+
+  // too large to pool
+  data = pool.Alloc(4 * kMiB, &capacity);
+  ASSERT_EQ(capacity, 4 * kMiB);
+  nfree = pool.NumFreeBuffers();
+  pool.Free(data, capacity);
+  ASSERT_EQ(pool.NumFreeBuffers(), nfree);
+}
+
+TEST_F(ReadBufferTest, ExternalBuffer) {
+  char data[kKiB];
+  ReadBuffer buffer(data, sizeof(data));
+  ASSERT_EQ(buffer.Data(), data);
+  ASSERT_FALSE(buffer.ZeroCopyable());
+
+  ReadBuffer buffer2(kKiB);
+  ASSERT_TRUE(buffer2.ZeroCopyable());
+}
+
+TEST_F(ReadBufferTest, AppendSegments) {
+  WriteFile(4 * kKiB, 'f');
+  std::string block(4 * kKiB, 'm');
+  auto mem_reader = std::make_shared<MemBlockReader>(
+      std::make_shared<MemBlock>(block.data(), block.size()));
+  auto file_reader = std::make_shared<FileBlockReader>(fd_);
+
+  ReadBuffer buffer(8 * kKiB);
+  ASSERT_TRUE(buffer.Append(mem_reader, kKiB, kKiB));
+  buffer.Append(kKiB, kKiB);  // hole
+  ASSERT_TRUE(buffer.Append(file_reader, 2 * kKiB, 2 * kKiB));
+  ASSERT_FALSE(buffer.Append(mem_reader, 3 * kKiB, 2 * kKiB));  // overflow
+  ASSERT_FALSE(buffer.Append(std::make_shared<CopyBlockReader>(), 0, kKiB));
+
+  const auto& segments = buffer.Segments();
+  ASSERT_EQ(segments.size(), 3);
+  ASSERT_EQ(segments[0].mem[0], 'm');
+  ASSERT_EQ(segments[0].length, kKiB);
+  ASSERT_EQ(segments[1].mem, buffer.Data() + kKiB);
+  ASSERT_EQ(segments[2].mem, nullptr);
+  ASSERT_EQ(segments[2].fd, fd_);
+  ASSERT_EQ(segments[2].pos, 2 * kKiB);
+  ASSERT_EQ(segments[2].length, 2 * kKiB);
+}
+
+TEST_F(ReadBufferTest, ReaderKeptUntilReset) {
+  auto file_reader = std::make_shared<FileBlockReader>(fd_);
+  {
+    ReadBuffer buffer(kKiB);
+    ASSERT_TRUE(buffer.Append(file_reader, 0, kKiB));
+    ASSERT_FALSE(file_reader->Closed());
+    ASSERT_EQ(file_reader.use_count(), 2);
+
+    buffer.Reset();
+    ASSERT_TRUE(file_reader->Closed());
+    ASSERT_TRUE(buffer.Segments().empty());
+    ASSERT_EQ(file_reader.use_count(), 1);
+  }
+
+  // the reader is closed when buffer destroyed
+  auto file_reader2 = std::make_shared<FileBlockReader>(fd_);
+  {
+    ReadBuffer buffer(kKiB);
+    ASSERT_TRUE(buffer.Append(file_reader2, 0, kKiB));
+  }
+  ASSERT_TRUE(file_reader2->Closed());
+}
+
+// Compare the CPU cost of replying read from disk cache:
+//   copy:      pread() cache file into a new buffer, write() it to pipe
+//   zero-copy: splice() cache file to pipe directly
+// The pipe is drained to /dev/null, like the fuse device consuming it.
+TEST_F(ReadBufferTest, DISABLED_BenchmarkZeroCopy) {
+  const size_t kBlockSize = 4 * kMiB;
+  const size_t kRequestSize = 128 * kKiB;
+  const int kRounds = 64;
+  WriteFile(kBlockSize, 'x');
+
+  int pipefd[2];
+  ASSERT_EQ(::pipe(pipefd), 0);
+  ::fcntl(pipefd[1], F_SETPIPE_SZ, kRequestSize);
+  int devnull = ::open("/dev/null", O_WRONLY);
+  ASSERT_GE(devnull, 0);
+
+  auto drain = [&](size_t length) {
+    while (length > 0) {
+      ssize_t n = ::splice(pipefd[0], nullptr, devnull, nullptr, length, 0);
+      ASSERT_GT(n, 0);
+      length -= n;
+    }
+  };
+
+  auto cpu_seconds = []() {
+    struct rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+  };
+
+  auto run = [&](const std::string& name, bool zero_copy) {
+    auto start = std::chrono::steady_clock::now();
+    double cpu_start = cpu_seconds();
+    for (int round = 0; round < kRounds; round++) {
+      for (size_t off = 0; off < kBlockSize; off += kRequestSize) {
+        if (zero_copy) {
+          ReadBuffer buffer(kRequestSize);
+          auto reader = std::make_shared<FileBlockReader>(fd_);
+          ASSERT_TRUE(buffer.Append(reader, off, kRequestSize));
+          loff_t pos = buffer.Segments()[0].pos;
+          size_t length = kRequestSize;
+          while (length > 0) {
+            ssize_t n =
+                ::splice(fd_, &pos, pipefd[1], nullptr, length, SPLICE_F_MOVE);
+            ASSERT_GT(n, 0);
+            drain(n);
+            length -= n;
+          }
+        } else {
+          std::unique_ptr<char[]> buffer(new char[kRequestSize]);
+          ASSERT_EQ(::pread(fd_, buffer.get(), kRequestSize, off),
+                    kRequestSize);
+          ASSERT_EQ(::write(pipefd[1], buffer.get(), kRequestSize),
+                    kRequestSize);
+          drain(kRequestSize);
+        }
+      }
+    }
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    double gib = static_cast<double>(kBlockSize) * kRounds / (1024 * kMiB);
+    LOG(INFO) << name << ": throughput=" << gib / seconds
+              << " GiB/s, cpu=" << (cpu_seconds() - cpu_start) / gib
+              << " s/GiB";
+  };
+
+  run("copy", false);
+  run("zero-copy", true);
+
+  ::close(devnull);
+  ::close(pipefd[0]);
+  ::close(pipefd[1]);
+}
+
+}  // namespace client
+}  // namespace dingofs
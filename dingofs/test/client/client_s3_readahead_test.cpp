@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "dingofs/src/client/common/dynamic_config.h"
+#include "dingofs/src/client/s3/client_s3_readahead.h"
+#include "dingofs/src/stub/metric/metric.h"
+
+namespace dingofs {
+namespace client {
+
+using common::FLAGS_s3_readahead_max_memory_mb;
+using stub::metric::ReadaheadMetric;
+
+static constexpr uint64_t kKiB = 1024;
+static constexpr uint64_t kMiB = 1024 * kKiB;
+
+class ReadaheadTest : public ::testing::Test {
+ protected:
+  void SetUp() override { FLAGS_s3_readahead_max_memory_mb = 512; }
+
+  static std::unique_ptr<char[]> NewData(uint64_t length, char c) {
+    std::unique_ptr<char[]> data(new char[length]);
+    std::memset(data.get(), c, length);
+    return data;
+  }
+};
+
+TEST_F(ReadaheadTest, WindowGrowOnSequentialRead) {
+  ReadaheadWindow window;
+  ASSERT_EQ(window.Update(0, 128 * kKiB, kMiB, 1, 8, false), 1);
+
+  // grow once per block
+  for (uint64_t offset = 128 * kKiB; offset < kMiB; offset += 128 * kKiB) {
+    ASSERT_EQ(window.Update(offset, 128 * kKiB, kMiB, 1, 8, false), 1);
+  }
+  ASSERT_EQ(window.Update(kMiB, 128 * kKiB, kMiB, 1, 8, false), 2);
+  ASSERT_EQ(window.Update(2 * kMiB, kMiB, kMiB, 1, 8, false), 4);
+  ASSERT_EQ(window.Update(3 * kMiB, kMiB, kMiB, 1, 8, false), 8);
+  ASSERT_EQ(window.Update(4 * kMiB, kMiB, kMiB, 1, 8, false), 8);  // max
+}
+
+TEST_F(ReadaheadTest, WindowRequireStrictAdjacency) {
+  ReadaheadWindow window;
+  ASSERT_EQ(window.Update(0, 128 * kKiB, kMiB, 2, 8, false), 2);
+  ASSERT_EQ(window.Update(128 * kKiB, 128 * kKiB, kMiB, 2, 8, false), 2);
+
+  // gap
+  ASSERT_EQ(window.Update(512 * kKiB, 128 * kKiB, kMiB, 2, 8, false), 0);
+  ASSERT_EQ(window.Update(640 * kKiB, 128 * kKiB, kMiB, 2, 8, false), 2);
+
+  // overlap
+  ASSERT_EQ(window.Update(704 * kKiB, 128 * kKiB, kMiB, 2, 8, false), 0);
+  ASSERT_EQ(window.Update(832 * kKiB, 128 * kKiB, kMiB, 2, 8, false), 2);
+
+  // reorder
+  ASSERT_EQ(window.Update(1088 * kKiB, 128 * kKiB, kMiB, 2, 8, false), 0);
+  ASSERT_EQ(window.Update(960 * kKiB, 128 * kKiB, kMiB, 2, 8, false), 0);
+}
+
+TEST_F(ReadaheadTest, WindowCollapseOnRandomRead) {
+  ReadaheadWindow window;
+  ASSERT_EQ(window.Update(0, kMiB, kMiB, 1, 8, false), 1);
+  ASSERT_EQ(window.Update(kMiB, kMiB, kMiB, 1, 8, false), 2);
+  ASSERT_EQ(window.Update(100 * kMiB, 4 * kKiB, kMiB, 1, 8, false), 0);
+  ASSERT_EQ(window.Window(), 0);
+
+  // restart from the initial window
+  ASSERT_EQ(window.Update(100 * kMiB + 4 * kKiB, 4 * kKiB, kMiB, 1, 8, false),
+            1);
+
+  // not start from the beginning of file
+  ReadaheadWindow window2;
+  ASSERT_EQ(window2.Update(kMiB, 4 * kKiB, kMiB, 1, 8, false), 0);
+}
+
+TEST_F(ReadaheadTest, WindowShrinkOnMemoryPressure) {
+  ReadaheadWindow window;
+  ASSERT_EQ(window.Update(0, kMiB, kMiB, 4, 8, false), 4);
+  ASSERT_EQ(window.Update(kMiB, kMiB, kMiB, 4, 8, true), 4);  // 8 -> 4
+  ASSERT_EQ(window.Update(2 * kMiB, kMiB, kMiB, 4, 8, true), 4);  // 8 -> 4
+  ASSERT_EQ(window.Update(3 * kMiB, 128 * kKiB, kMiB, 4, 8, true), 4);
+
+  // disabled
+  ReadaheadWindow window2;
+  ASSERT_EQ(window2.Update(0, kMiB, kMiB, 4, 0, false), 0);
+}
+
+TEST_F(ReadaheadTest, BufferPutAndGet) {
+  ReadaheadBuffer buffer;
+  char out[kKiB];
+  ASSERT_FALSE(buffer.Get("block_0", 0, kKiB, out));
+
+  ASSERT_TRUE(buffer.Put("block_0", NewData(2 * kKiB, 'a'), 2 * kKiB, 8));
+  ASSERT_TRUE(buffer.IsCached("block_0"));
+  ASSERT_FALSE(buffer.Get("block_0", kKiB, 2 * kKiB, out));  // out of range
+
+  ASSERT_TRUE(buffer.Get("block_0", 0, kKiB, out));
+  ASSERT_EQ(out[0], 'a');
+  ASSERT_TRUE(buffer.IsCached("block_0"));
+
+  // dropped once read entirely
+  ASSERT_TRUE(buffer.Get("block_0", kKiB, kKiB, out));
+  ASSERT_FALSE(buffer.IsCached("block_0"));
+  ASSERT_EQ(ReadaheadBuffer::UsedBytes(), 0);
+}
+
+TEST_F(ReadaheadTest, BufferEvictAndWasted) {
+  auto& metric = ReadaheadMetric::GetInstance();
+  uint64_t wasted = metric.wasted_bytes.get_value();
+
+  ReadaheadBuffer buffer;
+  ASSERT_TRUE(buffer.Put("block_0", NewData(kKiB, 'a'), kKiB, 2));
+  ASSERT_TRUE(buffer.Put("block_1", NewData(kKiB, 'b'), kKiB, 2));
+  ASSERT_TRUE(buffer.Put("block_2", NewData(kKiB, 'c'), kKiB, 2));
+  ASSERT_FALSE(buffer.IsCached("block_0"));  // evict the oldest one
+  ASSERT_TRUE(buffer.IsCached("block_1"));
+  ASSERT_TRUE(buffer.IsCached("block_2"));
+  ASSERT_EQ(metric.wasted_bytes.get_value() - wasted, kKiB);
+
+  buffer.Clear();
+  ASSERT_EQ(metric.wasted_bytes.get_value() - wasted, 3 * kKiB);
+  ASSERT_EQ(ReadaheadBuffer::UsedBytes(), 0);
+}
+
+TEST_F(ReadaheadTest, BufferMemoryBudget) {
+  FLAGS_s3_readahead_max_memory_mb = 1;
+
+  ReadaheadBuffer buffer;
+  ASSERT_TRUE(buffer.Put("block_0", NewData(kMiB, 'a'), kMiB, 8));
+  ASSERT_FALSE(buffer.Put("block_1", NewData(kKiB, 'b'), kKiB, 8));
+  ASSERT_FALSE(buffer.IsCached("block_1"));
+
+  // the budget is shared by all files
+  ReadaheadBuffer buffer2;
+  ASSERT_FALSE(buffer2.Put("block_0", NewData(kKiB, 'c'), kKiB, 8));
+
+  buffer.Clear();
+  ASSERT_TRUE(buffer2.Put("block_0", NewData(kKiB, 'c'), kKiB, 8));
+}
+
+TEST_F(ReadaheadTest, History) {
+  ReadaheadHistory history;
+  ASSERT_FALSE(history.Contains("block_0"));
+
+  history.Add("block_0", 2);
+  history.Add("block_1", 2);
+  ASSERT_TRUE(history.Contains("block_0"));
+  ASSERT_TRUE(history.Contains("block_1"));
+
+  history.Add("block_2", 2);  // forget the oldest one
+  ASSERT_FALSE(history.Contains("block_0"));
+  ASSERT_TRUE(history.Contains("block_1"));
+  ASSERT_TRUE(history.Contains("block_2"));
+
+  history.Clear();
+  ASSERT_FALSE(history.Contains("block_1"));
+  ASSERT_FALSE(history.Contains("block_2"));
+}
+
+// Scan a file sequentially, every block fetched from s3 costs |kLatency|,
+// the blocks in window are fetched in background and kept in
+// ReadaheadBuffer. Run it with --gtest_also_run_disabled_tests.
+TEST_F(ReadaheadTest, DISABLED_BenchmarkSequentialScan) {
+  constexpr uint64_t kBlockSize = kMiB;
+  constexpr uint64_t kBlocks = 128;
+  constexpr uint64_t kRequestSize = 128 * kKiB;
+  const auto kLatency = std::chrono::milliseconds(10);
+
+  auto fetch = [&](ReadaheadBuffer* buffer, uint64_t index) {
+    std::this_thread::sleep_for(kLatency);
+    buffer->Put("block_" + std::to_string(index),
+                NewData(kBlockSize, 'a' + index % 26), kBlockSize, 16);
+  };
+
+  auto scan = [&](uint32_t max_blocks) {
+    ReadaheadWindow window;
+    ReadaheadBuffer buffer;
+    std::map<uint64_t, std::future<void>> inflight;
+    uint64_t hits = 0;
+    std::unique_ptr<char[]> out(new char[kRequestSize]);
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t offset = 0; offset < kBlocks * kBlockSize;
+         offset += kRequestSize) {
+      uint64_t index = offset / kBlockSize;
+      uint32_t n = window.Update(offset, kRequestSize, kBlockSize, 1,
+                                 max_blocks, false);
+      for (uint64_t i = index + 1; i <= index + n && i < kBlocks; i++) {
+        if (inflight.find(i) == inflight.end()) {
+          inflight.emplace(
+              i, std::async(std::launch::async, fetch, &buffer, i));
+        }
+      }
+
+      auto iter = inflight.find(index);
+      bool prefetched = iter != inflight.end() && iter->second.valid();
+      if (prefetched) {
+        iter->second.wait();
+        hits++;
+      } else if (iter == inflight.end()) {  // read it synchronously
+        fetch(&buffer, index);
+        inflight.emplace(index, std::future<void>());
+      }
+      std::string name = "block_" + std::to_string(index);
+      CHECK(buffer.Get(name, offset % kBlockSize, kRequestSize, out.get()));
+    }
+    for (auto& item : inflight) {
+      if (item.second.valid()) {
+        item.second.wait();
+      }
+    }
+
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    LOG(INFO) << "readahead max blocks=" << max_blocks
+              << ": throughput=" << kBlocks * kBlockSize / kMiB / seconds
+              << " MiB/s, readahead hits=" << hits << "/"
+              << kBlocks * kBlockSize / kRequestSize;
+    return seconds;
+  };
+
+  double without = scan(0);
+  double with = scan(8);
+  EXPECT_LT(with, without);
+}
+
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include <fcntl.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dingofs/src/client/datastream/data_stream.h"
+#include "dingofs/src/client/s3/client_s3_adaptor.h"
+#include "dingofs/src/client/s3/client_s3_cache_manager.h"
+#include "dingofs/src/client/s3/client_s3_write_buffer.h"
+#include "dingofs/test/client/mock_client_s3_cache_manager.h"
+
+namespace dingofs {
+namespace client {
+
+using datastream::DataStream;
+
+static constexpr uint64_t kKiB = 1024;
+static constexpr uint64_t kMiB = 1024 * kKiB;
+static constexpr uint64_t kPageSize = 64 * kKiB;
+
+class WriteBufferTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    common::DataStreamOption option;
+    option.background_flush_option.trigger_force_memory_ratio = 0.9;
+    option.file_option = {1, 16};
+    option.chunk_option = {1, 16};
+    option.slice_option = {1, 16};
+    option.page_option = {kPageSize, 256 * kMiB, false};
+    ASSERT_TRUE(DataStream::GetInstance().Init(option));
+  }
+
+  // Fill the buffer with |data| like reading it from fuse device.
+  static WriteBuffer::FillFunc FillFrom(const std::string& data,
+                                        std::vector<struct iovec>* out) {
+    return [&data, out](const std::vector<struct iovec>& iovs) {
+      size_t pos = 0;
+      for (const auto& iov : iovs) {
+        std::memcpy(iov.iov_base, data.data() + pos, iov.iov_len);
+        pos += iov.iov_len;
+      }
+      *out = iovs;
+      return pos == data.size();
+    };
+  }
+
+  static std::string NewData(size_t length) {
+    std::string data(length, '\0');
+    for (size_t i = 0; i < length; i++) {
+      data[i] = static_cast<char>(i % 251);
+    }
+    return data;
+  }
+};
+
+TEST_F(WriteBufferTest, PageAlignedLayout) {
+  std::string data = NewData(200 * kKiB);
+  std::vector<struct iovec> iovs;
+  WriteBuffer buffer(kPageSize + 100, data.size(), FillFrom(data, &iovs));
+  ASSERT_TRUE(buffer.Fill(kPageSize));
+
+  // the first page starts at the offset in page, like DataCache
+  ASSERT_EQ(iovs.size(), 4);
+  ASSERT_EQ(iovs[0].iov_len, kPageSize - 100);
+  ASSERT_EQ(iovs[1].iov_len, kPageSize);
+  ASSERT_EQ(iovs[2].iov_len, kPageSize);
+  ASSERT_EQ(iovs[3].iov_len, 200 * kKiB - 3 * kPageSize + 100);
+
+  ASSERT_EQ(*buffer.Data(0), data[0]);
+  ASSERT_EQ(*buffer.Data(kPageSize - 100), data[kPageSize - 100]);
+  std::string out(data.size(), '\0');
+  buffer.CopyTo(0, data.size(), &out[0]);
+  ASSERT_EQ(out, data);
+
+  char* page = buffer.TakePage(kPageSize - 100);
+  ASSERT_EQ(page, static_cast<char*>(iovs[1].iov_base));
+  DataStream::GetInstance().FreePage(page);
+}
+
+TEST_F(WriteBufferTest, FillFailed) {
+  WriteBuffer buffer(0, kKiB,
+                     [](const std::vector<struct iovec>&) { return false; });
+  ASSERT_FALSE(buffer.Fill(kPageSize));
+}
+
+TEST_F(WriteBufferTest, DataCacheAdoptPages) {
+  common::S3ClientAdaptorOption option;
+  option.blockSize = 1 * kMiB;
+  option.chunkSize = 4 * kMiB;
+  option.pageSize = kPageSize;
+  option.intervalMs = 5000 * 1000;
+  option.flushIntervalSec = 5000;
+  option.readCacheMaxByte = 104857600;
+  option.readCacheThreads = 5;
+  auto* s3_client_adaptor = new S3ClientAdaptorImpl();
+  auto fs_cache_manager = std::make_shared<FsCacheManager>(
+      s3_client_adaptor, option.readCacheMaxByte, option.writeCacheMaxByte,
+      option.readCacheThreads, nullptr);
+  s3_client_adaptor->Init(option, nullptr, nullptr, nullptr, fs_cache_manager,
+                          nullptr, nullptr, nullptr);
+  auto chunk_cache_manager = std::make_shared<MockChunkCacheManager>();
+
+  // new DataCache: [100, 100 + 2 pages)
+  std::string data = NewData(2 * kPageSize);
+  std::vector<struct iovec> iovs;
+  WriteBuffer buffer(100, data.size(), FillFrom(data, &iovs));
+  ASSERT_TRUE(buffer.Fill(kPageSize));
+  auto data_cache = std::make_shared<DataCache>(
+      s3_client_adaptor, chunk_cache_manager, 100, data.size(), &buffer, 0,
+      nullptr);
+  ASSERT_EQ(data_cache->GetLen(), data.size());
+  ASSERT_EQ(data_cache->GetActualLen(), 3 * kPageSize);
+  // the partial pages are copied, the full page is adopted
+  ASSERT_NE(data_cache->GetPage(0), iovs[0].iov_base);
+  ASSERT_EQ(data_cache->GetPage(1), iovs[1].iov_base);
+  ASSERT_NE(data_cache->GetPage(2), iovs[2].iov_base);
+
+  // append: [100 + 2 pages, 100 + 4 pages)
+  std::string data2 = NewData(2 * kPageSize);
+  WriteBuffer buffer2(100 + data.size(), data2.size(), FillFrom(data2, &iovs));
+  ASSERT_TRUE(buffer2.Fill(kPageSize));
+  data_cache->WriteBuf(100 + data.size(), data2.size(), &buffer2, 0);
+  ASSERT_EQ(data_cache->GetLen(), 4 * kPageSize);
+  ASSERT_EQ(data_cache->GetActualLen(), 5 * kPageSize);
+  ASSERT_EQ(data_cache->GetPage(3), iovs[1].iov_base);
+
+  std::string out(4 * kPageSize, '\0');
+  data_cache->CopyDataCacheToBuf(0, out.size(), &out[0]);
+  ASSERT_EQ(out, data + data2);
+}
+
+// Compare the write bandwidth of ingesting the data from pipe (splice):
+//   copy:     read() pipe into a heap buffer (libfuse without write_buf),
+//             then copy it into pages
+//   write_buf: readv() pipe into pages directly
+TEST_F(WriteBufferTest, DISABLED_BenchmarkWriteBuf) {
+  const size_t kRequestSize = 128 * kKiB;  // max_write of fuse
+  const size_t kTotalSize = 256 * kMiB;
+
+  int pipefd[2];
+  ASSERT_EQ(::pipe(pipefd), 0);
+  ::fcntl(pipefd[1], F_SETPIPE_SZ, kRequestSize);
+  std::string data = NewData(kRequestSize);
+
+  auto run = [&](const std::string& name, bool write_buf) {
+    std::thread producer([&]() {  // the kernel, writes the requests
+      for (size_t n = 0; n < kTotalSize; n += kRequestSize) {
+        size_t pos = 0;
+        while (pos < kRequestSize) {
+          ssize_t rc =
+              ::write(pipefd[1], data.data() + pos, kRequestSize - pos);
+          ASSERT_GT(rc, 0);
+          pos += rc;
+        }
+      }
+    });
+
+    auto read_full = [&](const std::vector<struct iovec>& iovs) {
+      std::vector<struct iovec> left = iovs;
+      size_t idx = 0;
+      while (idx < left.size()) {
+        ssize_t rc = ::readv(pipefd[0], &left[idx], left.size() - idx);
+        if (rc <= 0) {
+          return false;
+        }
+        while (rc > 0 && idx < left.size()) {
+          size_t n = std::min<size_t>(rc, left[idx].iov_len);
+          left[idx].iov_base = static_cast<char*>(left[idx].iov_base) + n;
+          left[idx].iov_len -= n;
+          rc -= n;
+          if (left[idx].iov_len == 0) {
+            idx++;
+          }
+        }
+      }
+      return true;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t off = 0; off < kTotalSize; off += kRequestSize) {
+      if (write_buf) {
+        WriteBuffer buffer(off, kRequestSize, read_full);
+        ASSERT_TRUE(buffer.Fill(kPageSize));
+        for (size_t pos = 0; pos < kRequestSize; pos += kPageSize) {
+          DataStream::GetInstance().FreePage(buffer.TakePage(pos));
+        }
+      } else {
+        std::unique_ptr<char[]> heap(new char[kRequestSize]);
+        ASSERT_TRUE(read_full({iovec{heap.get(), kRequestSize}}));
+        for (size_t pos = 0; pos < kRequestSize; pos += kPageSize) {
+          char* page = DataStream::GetInstance().NewPage();
+          std::memcpy(page, heap.get() + pos, kPageSize);
+          DataStream::GetInstance().FreePage(page);
+        }
+      }
+    }
+    producer.join();
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    LOG(INFO) << name << ": bandwidth=" << kTotalSize / kMiB / seconds
+              << " MiB/s";
+  };
+
+  run("copy", false);
+  run("write_buf", true);
+
+  ::close(pipefd[0]);
+  ::close(pipefd[1]);
+}
+
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "dingofs/src/client/s3/client_s3_write_throttle.h"
+#include "dingofs/src/stub/metric/metric.h"
+
+namespace dingofs {
+namespace client {
+
+using stub::metric::WriteBackMetric;
+
+class WriteThrottleTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ratio_.store(0);
+    wakeups_.store(0);
+  }
+
+  std::unique_ptr<WriteThrottle> NewThrottle(double background,
+                                             double limit) {
+    WriteThrottle::Option option;
+    option.background_ratio = background;
+    option.limit_ratio = limit;
+    option.base_pause_us = 100;
+    return std::make_unique<WriteThrottle>(
+        option, [this]() { return ratio_.load(); },
+        [this]() { wakeups_.fetch_add(1); });
+  }
+
+ protected:
+  std::atomic<double> ratio_;
+  std::atomic<int> wakeups_;
+};
+
+TEST_F(WriteThrottleTest, PauseGrowWithRatio) {
+  auto throttle = NewThrottle(0.5, 0.9);
+  uint64_t max_pause_us = 100 * WriteThrottle::kMaxPauseFactor;
+  ASSERT_EQ(throttle->PauseUs(0.3), 0);
+  ASSERT_EQ(throttle->PauseUs(0.5), 100);
+  ASSERT_NEAR(throttle->PauseUs(0.7), 200, 1);
+  ASSERT_NEAR(throttle->PauseUs(0.8), 400, 1);
+
+  uint64_t last = 0;
+  for (double ratio = 0.5; ratio < 0.9; ratio += 0.01) {
+    uint64_t pause = throttle->PauseUs(ratio);
+    ASSERT_GE(pause, last);
+    ASSERT_LE(pause, max_pause_us);
+    last = pause;
+  }
+  ASSERT_EQ(throttle->PauseUs(0.95), max_pause_us);
+}
+
+TEST_F(WriteThrottleTest, NoThrottleBelowBackground) {
+  auto throttle = NewThrottle(0.5, 0.9);
+  ratio_.store(0.4);
+  ASSERT_FALSE(throttle->NeedFlush());
+  ASSERT_EQ(throttle->Throttle(), 0);
+  ASSERT_EQ(wakeups_.load(), 0);
+}
+
+TEST_F(WriteThrottleTest, ThrottleAndWakeupFlusher) {
+  auto& metric = WriteBackMetric::GetInstance();
+  uint64_t throttled = metric.throttled_writes.get_value();
+
+  auto throttle = NewThrottle(0.5, 0.9);
+  ratio_.store(0.8);
+  ASSERT_TRUE(throttle->NeedFlush());
+  ASSERT_GE(throttle->Throttle(), 300);
+  ASSERT_EQ(wakeups_.load(), 1);
+  ASSERT_EQ(metric.throttled_writes.get_value() - throttled, 1);
+}
+
+TEST_F(WriteThrottleTest, BlockAtLimit) {
+  auto throttle = NewThrottle(0.5, 0.9);
+  ratio_.store(0.95);
+
+  std::atomic<bool> done(false);
+  std::thread writer([&]() {
+    throttle->Throttle();
+    done.store(true);
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_FALSE(done.load());
+  ratio_.store(0.85);  // flushed
+  writer.join();
+  ASSERT_TRUE(done.load());
+}
+
+TEST_F(WriteThrottleTest, BackgroundAboveLimit) {
+  // no gradual throttle, only block at the limit
+  auto throttle = NewThrottle(0.95, 0.9);
+  ASSERT_EQ(throttle->PauseUs(0.85), 0);
+  ratio_.store(0.85);
+  ASSERT_EQ(throttle->Throttle(), 0);
+}
+
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include "dingofs/src/client/filesystem/attr_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "dingofs/src/client/common/config.h"
+#include "dingofs/test/client/filesystem/helper/helper.h"
+
+namespace dingofs {
+namespace client {
+namespace filesystem {
+
+using common::AttrCacheOption;
+using pb::metaserver::FsFileType;
+using pb::metaserver::InodeAttr;
+
+class AttrCacheTest : public ::testing::Test {
+ protected:
+  static AttrCacheOption Option(uint64_t lruSize, uint32_t timeout,
+                                uint32_t dirTimeout) {
+    AttrCacheOption option;
+    option.lruSize = lruSize;
+    option.attrTimeoutSec = timeout;
+    option.dirAttrTimeoutSec = dirTimeout;
+    return option;
+  }
+
+  // Fill the attribute which is just fetched.
+  static bool Fill(std::shared_ptr<AttrCache> cache, const InodeAttr& attr) {
+    return cache->Put(attr, cache->Version(attr.inodeid()));
+  }
+};
+
+TEST_F(AttrCacheTest, Basic) {
+  auto cache = std::make_shared<AttrCache>(Option(100, 60, 60));
+  InodeAttr out;
+  ASSERT_FALSE(cache->Get(100, &out));
+
+  Fill(cache, MkAttr(100, AttrOption().length(4096)));
+  ASSERT_TRUE(cache->Get(100, &out));
+  ASSERT_EQ(out.length(), 4096);
+
+  cache->Delete(100);
+  ASSERT_FALSE(cache->Get(100, &out));
+}
+
+TEST_F(AttrCacheTest, Disable) {
+  // CASE 1: lruSize = 0
+  auto cache = std::make_shared<AttrCache>(Option(0, 60, 60));
+  InodeAttr out;
+  Fill(cache, MkAttr(100));
+  ASSERT_FALSE(cache->Get(100, &out));
+
+  // CASE 2: directory attribute timeout = 0
+  cache = std::make_shared<AttrCache>(Option(100, 60, 0));
+  Fill(cache, MkAttr(100, AttrOption().type(FsFileType::TYPE_DIRECTORY)));
+  ASSERT_FALSE(cache->Get(100, &out));
+  Fill(cache, MkAttr(200, AttrOption().type(FsFileType::TYPE_S3)));
+  ASSERT_TRUE(cache->Get(200, &out));
+}
+
+TEST_F(AttrCacheTest, Timeout) {
+  auto cache = std::make_shared<AttrCache>(Option(100, 1, 1));
+  InodeAttr out;
+  Fill(cache, MkAttr(100));
+  ASSERT_TRUE(cache->Get(100, &out));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  ASSERT_FALSE(cache->Get(100, &out));
+}
+
+TEST_F(AttrCacheTest, Revalidate) {
+  auto cache = std::make_shared<AttrCache>(Option(100, 60, 60));
+  InodeAttr out;
+  Fill(cache, MkAttr(100, AttrOption().mtime(123, 456).ctime(123, 456)));
+
+  // CASE 1: unchanged
+  cache->Revalidate(MkAttr(100, AttrOption().mtime(123, 456).ctime(123, 456)));
+  ASSERT_TRUE(cache->Get(100, &out));
+
+  // CASE 2: ctime changed, e.g. chmod
+  cache->Revalidate(MkAttr(100, AttrOption().mtime(123, 456).ctime(124, 0)));
+  ASSERT_FALSE(cache->Get(100, &out));
+
+  // CASE 3: mtime changed
+  Fill(cache, MkAttr(100, AttrOption().mtime(123, 456).ctime(123, 456)));
+  cache->Revalidate(MkAttr(100, AttrOption().mtime(123, 457).ctime(123, 456)));
+  ASSERT_FALSE(cache->Get(100, &out));
+}
+
+TEST_F(AttrCacheTest, StaleFill) {
+  auto cache = std::make_shared<AttrCache>(Option(100, 60, 60));
+  InodeAttr out;
+
+  // CASE 1: invalidated during the fetch
+  uint64_t version = cache->Version(100);
+  cache->Delete(100);
+  ASSERT_FALSE(cache->Put(MkAttr(100), version));
+  ASSERT_FALSE(cache->Get(100, &out));
+
+  // CASE 2: pinned, even the fill starts after the pin
+  cache->Pin(100);
+  cache->Pin(100);
+  ASSERT_FALSE(cache->Put(MkAttr(100), cache->Version(100)));
+  cache->Unpin(100);
+  ASSERT_FALSE(cache->Put(MkAttr(100), cache->Version(100)));
+
+  // CASE 3: the fill started before unpin completes after it
+  version = cache->Version(100);
+  cache->Unpin(100);
+  ASSERT_FALSE(cache->Put(MkAttr(100), version));
+  ASSERT_TRUE(cache->Put(MkAttr(100), cache->Version(100)));
+  ASSERT_TRUE(cache->Get(100, &out));
+
+  // CASE 4: pin drops the cached one
+  cache->Pin(100);
+  ASSERT_FALSE(cache->Get(100, &out));
+  cache->Unpin(100);
+}
+
+TEST_F(AttrCacheTest, LRUSize) {
+  auto cache = std::make_shared<AttrCache>(Option(AttrCache::kShards, 60, 60));
+  InodeAttr out;
+
+  // one entry per shard
+  Fill(cache, MkAttr(1));
+  Fill(cache, MkAttr(1 + AttrCache::kShards));
+  ASSERT_FALSE(cache->Get(1, &out));
+  ASSERT_TRUE(cache->Get(1 + AttrCache::kShards, &out));
+}
+
+}  // namespace filesystem
+}  // namespace client
+}  // namespace dingofs
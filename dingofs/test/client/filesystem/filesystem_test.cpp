@@ -212,6 +212,45 @@ TEST_F(FileSystemTest, Lookup_NegativeCache) {
   ASSERT_EQ(rc, DINGOFS_ERROR::NOTEXIST);
 }
 
+TEST_F(FileSystemTest, Lookup_PositiveCache) {
+  auto builder = FileSystemBuilder();
+  auto fs = builder
+                .SetOption([](FileSystemOption* option) {
+                  option->lookupCacheOption.positiveTimeoutSec = 60;
+                  option->lookupCacheOption.lruSize = 100000;
+                })
+                .Build();
+
+  // CASE 1: the second lookup only fetch attribute
+  EXPECT_CALL(*builder.GetDentryManager(), GetDentry(1, "f1", _))
+      .WillOnce(Invoke([&](uint64_t parent, const std::string& name,
+                           Dentry* dentry) -> DINGOFS_ERROR {
+        *dentry = MkDentry(100, name);
+        return DINGOFS_ERROR::OK;
+      }));
+  EXPECT_CALL(*builder.GetInodeManager(), GetInodeAttr(100, _))
+      .Times(2)
+      .WillRepeatedly(
+          Invoke([&](uint64_t ino, InodeAttr* attr) -> DINGOFS_ERROR {
+            *attr = MkAttr(ino);
+            return DINGOFS_ERROR::OK;
+          }));
+
+  EntryOut entryOut;
+  auto rc = fs->Lookup(Request(), 1, "f1", &entryOut);
+  ASSERT_EQ(rc, DINGOFS_ERROR::OK);
+  rc = fs->Lookup(Request(), 1, "f1", &entryOut);
+  ASSERT_EQ(rc, DINGOFS_ERROR::OK);
+  ASSERT_EQ(entryOut.attr.inodeid(), 100);
+
+  // CASE 2: lookup again after the entry modified by this client
+  fs->InvalidateLookup(1, "f1");
+  EXPECT_CALL_RETURN_GetDentry(*builder.GetDentryManager(),
+                               DINGOFS_ERROR::NOTEXIST);
+  rc = fs->Lookup(Request(), 1, "f1", &entryOut);
+  ASSERT_EQ(rc, DINGOFS_ERROR::NOTEXIST);
+}
+
 TEST_F(FileSystemTest, GetAttr_Basic) {
   auto builder = FileSystemBuilder();
   auto fs = builder.Build();
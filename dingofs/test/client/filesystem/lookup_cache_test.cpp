@@ -89,6 +89,104 @@ TEST_F(LookupCacheTest, LRUSize) {
   ASSERT_TRUE(cache->Get(1, "f2"));
 }
 
+TEST_F(LookupCacheTest, Positive) {
+  auto option = LookupCacheOption{
+    lruSize : 10,
+    negativeTimeoutSec : 1,
+    minUses : 0,
+    positiveTimeoutSec : 1,
+  };
+  auto cache = std::make_shared<LookupCache>(option);
+
+  // CASE 1: cache hit.
+  Ino ino;
+  ASSERT_FALSE(cache->Get(1, "f1", &ino));
+  cache->Put(1, "f1", 100);
+  ASSERT_TRUE(cache->Get(1, "f1", &ino));
+  ASSERT_EQ(ino, 100);
+  ASSERT_FALSE(cache->Get(1, "f1"));  // not negative entry
+
+  // CASE 2: negative entry overwrite positive one, e.g. unlinked.
+  cache->Put(1, "f1");
+  ASSERT_FALSE(cache->Get(1, "f1", &ino));
+  ASSERT_TRUE(cache->Get(1, "f1"));
+
+  // CASE 3: cache miss due to expiration.
+  cache->Put(1, "f2", 200);
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  ASSERT_FALSE(cache->Get(1, "f2", &ino));
+}
+
+TEST_F(LookupCacheTest, PositiveDisabled) {
+  auto option = LookupCacheOption{
+    lruSize : 10,
+    negativeTimeoutSec : 1,
+    minUses : 0,
+    positiveTimeoutSec : 0,
+  };
+  auto cache = std::make_shared<LookupCache>(option);
+
+  // the negative entry still dropped by the positive one
+  Ino ino;
+  cache->Put(1, "f1");
+  ASSERT_TRUE(cache->Get(1, "f1"));
+  cache->Put(1, "f1", 100);
+  ASSERT_FALSE(cache->Get(1, "f1", &ino));
+  ASSERT_FALSE(cache->Get(1, "f1"));
+}
+
+TEST_F(LookupCacheTest, DeleteParent) {
+  auto option = LookupCacheOption{
+    lruSize : 10,
+    negativeTimeoutSec : 60,
+    minUses : 0,
+    positiveTimeoutSec : 60,
+  };
+  auto cache = std::make_shared<LookupCache>(option);
+
+  Ino ino;
+  cache->Put(1, "f1", 100);
+  cache->Put(1, "f2");
+  cache->Put(2, "f1", 200);
+
+  // CASE 1: entries under parent are invalidated.
+  cache->DeleteParent(1);
+  ASSERT_FALSE(cache->Get(1, "f1", &ino));
+  ASSERT_FALSE(cache->Get(1, "f2"));
+  ASSERT_TRUE(cache->Get(2, "f1", &ino));
+  ASSERT_EQ(ino, 200);
+
+  // CASE 2: entries inserted after invalidation are valid.
+  cache->Put(1, "f1", 101);
+  ASSERT_TRUE(cache->Get(1, "f1", &ino));
+  ASSERT_EQ(ino, 101);
+}
+
+TEST_F(LookupCacheTest, DeleteParentEvicted) {
+  auto option = LookupCacheOption{
+    lruSize : 2,
+    negativeTimeoutSec : 60,
+    minUses : 0,
+    positiveTimeoutSec : 60,
+  };
+  auto cache = std::make_shared<LookupCache>(option);
+
+  Ino ino;
+  cache->Put(1, "f1", 100);
+
+  // CASE 1: the invalidation record of parent 1 is evicted by others,
+  //         but its entries are still stale.
+  cache->DeleteParent(1);
+  cache->DeleteParent(2);
+  cache->DeleteParent(3);
+  ASSERT_FALSE(cache->Get(1, "f1", &ino));
+
+  // CASE 2: entries inserted after the eviction are valid.
+  cache->Put(1, "f1", 101);
+  ASSERT_TRUE(cache->Get(1, "f1", &ino));
+  ASSERT_EQ(ino, 101);
+}
+
 }  // namespace filesystem
 }  // namespace client
 }  // namespace dingofs
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ * Author: agent
+ */
+
+#include "dingofs/src/client/filesystem/lookup_count.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace dingofs {
+namespace client {
+namespace filesystem {
+
+class LookupCountTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    forgotten_.clear();
+    count_ = std::make_shared<LookupCount>(
+        [&](Ino ino) { forgotten_.push_back(ino); });
+  }
+
+  std::vector<Ino> forgotten_;
+  std::shared_ptr<LookupCount> count_;
+};
+
+TEST_F(LookupCountTest, Basic) {
+  ASSERT_EQ(count_->Get(100), 0);
+  ASSERT_EQ(count_->Size(), 0);
+
+  count_->Ref(100);
+  count_->Ref(100);
+  count_->Ref(200);
+  ASSERT_EQ(count_->Get(100), 2);
+  ASSERT_EQ(count_->Get(200), 1);
+  ASSERT_EQ(count_->Size(), 2);
+}
+
+TEST_F(LookupCountTest, Forget) {
+  count_->Ref(100);
+  count_->Ref(100);
+  count_->Ref(100);
+
+  // CASE 1: partial forget
+  count_->Forget(100, 2);
+  ASSERT_EQ(count_->Get(100), 1);
+  ASSERT_TRUE(forgotten_.empty());
+
+  // CASE 2: forget all
+  count_->Forget(100, 1);
+  ASSERT_EQ(count_->Get(100), 0);
+  ASSERT_EQ(count_->Size(), 0);
+  ASSERT_EQ(forgotten_, std::vector<Ino>{100});
+
+  // CASE 3: forget more than referenced
+  count_->Ref(200);
+  count_->Forget(200, 10);
+  ASSERT_EQ(count_->Size(), 0);
+  ASSERT_EQ(forgotten_, std::vector<Ino>({100, 200}));
+}
+
+TEST_F(LookupCountTest, ForgetUntracked) {
+  count_->Forget(300, 1);
+  ASSERT_EQ(count_->Size(), 0);
+  ASSERT_TRUE(forgotten_.empty());
+
+  // the callback can take the lock of the same shard
+  count_ = std::make_shared<LookupCount>([&](Ino ino) {
+    forgotten_.push_back(ino);
+    ASSERT_EQ(count_->Get(ino), 0);
+  });
+  count_->Ref(400);
+  count_->Forget(400, 1);
+  ASSERT_EQ(forgotten_, std::vector<Ino>{400});
+}
+
+TEST_F(LookupCountTest, Reference) {
+  count_->Ref(100);
+  count_->Forget(100, 1);
+  count_->Ref(100);
+  ASSERT_EQ(count_->Get(100), 1);
+  ASSERT_EQ(forgotten_, std::vector<Ino>{100});
+}
+
+}  // namespace filesystem
+}  // namespace client
+}  // namespace dingofs
@@ -124,6 +124,23 @@ TEST_F(OpenFileTest, CloseAll) {
   }
 }
 
+TEST_F(OpenFileTest, Forget) {
+  auto builder = OpenFilesBuilder();
+  auto openfiles = builder.Build();
+
+  // CASE 1: forget the file which not opened
+  Ino ino = 100;
+  auto out = MkInode(0);
+  openfiles->Forget(ino);
+  ASSERT_FALSE(openfiles->IsOpened(ino, &out));
+
+  // CASE 2: forget the file whose release lost
+  openfiles->Open(ino, MkInode(ino));
+  openfiles->Open(ino, MkInode(ino));
+  openfiles->Forget(ino);
+  ASSERT_FALSE(openfiles->IsOpened(ino, &out));
+}
+
 }  // namespace filesystem
 }  // namespace client
 }  // namespace dingofs
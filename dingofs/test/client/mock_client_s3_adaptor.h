@@ -61,15 +61,22 @@ class MockS3ClientAdaptor : public S3ClientAdaptor {
 
   MOCK_METHOD4(Write, int(uint64_t inodeId, uint64_t offset, uint64_t length,
                           const char* buf));
+  MOCK_METHOD2(WriteBuf, int(uint64_t inodeId, WriteBuffer* buffer));
 
   MOCK_METHOD4(Read, int(uint64_t inodeId, uint64_t offset, uint64_t length,
                          char* buf));
+  MOCK_METHOD4(ReadZeroCopy, bool(uint64_t inodeId, uint64_t offset,
+                                  uint64_t length, ReadBuffer* buffer));
   MOCK_METHOD1(ReleaseCache, void(uint64_t inodeId));
   MOCK_METHOD1(Flush, DINGOFS_ERROR(uint64_t inodeId));
   MOCK_METHOD1(FlushAllCache, DINGOFS_ERROR(uint64_t inodeId));
   MOCK_METHOD0(FsSync, DINGOFS_ERROR());
   MOCK_METHOD0(Stop, int());
   MOCK_METHOD2(Truncate, DINGOFS_ERROR(InodeWrapper* inode, uint64_t size));
+  MOCK_METHOD5(CopyRange,
+               DINGOFS_ERROR(InodeWrapper* src, uint64_t srcOff,
+                             InodeWrapper* dst, uint64_t dstOff,
+                             uint64_t length));
   MOCK_METHOD3(AllocS3ChunkId,
                FSStatusCode(uint32_t fsId, uint32_t idNum, uint64_t* chunkId));
   MOCK_METHOD1(SetFsId, void(uint32_t fsId));
@@ -95,6 +95,10 @@ class MockDataCache : public DataCache {
   MOCK_METHOD4(Write, void(uint64_t chunkPos, uint64_t len, const char* data,
                            const std::vector<DataCachePtr>& mergeDataCacheVer));
   MOCK_METHOD2(Flush, DINGOFS_ERROR(uint64_t inodeId, bool toS3));
+  MOCK_METHOD3(FlushAsync,
+               DINGOFS_ERROR(uint64_t inodeId, bool toS3,
+                             std::shared_ptr<FlushWindow> window));
+  MOCK_METHOD1(WaitFlush, DINGOFS_ERROR(uint64_t inodeId));
   MOCK_METHOD1(Truncate, void(uint64_t size));
   MOCK_METHOD1(CanFlush, bool(bool force));
 };
@@ -46,10 +46,11 @@ class MockInodeCacheManager : public InodeCacheManager {
   MockInodeCacheManager() = default;
   ~MockInodeCacheManager() override = default;
 
-  MOCK_METHOD3(Init,
+  MOCK_METHOD4(Init,
                DINGOFS_ERROR(common::RefreshDataOption option,
                              std::shared_ptr<filesystem::OpenFiles> openFiles,
-                             std::shared_ptr<filesystem::DeferSync> deferSync));
+                             std::shared_ptr<filesystem::DeferSync> deferSync,
+                             std::shared_ptr<filesystem::AttrCache> attrCache));
 
   MOCK_METHOD2(GetInode,
                DINGOFS_ERROR(uint64_t inodeId,
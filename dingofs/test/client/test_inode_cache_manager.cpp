@@ -54,8 +54,10 @@ using ::testing::DoAll;
 using ::testing::Return;
 using ::testing::SetArgPointee;
 
+using ::dingofs::client::common::AttrCacheOption;
 using ::dingofs::client::common::DeferSyncOption;
 using ::dingofs::client::common::OpenFilesOption;
+using ::dingofs::client::filesystem::AttrCache;
 using ::dingofs::client::filesystem::DeferSync;
 using ::dingofs::client::filesystem::OpenFiles;
 
@@ -89,7 +91,12 @@ class TestInodeCacheManager : public ::testing::Test {
     option.refreshDataIntervalSec = 0;
     auto deferSync = std::make_shared<DeferSync>(DeferSyncOption());
     auto openFiles = std::make_shared<OpenFiles>(OpenFilesOption(), deferSync);
-    iCacheManager_->Init(option, openFiles, deferSync);
+    AttrCacheOption attrCacheOption;
+    attrCacheOption.lruSize = 100;
+    attrCacheOption.attrTimeoutSec = 60;
+    attrCacheOption.dirAttrTimeoutSec = 60;
+    attrCache_ = std::make_shared<AttrCache>(attrCacheOption);
+    iCacheManager_->Init(option, openFiles, deferSync, attrCache_);
   }
 
   virtual void TearDown() {
@@ -100,6 +107,7 @@ class TestInodeCacheManager : public ::testing::Test {
  protected:
   std::shared_ptr<InodeCacheManagerImpl> iCacheManager_;
   std::shared_ptr<MockMetaServerClient> metaClient_;
+  std::shared_ptr<AttrCache> attrCache_;
   uint32_t fsId_ = 888;
   uint32_t timeout_ = 3;
 };
@@ -225,6 +233,73 @@ TEST_F(TestInodeCacheManager, GetInodeAttr) {
   // ASSERT_EQ(FsFileType::TYPE_FILE, out.type());
 }
 
+TEST_F(TestInodeCacheManager, GetInodeAttrFromAttrCache) {
+  uint64_t inodeId = 100;
+  InodeAttr attr;
+  attr.set_inodeid(inodeId);
+  attr.set_fsid(fsId_);
+  attr.set_length(100);
+  attr.set_type(FsFileType::TYPE_FILE);
+  std::list<InodeAttr> attrs{attr};
+
+  // 1. only the first getattr goes to metaserver
+  EXPECT_CALL(*metaClient_, BatchGetInodeAttr(fsId_, _, _))
+      .Times(2)
+      .WillRepeatedly(
+          DoAll(SetArgPointee<2>(attrs), Return(MetaStatusCode::OK)));
+  InodeAttr out;
+  ASSERT_EQ(DINGOFS_ERROR::OK, iCacheManager_->GetInodeAttr(inodeId, &out));
+  ASSERT_EQ(DINGOFS_ERROR::OK, iCacheManager_->GetInodeAttr(inodeId, &out));
+  ASSERT_EQ(100, out.length());
+
+  // 2. the attribute is modified and replied to kernel
+  attr.set_mtime(1);
+  attrCache_->Revalidate(attr);
+  ASSERT_EQ(DINGOFS_ERROR::OK, iCacheManager_->GetInodeAttr(inodeId, &out));
+
+  // 3. invalidated by local mutation
+  EXPECT_CALL(*metaClient_, DeleteInode(fsId_, inodeId))
+      .WillOnce(Return(MetaStatusCode::OK));
+  ASSERT_EQ(DINGOFS_ERROR::OK, iCacheManager_->DeleteInode(inodeId));
+  ASSERT_FALSE(attrCache_->Get(inodeId, &out));
+}
+
+TEST_F(TestInodeCacheManager, AttrCachePinnedByModification) {
+  uint64_t inodeId = 100;
+  Inode inode;
+  inode.set_inodeid(inodeId);
+  inode.set_fsid(fsId_);
+  inode.set_length(100);
+  inode.set_type(FsFileType::TYPE_S3);
+  InodeAttr attr;
+  attr.set_inodeid(inodeId);
+  attr.set_fsid(fsId_);
+  attr.set_length(100);
+  attr.set_type(FsFileType::TYPE_S3);
+  std::list<InodeAttr> attrs{attr};
+
+  // 1. the inode is being modified, no attribute cached
+  EXPECT_CALL(*metaClient_, GetInode(fsId_, inodeId, _, _))
+      .WillOnce(DoAll(SetArgPointee<2>(inode), SetArgPointee<3>(false),
+                      Return(MetaStatusCode::OK)));
+  std::shared_ptr<InodeWrapper> inodeWrapper;
+  ASSERT_EQ(DINGOFS_ERROR::OK, iCacheManager_->GetInode(inodeId, inodeWrapper));
+
+  EXPECT_CALL(*metaClient_, BatchGetInodeAttr(fsId_, _, _))
+      .Times(3)
+      .WillRepeatedly(
+          DoAll(SetArgPointee<2>(attrs), Return(MetaStatusCode::OK)));
+  InodeAttr out;
+  ASSERT_EQ(DINGOFS_ERROR::OK, iCacheManager_->GetInodeAttr(inodeId, &out));
+  ASSERT_EQ(DINGOFS_ERROR::OK, iCacheManager_->GetInodeAttr(inodeId, &out));
+  ASSERT_FALSE(attrCache_->Get(inodeId, &out));
+
+  // 2. the modification is done
+  inodeWrapper = nullptr;
+  ASSERT_EQ(DINGOFS_ERROR::OK, iCacheManager_->GetInodeAttr(inodeId, &out));
+  ASSERT_TRUE(attrCache_->Get(inodeId, &out));
+}
+
 TEST_F(TestInodeCacheManager, CreateAndGetInode) {
   dingofs::client::common::FLAGS_enableCto = false;
   uint64_t inodeId = 100;
@@ -28,6 +28,7 @@
 #include <condition_variable>
 #include <mutex>
 #include <regex>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "dingofs/proto/metaserver.pb.h"
@@ -125,6 +126,7 @@ using ::testing::AtLeast;
 using ::testing::DoAll;
 using ::testing::Invoke;
 using ::testing::Return;
+using ::testing::SetArgPointee;
 
 class MetaOperatorTest : public testing::Test {
  protected:
@@ -493,6 +495,13 @@ TEST_F(MetaOperatorTest, PropostTest_PropostTaskFailed) {
   braft::Configuration conf;
 
   CopysetNode node(poolId, copysetId, conf, &mockNodeManager_);
+  auto* mockRaftNode = new MockRaftNode();
+  node.TEST_SetRaftNode(mockRaftNode);
+
+  // leader lease is disabled by default
+  EXPECT_CALL(*mockRaftNode, get_leader_lease_status(_)).Times(1);
+  EXPECT_CALL(*mockRaftNode, shutdown(_)).Times(AtLeast(1));
+  EXPECT_CALL(*mockRaftNode, join()).Times(AtLeast(1));
 
   node.on_leader_start(1);
   node.UpdateAppliedIndex(101);
@@ -518,6 +527,263 @@ TEST_F(MetaOperatorTest, PropostTest_PropostTaskFailed) {
   EXPECT_FALSE(response.has_appliedindex());
 }
 
+TEST_F(MetaOperatorTest, PropostTest_LeaseLeaderCanBypassPropose) {
+  dingofs::fs::MockLocalFileSystem localFs;
+
+  PoolId poolId = 100;
+  CopysetId copysetId = 100;
+  braft::Configuration conf;
+
+  CopysetNode node(poolId, copysetId, conf, &mockNodeManager_);
+  CopysetNodeOptions options;
+  options.dataUri = "local:///mnt/data";
+  options.localFileSystem = &localFs;
+  options.storageOptions.type = "memory";
+
+  EXPECT_CALL(localFs, Mkdir(_)).WillOnce(Return(0));
+
+  EXPECT_TRUE(node.Init(options));
+  auto* mockMetaStore = new mock::MockMetaStore();
+  node.TEST_SetMetaStore(mockMetaStore);
+  auto* mockRaftNode = new MockRaftNode();
+  node.TEST_SetRaftNode(mockRaftNode);
+
+  braft::LeaderLeaseStatus lease;
+  lease.state = braft::LEASE_VALID;
+  lease.term = 1;
+
+  ON_CALL(*mockMetaStore, Clear()).WillByDefault(Return(true));
+  EXPECT_CALL(*mockRaftNode, get_leader_lease_status(_))
+      .WillOnce(SetArgPointee<0>(lease));
+  EXPECT_CALL(*mockRaftNode, apply(_)).Times(0);
+  EXPECT_CALL(*mockRaftNode, shutdown(_)).Times(AtLeast(1));
+  EXPECT_CALL(*mockRaftNode, join()).Times(AtLeast(1));
+  EXPECT_CALL(*mockMetaStore, GetDentry(_, _))
+      .WillOnce(Return(MetaStatusCode::OK));
+
+  node.on_leader_start(1);
+  node.UpdateAppliedIndex(101);
+
+  // request without appliedindex is served locally by lease leader
+  GetDentryRequest request;
+  GetDentryResponse response;
+  auto op = absl::make_unique<GetDentryOperator>(&node, nullptr, &request,
+                                                 &response, nullptr);
+  op->Propose();
+  op.release();
+
+  node.TEST_FlushApplyQueue();
+
+  EXPECT_TRUE(response.has_appliedindex());
+  EXPECT_EQ(101, response.appliedindex());
+
+  node.Stop();
+}
+
+TEST_F(MetaOperatorTest, PropostTest_InvalidLeaseCanNotBypassPropose) {
+  PoolId poolId = 100;
+  CopysetId copysetId = 100;
+  braft::Configuration conf;
+
+  CopysetNode node(poolId, copysetId, conf, &mockNodeManager_);
+  auto* mockRaftNode = new MockRaftNode();
+  node.TEST_SetRaftNode(mockRaftNode);
+
+  braft::LeaderLeaseStatus lease;
+  EXPECT_CALL(*mockRaftNode, get_leader_lease_status(_))
+      .WillRepeatedly(Invoke(
+          [&lease](braft::LeaderLeaseStatus* status) { *status = lease; }));
+  EXPECT_CALL(*mockRaftNode, apply(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([](const braft::Task& task) {
+        task.done->status().set_error(EPERM, "leader changed");
+        task.done->Run();
+      }));
+  EXPECT_CALL(*mockRaftNode, shutdown(_)).Times(AtLeast(1));
+  EXPECT_CALL(*mockRaftNode, join()).Times(AtLeast(1));
+
+  node.on_leader_start(2);
+  node.UpdateAppliedIndex(101);
+
+  // CASE 1: lease of current term is expired
+  // CASE 2: lease is valid, but it belongs to a newer term
+  // CASE 3: lease of current term is not ready
+  std::vector<braft::LeaderLeaseStatus> leases(3);
+  leases[0].state = braft::LEASE_EXPIRED;
+  leases[0].term = 2;
+  leases[1].state = braft::LEASE_VALID;
+  leases[1].term = 3;
+  leases[2].state = braft::LEASE_NOT_READY;
+  leases[2].term = 2;
+  for (const auto& item : leases) {
+    lease = item;
+    EXPECT_FALSE(node.IsLeaseLeader());
+
+    GetInodeRequest request;
+    GetInodeResponse response;
+    auto op = absl::make_unique<GetInodeOperator>(&node, nullptr, &request,
+                                                  &response, nullptr);
+    op->Propose();
+    op.release();
+
+    EXPECT_EQ(MetaStatusCode::REDIRECTED, response.statuscode());
+    EXPECT_FALSE(response.has_appliedindex());
+  }
+
+  lease.state = braft::LEASE_VALID;
+  lease.term = 2;
+  EXPECT_TRUE(node.IsLeaseLeader());
+}
+
+TEST_F(MetaOperatorTest, PropostTest_LeaseOfPreviousTermCanNotBypassPropose) {
+  PoolId poolId = 100;
+  CopysetId copysetId = 100;
+  braft::Configuration conf;
+
+  CopysetNode node(poolId, copysetId, conf, &mockNodeManager_);
+  auto* mockRaftNode = new MockRaftNode();
+  node.TEST_SetRaftNode(mockRaftNode);
+
+  // lease is still valid, but it belongs to previous term
+  braft::LeaderLeaseStatus lease;
+  lease.state = braft::LEASE_VALID;
+  lease.term = 1;
+
+  EXPECT_CALL(*mockRaftNode, get_leader_lease_status(_))
+      .WillOnce(SetArgPointee<0>(lease));
+  EXPECT_CALL(*mockRaftNode, apply(_))
+      .WillOnce(Invoke([](const braft::Task& task) {
+        task.done->status().set_error(EPERM, "leader changed");
+        task.done->Run();
+      }));
+  EXPECT_CALL(*mockRaftNode, shutdown(_)).Times(AtLeast(1));
+  EXPECT_CALL(*mockRaftNode, join()).Times(AtLeast(1));
+
+  node.on_leader_start(2);
+  node.UpdateAppliedIndex(101);
+
+  GetDentryRequest request;
+  GetDentryResponse response;
+  auto op = absl::make_unique<GetDentryOperator>(&node, nullptr, &request,
+                                                 &response, nullptr);
+  op->Propose();
+  op.release();
+
+  EXPECT_EQ(MetaStatusCode::REDIRECTED, response.statuscode());
+  EXPECT_FALSE(response.has_appliedindex());
+}
+
+TEST_F(MetaOperatorTest, PropostTest_SteppedDownLeaderRedirectRead) {
+  PoolId poolId = 100;
+  CopysetId copysetId = 100;
+  braft::Configuration conf;
+
+  CopysetNode node(poolId, copysetId, conf, &mockNodeManager_);
+  auto* mockRaftNode = new MockRaftNode();
+  node.TEST_SetRaftNode(mockRaftNode);
+
+  EXPECT_CALL(*mockRaftNode, get_leader_lease_status(_)).Times(0);
+  EXPECT_CALL(*mockRaftNode, apply(_)).Times(0);
+  EXPECT_CALL(*mockRaftNode, shutdown(_)).Times(AtLeast(1));
+  EXPECT_CALL(*mockRaftNode, join()).Times(AtLeast(1));
+
+  butil::Status status;
+  status.set_error(EINVAL, "invalid");
+  node.on_leader_start(1);
+  node.on_leader_stop(status);
+  EXPECT_FALSE(node.IsLeaseLeader());
+
+  GetDentryRequest request;
+  GetDentryResponse response;
+  auto op = absl::make_unique<GetDentryOperator>(&node, nullptr, &request,
+                                                 &response, nullptr);
+  op->Propose();
+  EXPECT_EQ(MetaStatusCode::REDIRECTED, response.statuscode());
+  EXPECT_FALSE(response.has_appliedindex());
+}
+
+TEST_F(MetaOperatorTest, PropostTest_FollowerRead) {
+  dingofs::fs::MockLocalFileSystem localFs;
+
+  PoolId poolId = 100;
+  CopysetId copysetId = 100;
+  braft::Configuration conf;
+
+  CopysetNode node(poolId, copysetId, conf, &mockNodeManager_);
+  CopysetNodeOptions options;
+  options.dataUri = "local:///mnt/data";
+  options.localFileSystem = &localFs;
+  options.storageOptions.type = "memory";
+
+  EXPECT_CALL(localFs, Mkdir(_)).WillOnce(Return(0));
+
+  EXPECT_TRUE(node.Init(options));
+  auto* mockMetaStore = new mock::MockMetaStore();
+  node.TEST_SetMetaStore(mockMetaStore);
+  auto* mockRaftNode = new MockRaftNode();
+  node.TEST_SetRaftNode(mockRaftNode);
+
+  ON_CALL(*mockMetaStore, Clear()).WillByDefault(Return(true));
+  EXPECT_CALL(*mockRaftNode, apply(_)).Times(0);
+  EXPECT_CALL(*mockRaftNode, shutdown(_)).Times(AtLeast(1));
+  EXPECT_CALL(*mockRaftNode, join()).Times(AtLeast(1));
+  EXPECT_CALL(*mockMetaStore, GetInode(_, _))
+      .WillOnce(Return(MetaStatusCode::OK));
+
+  // current node is a follower
+  node.UpdateAppliedIndex(101);
+
+  // CASE 1: follower has applied the log that client has seen
+  {
+    GetInodeRequest request;
+    request.set_appliedindex(100);
+    GetInodeResponse response;
+    auto op = absl::make_unique<GetInodeOperator>(&node, nullptr, &request,
+                                                  &response, nullptr);
+    op->Propose();
+    op.release();
+
+    node.TEST_FlushApplyQueue();
+
+    EXPECT_TRUE(response.has_appliedindex());
+    EXPECT_EQ(101, response.appliedindex());
+  }
+
+  // CASE 2: follower falls behind client
+  {
+    GetInodeRequest request;
+    request.set_appliedindex(102);
+    GetInodeResponse response;
+    auto op = absl::make_unique<GetInodeOperator>(&node, nullptr, &request,
+                                                  &response, nullptr);
+    op->Propose();
+    EXPECT_EQ(MetaStatusCode::REDIRECTED, response.statuscode());
+  }
+
+  // CASE 3: request without appliedindex
+  {
+    ListDentryRequest request;
+    ListDentryResponse response;
+    auto op = absl::make_unique<ListDentryOperator>(&node, nullptr, &request,
+                                                    &response, nullptr);
+    op->Propose();
+    EXPECT_EQ(MetaStatusCode::REDIRECTED, response.statuscode());
+  }
+
+  // CASE 4: operator doesn't support follower read
+  {
+    GetDentryRequest request;
+    request.set_appliedindex(100);
+    GetDentryResponse response;
+    auto op = absl::make_unique<GetDentryOperator>(&node, nullptr, &request,
+                                                   &response, nullptr);
+    op->Propose();
+    EXPECT_EQ(MetaStatusCode::REDIRECTED, response.statuscode());
+  }
+
+  node.Stop();
+}
+
 }  // namespace copyset
 }  // namespace metaserver
 }  // namespace dingofs
@@ -47,6 +47,7 @@ class MockCopysetNode : public CopysetNode {
   MOCK_METHOD2(ChangePeers, void(const std::vector<Peer>&, braft::Closure*));
   MOCK_CONST_METHOD1(ListPeers, void(std::vector<Peer>*));
   MOCK_CONST_METHOD0(IsLeaderTerm, bool());
+  MOCK_CONST_METHOD0(IsLeaseLeader, bool());
   MOCK_METHOD1(Propose, void(const braft::Task& task));
 };
 
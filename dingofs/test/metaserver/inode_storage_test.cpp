@@ -776,7 +776,9 @@ TEST_F(InodeStorageTest, TestUpdateVolumeExtentSlice) {
 
     const std::string expectTableName =
         nameGenerator_->GetVolumeExtentTableName();
-    const std::string expectKey = "4:1:1:" + std::to_string(slice.offset());
+    const std::string expectKey =
+        storage::Key4VolumeExtentSlice(fsId, inodeId, slice.offset())
+            .SerializeToString();
     EXPECT_CALL(*kvStorage, SSet(expectTableName, expectKey, testing::_))
         .WillOnce(Return(test.second));
 
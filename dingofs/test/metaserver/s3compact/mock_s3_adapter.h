@@ -63,6 +63,8 @@ class MockS3Adapter : public S3Adapter {
   MOCK_METHOD0(GetBucketName, std::string());
   MOCK_METHOD2(PutObject, int(const Aws::String&, const std::string&));
   MOCK_METHOD2(GetObject, int(const Aws::String&, std::string*));
+  MOCK_METHOD4(GetObject, int(const std::string&, char*, off_t, size_t));
+  MOCK_METHOD2(GetObjectSize, int(const Aws::String&, uint64_t*));
   MOCK_METHOD1(DeleteObject, int(const Aws::String&));
 };
 }  // namespace metaserver
@@ -25,6 +25,7 @@
 
 #include <memory>
 
+#include "dingofs/src/client/blockcache/block_pack.h"
 #include "dingofs/src/fs/ext4_filesystem_impl.h"
 #include "dingofs/src/metaserver/s3compact_inode.h"
 #include "dingofs/src/metaserver/s3compact_manager.h"
@@ -37,6 +38,8 @@
 #include "dingofs/test/metaserver/s3compact/mock_s3infocache.h"
 #include "dingofs/test/metaserver/storage/utils.h"
 
+using ::dingofs::client::blockcache::BlockKey;
+using ::dingofs::client::blockcache::BlockPack;
 using ::dingofs::metaserver::copyset::CopysetNode;
 using ::dingofs::metaserver::copyset::CopysetNodeManager;
 using ::testing::_;
@@ -525,11 +528,63 @@ TEST_F(S3CompactTest, test_ReadFullChunk) {
 
   reset();
   EXPECT_CALL(*s3adapter_, GetObject(_, _)).WillRepeatedly(Return(-1));
+  EXPECT_CALL(*s3adapter_, GetObjectSize(_, _)).WillRepeatedly(Return(-1));
   validList.emplace_back(0, 1, 1, 1, 0, 0, false);
   ret = impl_->ReadFullChunk(ctx, validList, &fullChunk, &newChunkInfo);
   ASSERT_EQ(ret, -1);
 }
 
+TEST_F(S3CompactTest, test_ReadPackedBlock) {
+  struct CompactInodeJob::S3CompactCtx ctx {
+    1, 1, PartitionInfo(), 4, 64, 0, 0, s3adapter_.get()
+  };
+
+  // block 0 and 1 are packed into the object of block 0
+  BlockPack pack;
+  pack.Add(BlockKey(1, 1, 1, 0, 0), "abcd", 4);
+  pack.Add(BlockKey(1, 1, 1, 1, 0), "efgh", 4);
+  std::string data = pack.Finish();
+  std::string pack_name = BlockKey(1, 1, 1, 0, 0).StoreKey();
+
+  auto mock_size = [&](const Aws::String& key, uint64_t* size) {
+    std::string name(key.c_str(), key.size());
+    if (name == pack_name) {
+      *size = data.size();
+      return 0;
+    } else if (name == BlockPack::MarkerKey(1)) {
+      *size = 0;
+      return 0;
+    }
+    return -ENOENT;
+  };
+  auto mock_range = [&](const std::string& key, char* buf, off_t off,
+                        size_t len) {
+    if (key != pack_name || off + len > data.size()) {
+      return -1;
+    }
+    memcpy(buf, data.data() + off, len);
+    return 0;
+  };
+  EXPECT_CALL(*s3adapter_, GetObjectSize(_, _))
+      .WillRepeatedly(testing::Invoke(mock_size));
+  EXPECT_CALL(*s3adapter_, GetObject(_, _, _, _))
+      .WillRepeatedly(testing::Invoke(mock_range));
+
+  std::string buf;
+  ASSERT_TRUE(impl_->ReadPackedBlock(ctx, BlockKey(1, 1, 1, 1, 0).StoreKey(),
+                                     &buf));
+  ASSERT_EQ(buf, "efgh");
+
+  // not in the pack
+  ASSERT_FALSE(impl_->ReadPackedBlock(
+      ctx, BlockKey(1, 1, 1, 2, 0).StoreKey(), &buf));
+  // the object exists, it failed for other reasons
+  ASSERT_FALSE(impl_->ReadPackedBlock(ctx, pack_name, &buf));
+  // the filesystem never packed blocks
+  ASSERT_FALSE(impl_->ReadPackedBlock(
+      ctx, BlockKey(2, 1, 1, 1, 0).StoreKey(), &buf));
+}
+
 TEST_F(S3CompactTest, test_WriteFullChunk) {
   struct CompactInodeJob::S3CompactCtx ctx {
     100, 1, PartitionInfo(), 4, 16, 0, 0, s3adapter_.get()
@@ -25,7 +25,9 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include <limits>
 #include <unordered_map>
+#include <vector>
 
 namespace dingofs {
 namespace metaserver {
@@ -33,9 +35,9 @@ namespace storage {
 
 class ConverterTest : public testing::Test {
  protected:
-  void SetUp() override {}
+  void SetUp() override { FLAGS_storage_binary_key = true; }
 
-  void TearDown() override {}
+  void TearDown() override { FLAGS_storage_binary_key = false; }
 
  protected:
   Converter conv_;
@@ -66,49 +68,172 @@ TEST_F(ConverterTest, Key4Dentry) {
     LOG(INFO) << "TEST " << path;
     Key4Dentry key(1, 1, path);
     std::string skey = conv_.SerializeToString(key);
-    ASSERT_EQ(skey, "3:1:1:" + path);
+    ASSERT_EQ(skey, std::string("\x01\x03\x00\x00\x00\x01"
+                                "\x00\x00\x00\x00\x00\x00\x00\x01",
+                                14) +
+                        path);
 
     Key4Dentry out;
     ASSERT_TRUE(conv_.ParseFromString(skey, &out));
     ASSERT_EQ(out.fsId, 1);
     ASSERT_EQ(out.parentInodeId, 1);
     ASSERT_EQ(out.name, path);
+
+    // legacy format
+    ASSERT_TRUE(conv_.ParseFromString("3:1:1:" + path, &out));
+    ASSERT_EQ(out.fsId, 1);
+    ASSERT_EQ(out.parentInodeId, 1);
+    ASSERT_EQ(out.name, path);
   }
 
   for (const auto& path : paths) {
     LOG(INFO) << "TEST " << path;
     Key4Dentry key(100, 1001, path);
     std::string skey = conv_.SerializeToString(key);
-    ASSERT_EQ(skey, "3:100:1001:" + path);
 
     Key4Dentry out;
     ASSERT_TRUE(conv_.ParseFromString(skey, &out));
     ASSERT_EQ(out.fsId, 100);
     ASSERT_EQ(out.parentInodeId, 1001);
     ASSERT_EQ(out.name, path);
+
+    // legacy format
+    ASSERT_TRUE(conv_.ParseFromString("3:100:1001:" + path, &out));
+    ASSERT_EQ(out.fsId, 100);
+    ASSERT_EQ(out.parentInodeId, 1001);
+    ASSERT_EQ(out.name, path);
   }
 }
 
 TEST_F(ConverterTest, Prefix4SameParentDentry) {
   Prefix4SameParentDentry prefix(1, 100);
   std::string sprefix = conv_.SerializeToString(prefix);
-  ASSERT_EQ(sprefix, "3:1:100:");
+  ASSERT_EQ(sprefix.size(), 14);
 
   Prefix4SameParentDentry out;
   ASSERT_TRUE(conv_.ParseFromString(sprefix, &out));
   ASSERT_EQ(out.fsId, 1);
   ASSERT_EQ(out.parentInodeId, 100);
+
+  // dentry of other parent never has the same prefix
+  Key4Dentry key(1, 1001, "a");
+  ASSERT_NE(conv_.SerializeToString(key).rfind(sprefix, 0), 0);
+
+  // legacy format
+  ASSERT_TRUE(conv_.ParseFromString("3:1:100:", &out));
+  ASSERT_EQ(out.fsId, 1);
+  ASSERT_EQ(out.parentInodeId, 100);
 }
 
 TEST_F(ConverterTest, Key4InodeAuxInfo) {
   Key4InodeAuxInfo key(1, 1);
   std::string skey = conv_.SerializeToString(key);
-  ASSERT_EQ(skey, "5:1:1");
 
   Key4InodeAuxInfo out;
   ASSERT_TRUE(conv_.ParseFromString(skey, &out));
   ASSERT_EQ(out.fsId, 1);
   ASSERT_EQ(out.inodeId, 1);
+
+  // legacy format
+  ASSERT_TRUE(conv_.ParseFromString("5:2:3", &out));
+  ASSERT_EQ(out.fsId, 2);
+  ASSERT_EQ(out.inodeId, 3);
+
+  // key of other type
+  Key4Inode inode;
+  ASSERT_FALSE(conv_.ParseFromString(skey, &inode));
+}
+
+TEST_F(ConverterTest, Key4S3ChunkInfoList) {
+  Key4S3ChunkInfoList key(1, 2, 3, 4, 5, 6);
+  std::string skey = conv_.SerializeToString(key);
+
+  Key4S3ChunkInfoList out;
+  ASSERT_TRUE(conv_.ParseFromString(skey, &out));
+  ASSERT_EQ(out.fsId, 1);
+  ASSERT_EQ(out.inodeId, 2);
+  ASSERT_EQ(out.chunkIndex, 3);
+  ASSERT_EQ(out.firstChunkId, 4);
+  ASSERT_EQ(out.lastChunkId, 5);
+  ASSERT_EQ(out.size, 6);
+
+  Prefix4ChunkIndexS3ChunkInfoList prefix(1, 2, 3);
+  ASSERT_EQ(skey.rfind(conv_.SerializeToString(prefix), 0), 0);
+  ASSERT_FALSE(conv_.ParseFromString(skey.substr(0, skey.size() - 1), &out));
+}
+
+TEST_F(ConverterTest, NumericOrder) {
+  std::vector<uint64_t> ids{0, 1, 9, 10, 99, 100, 255, 256, 65536,
+                            std::numeric_limits<uint64_t>::max()};
+  for (size_t i = 1; i < ids.size(); i++) {
+    Key4Inode lhs(1, ids[i - 1]);
+    Key4Inode rhs(1, ids[i]);
+    ASSERT_LT(conv_.SerializeToString(lhs), conv_.SerializeToString(rhs));
+
+    Key4S3ChunkInfoList lhsList(1, 1, ids[i - 1], 0, 0, 0);
+    Key4S3ChunkInfoList rhsList(1, 1, ids[i], 0, 0, 0);
+    ASSERT_LT(conv_.SerializeToString(lhsList),
+              conv_.SerializeToString(rhsList));
+  }
+}
+
+TEST_F(ConverterTest, LegacyFormat) {
+  FLAGS_storage_binary_key = false;
+  ASSERT_EQ(conv_.SerializeToString(Key4Inode(1, 100)), "1:1:100");
+  ASSERT_EQ(conv_.SerializeToString(Key4Dentry(1, 100, "/a:b")),
+            "3:1:100:/a:b");
+  ASSERT_EQ(conv_.SerializeToString(Prefix4SameParentDentry(1, 100)),
+            "3:1:100:");
+  ASSERT_EQ(conv_.SerializeToString(Key4S3ChunkInfoList(1, 100, 3, 4, 5, 6)),
+            "2:1:100:3:00000000000000000004:00000000000000000005:6");
+
+  // binary key is still parsed
+  Key4Inode out;
+  FLAGS_storage_binary_key = true;
+  std::string skey = conv_.SerializeToString(Key4Inode(1, 100));
+  FLAGS_storage_binary_key = false;
+  ASSERT_TRUE(conv_.ParseFromString(skey, &out));
+  ASSERT_EQ(out.fsId, 1);
+  ASSERT_EQ(out.inodeId, 100);
+}
+
+TEST_F(ConverterTest, ConvertKey) {
+  std::string out;
+
+  // CASE 1: legacy key to binary key
+  ASSERT_TRUE(conv_.ConvertKey("1:1:100", &out));
+  ASSERT_EQ(out, conv_.SerializeToString(Key4Inode(1, 100)));
+  ASSERT_TRUE(conv_.ConvertKey(
+      "2:1:100:3:00000000000000000004:00000000000000000005:6", &out));
+  ASSERT_EQ(out, conv_.SerializeToString(Key4S3ChunkInfoList(1, 100, 3, 4, 5,
+                                                             6)));
+  ASSERT_TRUE(conv_.ConvertKey("3:1:100:/a:b", &out));
+  ASSERT_EQ(out, conv_.SerializeToString(Key4Dentry(1, 100, "/a:b")));
+  ASSERT_TRUE(conv_.ConvertKey("4:1:100:4096", &out));
+  ASSERT_EQ(out, conv_.SerializeToString(Key4VolumeExtentSlice(1, 100, 4096)));
+  ASSERT_TRUE(conv_.ConvertKey("5:1:100", &out));
+  ASSERT_EQ(out, conv_.SerializeToString(Key4InodeAuxInfo(1, 100)));
+  ASSERT_TRUE(conv_.ConvertKey("6:1", &out));
+  ASSERT_EQ(out, conv_.SerializeToString(Key4FsQuota(1)));
+  ASSERT_TRUE(conv_.ConvertKey("7:1:100", &out));
+  ASSERT_EQ(out, conv_.SerializeToString(Key4DirQuota(1, 100)));
+
+  // CASE 2: binary key is kept
+  std::string skey = conv_.SerializeToString(Key4Dentry(1, 100, "/a:b"));
+  ASSERT_TRUE(conv_.ConvertKey(skey, &out));
+  ASSERT_EQ(out, skey);
+
+  // CASE 3: binary key to legacy key
+  FLAGS_storage_binary_key = false;
+  ASSERT_TRUE(conv_.ConvertKey(skey, &out));
+  ASSERT_EQ(out, "3:1:100:/a:b");
+  ASSERT_TRUE(conv_.ConvertKey("1:1:100", &out));
+  ASSERT_EQ(out, "1:1:100");
+
+  // CASE 4: unknown key
+  ASSERT_FALSE(conv_.ConvertKey("9:1:100", &out));
+  ASSERT_FALSE(conv_.ConvertKey("key", &out));
+  ASSERT_FALSE(conv_.ConvertKey(std::string("\x01\x09", 2), &out));
 }
 
 TEST_F(ConverterTest, NameGenerator) {
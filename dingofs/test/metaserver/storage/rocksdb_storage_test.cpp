@@ -28,8 +28,12 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <string>
 
+#include "dingofs/src/metaserver/storage/converter.h"
 #include "dingofs/src/metaserver/storage/storage.h"
 #include "dingofs/src/metaserver/storage/utils.h"
 #include "dingofs/test/metaserver/storage/storage_test.h"
@@ -175,6 +179,120 @@ TEST_F(RocksDBStorageTest, HClearTestSMixOperator) {
 }
 TEST_F(RocksDBStorageTest, Transaction) { TestTransaction(kvStorage_); }
 
+// Compare the legacy string keys with the binary keys on the dentry paths:
+// get one dentry, and list the dentries of a directory which seeks by the
+// prefix and parses every key.
+TEST_F(RocksDBStorageTest, DISABLED_BenchmarkKeyFormat) {
+  const uint64_t kParents = 50;
+  const uint64_t kChildren = 1000;
+  Converter conv;
+  auto legacyKey = [](uint64_t parent, const std::string& name) {
+    return "3:1:" + std::to_string(parent) + ":" + name;
+  };
+  auto binaryKey = [&conv](uint64_t parent, const std::string& name) {
+    return conv.SerializeToString(Key4Dentry(1, parent, name));
+  };
+  auto legacyPrefix = [](uint64_t parent) {
+    return "3:1:" + std::to_string(parent) + ":";
+  };
+  auto binaryPrefix = [&conv](uint64_t parent) {
+    return conv.SerializeToString(Prefix4SameParentDentry(1, parent));
+  };
+
+  auto run = [&](const std::string& name, const std::string& table,
+                 std::function<std::string(uint64_t, const std::string&)> key,
+                 std::function<std::string(uint64_t)> prefix) {
+    for (uint64_t parent = 1; parent <= kParents; parent++) {
+      for (uint64_t i = 0; i < kChildren; i++) {
+        auto child = "file" + std::to_string(i);
+        ASSERT_TRUE(
+            kvStorage_->SSet(table, key(parent, child), Value("dentry")).ok());
+      }
+    }
+
+    Dentry value;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t parent = 1; parent <= kParents; parent++) {
+      for (uint64_t i = 0; i < kChildren; i++) {
+        auto child = "file" + std::to_string(i);
+        ASSERT_TRUE(kvStorage_->SGet(table, key(parent, child), &value).ok());
+      }
+    }
+    double getUs = std::chrono::duration<double, std::micro>(
+                       std::chrono::steady_clock::now() - start)
+                       .count() /
+                   (kParents * kChildren);
+
+    start = std::chrono::steady_clock::now();
+    for (uint64_t parent = 1; parent <= kParents; parent++) {
+      uint64_t count = 0;
+      auto iterator = kvStorage_->SSeek(table, prefix(parent));
+      ASSERT_EQ(iterator->Status(), 0);
+      for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
+        Key4Dentry out;
+        ASSERT_TRUE(conv.ParseFromString(iterator->Key(), &out));
+        ASSERT_EQ(out.parentInodeId, parent);
+        count++;
+      }
+      ASSERT_EQ(count, kChildren);
+    }
+    double listUs = std::chrono::duration<double, std::micro>(
+                        std::chrono::steady_clock::now() - start)
+                        .count() /
+                    kParents;
+
+    LOG(INFO) << name << " keys: get " << getUs << " us/op, list "
+              << kChildren << " dentries " << listUs << " us/op";
+  };
+
+  run("legacy", "partition:1", legacyKey, legacyPrefix);
+  FLAGS_storage_binary_key = true;
+  run("binary", "partition:2", binaryKey, binaryPrefix);
+  FLAGS_storage_binary_key = false;
+}
+
+TEST_F(RocksDBStorageTest, ConvertKeysTest) {
+  Dentry value;
+  Converter conv;
+  NameGenerator nameGenerator(1);
+  auto inodeTable = nameGenerator.GetInodeTableName();
+  auto dentryTable = nameGenerator.GetDentryTableName();
+  ASSERT_TRUE(kvStorage_->HSet(inodeTable, "1:1:100", Value("inode")).ok());
+  ASSERT_TRUE(kvStorage_->SSet(dentryTable, "3:1:1:/a", Value("dentry")).ok());
+
+  // CASE 1: the keys are kept in legacy format by default
+  auto* storage = dynamic_cast<RocksDBStorage*>(kvStorage_.get());
+  ASSERT_TRUE(storage->ConvertKeys());
+  ASSERT_TRUE(kvStorage_->HGet(inodeTable, "1:1:100", &value).ok());
+
+  // CASE 2: convert to binary format
+  FLAGS_storage_binary_key = true;
+  ASSERT_TRUE(storage->ConvertKeys());
+  auto skey = conv.SerializeToString(Key4Inode(1, 100));
+  ASSERT_TRUE(kvStorage_->HGet(inodeTable, skey, &value).ok());
+  ASSERT_EQ(value, Value("inode"));
+  ASSERT_TRUE(kvStorage_->HGet(inodeTable, "1:1:100", &value).IsNotFound());
+
+  auto dkey = conv.SerializeToString(Key4Dentry(1, 1, "/a"));
+  ASSERT_TRUE(kvStorage_->SGet(dentryTable, dkey, &value).ok());
+  ASSERT_EQ(value, Value("dentry"));
+  ASSERT_TRUE(kvStorage_->SGet(dentryTable, "3:1:1:/a", &value).IsNotFound());
+  ASSERT_TRUE(storage->ConvertKeys());
+  ASSERT_EQ(kvStorage_->HSize(inodeTable), 1);
+  ASSERT_EQ(kvStorage_->SSize(dentryTable), 1);
+
+  // CASE 3: convert back to legacy format, e.g. the database is recovered
+  //         from the snapshot of a member which serializes binary keys
+  FLAGS_storage_binary_key = false;
+  ASSERT_TRUE(storage->ConvertKeys());
+  ASSERT_TRUE(kvStorage_->HGet(inodeTable, "1:1:100", &value).ok());
+  ASSERT_TRUE(kvStorage_->HGet(inodeTable, skey, &value).IsNotFound());
+  ASSERT_TRUE(kvStorage_->SGet(dentryTable, "3:1:1:/a", &value).ok());
+  ASSERT_TRUE(kvStorage_->SGet(dentryTable, dkey, &value).IsNotFound());
+  ASSERT_EQ(kvStorage_->HSize(inodeTable), 1);
+  ASSERT_EQ(kvStorage_->SSize(dentryTable), 1);
+}
+
 TEST_F(RocksDBStorageTest, TestCleanOpen) {
   ASSERT_TRUE(kvStorage_->Close());
 
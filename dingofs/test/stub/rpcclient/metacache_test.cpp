@@ -25,6 +25,8 @@
 #include <brpc/server.h>
 #include <gtest/gtest.h>
 
+#include <set>
+
 #include "dingofs/proto/common.pb.h"
 #include "dingofs/src/stub/common/common.h"
 #include "dingofs/test/stub/rpcclient/mock_cli2_client.h"
@@ -226,6 +228,55 @@ TEST_F(MetaCacheTest, test_GetTarget) {
   metaCache_.MarkPartitionUnavailable(1);
 }
 
+TEST_F(MetaCacheTest, test_GetTargetForRead) {
+  uint32_t fsID = 1;
+  uint64_t inodeID = 1;
+  CopysetGroupID groupID(1, 1);
+
+  CopysetTarget target;
+  uint64_t applyIndex = 0;
+
+  opt_.followerRead = true;
+  metaCache_.Init(opt_, mockCli2Client_, mockMdsClient_);
+
+  std::vector<CopysetInfo<MetaserverID>> metaServerInfos;
+  metaServerInfos.push_back(metaServerList_);
+  EXPECT_CALL(*mockMdsClient_.get(), ListPartition(fsID, _))
+      .WillOnce(DoAll(SetArgPointee<1>(pInfoList_), Return(true)));
+  EXPECT_CALL(*mockMdsClient_.get(), GetCopysetOfPartitions(_, _))
+      .WillOnce(DoAll(SetArgPointee<1>(copysetMap_), Return(true)));
+  EXPECT_CALL(*mockMdsClient_.get(), GetMetaServerListInCopysets(_, _, _))
+      .WillOnce(DoAll(SetArgPointee<2>(metaServerInfos), Return(true)));
+
+  LOG(INFO) << "test1: read from leader before seeing an applied index";
+  ASSERT_TRUE(metaCache_.GetTargetForRead(fsID, inodeID, &target, &applyIndex));
+  ASSERT_EQ(0, applyIndex);
+  ASSERT_TRUE(CopysetTargetEQ(target, expect));
+
+  LOG(INFO) << "test2: read from all replicas in turn";
+  metaCache_.UpdateApplyIndex(groupID, 100);
+  std::set<MetaserverID> selected;
+  for (int i = 0; i < 3; ++i) {
+    target.Reset();
+    ASSERT_TRUE(
+        metaCache_.GetTargetForRead(fsID, inodeID, &target, &applyIndex));
+    ASSERT_EQ(100, applyIndex);
+    ASSERT_EQ(expect.partitionID, target.partitionID);
+    ASSERT_EQ(expect.txId, target.txId);
+    selected.insert(target.metaServerID);
+  }
+  ASSERT_EQ(std::set<MetaserverID>({1, 2, 3}), selected);
+
+  LOG(INFO) << "test3: follower read is disabled";
+  opt_.followerRead = false;
+  metaCache_.Init(opt_, mockCli2Client_, mockMdsClient_);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(
+        metaCache_.GetTargetForRead(fsID, inodeID, &target, &applyIndex));
+    ASSERT_TRUE(CopysetTargetEQ(target, expect));
+  }
+}
+
 TEST_F(MetaCacheTest, SetTxId) {
   CopysetTarget target;
   uint64_t applyIdx;
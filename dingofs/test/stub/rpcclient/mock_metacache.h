@@ -52,6 +52,10 @@ class MockMetaCache : public MetaCache {
   MOCK_METHOD3(SelectTarget, bool(uint32_t fsID, CopysetTarget* target,
                                   uint64_t* applyIndex));
 
+  MOCK_METHOD4(GetTargetForRead,
+               bool(uint32_t fsID, uint64_t inodeID, CopysetTarget* target,
+                    uint64_t* applyIndex));
+
   MOCK_METHOD1(GetAllTxIds, void(std::vector<PartitionTxId>* txIds));
 
   MOCK_METHOD2(SetTxId, void(uint32_t partitionId, uint64_t txId));
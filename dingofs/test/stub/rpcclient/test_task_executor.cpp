@@ -44,6 +44,18 @@ using common::PartitionID;
 
 using pb::metaserver::MetaStatusCode;
 
+// Fill the target of copyset (1, 1) which is served by |metaServerID|.
+void FillTarget(CopysetTarget* target, MetaserverID metaServerID) {
+  target->groupID = CopysetGroupID{1, 1};
+  target->partitionID = 1;
+  target->txId = 1;
+  target->metaServerID = metaServerID;
+
+  butil::EndPoint ep;
+  butil::str2endpoint("127.0.0.1", 12345 + metaServerID, &ep);
+  target->endPoint = std::move(ep);
+}
+
 TEST(CreateInodeTaskExecutorTest, TestPartitionAllocIdFail) {
   auto context = std::make_shared<TaskContext>();
   context->rpctask = [](LogicPoolID poolID, CopysetID copysetID,
@@ -89,6 +101,90 @@ TEST(CreateInodeTaskExecutorTest, TestPartitionAllocIdFail) {
   EXPECT_EQ(MetaStatusCode::OK, executor.DoRPCTask());
 }
 
+TEST(FollowerReadExcutorTest, TestRedirectedByFollower) {
+  int count = 0;
+  auto context = std::make_shared<TaskContext>();
+  context->rpctask = [&count](LogicPoolID poolID, CopysetID copysetID,
+                              PartitionID partitionID, uint64_t txId,
+                              uint64_t applyIndex, brpc::Channel* channel,
+                              brpc::Controller* cntl, TaskExecutorDone* done) {
+    // redirected by follower firstly
+    return ++count == 1 ? MetaStatusCode::REDIRECTED : MetaStatusCode::OK;
+  };
+
+  auto mockMetaCache = std::make_shared<MockMetaCache>();
+  auto channelMgr = std::make_shared<ChannelManager<MetaserverID>>();
+  FollowerReadExcutor executor(ExcutorOpt{}, mockMetaCache, channelMgr,
+                               context);
+
+  EXPECT_CALL(*mockMetaCache, GetTargetForRead(_, _, _, _))
+      .WillOnce(Invoke([](uint32_t /*fsId*/, uint64_t /*inodeId*/,
+                          CopysetTarget* target, uint64_t* applyIndex) {
+        FillTarget(target, 2);
+        *applyIndex = 1;
+        return true;
+      }));
+
+  // retry on the cached leader, it's not refreshed
+  EXPECT_CALL(*mockMetaCache, GetTargetLeader(_, _, false))
+      .WillOnce(Invoke(
+          [](CopysetTarget* target, uint64_t* applyIndex, bool /*refresh*/) {
+            FillTarget(target, 1);
+            *applyIndex = 1;
+            return true;
+          }));
+  EXPECT_CALL(*mockMetaCache, GetTargetLeader(_, _, true)).Times(0);
+
+  EXPECT_EQ(MetaStatusCode::OK, executor.DoRPCTask());
+  EXPECT_EQ(2, count);
+  EXPECT_EQ(1, context->target.metaServerID);
+}
+
+TEST(FollowerReadExcutorTest, TestRedirectedByLeader) {
+  int count = 0;
+  auto context = std::make_shared<TaskContext>();
+  context->rpctask = [&count](LogicPoolID poolID, CopysetID copysetID,
+                              PartitionID partitionID, uint64_t txId,
+                              uint64_t applyIndex, brpc::Channel* channel,
+                              brpc::Controller* cntl, TaskExecutorDone* done) {
+    // redirected by the stale leader firstly
+    return ++count == 1 ? MetaStatusCode::REDIRECTED : MetaStatusCode::OK;
+  };
+
+  auto mockMetaCache = std::make_shared<MockMetaCache>();
+  auto channelMgr = std::make_shared<ChannelManager<MetaserverID>>();
+  FollowerReadExcutor executor(ExcutorOpt{}, mockMetaCache, channelMgr,
+                               context);
+
+  EXPECT_CALL(*mockMetaCache, GetTargetForRead(_, _, _, _))
+      .WillOnce(Invoke([](uint32_t /*fsId*/, uint64_t /*inodeId*/,
+                          CopysetTarget* target, uint64_t* applyIndex) {
+        FillTarget(target, 1);
+        *applyIndex = 1;
+        return true;
+      }));
+
+  // the cached leader is the one which redirected, refresh it
+  EXPECT_CALL(*mockMetaCache, GetTargetLeader(_, _, false))
+      .WillOnce(Invoke(
+          [](CopysetTarget* target, uint64_t* applyIndex, bool /*refresh*/) {
+            FillTarget(target, 1);
+            *applyIndex = 1;
+            return true;
+          }));
+  EXPECT_CALL(*mockMetaCache, GetTargetLeader(_, _, true))
+      .WillOnce(Invoke(
+          [](CopysetTarget* target, uint64_t* applyIndex, bool /*refresh*/) {
+            FillTarget(target, 3);
+            *applyIndex = 1;
+            return true;
+          }));
+
+  EXPECT_EQ(MetaStatusCode::OK, executor.DoRPCTask());
+  EXPECT_EQ(2, count);
+  EXPECT_EQ(3, context->target.metaServerID);
+}
+
 }  // namespace rpcclient
 }  // namespace stub
 }  // namespace dingofs